@@ -20,8 +20,56 @@
 
 #include <balance_equations.h>
 
+#include <algorithm>
+
 namespace balance_equations {
 
+    template <unsigned int rows, unsigned int cols>
+    static bool copy_to_array(const variableMatrix &A, double (&B)[rows][cols]) {
+        /*!
+         * Copy a matrix into a fixed size row-major array checking the dimensions
+         *
+         * Returns true if the matrix has the expected dimensions and false otherwise.
+         *
+         * :param const variableMatrix &A: The incoming matrix
+         * :param double ( &B )[ rows ][ cols ]: The output array
+         */
+
+        if (A.size() != rows) {
+            return false;
+        }
+
+        for (unsigned int i = 0; i < rows; i++) {
+            if (A[i].size() != cols) {
+                return false;
+            }
+
+            std::copy(A[i].begin(), A[i].end(), B[i]);
+        }
+
+        return true;
+    }
+
+    template <unsigned int size>
+    static bool copy_to_array(const variableVector &a, double (&b)[size]) {
+        /*!
+         * Copy a vector into a fixed size array checking the dimension
+         *
+         * Returns true if the vector has the expected dimension and false otherwise.
+         *
+         * :param const variableVector &a: The incoming vector
+         * :param double ( &b )[ size ]: The output array
+         */
+
+        if (a.size() != size) {
+            return false;
+        }
+
+        std::copy(a.begin(), a.end(), b);
+
+        return true;
+    }
+
     int compute_internal_force(const double (&dNdX)[3], const variableVector &F, const variableVector &PK2,
                                double (&fint)[3]) {
         /*!
@@ -463,19 +511,38 @@ namespace balance_equations {
         // Assume 12 degrees of freedom
         const unsigned int NDOF = 12;
 
-        int errorCode;
+        // Check the sizes once and copy the incoming values to flat arrays
+        double _F[dim * dim], _PK2[dim * dim];
+        double _DPK2Dgrad_u[dim * dim][dim * dim], _DPK2Dphi[dim * dim][dim * dim],
+            _DPK2Dgrad_phi[dim * dim][dim * dim * dim];
+
+        if (!copy_to_array(F, _F)) {
+            return 1;
+        }
+
+        if (!copy_to_array(PK2, _PK2)) {
+            return 2;
+        }
+
+        if (!copy_to_array(DPK2Dgrad_u, _DPK2Dgrad_u)) {
+            return 3;
+        }
+
+        if (!copy_to_array(DPK2Dphi, _DPK2Dphi)) {
+            return 4;
+        }
+
+        if (!copy_to_array(DPK2Dgrad_phi, _DPK2Dgrad_phi)) {
+            return 5;
+        }
+
+        double _fint[dim], _DfintDU[dim][NDOF];
+        compute_internal_force_and_jacobian(N, dNdX, eta, detadX, _F, _PK2, _DPK2Dgrad_u, _DPK2Dphi, _DPK2Dgrad_phi,
+                                            _fint, _DfintDU);
+
         DfintDU = variableMatrix(dim, variableVector(NDOF, 0));
         for (unsigned int i = 0; i < dim; i++) {
-            for (unsigned int j = 0; j < NDOF; j++) {
-                errorCode = compute_internal_force_jacobian(i, j, N, dNdX, eta, detadX, F, PK2, DPK2Dgrad_u, DPK2Dphi,
-                                                            DPK2Dgrad_phi, DfintDU[i][j]);
-
-#ifndef SKIP_ERROR_HANDLING
-                if (errorCode != 0) {
-                    return errorCode;
-                }
-#endif
-            }
+            std::copy(_DfintDU[i], _DfintDU[i] + NDOF, DfintDU[i].begin());
         }
 
         return 0;
@@ -651,23 +718,80 @@ namespace balance_equations {
         // Assume 12 degrees of freedom
         const unsigned int NDOF = 12;
 
-        int errorCode;
+        // Check the sizes once and copy the incoming values to flat arrays
+        double _F[dim * dim], _chi[dim * dim], _PK2[dim * dim], _SIGMA[dim * dim], _M[dim * dim * dim];
+        double _DPK2Dgrad_u[dim * dim][dim * dim], _DPK2Dphi[dim * dim][dim * dim],
+            _DPK2Dgrad_phi[dim * dim][dim * dim * dim];
+        double _DSIGMADgrad_u[dim * dim][dim * dim], _DSIGMADphi[dim * dim][dim * dim],
+            _DSIGMADgrad_phi[dim * dim][dim * dim * dim];
+        double _DMDgrad_u[dim * dim * dim][dim * dim], _DMDphi[dim * dim * dim][dim * dim],
+            _DMDgrad_phi[dim * dim * dim][dim * dim * dim];
+
+        if (!copy_to_array(F, _F)) {
+            return 1;
+        }
+
+        if (!copy_to_array(chi, _chi)) {
+            return 2;
+        }
+
+        if (!copy_to_array(PK2, _PK2)) {
+            return 3;
+        }
+
+        if (!copy_to_array(SIGMA, _SIGMA)) {
+            return 4;
+        }
+
+        if (!copy_to_array(M, _M)) {
+            return 5;
+        }
+
+        if (!copy_to_array(DPK2Dgrad_u, _DPK2Dgrad_u)) {
+            return 6;
+        }
+
+        if (!copy_to_array(DPK2Dphi, _DPK2Dphi)) {
+            return 7;
+        }
+
+        if (!copy_to_array(DPK2Dgrad_phi, _DPK2Dgrad_phi)) {
+            return 8;
+        }
+
+        if (!copy_to_array(DSIGMADgrad_u, _DSIGMADgrad_u)) {
+            return 9;
+        }
+
+        if (!copy_to_array(DSIGMADphi, _DSIGMADphi)) {
+            return 10;
+        }
+
+        if (!copy_to_array(DSIGMADgrad_phi, _DSIGMADgrad_phi)) {
+            return 11;
+        }
+
+        if (!copy_to_array(DMDgrad_u, _DMDgrad_u)) {
+            return 12;
+        }
+
+        if (!copy_to_array(DMDphi, _DMDphi)) {
+            return 13;
+        }
+
+        if (!copy_to_array(DMDgrad_phi, _DMDgrad_phi)) {
+            return 14;
+        }
 
         // Compute the Jacobian terms
+        double _cint[dim * dim], _DcintDU[dim * dim][NDOF];
+        compute_internal_couple_and_jacobian(N, dNdX, eta, detadX, _F, _chi, _PK2, _SIGMA, _M, _DPK2Dgrad_u,
+                                             _DPK2Dphi, _DPK2Dgrad_phi, _DSIGMADgrad_u, _DSIGMADphi, _DSIGMADgrad_phi,
+                                             _DMDgrad_u, _DMDphi, _DMDgrad_phi, _cint, _DcintDU);
+
         DcintDU = variableMatrix(dim * dim, variableVector(NDOF, 0));
         for (unsigned int i = 0; i < dim * dim; i++) {
-            for (unsigned int j = 0; j < NDOF; j++) {
-                errorCode =
-                    compute_internal_couple_jacobian(i, j, N, dNdX, eta, detadX, F, chi, PK2, SIGMA, M, DPK2Dgrad_u,
-                                                     DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi,
-                                                     DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, DcintDU[i][j]);
-
-#ifndef SKIP_ERROR_HANDLING
-                if (errorCode != 0) {
-                    return errorCode;
-                }
-#endif
-            }
+            std::copy(_DcintDU[i], _DcintDU[i] + NDOF, DcintDU[i].begin());
         }
 
         return 0;
@@ -912,6 +1036,414 @@ namespace balance_equations {
         return 0;
     }
 
+    void compute_internal_force_and_jacobian(const double &N, const double (&dNdX)[3], const double &eta,
+                                             const double (&detadX)[3], const double (&F)[9], const double (&PK2)[9],
+                                             const double (&DPK2Dgrad_u)[9][9], const double (&DPK2Dphi)[9][9],
+                                             const double (&DPK2Dgrad_phi)[9][27], double (&fint)[3],
+                                             double (&DfintDU)[3][12]) {
+        /*!
+         * Compute the internal force and its Jacobian for one test function, interpolation function pair in a single
+         * pass over row-major arrays. The sizes are fixed by the argument types so no error checking is required.
+         *
+         * fint_i = - N_{ , I } PK2_{ I J } F_{ i J }
+         *
+         * The derivative of PK2 w.r.t. each degree of freedom is contracted with the test function gradient once
+         * and then shared by all of the rows of the Jacobian.
+         *
+         * :param const double &N: The shape function value
+         * :param const double ( &dNdX )[ 3 ]: The gradient of the shape function w.r.t. X in the reference
+         *     configuration.
+         * :param const double &eta: The interpolation function value
+         * :param const double ( &detadX )[ 3 ]: The gradient of the interpolation function w.r.t. X in the reference
+         *     configuration.
+         * :param const double ( &F )[ 9 ]: The deformation gradient.
+         * :param const double ( &PK2 )[ 9 ]: The second Piola Kirchoff stress.
+         * :param const double ( &DPK2Dgrad_u )[ 9 ][ 9 ]: The Jacobian of the second Piola Kirchoff stress w.r.t. the
+         *     gradient of the macro displacement w.r.t. X in the reference configuration.
+         * :param const double ( &DPK2Dphi )[ 9 ][ 9 ]: The Jacobian of the second Piola Kirchoff stress w.r.t. the
+         *     micro displacement.
+         * :param const double ( &DPK2Dgrad_phi )[ 9 ][ 27 ]: The Jacobian of the second Piola Kirchoff stress w.r.t.
+         *     the gradient of the micro displacement.
+         * :param double ( &fint )[ 3 ]: The internal force.
+         * :param double ( &DfintDU )[ 3 ][ 12 ]: The Jacobian of the internal force w.r.t. the degree of freedom
+         *     vector which is organized:
+         *     [ u1, u2, u3, phi_11, phi_12, phi_13, phi_21, phi_22, phi_23, phi_31, phi_32, phi_33 ]
+         */
+
+        // Assume 3D
+        const unsigned int dim = 3;
+
+        // Assume 12 degrees of freedom
+        const unsigned int NDOF = 12;
+
+        // N_{ , I } PK2_{ I J } and its derivative w.r.t. each degree of freedom
+        double dNdXPK2[dim]          = {0, 0, 0};
+        double dNdXDPK2DU[dim][NDOF] = {};
+
+        for (unsigned int I = 0; I < dim; I++) {
+            for (unsigned int J = 0; J < dim; J++) {
+                const unsigned int IJ = dim * I + J;
+
+                dNdXPK2[J] += dNdX[I] * PK2[IJ];
+
+                for (unsigned int j = 0; j < dim; j++) {
+                    double DPK2DU = 0;
+                    for (unsigned int K = 0; K < dim; K++) {
+                        DPK2DU += DPK2Dgrad_u[IJ][dim * j + K] * detadX[K];
+                    }
+                    dNdXDPK2DU[J][j] += dNdX[I] * DPK2DU;
+                }
+
+                for (unsigned int j = 0; j < dim * dim; j++) {
+                    double DPK2DU = DPK2Dphi[IJ][j] * eta;
+                    for (unsigned int K = 0; K < dim; K++) {
+                        DPK2DU += DPK2Dgrad_phi[IJ][dim * j + K] * detadX[K];
+                    }
+                    dNdXDPK2DU[J][dim + j] += dNdX[I] * DPK2DU;
+                }
+            }
+        }
+
+        for (unsigned int i = 0; i < dim; i++) {
+            fint[i] = 0;
+            for (unsigned int j = 0; j < NDOF; j++) {
+                DfintDU[i][j] = 0;
+            }
+
+            for (unsigned int J = 0; J < dim; J++) {
+                fint[i] -= dNdXPK2[J] * F[dim * i + J];
+
+                for (unsigned int j = 0; j < NDOF; j++) {
+                    DfintDU[i][j] -= F[dim * i + J] * dNdXDPK2DU[J][j];
+                }
+
+                // The derivative of the deformation gradient w.r.t. the macro displacement
+                DfintDU[i][i] -= dNdXPK2[J] * detadX[J];
+            }
+        }
+
+        return;
+    }
+
+    static void compute_higher_order_couple_terms(const double (&dNdX)[3], const double &eta,
+                                                  const double (&detadX)[3], const double (&M)[27],
+                                                  const double (&DMDgrad_u)[27][9], const double (&DMDphi)[27][9],
+                                                  const double (&DMDgrad_phi)[27][27], double (&T)[3][3],
+                                                  double (&DTDU)[3][3][12]) {
+        /*!
+         * Add the higher order stress term of the internal couple T_{ IJ } = N_{ ,K } M_{ KIJ } and its derivative
+         * w.r.t. the degrees of freedom of the interpolation function to T and DTDU
+         *
+         * :param const double ( &dNdX )[ 3 ]: The gradient of the shape function w.r.t. the reference coordinates.
+         * :param const double &eta: The interpolation function value
+         * :param const double ( &detadX )[ 3 ]: The gradient of the interpolation function w.r.t. the reference
+         *     coordinates.
+         * :param const double ( &M )[ 27 ]: The higher order stress tensor in the reference configuration.
+         * :param const double ( &DMDgrad_u )[ 27 ][ 9 ]: The derivative of the higher order stress w.r.t. the
+         *     gradient of the macro displacement w.r.t. the reference configuration.
+         * :param const double ( &DMDphi )[ 27 ][ 9 ]: The derivative of the higher order stress w.r.t. the micro
+         *     displacement.
+         * :param const double ( &DMDgrad_phi )[ 27 ][ 27 ]: The derivative of the higher order stress w.r.t. the
+         *     gradient of the micro displacement w.r.t. the reference configuration.
+         * :param double ( &T )[ 3 ][ 3 ]: The higher order stress term
+         * :param double ( &DTDU )[ 3 ][ 3 ][ 12 ]: The derivative of the higher order stress term
+         */
+
+        // Assume 3D
+        const unsigned int dim = 3;
+
+        for (unsigned int I = 0; I < dim; I++) {
+            for (unsigned int J = 0; J < dim; J++) {
+                for (unsigned int K = 0; K < dim; K++) {
+                    const unsigned int KIJ = dim * dim * K + dim * I + J;
+
+                    T[I][J] += dNdX[K] * M[KIJ];
+
+                    for (unsigned int j = 0; j < dim; j++) {
+                        for (unsigned int L = 0; L < dim; L++) {
+                            DTDU[I][J][j] += dNdX[K] * DMDgrad_u[KIJ][dim * j + L] * detadX[L];
+                        }
+                    }
+
+                    for (unsigned int j = 0; j < dim * dim; j++) {
+                        DTDU[I][J][dim + j] += dNdX[K] * DMDphi[KIJ][j] * eta;
+                        for (unsigned int L = 0; L < dim; L++) {
+                            DTDU[I][J][dim + j] += dNdX[K] * DMDgrad_phi[KIJ][dim * j + L] * detadX[L];
+                        }
+                    }
+                }
+            }
+        }
+
+        return;
+    }
+
+    static void assemble_internal_couple(const double &eta, const double (&detadX)[3], const double (&F)[9],
+                                         const double (&chi)[9], const double (&S)[3][3], const double (&T)[3][3],
+                                         const double (&DSDU)[3][3][12], const double (&DTDU)[3][3][12],
+                                         double (&cint)[9], double (&DcintDU)[9][12]) {
+        /*!
+         * Assemble the internal couple and its Jacobian from the stress terms
+         *
+         * cint_{ ij } = F_{ iI } S_{ IJ } F_{ jJ } - F_{ iI } T_{ IJ } \chi_{ jJ }
+         *
+         * where S_{ IJ } = N ( PK2_{ JI } - SIGMA_{ JI } ) and T_{ IJ } = N_{ ,K } M_{ KIJ }.
+         *
+         * :param const double &eta: The interpolation function value
+         * :param const double ( &detadX )[ 3 ]: The gradient of the interpolation function w.r.t. the reference
+         *     coordinates.
+         * :param const double ( &F )[ 9 ]: The deformation gradient.
+         * :param const double ( &chi )[ 9 ]: The micro deformation tensor.
+         * :param const double ( &S )[ 3 ][ 3 ]: The stress term
+         * :param const double ( &T )[ 3 ][ 3 ]: The higher order stress term
+         * :param const double ( &DSDU )[ 3 ][ 3 ][ 12 ]: The derivative of the stress term w.r.t. the degrees of
+         *     freedom
+         * :param const double ( &DTDU )[ 3 ][ 3 ][ 12 ]: The derivative of the higher order stress term w.r.t. the
+         *     degrees of freedom
+         * :param double ( &cint )[ 9 ]: The internal couple
+         * :param double ( &DcintDU )[ 9 ][ 12 ]: The Jacobian of the internal couple w.r.t. the degree of freedom
+         *     vector
+         */
+
+        // Assume 3D
+        const unsigned int dim = 3;
+
+        // Assume 12 degrees of freedom
+        const unsigned int NDOF = 12;
+
+        for (unsigned int i = 0; i < dim; i++) {
+            for (unsigned int j = 0; j < dim; j++) {
+                const unsigned int ij = dim * i + j;
+
+                // The terms of the couple which multiply F_{ iI }
+                double H[dim]          = {0, 0, 0};
+                double DHDU[dim][NDOF] = {};
+                double SdetadX         = 0;
+
+                for (unsigned int I = 0; I < dim; I++) {
+                    for (unsigned int J = 0; J < dim; J++) {
+                        H[I] += S[I][J] * F[dim * j + J] - T[I][J] * chi[dim * j + J];
+
+                        for (unsigned int k = 0; k < NDOF; k++) {
+                            DHDU[I][k] += DSDU[I][J][k] * F[dim * j + J] - DTDU[I][J][k] * chi[dim * j + J];
+                        }
+
+                        SdetadX += F[dim * i + I] * S[I][J] * detadX[J];
+                    }
+                }
+
+                cint[ij] = 0;
+                for (unsigned int k = 0; k < NDOF; k++) {
+                    DcintDU[ij][k] = 0;
+                }
+
+                for (unsigned int I = 0; I < dim; I++) {
+                    cint[ij] += F[dim * i + I] * H[I];
+
+                    for (unsigned int k = 0; k < NDOF; k++) {
+                        DcintDU[ij][k] += F[dim * i + I] * DHDU[I][k];
+                    }
+
+                    // The derivative of F_{ iI } w.r.t. the macro displacement
+                    DcintDU[ij][i] += detadX[I] * H[I];
+
+                    // The derivative of chi_{ jJ } w.r.t. the micro displacement
+                    for (unsigned int J = 0; J < dim; J++) {
+                        DcintDU[ij][dim + dim * j + J] -= eta * F[dim * i + I] * T[I][J];
+                    }
+                }
+
+                // The derivative of F_{ jJ } w.r.t. the macro displacement
+                DcintDU[ij][j] += SdetadX;
+            }
+        }
+
+        return;
+    }
+
+    void compute_internal_couple_and_jacobian(
+        const double &N, const double (&dNdX)[3], const double &eta, const double (&detadX)[3], const double (&F)[9],
+        const double (&chi)[9], const double (&PK2)[9], const double (&SIGMA)[9], const double (&M)[27],
+        const double (&DPK2Dgrad_u)[9][9], const double (&DPK2Dphi)[9][9], const double (&DPK2Dgrad_phi)[9][27],
+        const double (&DSIGMADgrad_u)[9][9], const double (&DSIGMADphi)[9][9], const double (&DSIGMADgrad_phi)[9][27],
+        const double (&DMDgrad_u)[27][9], const double (&DMDphi)[27][9], const double (&DMDgrad_phi)[27][27],
+        double (&cint)[9], double (&DcintDU)[9][12]) {
+        /*!
+         * Compute the internal couple and its Jacobian for one test function, interpolation function pair in a single
+         * pass over row-major arrays. The sizes are fixed by the argument types so no error checking is required.
+         *
+         * cint_{ ij } = N F_{ iI } ( PK2_{ JI } - SIGMA_{ JI } ) F_{ jJ } - N_{ ,K } F_{ iI } \chi_{ jJ } M_{ KIJ }
+         *
+         * The stress terms N ( PK2_{ JI } - SIGMA_{ JI } ) and N_{ ,K } M_{ KIJ } and their derivatives w.r.t. each
+         * degree of freedom are formed once and then shared by all of the rows of the Jacobian.
+         *
+         * :param const double &N: The shape function value
+         * :param const double ( &dNdX )[ 3 ]: The gradient of the shape function w.r.t. the reference coordinates.
+         * :param const double &eta: The interpolation function value
+         * :param const double ( &detadX )[ 3 ]: The gradient of the interpolation function w.r.t. the reference
+         *     coordinates.
+         * :param const double ( &F )[ 9 ]: The deformation gradient.
+         * :param const double ( &chi )[ 9 ]: The micro deformation tensor.
+         * :param const double ( &PK2 )[ 9 ]: The second Piola Kirchoff stress tensor.
+         * :param const double ( &SIGMA )[ 9 ]: The symmetric micro stress tensor in the reference configuration.
+         * :param const double ( &M )[ 27 ]: The higher order stress tensor in the reference configuration.
+         * :param const double ( &DPK2Dgrad_u )[ 9 ][ 9 ]: The derivative of the PK2 stress w.r.t. the gradient of the
+         *     macro displacement w.r.t. the reference configuration.
+         * :param const double ( &DPK2Dphi )[ 9 ][ 9 ]: The derivative of the PK2 stress w.r.t. the micro displacement.
+         * :param const double ( &DPK2Dgrad_phi )[ 9 ][ 27 ]: The derivative of the PK2 stress w.r.t. the gradient of
+         *     the micro displacement w.r.t. the reference configuration.
+         * :param const double ( &DSIGMADgrad_u )[ 9 ][ 9 ]: The derivative of the symmetric micro stress w.r.t. the
+         *     gradient of the macro displacement w.r.t. the reference configuration.
+         * :param const double ( &DSIGMADphi )[ 9 ][ 9 ]: The derivative of the symmetric micro stress w.r.t. the
+         *     micro displacement.
+         * :param const double ( &DSIGMADgrad_phi )[ 9 ][ 27 ]: The derivative of the symmetric micro stress w.r.t.
+         *     the gradient of the micro displacement w.r.t. the reference configuration.
+         * :param const double ( &DMDgrad_u )[ 27 ][ 9 ]: The derivative of the higher order stress w.r.t. the
+         *     gradient of the macro displacement w.r.t. the reference configuration.
+         * :param const double ( &DMDphi )[ 27 ][ 9 ]: The derivative of the higher order stress w.r.t. the micro
+         *     displacement.
+         * :param const double ( &DMDgrad_phi )[ 27 ][ 27 ]: The derivative of the higher order stress w.r.t. the
+         *     gradient of the micro displacement w.r.t. the reference configuration.
+         * :param double ( &cint )[ 9 ]: The internal couple
+         * :param double ( &DcintDU )[ 9 ][ 12 ]: The Jacobian of the internal couple w.r.t. the degree of freedom
+         *     vector which is organized:
+         *     [ u1, u2, u3, phi_11, phi_12, phi_13, phi_21, phi_22, phi_23, phi_31, phi_32, phi_33 ]
+         */
+
+        // Assume 3D
+        const unsigned int dim = 3;
+
+        // Assume 12 degrees of freedom
+        const unsigned int NDOF = 12;
+
+        // S_{ IJ } = N ( PK2_{ JI } - SIGMA_{ JI } ), T_{ IJ } = N_{ ,K } M_{ KIJ }, and their derivatives
+        double S[dim][dim]          = {};
+        double T[dim][dim]          = {};
+        double DSDU[dim][dim][NDOF] = {};
+        double DTDU[dim][dim][NDOF] = {};
+
+        for (unsigned int I = 0; I < dim; I++) {
+            for (unsigned int J = 0; J < dim; J++) {
+                const unsigned int JI = dim * J + I;
+
+                S[I][J] = N * (PK2[JI] - SIGMA[JI]);
+
+                for (unsigned int j = 0; j < dim; j++) {
+                    for (unsigned int K = 0; K < dim; K++) {
+                        DSDU[I][J][j] +=
+                            N * (DPK2Dgrad_u[JI][dim * j + K] - DSIGMADgrad_u[JI][dim * j + K]) * detadX[K];
+                    }
+                }
+
+                for (unsigned int j = 0; j < dim * dim; j++) {
+                    DSDU[I][J][dim + j] += N * (DPK2Dphi[JI][j] - DSIGMADphi[JI][j]) * eta;
+                    for (unsigned int K = 0; K < dim; K++) {
+                        DSDU[I][J][dim + j] +=
+                            N * (DPK2Dgrad_phi[JI][dim * j + K] - DSIGMADgrad_phi[JI][dim * j + K]) * detadX[K];
+                    }
+                }
+            }
+        }
+
+        compute_higher_order_couple_terms(dNdX, eta, detadX, M, DMDgrad_u, DMDphi, DMDgrad_phi, T, DTDU);
+
+        assemble_internal_couple(eta, detadX, F, chi, S, T, DSDU, DTDU, cint, DcintDU);
+
+        return;
+    }
+
+    void compute_internal_couple_and_jacobian(
+        const double &N, const double (&dNdX)[3], const double &eta, const double (&detadX)[3], const double (&F)[9],
+        const double (&chi)[9], const double (&PK2)[9], const double (&SIGMA)[6], const double (&M)[27],
+        const double (&DPK2Dgrad_u)[9][9], const double (&DPK2Dphi)[9][9], const double (&DPK2Dgrad_phi)[9][27],
+        const double (&DSIGMADgrad_u)[6][9], const double (&DSIGMADphi)[6][9], const double (&DSIGMADgrad_phi)[6][27],
+        const double (&DMDgrad_u)[27][9], const double (&DMDphi)[27][9], const double (&DMDgrad_phi)[27][27],
+        double (&cint)[9], double (&DcintDU)[9][12]) {
+        /*!
+         * Compute the internal couple and its Jacobian for one test function, interpolation function pair with the
+         * symmetric micro stress and its Jacobians in Voigt form. Because SIGMA is symmetric only six of its rows
+         * are contracted with the interpolation functions and each result is shared by SIGMA_{ IJ } and SIGMA_{ JI }.
+         *
+         * cint_{ ij } = N F_{ iI } ( PK2_{ JI } - SIGMA_{ JI } ) F_{ jJ } - N_{ ,K } F_{ iI } \chi_{ jJ } M_{ KIJ }
+         *
+         * The arguments are the same as for the full form except
+         *
+         * :param const double ( &SIGMA )[ 6 ]: The symmetric micro stress tensor in the reference configuration in
+         *     Voigt form [ SIGMA_{ 11 }, SIGMA_{ 22 }, SIGMA_{ 33 }, SIGMA_{ 23 }, SIGMA_{ 13 }, SIGMA_{ 12 } ]
+         * :param const double ( &DSIGMADgrad_u )[ 6 ][ 9 ]: The derivative of the Voigt symmetric micro stress w.r.t.
+         *     the gradient of the macro displacement w.r.t. the reference configuration.
+         * :param const double ( &DSIGMADphi )[ 6 ][ 9 ]: The derivative of the Voigt symmetric micro stress w.r.t.
+         *     the micro displacement.
+         * :param const double ( &DSIGMADgrad_phi )[ 6 ][ 27 ]: The derivative of the Voigt symmetric micro stress
+         *     w.r.t. the gradient of the micro displacement w.r.t. the reference configuration.
+         */
+
+        // Assume 3D
+        const unsigned int dim = 3;
+
+        // Assume 12 degrees of freedom
+        const unsigned int NDOF = 12;
+
+        // The Voigt component of SIGMA_{ JI } for each row-major index JI
+        const unsigned int voigt[dim * dim] = {0, 5, 4, 5, 1, 3, 4, 3, 2};
+
+        // The derivatives of the Voigt components of SIGMA w.r.t. each degree of freedom ( without N )
+        double DSIGMADU[6][NDOF];
+
+        for (unsigned int v = 0; v < 6; v++) {
+            for (unsigned int j = 0; j < dim; j++) {
+                DSIGMADU[v][j] = 0;
+                for (unsigned int K = 0; K < dim; K++) {
+                    DSIGMADU[v][j] += DSIGMADgrad_u[v][dim * j + K] * detadX[K];
+                }
+            }
+
+            for (unsigned int j = 0; j < dim * dim; j++) {
+                DSIGMADU[v][dim + j] = DSIGMADphi[v][j] * eta;
+                for (unsigned int K = 0; K < dim; K++) {
+                    DSIGMADU[v][dim + j] += DSIGMADgrad_phi[v][dim * j + K] * detadX[K];
+                }
+            }
+        }
+
+        // S_{ IJ } = N ( PK2_{ JI } - SIGMA_{ JI } ), T_{ IJ } = N_{ ,K } M_{ KIJ }, and their derivatives
+        double S[dim][dim]          = {};
+        double T[dim][dim]          = {};
+        double DSDU[dim][dim][NDOF] = {};
+        double DTDU[dim][dim][NDOF] = {};
+
+        for (unsigned int I = 0; I < dim; I++) {
+            for (unsigned int J = 0; J < dim; J++) {
+                const unsigned int JI = dim * J + I;
+                const unsigned int v  = voigt[JI];
+
+                S[I][J] = N * (PK2[JI] - SIGMA[v]);
+
+                for (unsigned int j = 0; j < dim; j++) {
+                    double DPK2DU = 0;
+                    for (unsigned int K = 0; K < dim; K++) {
+                        DPK2DU += DPK2Dgrad_u[JI][dim * j + K] * detadX[K];
+                    }
+                    DSDU[I][J][j] = N * (DPK2DU - DSIGMADU[v][j]);
+                }
+
+                for (unsigned int j = 0; j < dim * dim; j++) {
+                    double DPK2DU = DPK2Dphi[JI][j] * eta;
+                    for (unsigned int K = 0; K < dim; K++) {
+                        DPK2DU += DPK2Dgrad_phi[JI][dim * j + K] * detadX[K];
+                    }
+                    DSDU[I][J][dim + j] = N * (DPK2DU - DSIGMADU[v][dim + j]);
+                }
+            }
+        }
+
+        compute_higher_order_couple_terms(dNdX, eta, detadX, M, DMDgrad_u, DMDphi, DMDgrad_phi, T, DTDU);
+
+        assemble_internal_couple(eta, detadX, F, chi, S, T, DSDU, DTDU, cint, DcintDU);
+
+        return;
+    }
+
     int compute_inertia_couple_jacobian(const double &N, const double &eta, const double &density,
                                         const double (&chi)[9], const double (&D2ChiDt2)[9],
                                         const variableMatrix &D3ChiDt2DChi, const double (&referenceInertia)[9],
@@ -1116,4 +1648,103 @@ namespace balance_equations {
         return 0;
     }
 
+    void interpolate_dof_batch(const ElementBatch &batch, const double *u, double *grad_u, double *phi,
+                               double *grad_phi) {
+        /*!
+         * Interpolate the degrees of freedom at every Gauss point of the batch. The outputs are in the structure of
+         * arrays form expected by IMaterial::evaluate_model_batch. See interpolate_gauss_point_dof.
+         */
+
+        for (unsigned int p = 0; p < batch.num_points(); p++) {
+            interpolate_gauss_point_dof(batch, u, p, grad_u, phi, grad_phi);
+        }
+    }
+
+    void integrate_element_residual_batch(const ElementBatch &batch, const double *grad_u, const double *phi,
+                                          const double *PK2, const double *SIGMA, const double *M,
+                                          double *element_RHS) {
+        /*!
+         * Compute the residual of every element of the batch from the stresses at the Gauss points. Each element only
+         * writes its own residual. See add_gauss_point_residual.
+         */
+
+        for (unsigned int e = 0; e < batch.num_elements; e++) {
+            integrate_element_residual(batch, e, grad_u, phi, PK2, SIGMA, M, element_RHS);
+        }
+    }
+
+    void map_dof_to_element_residuals(const ElementBatch &batch, const unsigned int ndof,
+                                      std::vector<unsigned int> &dof_offsets, std::vector<unsigned int> &dof_entries) {
+        /*!
+         * Form the compressed map from each global degree of freedom to the element residual entries which are
+         * summed into it by assemble_residual_batch. The entries of dof d are
+         * dof_entries[ dof_offsets[ d ] ], ..., dof_entries[ dof_offsets[ d + 1 ] - 1 ] ordered by element.
+         *
+         * :param const ElementBatch &batch: The elements ( batch.dof must be accessible from the host )
+         * :param const unsigned int ndof: The number of global degrees of freedom
+         * :param std::vector< unsigned int > &dof_offsets: The offset of the entries of each dof ( ndof + 1 )
+         * :param std::vector< unsigned int > &dof_entries: The indices of the element residual entries
+         */
+
+        const unsigned int nentries = 12 * batch.num_nodes * batch.num_elements;
+
+        dof_offsets.assign(ndof + 1, 0);
+        for (unsigned int k = 0; k < nentries; k++) {
+            dof_offsets[batch.dof[k] + 1]++;
+        }
+
+        for (unsigned int d = 0; d < ndof; d++) {
+            dof_offsets[d + 1] += dof_offsets[d];
+        }
+
+        // Visit the entries element by element so that the summation order does not depend on the numbering
+        std::vector<unsigned int> position(dof_offsets.begin(), dof_offsets.end() - 1);
+        dof_entries.resize(nentries);
+        for (unsigned int e = 0; e < batch.num_elements; e++) {
+            for (unsigned int k = 0; k < 12 * batch.num_nodes; k++) {
+                const unsigned int entry                     = k * batch.num_elements + e;
+                dof_entries[position[batch.dof[entry]]++] = entry;
+            }
+        }
+    }
+
+    void assemble_residual_batch(const unsigned int ndof, const unsigned int *dof_offsets,
+                                 const unsigned int *dof_entries, const double *element_RHS, double *RHS) {
+        /*!
+         * Assemble the global residual from the element residuals. Each degree of freedom gathers its own entries
+         * in element order so the result does not depend on the numbering of the elements.
+         *
+         * :param const unsigned int ndof: The number of global degrees of freedom
+         * :param const unsigned int *dof_offsets: The offsets from map_dof_to_element_residuals
+         * :param const unsigned int *dof_entries: The entries from map_dof_to_element_residuals
+         * :param const double *element_RHS: The element residuals ( 12 num_nodes x num_elements )
+         * :param double *RHS: The global residual ( ndof )
+         */
+
+        for (unsigned int d = 0; d < ndof; d++) {
+            double value = 0;
+            for (unsigned int k = dof_offsets[d]; k < dof_offsets[d + 1]; k++) {
+                value += element_RHS[dof_entries[k]];
+            }
+            RHS[d] = value;
+        }
+    }
+
+    double residual_norm_squared_batch(const unsigned int ndof, const double *RHS) {
+        /*!
+         * Return the squared Euclidean norm of the residual
+         *
+         * :param const unsigned int ndof: The number of degrees of freedom
+         * :param const double *RHS: The residual ( ndof )
+         */
+
+        double norm = 0;
+
+        for (unsigned int d = 0; d < ndof; d++) {
+            norm += RHS[d] * RHS[d];
+        }
+
+        return norm;
+    }
+
 }  // namespace balance_equations
@@ -23,6 +23,8 @@
 #define BALANCE_EQUATIONS_H
 
 #define USE_EIGEN
+#include <map>
+#include <string>
 #include <vector>
 
 namespace balance_equations {
@@ -137,6 +139,455 @@ namespace balance_equations {
                                         const double &eta, const double &density, const double (&chi)[9],
                                         const double (&D2ChiDt2)[9], const variableVector &D3ChiDt2dChi_j,
                                         const double (&referenceInertia)[9], double       &DcinertiaDU_ij);
+
+    /*==============================================================
+    | Block kernels for the residuals and Jacobians on flat arrays |
+    ==============================================================*/
+
+    void compute_internal_force_and_jacobian(const double &N, const double (&dNdX)[3], const double &eta,
+                                             const double (&detadX)[3], const double (&F)[9], const double (&PK2)[9],
+                                             const double (&DPK2Dgrad_u)[9][9], const double (&DPK2Dphi)[9][9],
+                                             const double (&DPK2Dgrad_phi)[9][27], double (&fint)[3],
+                                             double (&DfintDU)[3][12]);
+
+    void compute_internal_couple_and_jacobian(
+        const double &N, const double (&dNdX)[3], const double &eta, const double (&detadX)[3], const double (&F)[9],
+        const double (&chi)[9], const double (&PK2)[9], const double (&SIGMA)[9], const double (&M)[27],
+        const double (&DPK2Dgrad_u)[9][9], const double (&DPK2Dphi)[9][9], const double (&DPK2Dgrad_phi)[9][27],
+        const double (&DSIGMADgrad_u)[9][9], const double (&DSIGMADphi)[9][9], const double (&DSIGMADgrad_phi)[9][27],
+        const double (&DMDgrad_u)[27][9], const double (&DMDphi)[27][9], const double (&DMDgrad_phi)[27][27],
+        double (&cint)[9], double (&DcintDU)[9][12]);
+
+    void compute_internal_couple_and_jacobian(
+        const double &N, const double (&dNdX)[3], const double &eta, const double (&detadX)[3], const double (&F)[9],
+        const double (&chi)[9], const double (&PK2)[9], const double (&SIGMA)[6], const double (&M)[27],
+        const double (&DPK2Dgrad_u)[9][9], const double (&DPK2Dphi)[9][9], const double (&DPK2Dgrad_phi)[9][27],
+        const double (&DSIGMADgrad_u)[6][9], const double (&DSIGMADphi)[6][9], const double (&DSIGMADgrad_phi)[6][27],
+        const double (&DMDgrad_u)[27][9], const double (&DMDphi)[27][9], const double (&DMDgrad_phi)[27][27],
+        double (&cint)[9], double (&DcintDU)[9][12]);
+
+    /*==========================================================
+    | Gauss point kernel templated on the material model type |
+    ==========================================================*/
+
+    template <unsigned int nSIGMA>
+    void add_gauss_point_residual_and_jacobian(
+        const unsigned int num_nodes, const double *N, const double (*dNdX)[3], const double &weight,
+        const double (&F)[9], const double (&chi)[9], const double (&PK2)[9], const double (&SIGMA)[nSIGMA],
+        const double (&M)[27], const double (&DPK2Dgrad_u)[9][9], const double (&DPK2Dphi)[9][9],
+        const double (&DPK2Dgrad_phi)[9][27], const double (&DSIGMADgrad_u)[nSIGMA][9],
+        const double (&DSIGMADphi)[nSIGMA][9], const double (&DSIGMADgrad_phi)[nSIGMA][27],
+        const double (&DMDgrad_u)[27][9], const double (&DMDphi)[27][9], const double (&DMDgrad_phi)[27][27],
+        double *RHS, double *AMATRX) {
+        /*!
+         * Add the weighted internal force and couple residuals and their Jacobians of every test function,
+         * interpolation function pair of a Gauss point to the element arrays. SIGMA and its Jacobians may either be
+         * in full ( nSIGMA = 9 ) or Voigt ( nSIGMA = 6 ) form.
+         *
+         * See compute_gauss_point_residual_and_jacobian for the layout of RHS and AMATRX.
+         */
+
+        const unsigned int ndof = 12 * num_nodes;
+
+        double fint[3], cint[9];
+        double DfintDU[3][12], DcintDU[9][12];
+
+        for (unsigned int a = 0; a < num_nodes; a++) {
+            for (unsigned int b = 0; b < num_nodes; b++) {
+                compute_internal_force_and_jacobian(N[a], dNdX[a], N[b], dNdX[b], F, PK2, DPK2Dgrad_u, DPK2Dphi,
+                                                    DPK2Dgrad_phi, fint, DfintDU);
+
+                compute_internal_couple_and_jacobian(N[a], dNdX[a], N[b], dNdX[b], F, chi, PK2, SIGMA, M,
+                                                     DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi,
+                                                     DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, cint, DcintDU);
+
+                // The residuals only depend on the test function
+                if (b == 0) {
+                    for (unsigned int i = 0; i < 3; i++) {
+                        RHS[12 * a + i] += weight * fint[i];
+                    }
+
+                    for (unsigned int i = 0; i < 9; i++) {
+                        RHS[12 * a + 3 + i] += weight * cint[i];
+                    }
+                }
+
+                for (unsigned int i = 0; i < 3; i++) {
+                    double *row = AMATRX + (12 * a + i) * ndof + 12 * b;
+                    for (unsigned int k = 0; k < 12; k++) {
+                        row[k] += weight * DfintDU[i][k];
+                    }
+                }
+
+                for (unsigned int i = 0; i < 9; i++) {
+                    double *row = AMATRX + (12 * a + 3 + i) * ndof + 12 * b;
+                    for (unsigned int k = 0; k < 12; k++) {
+                        row[k] += weight * DcintDU[i][k];
+                    }
+                }
+            }
+        }
+    }
+
+    inline void compute_deformation_and_micro_deformation(const double (&grad_u)[3][3], const double (&phi)[9],
+                                                          double (&F)[9], double (&chi)[9]) {
+        /*!
+         * Compute the row-major deformation gradient and micro deformation from the degree of freedom gradients
+         *
+         * :param const double ( &grad_u )[ 3 ][ 3 ]: The displacement gradient w.r.t. X
+         * :param const double ( &phi )[ 9 ]: The micro displacement
+         * :param double ( &F )[ 9 ]: The deformation gradient
+         * :param double ( &chi )[ 9 ]: The micro deformation
+         */
+
+        for (unsigned int i = 0; i < 3; i++) {
+            for (unsigned int I = 0; I < 3; I++) {
+                F[3 * i + I]   = grad_u[i][I];
+                chi[3 * i + I] = phi[3 * i + I];
+            }
+            F[4 * i] += 1;
+            chi[4 * i] += 1;
+        }
+    }
+
+    template <class Material>
+    int compute_gauss_point_residual_and_jacobian(
+        Material &material, const std::vector<double> &time, const std::vector<double> &fparams,
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const unsigned int num_nodes,
+        const double *N, const double (*dNdX)[3], const double &weight, double *RHS, double *AMATRX,
+        std::string &output_message) {
+        /*!
+         * Evaluate the material model at a Gauss point and add the weighted internal force and couple residuals and
+         * their Jacobians to the element arrays using Galerkin ( N = eta ) shape functions.
+         *
+         * The material is evaluated through the unqualified call evaluate_material_flat( material, ... ) which is
+         * found by argument dependent lookup. For the micromorphic material library this calls the model directly
+         * when Material is a concrete model ( e.g. micromorphic_material_library::StaticMaterial ) so it may be
+         * inlined into the element and through the virtual interface when Material is IMaterial.
+         *
+         * The degrees of freedom of each node are ordered [ u1, u2, u3, phi_11, phi_12, ..., phi_33 ] and the
+         * residual of each node is [ fint_1, fint_2, fint_3, cint_11, cint_12, ..., cint_33 ].
+         *
+         * :param Material &material: The material model
+         * :param const std::vector< double > &time: The current time and the timestep
+         * :param const std::vector< double > &fparams: The parameters for the constitutive model
+         * :param const double ( &current_grad_u )[ 3 ][ 3 ]: The current displacement gradient w.r.t. X
+         * :param const double ( &current_phi )[ 9 ]: The current micro displacement
+         * :param const double ( &current_grad_phi )[ 9 ][ 3 ]: The current micro displacement gradient w.r.t. X
+         * :param const double ( &previous_grad_u )[ 3 ][ 3 ]: The previous displacement gradient w.r.t. X
+         * :param const double ( &previous_phi )[ 9 ]: The previous micro displacement
+         * :param const double ( &previous_grad_phi )[ 9 ][ 3 ]: The previous micro displacement gradient w.r.t. X
+         * :param std::vector< double > &SDVS: The state variables which are updated by the material model
+         * :param const unsigned int num_nodes: The number of nodes of the element
+         * :param const double *N: The shape function values at the Gauss point ( num_nodes )
+         * :param const double ( *dNdX )[ 3 ]: The shape function gradients w.r.t. X at the Gauss point
+         *     ( num_nodes x 3 )
+         * :param const double &weight: The Gauss point weight times the Jacobian of the reference map
+         * :param double *RHS: The residual vector the Gauss point contribution is added to ( 12 num_nodes )
+         * :param double *AMATRX: The row-major Jacobian of the residual w.r.t. the degrees of freedom the Gauss point
+         *     contribution is added to ( 12 num_nodes x 12 num_nodes )
+         * :param std::string &output_message: The output message of the material model
+         *
+         * Returns the error code of the material model. Nothing is added to RHS or AMATRX if it is not zero.
+         */
+
+        double F[9], chi[9];
+        compute_deformation_and_micro_deformation(current_grad_u, current_phi, F, chi);
+
+        double PK2[9], SIGMA[9], M[27];
+        double DPK2Dgrad_u[9][9], DPK2Dphi[9][9], DPK2Dgrad_phi[9][27];
+        double DSIGMADgrad_u[9][9], DSIGMADphi[9][9], DSIGMADgrad_phi[9][27];
+        double DMDgrad_u[27][9], DMDphi[27][9], DMDgrad_phi[27][27];
+
+        const std::vector<double>                       ADD_DOF;
+        const std::vector<std::vector<double> >         ADD_grad_DOF;
+        std::vector<std::vector<double> >               ADD_TERMS;
+        std::vector<std::vector<std::vector<double> > > ADD_JACOBIANS;
+
+#ifdef DEBUG_MODE
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG;
+#endif
+
+        int errorCode = evaluate_material_flat(
+            material, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+            previous_grad_phi, SDVS, ADD_DOF, ADD_grad_DOF, ADD_DOF, ADD_grad_DOF, PK2, SIGMA, M, DPK2Dgrad_u,
+            DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi,
+            ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+            ,
+            DEBUG
+#endif
+        );
+
+        if (errorCode > 0) {
+            return errorCode;
+        }
+
+        add_gauss_point_residual_and_jacobian(num_nodes, N, dNdX, weight, F, chi, PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi,
+                                              DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+                                              DMDphi, DMDgrad_phi, RHS, AMATRX);
+
+        return 0;
+    }
+
+    template <class Material>
+    int compute_gauss_point_residual_and_jacobian_symmetric(
+        Material &material, const std::vector<double> &time, const std::vector<double> &fparams,
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const unsigned int num_nodes,
+        const double *N, const double (*dNdX)[3], const double &weight, double *RHS, double *AMATRX,
+        std::string &output_message) {
+        /*!
+         * The same as compute_gauss_point_residual_and_jacobian except that the symmetric micro stress and its
+         * Jacobians are requested from the material and contracted in Voigt form
+         * [ SIGMA_{ 11 }, SIGMA_{ 22 }, SIGMA_{ 33 }, SIGMA_{ 23 }, SIGMA_{ 13 }, SIGMA_{ 12 } ] which removes a third
+         * of the work and storage of the SIGMA terms.
+         *
+         * The material is evaluated through the unqualified call evaluate_material_flat_symmetric( material, ... )
+         * which is found by argument dependent lookup. The arguments are the same as for
+         * compute_gauss_point_residual_and_jacobian.
+         */
+
+        double F[9], chi[9];
+        compute_deformation_and_micro_deformation(current_grad_u, current_phi, F, chi);
+
+        double PK2[9], SIGMA[6], M[27];
+        double DPK2Dgrad_u[9][9], DPK2Dphi[9][9], DPK2Dgrad_phi[9][27];
+        double DSIGMADgrad_u[6][9], DSIGMADphi[6][9], DSIGMADgrad_phi[6][27];
+        double DMDgrad_u[27][9], DMDphi[27][9], DMDgrad_phi[27][27];
+
+        const std::vector<double>                       ADD_DOF;
+        const std::vector<std::vector<double> >         ADD_grad_DOF;
+        std::vector<std::vector<double> >               ADD_TERMS;
+        std::vector<std::vector<std::vector<double> > > ADD_JACOBIANS;
+
+#ifdef DEBUG_MODE
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG;
+#endif
+
+        int errorCode = evaluate_material_flat_symmetric(
+            material, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+            previous_grad_phi, SDVS, ADD_DOF, ADD_grad_DOF, ADD_DOF, ADD_grad_DOF, PK2, SIGMA, M, DPK2Dgrad_u,
+            DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi,
+            ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+            ,
+            DEBUG
+#endif
+        );
+
+        if (errorCode > 0) {
+            return errorCode;
+        }
+
+        add_gauss_point_residual_and_jacobian(num_nodes, N, dNdX, weight, F, chi, PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi,
+                                              DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+                                              DMDphi, DMDgrad_phi, RHS, AMATRX);
+
+        return 0;
+    }
+
+    /*=============================================================
+    | Batched kernels over every Gauss point of a set of elements |
+    =============================================================*/
+
+    struct ElementBatch {
+        /*!
+         * A view of the elements and Gauss points evaluated by the batched kernels. Every array is stored in
+         * structure of arrays form i.e. component c of element ( or point ) x is located at [ c * n + x ] where n is
+         * the number of elements ( or points ). The points are numbered p = num_gauss_points * e + g which matches
+         * the layout of IMaterial::evaluate_model_batch so the interpolated degrees of freedom and the stresses can
+         * be passed to and from the material model without copying.
+         */
+
+        unsigned int num_elements;      //!< The number of elements
+        unsigned int num_gauss_points;  //!< The number of Gauss points of each element
+        unsigned int num_nodes;         //!< The number of nodes of each element
+
+        const unsigned int *dof;     //!< The global degree of freedom of each element degree of freedom
+                                     //!< ( 12 num_nodes x num_elements )
+        const double       *N;       //!< The shape function values ( num_nodes x num_points )
+        const double       *dNdX;    //!< The shape function gradients w.r.t. X ( 3 num_nodes x num_points )
+        const double       *weight;  //!< The Gauss point weights times the Jacobian of the reference map
+                                     //!< ( num_points )
+
+        inline unsigned int num_points() const { return num_elements * num_gauss_points; }
+    };
+
+    inline void interpolate_gauss_point_dof(const ElementBatch &batch, const double *u, const unsigned int p,
+                                            double *grad_u, double *phi, double *grad_phi) {
+        /*!
+         * Interpolate the displacement gradient, the micro displacement and its gradient at a Gauss point
+         *
+         * :param const ElementBatch &batch: The elements
+         * :param const double *u: The global degree of freedom vector
+         * :param const unsigned int p: The Gauss point
+         * :param double *grad_u: The row-major displacement gradients ( 9 x num_points )
+         * :param double *phi: The micro displacements ( 9 x num_points )
+         * :param double *grad_phi: The row-major micro displacement gradients ( 27 x num_points )
+         */
+
+        const unsigned int npoints = batch.num_points();
+        const unsigned int e       = p / batch.num_gauss_points;
+
+        double local_grad_u[9] = {}, local_phi[9] = {}, local_grad_phi[27] = {};
+
+        for (unsigned int a = 0; a < batch.num_nodes; a++) {
+            const double        N       = batch.N[a * npoints + p];
+            const double        dNdX[3] = {batch.dNdX[(3 * a + 0) * npoints + p],
+                                           batch.dNdX[(3 * a + 1) * npoints + p],
+                                           batch.dNdX[(3 * a + 2) * npoints + p]};
+            const unsigned int *dof     = batch.dof + 12 * a * batch.num_elements + e;
+
+            for (unsigned int i = 0; i < 3; i++) {
+                const double u_i = u[dof[i * batch.num_elements]];
+                for (unsigned int I = 0; I < 3; I++) {
+                    local_grad_u[3 * i + I] += u_i * dNdX[I];
+                }
+            }
+
+            for (unsigned int ij = 0; ij < 9; ij++) {
+                const double phi_ij = u[dof[(3 + ij) * batch.num_elements]];
+                local_phi[ij] += N * phi_ij;
+                for (unsigned int K = 0; K < 3; K++) {
+                    local_grad_phi[3 * ij + K] += phi_ij * dNdX[K];
+                }
+            }
+        }
+
+        for (unsigned int c = 0; c < 9; c++) {
+            grad_u[c * npoints + p] = local_grad_u[c];
+            phi[c * npoints + p]    = local_phi[c];
+        }
+
+        for (unsigned int c = 0; c < 27; c++) {
+            grad_phi[c * npoints + p] = local_grad_phi[c];
+        }
+    }
+
+    inline void add_gauss_point_residual(const ElementBatch &batch, const unsigned int p, const double *grad_u,
+                                         const double *phi, const double *PK2, const double *SIGMA, const double *M,
+                                         double *element_RHS) {
+        /*!
+         * Add the weighted internal force and couple residuals of a Gauss point to the residual of its element.
+         * The stress measures are contracted with the deformation once per point so the work of each node is only
+         * the contraction with its shape function and gradient.
+         *
+         * :param const ElementBatch &batch: The elements
+         * :param const unsigned int p: The Gauss point
+         * :param const double *grad_u: The row-major displacement gradients ( 9 x num_points )
+         * :param const double *phi: The micro displacements ( 9 x num_points )
+         * :param const double *PK2: The second Piola Kirchhoff stresses ( 9 x num_points )
+         * :param const double *SIGMA: The reference symmetric micro stresses ( 9 x num_points )
+         * :param const double *M: The reference higher order stresses ( 27 x num_points )
+         * :param double *element_RHS: The element residuals ordered as in compute_gauss_point_residual_and_jacobian
+         *     ( 12 num_nodes x num_elements )
+         */
+
+        const unsigned int npoints = batch.num_points();
+        const unsigned int e       = p / batch.num_gauss_points;
+
+        double F[9], chi[9];
+        for (unsigned int c = 0; c < 9; c++) {
+            F[c]   = grad_u[c * npoints + p] + (c % 4 == 0);
+            chi[c] = phi[c * npoints + p] + (c % 4 == 0);
+        }
+
+        // FPK2_{ iI } = F_{ iJ } PK2_{ IJ } and S_{ ij } = F_{ iI } ( PK2_{ JI } - SIGMA_{ JI } ) F_{ jJ }
+        double FPK2[9] = {}, FS[9] = {}, S[9] = {};
+        for (unsigned int i = 0; i < 3; i++) {
+            for (unsigned int I = 0; I < 3; I++) {
+                for (unsigned int J = 0; J < 3; J++) {
+                    FPK2[3 * i + I] += F[3 * i + J] * PK2[(3 * I + J) * npoints + p];
+                    FS[3 * i + J] += F[3 * i + I] * (PK2[(3 * J + I) * npoints + p] - SIGMA[(3 * J + I) * npoints + p]);
+                }
+            }
+        }
+
+        for (unsigned int i = 0; i < 3; i++) {
+            for (unsigned int j = 0; j < 3; j++) {
+                for (unsigned int J = 0; J < 3; J++) {
+                    S[3 * i + j] += FS[3 * i + J] * F[3 * j + J];
+                }
+            }
+        }
+
+        // FchiM_{ Kij } = F_{ iI } chi_{ jJ } M_{ KIJ }
+        double FchiM[27] = {};
+        for (unsigned int K = 0; K < 3; K++) {
+            for (unsigned int i = 0; i < 3; i++) {
+                for (unsigned int J = 0; J < 3; J++) {
+                    double FM = 0;
+                    for (unsigned int I = 0; I < 3; I++) {
+                        FM += F[3 * i + I] * M[(9 * K + 3 * I + J) * npoints + p];
+                    }
+                    for (unsigned int j = 0; j < 3; j++) {
+                        FchiM[9 * K + 3 * i + j] += FM * chi[3 * j + J];
+                    }
+                }
+            }
+        }
+
+        const double weight = batch.weight[p];
+
+        for (unsigned int a = 0; a < batch.num_nodes; a++) {
+            const double N       = batch.N[a * npoints + p];
+            const double dNdX[3] = {batch.dNdX[(3 * a + 0) * npoints + p], batch.dNdX[(3 * a + 1) * npoints + p],
+                                    batch.dNdX[(3 * a + 2) * npoints + p]};
+            double      *RHS     = element_RHS + 12 * a * batch.num_elements + e;
+
+            for (unsigned int i = 0; i < 3; i++) {
+                double fint = 0;
+                for (unsigned int I = 0; I < 3; I++) {
+                    fint -= dNdX[I] * FPK2[3 * i + I];
+                }
+                RHS[i * batch.num_elements] += weight * fint;
+            }
+
+            for (unsigned int ij = 0; ij < 9; ij++) {
+                double cint = N * S[ij];
+                for (unsigned int K = 0; K < 3; K++) {
+                    cint -= dNdX[K] * FchiM[9 * K + ij];
+                }
+                RHS[(3 + ij) * batch.num_elements] += weight * cint;
+            }
+        }
+    }
+
+    inline void integrate_element_residual(const ElementBatch &batch, const unsigned int e, const double *grad_u,
+                                           const double *phi, const double *PK2, const double *SIGMA, const double *M,
+                                           double *element_RHS) {
+        /*!
+         * Compute the residual of an element from the stresses at its Gauss points. See add_gauss_point_residual
+         * for the arguments.
+         */
+
+        for (unsigned int k = 0; k < 12 * batch.num_nodes; k++) {
+            element_RHS[k * batch.num_elements + e] = 0;
+        }
+
+        for (unsigned int g = 0; g < batch.num_gauss_points; g++) {
+            add_gauss_point_residual(batch, batch.num_gauss_points * e + g, grad_u, phi, PK2, SIGMA, M, element_RHS);
+        }
+    }
+
+    void interpolate_dof_batch(const ElementBatch &batch, const double *u, double *grad_u, double *phi,
+                               double *grad_phi);
+
+    void integrate_element_residual_batch(const ElementBatch &batch, const double *grad_u, const double *phi,
+                                          const double *PK2, const double *SIGMA, const double *M,
+                                          double *element_RHS);
+
+    void map_dof_to_element_residuals(const ElementBatch &batch, const unsigned int ndof,
+                                      std::vector<unsigned int> &dof_offsets, std::vector<unsigned int> &dof_entries);
+
+    void assemble_residual_batch(const unsigned int ndof, const unsigned int *dof_offsets,
+                                 const unsigned int *dof_entries, const double *element_RHS, double *RHS);
+
+    double residual_norm_squared_batch(const unsigned int ndof, const double *RHS);
 }  // namespace balance_equations
 
 #endif
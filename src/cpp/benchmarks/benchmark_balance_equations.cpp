@@ -0,0 +1,486 @@
+/*!============================================================================
+   |                                                                          |
+   |                   benchmark_balance_equations.cpp                        |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+   | Benchmarks of the Jacobians of the balance equations. The nested vector  |
+   | Jacobians are compared to the block kernels on flat arrays and the       |
+   | assembly of the contribution of a Gauss point of an eight node element   |
+   | is timed with a material whose cost is negligible.                       |
+   ============================================================================
+   | Dependencies:                                                            |
+   | benchmark: The Google benchmark library. Available at                    |
+   |            github.com/google/benchmark                                   |
+   ============================================================================*/
+
+#include <balance_equations.h>
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+typedef balance_equations::variableVector variableVector;
+typedef balance_equations::variableMatrix variableMatrix;
+
+namespace benchmarkMaterial {
+
+    struct ConstantTangent {
+        /*!
+         * A material with fixed stresses and tangents so that the Gauss point benchmark only times the balance
+         * equation kernels. The flat evaluation is found through argument dependent lookup.
+         */
+
+        double PK2[9], SIGMA[9], M[27];
+        double DPK2Dgrad_u[9][9], DPK2Dphi[9][9], DPK2Dgrad_phi[9][27];
+        double DSIGMADgrad_u[9][9], DSIGMADphi[9][9], DSIGMADgrad_phi[9][27];
+        double DMDgrad_u[27][9], DMDphi[27][9], DMDgrad_phi[27][27];
+    };
+
+    int evaluate_material_flat(
+        ConstantTangent &material, const std::vector<double> &time, const std::vector<double> &fparams,
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[9],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[9][9], double (&DSIGMADphi)[9][9], double (&DSIGMADgrad_phi)[9][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Copy the fixed stresses and tangents of the material
+         */
+
+        std::copy(&material.PK2[0], &material.PK2[0] + 9, &PK2[0]);
+        std::copy(&material.SIGMA[0], &material.SIGMA[0] + 9, &SIGMA[0]);
+        std::copy(&material.M[0], &material.M[0] + 27, &M[0]);
+        std::copy(&material.DPK2Dgrad_u[0][0], &material.DPK2Dgrad_u[0][0] + 81, &DPK2Dgrad_u[0][0]);
+        std::copy(&material.DPK2Dphi[0][0], &material.DPK2Dphi[0][0] + 81, &DPK2Dphi[0][0]);
+        std::copy(&material.DPK2Dgrad_phi[0][0], &material.DPK2Dgrad_phi[0][0] + 243, &DPK2Dgrad_phi[0][0]);
+        std::copy(&material.DSIGMADgrad_u[0][0], &material.DSIGMADgrad_u[0][0] + 81, &DSIGMADgrad_u[0][0]);
+        std::copy(&material.DSIGMADphi[0][0], &material.DSIGMADphi[0][0] + 81, &DSIGMADphi[0][0]);
+        std::copy(&material.DSIGMADgrad_phi[0][0], &material.DSIGMADgrad_phi[0][0] + 243, &DSIGMADgrad_phi[0][0]);
+        std::copy(&material.DMDgrad_u[0][0], &material.DMDgrad_u[0][0] + 243, &DMDgrad_u[0][0]);
+        std::copy(&material.DMDphi[0][0], &material.DMDphi[0][0] + 243, &DMDphi[0][0]);
+        std::copy(&material.DMDgrad_phi[0][0], &material.DMDgrad_phi[0][0] + 729, &DMDgrad_phi[0][0]);
+
+        return 0;
+    }
+
+    int evaluate_material_flat_symmetric(
+        ConstantTangent &material, const std::vector<double> &time, const std::vector<double> &fparams,
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[6],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[6][9], double (&DSIGMADphi)[6][9], double (&DSIGMADgrad_phi)[6][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Copy the fixed stresses and tangents of the material with the upper triangle of SIGMA in Voigt form
+         */
+
+        const unsigned int voigt[6] = {0, 4, 8, 5, 2, 1};
+
+        std::copy(&material.PK2[0], &material.PK2[0] + 9, &PK2[0]);
+        std::copy(&material.M[0], &material.M[0] + 27, &M[0]);
+        std::copy(&material.DPK2Dgrad_u[0][0], &material.DPK2Dgrad_u[0][0] + 81, &DPK2Dgrad_u[0][0]);
+        std::copy(&material.DPK2Dphi[0][0], &material.DPK2Dphi[0][0] + 81, &DPK2Dphi[0][0]);
+        std::copy(&material.DPK2Dgrad_phi[0][0], &material.DPK2Dgrad_phi[0][0] + 243, &DPK2Dgrad_phi[0][0]);
+        std::copy(&material.DMDgrad_u[0][0], &material.DMDgrad_u[0][0] + 243, &DMDgrad_u[0][0]);
+        std::copy(&material.DMDphi[0][0], &material.DMDphi[0][0] + 243, &DMDphi[0][0]);
+        std::copy(&material.DMDgrad_phi[0][0], &material.DMDgrad_phi[0][0] + 729, &DMDgrad_phi[0][0]);
+
+        for (unsigned int v = 0; v < 6; v++) {
+            SIGMA[v] = material.SIGMA[voigt[v]];
+            std::copy(material.DSIGMADgrad_u[voigt[v]], material.DSIGMADgrad_u[voigt[v]] + 9, DSIGMADgrad_u[v]);
+            std::copy(material.DSIGMADphi[voigt[v]], material.DSIGMADphi[voigt[v]] + 9, DSIGMADphi[v]);
+            std::copy(material.DSIGMADgrad_phi[voigt[v]], material.DSIGMADgrad_phi[voigt[v]] + 27,
+                      DSIGMADgrad_phi[v]);
+        }
+
+        return 0;
+    }
+
+}  // namespace benchmarkMaterial
+
+namespace {
+
+    double value(const unsigned int i) {
+        /*!
+         * A deterministic, non-trivial value used to fill the inputs
+         *
+         * :param const unsigned int i: The index of the value
+         */
+
+        return 0.01 * ((i * 37) % 101) - 0.5;
+    }
+
+    void fill(double *begin, const unsigned int n, const unsigned int offset) {
+        /*!
+         * Fill an array with deterministic values
+         *
+         * :param double *begin: The start of the array
+         * :param const unsigned int n: The number of values
+         * :param const unsigned int offset: The offset of the first value
+         */
+
+        for (unsigned int i = 0; i < n; i++) {
+            begin[i] = value(i + offset);
+        }
+    }
+
+    variableMatrix to_matrix(const double *A, const unsigned int rows, const unsigned int cols) {
+        /*!
+         * Copy a row-major array to a nested vector matrix
+         *
+         * :param const double *A: The row-major array
+         * :param const unsigned int rows: The number of rows
+         * :param const unsigned int cols: The number of columns
+         */
+
+        variableMatrix result(rows, variableVector(cols));
+        for (unsigned int i = 0; i < rows; i++) {
+            for (unsigned int j = 0; j < cols; j++) {
+                result[i][j] = A[cols * i + j];
+            }
+        }
+        return result;
+    }
+
+    struct KernelInputs {
+        /*!
+         * The inputs of the balance equation Jacobians at a point in both the flat and the nested vector forms
+         */
+
+        double N, eta, dNdX[3], detadX[3];
+
+        benchmarkMaterial::ConstantTangent flat;
+        double                             F[9], chi[9];
+
+        variableVector vF, vchi, vPK2, vSIGMA, vM;
+        variableMatrix vDPK2Dgrad_u, vDPK2Dphi, vDPK2Dgrad_phi;
+        variableMatrix vDSIGMADgrad_u, vDSIGMADphi, vDSIGMADgrad_phi;
+        variableMatrix vDMDgrad_u, vDMDphi, vDMDgrad_phi;
+
+        KernelInputs() {
+            /*!
+             * Fill the inputs with deterministic values
+             */
+
+            N         = 0.3;
+            eta       = 0.7;
+            dNdX[0]   = 0.1;
+            dNdX[1]   = -0.2;
+            dNdX[2]   = 0.3;
+            detadX[0] = -0.4;
+            detadX[1] = 0.5;
+            detadX[2] = 0.6;
+
+            fill(F, 9, 0);
+            fill(chi, 9, 10);
+            F[0] += 1;
+            F[4] += 1;
+            F[8] += 1;
+            chi[0] += 1;
+            chi[4] += 1;
+            chi[8] += 1;
+
+            fill(flat.PK2, 9, 20);
+            fill(flat.SIGMA, 9, 30);
+            fill(flat.M, 27, 40);
+            fill(&flat.DPK2Dgrad_u[0][0], 81, 50);
+            fill(&flat.DPK2Dphi[0][0], 81, 60);
+            fill(&flat.DPK2Dgrad_phi[0][0], 243, 70);
+            fill(&flat.DSIGMADgrad_u[0][0], 81, 80);
+            fill(&flat.DSIGMADphi[0][0], 81, 90);
+            fill(&flat.DSIGMADgrad_phi[0][0], 243, 100);
+            fill(&flat.DMDgrad_u[0][0], 243, 110);
+            fill(&flat.DMDphi[0][0], 243, 120);
+            fill(&flat.DMDgrad_phi[0][0], 729, 130);
+
+            vF               = variableVector(F, F + 9);
+            vchi             = variableVector(chi, chi + 9);
+            vPK2             = variableVector(flat.PK2, flat.PK2 + 9);
+            vSIGMA           = variableVector(flat.SIGMA, flat.SIGMA + 9);
+            vM               = variableVector(flat.M, flat.M + 27);
+            vDPK2Dgrad_u     = to_matrix(&flat.DPK2Dgrad_u[0][0], 9, 9);
+            vDPK2Dphi        = to_matrix(&flat.DPK2Dphi[0][0], 9, 9);
+            vDPK2Dgrad_phi   = to_matrix(&flat.DPK2Dgrad_phi[0][0], 9, 27);
+            vDSIGMADgrad_u   = to_matrix(&flat.DSIGMADgrad_u[0][0], 9, 9);
+            vDSIGMADphi      = to_matrix(&flat.DSIGMADphi[0][0], 9, 9);
+            vDSIGMADgrad_phi = to_matrix(&flat.DSIGMADgrad_phi[0][0], 9, 27);
+            vDMDgrad_u       = to_matrix(&flat.DMDgrad_u[0][0], 27, 9);
+            vDMDphi          = to_matrix(&flat.DMDphi[0][0], 27, 9);
+            vDMDgrad_phi     = to_matrix(&flat.DMDgrad_phi[0][0], 27, 27);
+        }
+    };
+
+    void BM_compute_internal_force_jacobian(benchmark::State &state) {
+        /*!
+         * The Jacobian of the internal force in nested vector form
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        KernelInputs   in;
+        variableMatrix DfintDU;
+
+        for (auto _ : state) {
+            balance_equations::compute_internal_force_jacobian(in.N, in.dNdX, in.eta, in.detadX, in.vF, in.vPK2,
+                                                               in.vDPK2Dgrad_u, in.vDPK2Dphi, in.vDPK2Dgrad_phi,
+                                                               DfintDU);
+            benchmark::DoNotOptimize(DfintDU.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_compute_internal_force_jacobian);
+
+    void BM_compute_internal_couple_jacobian(benchmark::State &state) {
+        /*!
+         * The Jacobian of the internal couple in nested vector form
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        KernelInputs   in;
+        variableMatrix DcintDU;
+
+        for (auto _ : state) {
+            balance_equations::compute_internal_couple_jacobian(
+                in.N, in.dNdX, in.eta, in.detadX, in.vF, in.vchi, in.vPK2, in.vSIGMA, in.vM, in.vDPK2Dgrad_u,
+                in.vDPK2Dphi, in.vDPK2Dgrad_phi, in.vDSIGMADgrad_u, in.vDSIGMADphi, in.vDSIGMADgrad_phi,
+                in.vDMDgrad_u, in.vDMDphi, in.vDMDgrad_phi, DcintDU);
+            benchmark::DoNotOptimize(DcintDU.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_compute_internal_couple_jacobian);
+
+    void BM_compute_internal_force_and_jacobian(benchmark::State &state) {
+        /*!
+         * The internal force and its Jacobian with the block kernel
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        KernelInputs in;
+        double       fint[3], DfintDU[3][12];
+
+        for (auto _ : state) {
+            balance_equations::compute_internal_force_and_jacobian(in.N, in.dNdX, in.eta, in.detadX, in.F,
+                                                                   in.flat.PK2, in.flat.DPK2Dgrad_u, in.flat.DPK2Dphi,
+                                                                   in.flat.DPK2Dgrad_phi, fint, DfintDU);
+            benchmark::DoNotOptimize(&DfintDU[0][0]);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_compute_internal_force_and_jacobian);
+
+    void BM_compute_internal_couple_and_jacobian(benchmark::State &state) {
+        /*!
+         * The internal couple and its Jacobian with the block kernel
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        KernelInputs in;
+        double       cint[9], DcintDU[9][12];
+
+        for (auto _ : state) {
+            balance_equations::compute_internal_couple_and_jacobian(
+                in.N, in.dNdX, in.eta, in.detadX, in.F, in.chi, in.flat.PK2, in.flat.SIGMA, in.flat.M,
+                in.flat.DPK2Dgrad_u, in.flat.DPK2Dphi, in.flat.DPK2Dgrad_phi, in.flat.DSIGMADgrad_u,
+                in.flat.DSIGMADphi, in.flat.DSIGMADgrad_phi, in.flat.DMDgrad_u, in.flat.DMDphi, in.flat.DMDgrad_phi,
+                cint, DcintDU);
+            benchmark::DoNotOptimize(&DcintDU[0][0]);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_compute_internal_couple_and_jacobian);
+
+    void BM_compute_internal_couple_and_jacobian_symmetric(benchmark::State &state) {
+        /*!
+         * The internal couple and its Jacobian with the block kernel and SIGMA in Voigt form
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        KernelInputs in;
+        double       SIGMA[6], DSIGMADgrad_u[6][9], DSIGMADphi[6][9], DSIGMADgrad_phi[6][27];
+        double       cint[9], DcintDU[9][12];
+
+        fill(SIGMA, 6, 30);
+        fill(&DSIGMADgrad_u[0][0], 54, 80);
+        fill(&DSIGMADphi[0][0], 54, 90);
+        fill(&DSIGMADgrad_phi[0][0], 162, 100);
+
+        for (auto _ : state) {
+            balance_equations::compute_internal_couple_and_jacobian(
+                in.N, in.dNdX, in.eta, in.detadX, in.F, in.chi, in.flat.PK2, SIGMA, in.flat.M, in.flat.DPK2Dgrad_u,
+                in.flat.DPK2Dphi, in.flat.DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi,
+                in.flat.DMDgrad_u, in.flat.DMDphi, in.flat.DMDgrad_phi, cint, DcintDU);
+            benchmark::DoNotOptimize(&DcintDU[0][0]);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_compute_internal_couple_and_jacobian_symmetric);
+
+    void BM_compute_gauss_point_residual_and_jacobian(benchmark::State &state) {
+        /*!
+         * The residual and Jacobian contribution of a Gauss point of an eight node element
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        const unsigned int num_nodes = 8;
+
+        KernelInputs in;
+
+        const std::vector<double> time    = {1., 0.1};
+        const std::vector<double> fparams = {};
+        std::vector<double>       SDVS;
+        std::string               output_message;
+
+        double grad_u[3][3], phi[9], grad_phi[9][3];
+        fill(&grad_u[0][0], 9, 0);
+        fill(phi, 9, 10);
+        fill(&grad_phi[0][0], 27, 20);
+
+        double N[num_nodes], dNdX[num_nodes][3];
+        fill(N, num_nodes, 30);
+        fill(&dNdX[0][0], 3 * num_nodes, 40);
+
+        std::vector<double> RHS(12 * num_nodes);
+        std::vector<double> AMATRX(144 * num_nodes * num_nodes);
+
+        for (auto _ : state) {
+            std::fill(RHS.begin(), RHS.end(), 0.);
+            std::fill(AMATRX.begin(), AMATRX.end(), 0.);
+            balance_equations::compute_gauss_point_residual_and_jacobian(
+                in.flat, time, fparams, grad_u, phi, grad_phi, grad_u, phi, grad_phi, SDVS, num_nodes, N, dNdX, 0.125,
+                RHS.data(), AMATRX.data(), output_message);
+            benchmark::DoNotOptimize(AMATRX.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_compute_gauss_point_residual_and_jacobian);
+
+    void BM_compute_gauss_point_residual_and_jacobian_symmetric(benchmark::State &state) {
+        /*!
+         * The residual and Jacobian contribution of a Gauss point of an eight node element with SIGMA in Voigt form
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        const unsigned int num_nodes = 8;
+
+        KernelInputs in;
+
+        const std::vector<double> time    = {1., 0.1};
+        const std::vector<double> fparams = {};
+        std::vector<double>       SDVS;
+        std::string               output_message;
+
+        double grad_u[3][3], phi[9], grad_phi[9][3];
+        fill(&grad_u[0][0], 9, 0);
+        fill(phi, 9, 10);
+        fill(&grad_phi[0][0], 27, 20);
+
+        double N[num_nodes], dNdX[num_nodes][3];
+        fill(N, num_nodes, 30);
+        fill(&dNdX[0][0], 3 * num_nodes, 40);
+
+        std::vector<double> RHS(12 * num_nodes);
+        std::vector<double> AMATRX(144 * num_nodes * num_nodes);
+
+        for (auto _ : state) {
+            std::fill(RHS.begin(), RHS.end(), 0.);
+            std::fill(AMATRX.begin(), AMATRX.end(), 0.);
+            balance_equations::compute_gauss_point_residual_and_jacobian_symmetric(
+                in.flat, time, fparams, grad_u, phi, grad_phi, grad_u, phi, grad_phi, SDVS, num_nodes, N, dNdX, 0.125,
+                RHS.data(), AMATRX.data(), output_message);
+            benchmark::DoNotOptimize(AMATRX.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_compute_gauss_point_residual_and_jacobian_symmetric);
+
+    void BM_batched_residual(benchmark::State &state) {
+        /*!
+         * The interpolation of the degrees of freedom, the element integration, the assembly and the norm of the
+         * residual of a row of eight node elements with eight Gauss points each using the batched kernels. The
+         * stresses are fixed so the material is not timed. The argument is the number of elements.
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        const unsigned int num_elements = state.range(0), num_gauss_points = 8, num_nodes = 8;
+        const unsigned int npoints = num_elements * num_gauss_points, ndof = 48 * (num_elements + 1);
+
+        // Element e shares its last four nodes with element e + 1
+        std::vector<unsigned int> dof(12 * num_nodes * num_elements);
+        for (unsigned int e = 0; e < num_elements; e++) {
+            for (unsigned int k = 0; k < 12 * num_nodes; k++) {
+                dof[k * num_elements + e] = 48 * e + k;
+            }
+        }
+
+        std::vector<double> N(num_nodes * npoints), dNdX(3 * num_nodes * npoints), weight(npoints);
+        std::vector<double> u(ndof), PK2(9 * npoints), SIGMA(9 * npoints), M(27 * npoints);
+        fill(N.data(), N.size(), 0);
+        fill(dNdX.data(), dNdX.size(), 10);
+        fill(weight.data(), weight.size(), 20);
+        fill(u.data(), u.size(), 30);
+        fill(PK2.data(), PK2.size(), 40);
+        fill(SIGMA.data(), SIGMA.size(), 50);
+        fill(M.data(), M.size(), 60);
+
+        balance_equations::ElementBatch batch;
+        batch.num_elements     = num_elements;
+        batch.num_gauss_points = num_gauss_points;
+        batch.num_nodes        = num_nodes;
+        batch.dof              = dof.data();
+        batch.N                = N.data();
+        batch.dNdX             = dNdX.data();
+        batch.weight           = weight.data();
+
+        std::vector<unsigned int> dof_offsets, dof_entries;
+        balance_equations::map_dof_to_element_residuals(batch, ndof, dof_offsets, dof_entries);
+
+        std::vector<double> grad_u(9 * npoints), phi(9 * npoints), grad_phi(27 * npoints);
+        std::vector<double> element_RHS(12 * num_nodes * num_elements), RHS(ndof);
+
+        for (auto _ : state) {
+            balance_equations::interpolate_dof_batch(batch, u.data(), grad_u.data(), phi.data(), grad_phi.data());
+            balance_equations::integrate_element_residual_batch(batch, grad_u.data(), phi.data(), PK2.data(),
+                                                                SIGMA.data(), M.data(), element_RHS.data());
+            balance_equations::assemble_residual_batch(ndof, dof_offsets.data(), dof_entries.data(),
+                                                       element_RHS.data(), RHS.data());
+            benchmark::DoNotOptimize(balance_equations::residual_norm_squared_batch(ndof, RHS.data()));
+            benchmark::ClobberMemory();
+        }
+
+        state.counters["elements_per_second"] =
+            benchmark::Counter(num_elements, benchmark::Counter::kIsIterationInvariantRate);
+    }
+    BENCHMARK(BM_batched_residual)->Arg(64)->Arg(512)->Arg(4096);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,298 @@
+/*!============================================================================
+   |                                                                          |
+   |                  benchmark_deformation_measures.cpp                      |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+   | Benchmarks of the deformation measures and the maps of the stresses and  |
+   | their Jacobians between the reference and current configurations. This   |
+   | replaces the timing loops of efficiency_tests/tensor_multiplication.cpp. |
+   ============================================================================
+   | Dependencies:                                                            |
+   | benchmark: The Google benchmark library. Available at                    |
+   |            github.com/google/benchmark                                   |
+   | Eigen:     An implementation of various matrix commands. Available at    |
+   |            eigen.tuxfamily.org                                           |
+   ============================================================================*/
+
+#include <benchmark/benchmark.h>
+#include <deformation_measures.h>
+
+#include <array>
+
+namespace {
+
+    const double grad_u[3][3] = {
+        {0.200,  0.100, -0.050},
+        {0.100,  0.001, 0.030 },
+        {-0.020, 0.040, 0.150 }
+    };
+
+    const double phi[9] = {0.100, -0.020, 0.030, 0.010, -0.050, 0.020, -0.010, 0.040, 0.070};
+
+    const double grad_phi[9][3] = {
+        {0.13890017,  -0.3598602,  -0.08048856},
+        {-0.18572739, 0.06847269,  0.22931628 },
+        {-0.01829735, -0.48731265, -0.25277529},
+        {0.26626212,  0.4844646,   -0.31965177},
+        {0.49197846,  0.19051656,  -0.0365349 },
+        {-0.06607774, -0.33526875, -0.15803078},
+        {0.09738707,  -0.49482218, -0.39584868},
+        {-0.45599864, 0.08585038,  -0.09432794},
+        {0.23055539,  0.07564162,  0.24051469 }
+    };
+
+    void BM_fundamental_measures(benchmark::State &state) {
+        /*!
+         * The deformation gradient, the micro deformation and its gradient
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        Matrix_3x3 F, chi;
+        Matrix_3x9 grad_chi;
+
+        for (auto _ : state) {
+            deformation_measures::get_deformation_gradient(grad_u, F);
+            deformation_measures::assemble_chi(phi, chi);
+            deformation_measures::assemble_grad_chi(grad_phi, F, grad_chi);
+            benchmark::DoNotOptimize(grad_chi.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_fundamental_measures);
+
+    void BM_deformation_measures(benchmark::State &state) {
+        /*!
+         * The right Cauchy-Green deformation tensor, Psi and Gamma
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        Matrix_3x3 F, chi, RCG, Psi;
+        Matrix_3x9 grad_chi, Gamma;
+
+        deformation_measures::get_deformation_gradient(grad_u, F);
+        deformation_measures::assemble_chi(phi, chi);
+        deformation_measures::assemble_grad_chi(grad_phi, F, grad_chi);
+
+        for (auto _ : state) {
+            deformation_measures::get_right_cauchy_green(F, RCG);
+            deformation_measures::get_psi(F, chi, Psi);
+            deformation_measures::get_gamma(F, grad_chi, Gamma);
+            benchmark::DoNotOptimize(Gamma.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_deformation_measures);
+
+    void BM_deformation_measure_jacobians(benchmark::State &state) {
+        /*!
+         * The dense Jacobians of the deformation measures w.r.t. the fundamental measures
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        Matrix_3x3   F, chi;
+        Matrix_3x9   grad_chi;
+        Vector_27    grad_chi_voigt;
+        Matrix_9x9   dRCGdF, dPsidF, dPsidchi;
+        Matrix_27x9  dGammadF;
+        Matrix_27x27 dGammadgrad_chi;
+
+        deformation_measures::get_deformation_gradient(grad_u, F);
+        deformation_measures::assemble_chi(phi, chi);
+        deformation_measures::assemble_grad_chi(grad_phi, F, grad_chi);
+        deformation_measures::voigt_3x9_tensor(grad_chi, grad_chi_voigt);
+
+        for (auto _ : state) {
+            deformation_measures::compute_dRCGdF(F, dRCGdF);
+            deformation_measures::compute_dPsidF(chi, dPsidF);
+            deformation_measures::compute_dPsidchi(F, dPsidchi);
+            deformation_measures::compute_dGammadF(grad_chi_voigt, dGammadF);
+            deformation_measures::compute_dGammadgrad_chi(F, dGammadgrad_chi);
+            benchmark::DoNotOptimize(dGammadgrad_chi.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_deformation_measure_jacobians);
+
+    void BM_chain_deformation_measure_jacobians(benchmark::State &state) {
+        /*!
+         * The chain rule through the Jacobians of the deformation measures w.r.t. the fundamental measures. The
+         * first argument is 1 if the fixed sparsity is applied directly and 0 if the dense Jacobians are formed
+         * and multiplied.
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        const bool   apply = state.range(0);
+        Matrix_3x3   F, chi;
+        Matrix_3x9   grad_chi;
+        Vector_27    grad_chi_voigt;
+        Matrix_27x9  dAdRCG   = Matrix_27x9::Constant(0.1);
+        Matrix_27x9  dAdPsi   = Matrix_27x9::Constant(0.2);
+        Matrix_27x27 dAdGamma = Matrix_27x27::Constant(0.3);
+        Matrix_9x9   dRCGdF, dPsidF, dPsidchi;
+        Matrix_27x9  dGammadF, dAdF, dAdchi;
+        Matrix_27x27 dGammadgrad_chi, dAdgrad_chi;
+
+        deformation_measures::get_deformation_gradient(grad_u, F);
+        deformation_measures::assemble_chi(phi, chi);
+        deformation_measures::assemble_grad_chi(grad_phi, F, grad_chi);
+        deformation_measures::voigt_3x9_tensor(grad_chi, grad_chi_voigt);
+
+        for (auto _ : state) {
+            if (apply) {
+                Matrix_27x9 tmp;
+                deformation_measures::apply_dRCGdF(dAdRCG, F, dAdF);
+                deformation_measures::apply_dPsidF(dAdPsi, chi, tmp);
+                dAdF += tmp;
+                deformation_measures::apply_dGammadF(dAdGamma, grad_chi_voigt, tmp);
+                dAdF += tmp;
+                deformation_measures::apply_dPsidchi(dAdPsi, F, dAdchi);
+                deformation_measures::apply_dGammadgrad_chi(dAdGamma, F, dAdgrad_chi);
+            } else {
+                deformation_measures::compute_dRCGdF(F, dRCGdF);
+                deformation_measures::compute_dPsidF(chi, dPsidF);
+                deformation_measures::compute_dPsidchi(F, dPsidchi);
+                deformation_measures::compute_dGammadF(grad_chi_voigt, dGammadF);
+                deformation_measures::compute_dGammadgrad_chi(F, dGammadgrad_chi);
+                dAdF        = dAdRCG * dRCGdF + dAdPsi * dPsidF + dAdGamma * dGammadF;
+                dAdchi      = dAdPsi * dPsidchi;
+                dAdgrad_chi = dAdGamma * dGammadgrad_chi;
+            }
+            benchmark::DoNotOptimize(dAdF.data());
+            benchmark::DoNotOptimize(dAdchi.data());
+            benchmark::DoNotOptimize(dAdgrad_chi.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_chain_deformation_measure_jacobians)->Arg(0)->Arg(1);
+
+    void BM_map_stresses_to_current_configuration(benchmark::State &state) {
+        /*!
+         * Map the reference stresses to the current configuration
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        Matrix_3x3 F, chi;
+        deformation_measures::get_deformation_gradient(grad_u, F);
+        deformation_measures::assemble_chi(phi, chi);
+
+        Vector_9  PK2   = Vector_9::Random();
+        Vector_9  SIGMA = Vector_9::Random();
+        Vector_27 M     = Vector_27::Random();
+        Vector_9  cauchy, s;
+        Vector_27 m;
+
+        for (auto _ : state) {
+            deformation_measures::map_stresses_to_current_configuration(F, chi, PK2, SIGMA, M, cauchy, s, m);
+            benchmark::DoNotOptimize(m.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_map_stresses_to_current_configuration);
+
+    void BM_map_jacobians_to_current_configuration(benchmark::State &state) {
+        /*!
+         * Map the Jacobians of the reference stresses to the current configuration
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        Matrix_3x3 F, chi;
+        deformation_measures::get_deformation_gradient(grad_u, F);
+        deformation_measures::assemble_chi(phi, chi);
+
+        Vector_9  PK2_voigt   = Vector_9::Random();
+        Vector_9  SIGMA_voigt = Vector_9::Random();
+        Vector_27 M_voigt     = Vector_27::Random();
+        Vector_9  cauchy_voigt, s_voigt;
+        Vector_27 m_voigt;
+        deformation_measures::map_stresses_to_current_configuration(F, chi, PK2_voigt, SIGMA_voigt, M_voigt,
+                                                                    cauchy_voigt, s_voigt, m_voigt);
+
+        Matrix_9x9   dPK2dF = Matrix_9x9::Random(), dPK2dchi = Matrix_9x9::Random();
+        Matrix_9x27  dPK2dgrad_chi = Matrix_9x27::Random();
+        Matrix_9x9   dSIGMAdF = Matrix_9x9::Random(), dSIGMAdchi = Matrix_9x9::Random();
+        Matrix_9x27  dSIGMAdgrad_chi = Matrix_9x27::Random();
+        Matrix_27x9  dMdF = Matrix_27x9::Random(), dMdchi = Matrix_27x9::Random();
+        Matrix_27x27 dMdgrad_chi = Matrix_27x27::Random();
+
+        Matrix_9x9   dcauchydF, dcauchydchi, dsdF, dsdchi;
+        Matrix_9x27  dcauchydgrad_chi, dsdgrad_chi;
+        Matrix_27x9  dmdF, dmdchi;
+        Matrix_27x27 dmdgrad_chi;
+
+        for (auto _ : state) {
+            deformation_measures::map_jacobians_to_current_configuration(
+                F, chi, PK2_voigt, SIGMA_voigt, M_voigt, cauchy_voigt, s_voigt, m_voigt, dPK2dF, dPK2dchi,
+                dPK2dgrad_chi, dSIGMAdF, dSIGMAdchi, dSIGMAdgrad_chi, dMdF, dMdchi, dMdgrad_chi, dcauchydF,
+                dcauchydchi, dcauchydgrad_chi, dsdF, dsdchi, dsdgrad_chi, dmdF, dmdchi, dmdgrad_chi);
+            benchmark::DoNotOptimize(dmdgrad_chi.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_map_jacobians_to_current_configuration);
+
+    void BM_map_dAdgrad_chi_to_dadgrad_chi_eigen(benchmark::State &state) {
+        /*!
+         * Map the Jacobian of a third order stress w.r.t. the gradient of chi using Eigen matrices
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        Matrix_3x3 F, chi;
+        deformation_measures::get_deformation_gradient(grad_u, F);
+        deformation_measures::assemble_chi(phi, chi);
+        const double J = F.determinant();
+
+        Matrix_27x27 dMdgrad_chi = Matrix_27x27::Random();
+        Matrix_27x27 dmdgrad_chi;
+
+        for (auto _ : state) {
+            deformation_measures::map_dAdgrad_chi_to_dadgrad_chi(dMdgrad_chi, J, F, chi, dmdgrad_chi);
+            benchmark::DoNotOptimize(dmdgrad_chi.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_map_dAdgrad_chi_to_dadgrad_chi_eigen);
+
+    void BM_map_dAdgrad_chi_to_dadgrad_chi_array(benchmark::State &state) {
+        /*!
+         * Map the Jacobian of a third order stress w.r.t. the gradient of chi using std::arrays
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        Matrix_3x3 F, chi;
+        deformation_measures::get_deformation_gradient(grad_u, F);
+        deformation_measures::assemble_chi(phi, chi);
+        const double J = F.determinant();
+
+        std::array<double, 9> F_array, chi_array;
+        for (unsigned int i = 0; i < 3; i++) {
+            for (unsigned int j = 0; j < 3; j++) {
+                F_array[3 * i + j]   = F(i, j);
+                chi_array[3 * i + j] = chi(i, j);
+            }
+        }
+
+        Matrix_27x27            random = Matrix_27x27::Random();
+        std::array<double, 729> dMdgrad_chi, dmdgrad_chi;
+        for (unsigned int i = 0; i < 729; i++) {
+            dMdgrad_chi[i] = random.data()[i];
+        }
+
+        for (auto _ : state) {
+            deformation_measures::map_dAdgrad_chi_to_dadgrad_chi(dMdgrad_chi, J, F_array, chi_array, dmdgrad_chi);
+            benchmark::DoNotOptimize(dmdgrad_chi.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_map_dAdgrad_chi_to_dadgrad_chi_array);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,225 @@
+/*!============================================================================
+   |                                                                          |
+   |                     benchmark_micro_element.cpp                          |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+   | Benchmarks of the integration of the micromorphic element and of the     |
+   | assembly of the residual and element jacobians of the finite element     |
+   | driver on cube meshes of several sizes.                                  |
+   ============================================================================
+   | Dependencies:                                                            |
+   | benchmark: The Google benchmark library. Available at                    |
+   |            github.com/google/benchmark                                   |
+   | Eigen:     An implementation of various matrix commands. Available at    |
+   |            eigen.tuxfamily.org                                           |
+   ============================================================================*/
+
+#include <benchmark/benchmark.h>
+
+// The element and driver headers are included in the order used by driver.cpp
+#include <tensor.h>
+#include <micro_element.h>
+#include <newton_krylov.h>
+#include <driver.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+    class NullBuffer : public std::streambuf {
+        /*!
+         * A stream buffer which discards its output. The driver reports its progress on std::cout which would
+         * otherwise dominate the timings.
+         */
+
+       protected:
+        int overflow(int c) { return c; }
+    };
+
+    class SilenceOutput {
+        /*!
+         * Discard the output to std::cout while in scope
+         */
+
+       public:
+        SilenceOutput() : previous(std::cout.rdbuf(&buffer)) {}
+
+        ~SilenceOutput() { std::cout.rdbuf(previous); }
+
+       private:
+        NullBuffer      buffer;
+        std::streambuf *previous;
+    };
+
+    std::vector<double> get_fparams() {
+        /*!
+         * The material parameters of the element tests
+         */
+
+        std::vector<double> fparams(19, 0.);
+        fparams[0] = 1000.;
+        for (int i = 1; i < 19; i++) {
+            fparams[i] = 0.1 * (i + 1);
+        }
+        return fparams;
+    }
+
+    micro_element::Hex8 get_element() {
+        /*!
+         * A distorted element with a non-trivial deformation
+         */
+
+        std::vector<double> reference_coords = {0,   0,    0, 1,   0,    0,   1,   1,   0,   0,   1,   0,
+                                                0.1, -0.2, 1, 1.1, -0.2, 1.1, 1.1, 0.8, 1.1, 0.1, 0.8, 1};
+        std::vector<double> U(96), dU(96);
+        for (int n = 0; n < 8; n++) {
+            const double *X = &reference_coords[3 * n];
+            for (int i = 0; i < 12; i++) {
+                U[12 * n + i]  = 0.01 * (i + 1) * (X[0] - 0.5 * X[1] + 0.25 * X[2]);
+                dU[12 * n + i] = 0.1 * U[12 * n + i];
+            }
+        }
+        return micro_element::Hex8(reference_coords, U, dU, get_fparams());
+    }
+
+    void BM_integrate_element(benchmark::State &state) {
+        /*!
+         * Integrate the element. The first argument is 1 if the tangents are computed.
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        const bool          set_tangents = state.range(0);
+        micro_element::Hex8 element      = get_element();
+
+        for (auto _ : state) {
+            element.integrate_element(set_tangents);
+            benchmark::DoNotOptimize(element.RHS.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_integrate_element)->Arg(0)->Arg(1);
+
+    void BM_integrate_element_parallel(benchmark::State &state) {
+        /*!
+         * Integrate the element with the Gauss points evaluated on a pool. The first argument is 1 if the tangents
+         * are computed and the second the number of workers of the pool.
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        const bool                    set_tangents = state.range(0);
+        micro_element::GaussPointPool pool(state.range(1));
+        micro_element::Hex8           element = get_element();
+
+        for (auto _ : state) {
+            element.integrate_element(pool, set_tangents);
+            benchmark::DoNotOptimize(element.RHS.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(BM_integrate_element_parallel)->Args({1, 2})->Args({1, 4})->Args({1, 8})->UseRealTime();
+
+    std::string write_cube_mesh(const unsigned int n) {
+        /*!
+         * Write the input deck of a unit cube meshed with n x n x n elements and return its filename
+         *
+         * :param const unsigned int n: The number of elements along each edge
+         */
+
+        std::stringstream filename;
+        filename << "benchmark_cube_" << n << ".inp";
+
+        std::ofstream deck(filename.str().c_str());
+        deck << "#Unit cube mesh for benchmark_micro_element\n";
+
+        deck << "*NODES,12\n";
+        for (unsigned int k = 0; k <= n; k++) {
+            for (unsigned int j = 0; j <= n; j++) {
+                for (unsigned int i = 0; i <= n; i++) {
+                    deck << 1 + i + (n + 1) * (j + (n + 1) * k) << ", " << double(i) / n << ", " << double(j) / n
+                         << ", " << double(k) / n << "\n";
+                }
+            }
+        }
+
+        deck << "\n*ELEMENTS\n";
+        for (unsigned int k = 0; k < n; k++) {
+            for (unsigned int j = 0; j < n; j++) {
+                for (unsigned int i = 0; i < n; i++) {
+                    unsigned int base = 1 + i + (n + 1) * (j + (n + 1) * k);
+                    unsigned int up   = (n + 1) * (n + 1);
+                    deck << 1 + i + n * (j + n * k) << ", " << base << ", " << base + 1 << ", " << base + n + 2 << ", "
+                         << base + n + 1 << ", " << base + up << ", " << base + up + 1 << ", " << base + up + n + 2
+                         << ", " << base + up + n + 1 << "\n";
+                }
+            }
+        }
+
+        deck << "\n*PROPERTIES\n";
+        std::vector<double> fparams = get_fparams();
+        for (unsigned int i = 0; i < fparams.size(); i++) {
+            deck << fparams[i] << ((i + 1 < fparams.size()) ? ", " : "\n");
+        }
+
+        return filename.str();
+    }
+
+    void BM_assemble_RHS_and_jacobian_matrix(benchmark::State &state) {
+        /*!
+         * Assemble the residual of the finite element model and, if requested, the element jacobians. The arguments
+         * are the number of elements along an edge of the cube mesh, the number of assembly threads and 1 if the
+         * jacobians are formed.
+         *
+         * :param benchmark::State &state: The benchmark state
+         */
+
+        SilenceOutput silence;
+
+        const std::string filename = write_cube_mesh(state.range(0));
+        InputParser       IP(filename);
+        IP.read_input();
+        std::remove(filename.c_str());
+
+        FEAModel FM(IP);
+        FM.num_threads   = state.range(1);
+        FM.form_jacobian = state.range(2);
+
+        // The degrees of freedom do not change between iterations so every element would otherwise be re-used
+        FM.incremental_assembly = false;
+
+        for (unsigned int i = 0; i < FM.du.size(); i++) {
+            FM.du[i] = 1e-3 * ((i * 37) % 101);
+            FM.u[i]  = FM.du[i];
+        }
+
+        for (auto _ : state) {
+            FM.assemble_RHS_and_jacobian_matrix();
+            benchmark::DoNotOptimize(FM.RHS.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.counters["elements"] = FM.mapped_elements.size();
+        state.counters["elements_per_second"] =
+            benchmark::Counter(FM.mapped_elements.size(), benchmark::Counter::kIsIterationInvariantRate);
+    }
+    BENCHMARK(BM_assemble_RHS_and_jacobian_matrix)
+        ->ArgsProduct({{2, 4, 8}, {1, 4}, {0}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+    // The element tangents are much more expensive than the residual so only the smaller meshes are used
+    BENCHMARK(BM_assemble_RHS_and_jacobian_matrix)
+        ->ArgsProduct({{2, 3}, {1, 4}, {1}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,297 @@
+/*!============================================================================
+   |                                                                          |
+   |             benchmark_micromorphic_material_library.cpp                  |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+   | Benchmarks of the material models served by the micromorphic material   |
+   | library. Each registered model is evaluated with and without its         |
+   | analytic Jacobians and with numeric gradients so that changes in the     |
+   | cost of the upstream tardigrade models are visible.                      |
+   ============================================================================
+   | Dependencies:                                                            |
+   | benchmark: The Google benchmark library. Available at                    |
+   |            github.com/google/benchmark                                   |
+   ============================================================================*/
+
+#include <benchmark/benchmark.h>
+#include <micromorphic_material_library.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+    typedef std::vector<std::vector<double> > matrixType;
+
+    struct ModelInputs {
+        /*!
+         * The inputs of a material model at a single point
+         */
+
+        std::string         model_name;
+        std::vector<double> time;
+        std::vector<double> fparams;
+        double              current_grad_u[3][3];
+        double              current_phi[9];
+        double              current_grad_phi[9][3];
+        double              previous_grad_u[3][3];
+        double              previous_phi[9];
+        double              previous_grad_phi[9][3];
+        std::vector<double> SDVS;
+    };
+
+    void set_deformation(ModelInputs &inputs) {
+        /*!
+         * Set the current deformation to a fixed, non-trivial state and the previous deformation to zero
+         *
+         * :param ModelInputs &inputs: The inputs to modify
+         */
+
+        const double grad_u[3][3] = {
+            {0.200, 0.100, 0.000},
+            {0.100, 0.001, 0.000},
+            {0.000, 0.000, 0.000}
+        };
+
+        const double grad_phi[9][3] = {
+            {0.13890017,  -0.3598602,  -0.08048856},
+            {-0.18572739, 0.06847269,  0.22931628 },
+            {-0.01829735, -0.48731265, -0.25277529},
+            {0.26626212,  0.4844646,   -0.31965177},
+            {0.49197846,  0.19051656,  -0.0365349 },
+            {-0.06607774, -0.33526875, -0.15803078},
+            {0.09738707,  -0.49482218, -0.39584868},
+            {-0.45599864, 0.08585038,  -0.09432794},
+            {0.23055539,  0.07564162,  0.24051469 }
+        };
+
+        for (unsigned int i = 0; i < 3; i++) {
+            for (unsigned int j = 0; j < 3; j++) {
+                inputs.current_grad_u[i][j]  = grad_u[i][j];
+                inputs.previous_grad_u[i][j] = 0;
+            }
+        }
+
+        for (unsigned int i = 0; i < 9; i++) {
+            inputs.current_phi[i]  = 0;
+            inputs.previous_phi[i] = 0;
+            for (unsigned int j = 0; j < 3; j++) {
+                inputs.current_grad_phi[i][j]  = grad_phi[i][j];
+                inputs.previous_grad_phi[i][j] = 0;
+            }
+        }
+
+        inputs.current_phi[0] = 0.1;
+    }
+
+    ModelInputs get_model_inputs(const std::string &model_name) {
+        /*!
+         * Get the inputs of one of the registered material models. The parameters are those of the interface tests
+         * and the deformation of the elasto-plastic model is large enough that the point yields.
+         *
+         * :param const std::string &model_name: The name of the model
+         */
+
+        ModelInputs inputs;
+        inputs.model_name = model_name;
+
+        if (model_name == "LinearElasticity") {
+            inputs.time    = {10, 2.7};
+            inputs.fparams = {2,  1.7, 1.8, 5,  2.8, .76, .15, 9.8, 5.4, 11, 1.,  2.,
+                              3., 4.,  5.,  6., 7.,  8.,  9.,  10., 11., 2,  .76, 5.4};
+            set_deformation(inputs);
+        } else {
+            inputs.time    = {10., 2.5};
+            inputs.fparams = {
+                2,     2.4e2,  1.5e1,                        // Macro hardening parameters
+                2,     1.4e2,  2.0e1,                        // Micro hardening parameters
+                2,     2.0e0,  2.7e1,                        // Micro gradient hardening parameters
+                2,     0.56,   0.2,                          // Macro flow parameters
+                2,     0.15,   -0.2,                         // Micro flow parameters
+                2,     0.82,   0.1,                          // Micro gradient flow parameters
+                2,     0.70,   0.3,                          // Macro yield parameters
+                2,     0.40,   -0.3,                         // Micro yield parameters
+                2,     0.52,   0.4,                          // Micro gradient yield parameters
+                2,     696.47, 65.84,                        // A stiffness tensor parameters
+                5,     -7.69,  -51.92, 38.61, -27.31, 5.13,  // B stiffness tensor parameters
+                11,    1.85,   -0.19,  -1.08, -1.57,  2.29,
+                -0.61, 5.97,   -2.02,  2.38,  -0.32,  -3.25,  // C stiffness tensor parameters
+                2,     -51.92, 5.13,                          // D stiffness tensor parameters
+                0.4,   0.3,    0.35,   1e-8,  1e-8            // Integration parameters
+            };
+            inputs.SDVS    = std::vector<double>(55, 0);
+            set_deformation(inputs);
+        }
+
+        return inputs;
+    }
+
+    void BM_evaluate_model(benchmark::State &state, const std::string &model_name) {
+        /*!
+         * Evaluate the stresses of a material model without the Jacobians
+         *
+         * :param benchmark::State &state: The benchmark state
+         * :param const std::string &model_name: The name of the model
+         */
+
+        auto material = micromorphic_material_library::MaterialFactory::Instance().GetSharedMaterial(model_name);
+        if (!material) {
+            state.SkipWithError(("material model " + model_name + " not found").c_str());
+            return;
+        }
+
+        ModelInputs inputs = get_model_inputs(model_name);
+
+        const std::vector<double> ADD_DOF;
+        const matrixType          ADD_grad_DOF;
+        std::vector<double>       SDVS, PK2, SIGMA, M;
+        matrixType                ADD_TERMS;
+        std::string               output_message;
+#ifdef DEBUG_MODE
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG;
+#endif
+
+        for (auto _ : state) {
+            SDVS          = inputs.SDVS;
+            int errorCode = material->evaluate_model(
+                inputs.time, inputs.fparams, inputs.current_grad_u, inputs.current_phi, inputs.current_grad_phi,
+                inputs.previous_grad_u, inputs.previous_phi, inputs.previous_grad_phi, SDVS, ADD_DOF, ADD_grad_DOF,
+                ADD_DOF, ADD_grad_DOF, PK2, SIGMA, M, ADD_TERMS, output_message
+#ifdef DEBUG_MODE
+                ,
+                DEBUG
+#endif
+            );
+            if (errorCode > 0) {
+                state.SkipWithError(output_message.c_str());
+                break;
+            }
+            benchmark::DoNotOptimize(PK2.data());
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void BM_evaluate_model_jacobian(benchmark::State &state, const std::string &model_name) {
+        /*!
+         * Evaluate the stresses of a material model and their analytic Jacobians
+         *
+         * :param benchmark::State &state: The benchmark state
+         * :param const std::string &model_name: The name of the model
+         */
+
+        auto material = micromorphic_material_library::MaterialFactory::Instance().GetSharedMaterial(model_name);
+        if (!material) {
+            state.SkipWithError(("material model " + model_name + " not found").c_str());
+            return;
+        }
+
+        ModelInputs inputs = get_model_inputs(model_name);
+
+        const std::vector<double>                       ADD_DOF;
+        const matrixType                                ADD_grad_DOF;
+        std::vector<double>                             SDVS, PK2, SIGMA, M;
+        matrixType                                      DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi;
+        matrixType                                      DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi;
+        matrixType                                      DMDgrad_u, DMDphi, DMDgrad_phi;
+        matrixType                                      ADD_TERMS;
+        std::vector<std::vector<std::vector<double> > > ADD_JACOBIANS;
+        std::string                                     output_message;
+#ifdef DEBUG_MODE
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG;
+#endif
+
+        for (auto _ : state) {
+            SDVS          = inputs.SDVS;
+            int errorCode = material->evaluate_model(
+                inputs.time, inputs.fparams, inputs.current_grad_u, inputs.current_phi, inputs.current_grad_phi,
+                inputs.previous_grad_u, inputs.previous_phi, inputs.previous_grad_phi, SDVS, ADD_DOF, ADD_grad_DOF,
+                ADD_DOF, ADD_grad_DOF, PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi,
+                DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+                ,
+                DEBUG
+#endif
+            );
+            if (errorCode > 0) {
+                state.SkipWithError(output_message.c_str());
+                break;
+            }
+            benchmark::DoNotOptimize(DMDgrad_phi.data());
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void BM_evaluate_model_numeric_gradients(benchmark::State &state, const std::string &model_name) {
+        /*!
+         * Evaluate the stresses of a material model and their Jacobians by central differences. The first argument
+         * of the benchmark is the number of threads used for the perturbations.
+         *
+         * :param benchmark::State &state: The benchmark state
+         * :param const std::string &model_name: The name of the model
+         */
+
+        auto material = micromorphic_material_library::MaterialFactory::Instance().GetSharedMaterial(model_name);
+        if (!material) {
+            state.SkipWithError(("material model " + model_name + " not found").c_str());
+            return;
+        }
+
+        ModelInputs inputs = get_model_inputs(model_name);
+
+        const unsigned int num_threads = state.range(0);
+
+        const std::vector<double>                       ADD_DOF;
+        const matrixType                                ADD_grad_DOF;
+        std::vector<double>                             SDVS, PK2, SIGMA, M;
+        matrixType                                      DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi;
+        matrixType                                      DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi;
+        matrixType                                      DMDgrad_u, DMDphi, DMDgrad_phi;
+        matrixType                                      ADD_TERMS;
+        std::vector<std::vector<std::vector<double> > > ADD_JACOBIANS;
+        std::string                                     output_message;
+#ifdef DEBUG_MODE
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG;
+#endif
+
+        for (auto _ : state) {
+            SDVS          = inputs.SDVS;
+            int errorCode = material->evaluate_model_numeric_gradients(
+                inputs.time, inputs.fparams, inputs.current_grad_u, inputs.current_phi, inputs.current_grad_phi,
+                inputs.previous_grad_u, inputs.previous_phi, inputs.previous_grad_phi, SDVS, ADD_DOF, ADD_grad_DOF,
+                ADD_DOF, ADD_grad_DOF, PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi,
+                DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message,
+#ifdef DEBUG_MODE
+                DEBUG,
+#endif
+                1e-6, micromorphic_material_library::CENTRAL_DIFFERENCE, num_threads);
+            if (errorCode > 0) {
+                state.SkipWithError(output_message.c_str());
+                break;
+            }
+            benchmark::DoNotOptimize(DMDgrad_phi.data());
+            benchmark::ClobberMemory();
+        }
+    }
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_evaluate_model, LinearElasticity, std::string("LinearElasticity"));
+BENCHMARK_CAPTURE(BM_evaluate_model, LinearElasticityDruckerPragerPlasticity,
+                  std::string("LinearElasticityDruckerPragerPlasticity"));
+
+BENCHMARK_CAPTURE(BM_evaluate_model_jacobian, LinearElasticity, std::string("LinearElasticity"));
+BENCHMARK_CAPTURE(BM_evaluate_model_jacobian, LinearElasticityDruckerPragerPlasticity,
+                  std::string("LinearElasticityDruckerPragerPlasticity"));
+
+BENCHMARK_CAPTURE(BM_evaluate_model_numeric_gradients, LinearElasticity, std::string("LinearElasticity"))
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_evaluate_model_numeric_gradients, LinearElasticityDruckerPragerPlasticity,
+                  std::string("LinearElasticityDruckerPragerPlasticity"))
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
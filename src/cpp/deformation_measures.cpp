@@ -2440,6 +2440,312 @@ namespace deformation_measures
         return;
     }
 
+    namespace{
+
+        //The second order tensor to voigt map (11,22,33,23,13,12,32,31,21). Third order tensors are
+        //stored as 9*i + sot_to_voigt[j][k].
+        constexpr int sot_to_voigt[3][3] = {{0,5,4},
+                                            {8,1,3},
+                                            {7,6,2}};
+
+        template<int rows>
+        void apply_dRCGdF_kernel(const Eigen::Matrix<double,rows,9> &dAdRCG, const Matrix_3x3 &F, Eigen::Matrix<double,rows,9> &dAdF){
+            /*!
+            dAdF_kK = dAdRCG_IJ (delta_IK F_kJ + F_kI delta_JK)
+            */
+
+            dAdF.setZero();
+            for (int k=0; k<3; k++){
+                for (int K=0; K<3; K++){
+                    for (int J=0; J<3; J++){
+                        dAdF.col(sot_to_voigt[k][K]) += F(k,J)*(dAdRCG.col(sot_to_voigt[K][J]) + dAdRCG.col(sot_to_voigt[J][K]));
+                    }
+                }
+            }
+        }
+
+        template<int rows>
+        void apply_dPsidF_kernel(const Eigen::Matrix<double,rows,9> &dAdPsi, const Matrix_3x3 &chi, Eigen::Matrix<double,rows,9> &dAdF){
+            /*!
+            dAdF_kL = dAdPsi_LJ chi_kJ
+            */
+
+            dAdF.setZero();
+            for (int k=0; k<3; k++){
+                for (int L=0; L<3; L++){
+                    for (int J=0; J<3; J++){
+                        dAdF.col(sot_to_voigt[k][L]) += chi(k,J)*dAdPsi.col(sot_to_voigt[L][J]);
+                    }
+                }
+            }
+        }
+
+        template<int rows>
+        void apply_dPsidchi_kernel(const Eigen::Matrix<double,rows,9> &dAdPsi, const Matrix_3x3 &F, Eigen::Matrix<double,rows,9> &dAdchi){
+            /*!
+            dAdchi_kL = dAdPsi_IL F_kI
+            */
+
+            dAdchi.setZero();
+            for (int k=0; k<3; k++){
+                for (int L=0; L<3; L++){
+                    for (int I=0; I<3; I++){
+                        dAdchi.col(sot_to_voigt[k][L]) += F(k,I)*dAdPsi.col(sot_to_voigt[I][L]);
+                    }
+                }
+            }
+        }
+
+        template<int rows>
+        void apply_dGammadF_kernel(const Eigen::Matrix<double,rows,27> &dAdGamma, const Vector_27 &grad_chi, Eigen::Matrix<double,rows,9> &dAdF){
+            /*!
+            dAdF_kL = dAdGamma_LJK grad_chi_kJK
+            */
+
+            for (int k=0; k<3; k++){
+                for (int L=0; L<3; L++){
+                    dAdF.col(sot_to_voigt[k][L]).noalias() = dAdGamma.template middleCols<9>(9*L)*grad_chi.segment<9>(9*k);
+                }
+            }
+        }
+
+        template<int rows>
+        void apply_dGammadgrad_chi_kernel(const Eigen::Matrix<double,rows,27> &dAdGamma, const Matrix_3x3 &F, Eigen::Matrix<double,rows,27> &dAdgrad_chi){
+            /*!
+            dAdgrad_chi_iJK = dAdGamma_IJK F_iI
+            */
+
+            for (int i=0; i<3; i++){
+                dAdgrad_chi.template middleCols<9>(9*i) = F(i,0)*dAdGamma.template middleCols<9>(0)
+                                                        + F(i,1)*dAdGamma.template middleCols<9>(9)
+                                                        + F(i,2)*dAdGamma.template middleCols<9>(18);
+            }
+        }
+
+        template<int rows>
+        void apply_dgrad_chidgrad_phi_kernel(const Eigen::Matrix<double,rows,27> &dAdgrad_chi, const Matrix_3x3 &F, Eigen::Matrix<double,rows,27> &dAdgrad_phi){
+            /*!
+            dAdgrad_phi_iIk = dAdgrad_chi_iIK F_kK
+            */
+
+            dAdgrad_phi.setZero();
+            for (int i=0; i<3; i++){
+                for (int I=0; I<3; I++){
+                    for (int k=0; k<3; k++){
+                        for (int K=0; K<3; K++){
+                            dAdgrad_phi.col(9*i + sot_to_voigt[I][k]) += F(k,K)*dAdgrad_chi.col(9*i + sot_to_voigt[I][K]);
+                        }
+                    }
+                }
+            }
+        }
+
+        template<int rows>
+        void apply_dgrad_chidF_kernel(const Eigen::Matrix<double,rows,27> &dAdgrad_chi, const Vector_27 &grad_phi, Eigen::Matrix<double,rows,9> &dAdF){
+            /*!
+            dAdF_aK = dAdgrad_chi_iIK grad_phi_iIa
+            */
+
+            dAdF.setZero();
+            for (int a=0; a<3; a++){
+                for (int K=0; K<3; K++){
+                    for (int i=0; i<3; i++){
+                        for (int I=0; I<3; I++){
+                            dAdF.col(sot_to_voigt[a][K]) += grad_phi(9*i + sot_to_voigt[I][a])*dAdgrad_chi.col(9*i + sot_to_voigt[I][K]);
+                        }
+                    }
+                }
+            }
+        }
+
+    }
+
+    void apply_dRCGdF(const Matrix_9x9 &dAdRCG, const Matrix_3x3 &F, Matrix_9x9 &dAdF){
+        /*!======================
+        |    apply_dRCGdF    |
+        ======================
+
+        Compute dAdF = dAdRCG*dRCGdF without forming
+        dRCGdF (see compute_dRCGdF).
+
+        */
+
+        apply_dRCGdF_kernel<9>(dAdRCG, F, dAdF);
+    }
+
+    void apply_dRCGdF(const Matrix_27x9 &dAdRCG, const Matrix_3x3 &F, Matrix_27x9 &dAdF){
+        /*!======================
+        |    apply_dRCGdF    |
+        ======================
+
+        Compute dAdF = dAdRCG*dRCGdF without forming
+        dRCGdF (see compute_dRCGdF).
+
+        */
+
+        apply_dRCGdF_kernel<27>(dAdRCG, F, dAdF);
+    }
+
+    void apply_dPsidF(const Matrix_9x9 &dAdPsi, const Matrix_3x3 &chi, Matrix_9x9 &dAdF){
+        /*!======================
+        |    apply_dPsidF    |
+        ======================
+
+        Compute dAdF = dAdPsi*dPsidF without forming
+        dPsidF (see compute_dPsidF).
+
+        */
+
+        apply_dPsidF_kernel<9>(dAdPsi, chi, dAdF);
+    }
+
+    void apply_dPsidF(const Matrix_27x9 &dAdPsi, const Matrix_3x3 &chi, Matrix_27x9 &dAdF){
+        /*!======================
+        |    apply_dPsidF    |
+        ======================
+
+        Compute dAdF = dAdPsi*dPsidF without forming
+        dPsidF (see compute_dPsidF).
+
+        */
+
+        apply_dPsidF_kernel<27>(dAdPsi, chi, dAdF);
+    }
+
+    void apply_dPsidchi(const Matrix_9x9 &dAdPsi, const Matrix_3x3 &F, Matrix_9x9 &dAdchi){
+        /*!========================
+        |    apply_dPsidchi    |
+        ========================
+
+        Compute dAdchi = dAdPsi*dPsidchi without forming
+        dPsidchi (see compute_dPsidchi).
+
+        */
+
+        apply_dPsidchi_kernel<9>(dAdPsi, F, dAdchi);
+    }
+
+    void apply_dPsidchi(const Matrix_27x9 &dAdPsi, const Matrix_3x3 &F, Matrix_27x9 &dAdchi){
+        /*!========================
+        |    apply_dPsidchi    |
+        ========================
+
+        Compute dAdchi = dAdPsi*dPsidchi without forming
+        dPsidchi (see compute_dPsidchi).
+
+        */
+
+        apply_dPsidchi_kernel<27>(dAdPsi, F, dAdchi);
+    }
+
+    void apply_dGammadF(const Matrix_9x27 &dAdGamma, const Vector_27 &grad_chi, Matrix_9x9 &dAdF){
+        /*!========================
+        |    apply_dGammadF    |
+        ========================
+
+        Compute dAdF = dAdGamma*dGammadF without forming
+        dGammadF (see compute_dGammadF).
+
+        */
+
+        apply_dGammadF_kernel<9>(dAdGamma, grad_chi, dAdF);
+    }
+
+    void apply_dGammadF(const Matrix_27x27 &dAdGamma, const Vector_27 &grad_chi, Matrix_27x9 &dAdF){
+        /*!========================
+        |    apply_dGammadF    |
+        ========================
+
+        Compute dAdF = dAdGamma*dGammadF without forming
+        dGammadF (see compute_dGammadF).
+
+        */
+
+        apply_dGammadF_kernel<27>(dAdGamma, grad_chi, dAdF);
+    }
+
+    void apply_dGammadgrad_chi(const Matrix_9x27 &dAdGamma, const Matrix_3x3 &F, Matrix_9x27 &dAdgrad_chi){
+        /*!===============================
+        |    apply_dGammadgrad_chi    |
+        ===============================
+
+        Compute dAdgrad_chi = dAdGamma*dGammadgrad_chi
+        without forming dGammadgrad_chi (see
+        compute_dGammadgrad_chi).
+
+        */
+
+        apply_dGammadgrad_chi_kernel<9>(dAdGamma, F, dAdgrad_chi);
+    }
+
+    void apply_dGammadgrad_chi(const Matrix_27x27 &dAdGamma, const Matrix_3x3 &F, Matrix_27x27 &dAdgrad_chi){
+        /*!===============================
+        |    apply_dGammadgrad_chi    |
+        ===============================
+
+        Compute dAdgrad_chi = dAdGamma*dGammadgrad_chi
+        without forming dGammadgrad_chi (see
+        compute_dGammadgrad_chi).
+
+        */
+
+        apply_dGammadgrad_chi_kernel<27>(dAdGamma, F, dAdgrad_chi);
+    }
+
+    void apply_dgrad_chidgrad_phi(const Matrix_9x27 &dAdgrad_chi, const Matrix_3x3 &F, Matrix_9x27 &dAdgrad_phi){
+        /*!==================================
+        |    apply_dgrad_chidgrad_phi    |
+        ==================================
+
+        Compute dAdgrad_phi = dAdgrad_chi*dgrad_chidgrad_phi
+        without forming dgrad_chidgrad_phi (see
+        compute_dgrad_chidgrad_phi).
+
+        */
+
+        apply_dgrad_chidgrad_phi_kernel<9>(dAdgrad_chi, F, dAdgrad_phi);
+    }
+
+    void apply_dgrad_chidgrad_phi(const Matrix_27x27 &dAdgrad_chi, const Matrix_3x3 &F, Matrix_27x27 &dAdgrad_phi){
+        /*!==================================
+        |    apply_dgrad_chidgrad_phi    |
+        ==================================
+
+        Compute dAdgrad_phi = dAdgrad_chi*dgrad_chidgrad_phi
+        without forming dgrad_chidgrad_phi (see
+        compute_dgrad_chidgrad_phi).
+
+        */
+
+        apply_dgrad_chidgrad_phi_kernel<27>(dAdgrad_chi, F, dAdgrad_phi);
+    }
+
+    void apply_dgrad_chidF(const Matrix_9x27 &dAdgrad_chi, const Vector_27 &grad_phi, Matrix_9x9 &dAdF){
+        /*!===========================
+        |    apply_dgrad_chidF    |
+        ===========================
+
+        Compute dAdF = dAdgrad_chi*dgrad_chidF without
+        forming dgrad_chidF (see compute_dgrad_chidF).
+
+        */
+
+        apply_dgrad_chidF_kernel<9>(dAdgrad_chi, grad_phi, dAdF);
+    }
+
+    void apply_dgrad_chidF(const Matrix_27x27 &dAdgrad_chi, const Vector_27 &grad_phi, Matrix_27x9 &dAdF){
+        /*!===========================
+        |    apply_dgrad_chidF    |
+        ===========================
+
+        Compute dAdF = dAdgrad_chi*dgrad_chidF without
+        forming dgrad_chidF (see compute_dgrad_chidF).
+
+        */
+
+        apply_dgrad_chidF_kernel<27>(dAdgrad_chi, grad_phi, dAdF);
+    }
+
     void compute_dFdgrad_u(const Matrix_3x3 &F, Matrix_9x9 &dFdgrad_u){
         /*!============================
         |    commpute_dFdgrad_u    |
@@ -3264,31 +3570,30 @@ namespace deformation_measures
         
         */        
 
-        //Define the partial derivatives of grad_chi
-        //Note: Removing sparse matrices because of problems with 
-        //      MOOSE.
-        //SpMat dgrad_chidF(27,9);
-        //SpMat dgrad_chidgrad_phi(27,27);
-
-        Matrix_27x9  dgrad_chidF;
-        Matrix_27x27 dgrad_chidgrad_phi;
+        //The partial derivatives of grad_chi w.r.t. F and grad_phi are applied 
+        //through their fixed sparsity rather than formed and multiplied (see 
+        //apply_dgrad_chidF and apply_dgrad_chidgrad_phi).
+        Matrix_9x9  dAdF_9;  //!The contribution of grad_chi to the derivative of a second order stress w.r.t. F
+        Matrix_27x9 dAdF_27; //!The contribution of grad_chi to the derivative of a third order stress w.r.t. F
         
         //Define the derivative of the deformation gradient w.r.t. the gradient of u w.r.t. the local coordinates.
         Matrix_9x9 dFdgrad_u;
         compute_dFdgrad_u(F,dFdgrad_u);
         
-        compute_dgrad_chidF(grad_phi, dgrad_chidF);
-        compute_dgrad_chidgrad_phi(F,dgrad_chidgrad_phi);
-        
         //Compute the total derivatives w.r.t. the deformation gradient.
-        DcauchyDgrad_u = (dcauchydF + dcauchydgrad_chi*dgrad_chidF)*dFdgrad_u;
-        DsDgrad_u      = (dsdF      +      dsdgrad_chi*dgrad_chidF)*dFdgrad_u;
-        DmDgrad_u      = (dmdF      +      dmdgrad_chi*dgrad_chidF)*dFdgrad_u;
+        apply_dgrad_chidF(dcauchydgrad_chi, grad_phi, dAdF_9);
+        DcauchyDgrad_u = (dcauchydF + dAdF_9)*dFdgrad_u;
+        
+        apply_dgrad_chidF(dsdgrad_chi, grad_phi, dAdF_9);
+        DsDgrad_u      = (dsdF      + dAdF_9)*dFdgrad_u;
+        
+        apply_dgrad_chidF(dmdgrad_chi, grad_phi, dAdF_27);
+        DmDgrad_u      = (dmdF      + dAdF_27)*dFdgrad_u;
         
         //Compute the total derivatives w.r.t. the gradient of the micro-displacement dof.
-        DcauchyDgrad_phi = dcauchydgrad_chi*dgrad_chidgrad_phi;
-        DsDgrad_phi      = dsdgrad_chi*dgrad_chidgrad_phi;
-        DmDgrad_phi      = dmdgrad_chi*dgrad_chidgrad_phi;
+        apply_dgrad_chidgrad_phi(dcauchydgrad_chi, F, DcauchyDgrad_phi);
+        apply_dgrad_chidgrad_phi(dsdgrad_chi,      F, DsDgrad_phi);
+        apply_dgrad_chidgrad_phi(dmdgrad_chi,      F, DmDgrad_phi);
         
         return;
     }
@@ -3314,30 +3619,30 @@ namespace deformation_measures
         
         */
 
-        //Define the partial derivatives of grad_chi
-        //Note: Removing sparse matrices because of problems with 
-        //      MOOSE.
-        //SpMat dgrad_chidF(27,9);
-        //SpMat dgrad_chidgrad_phi(27,27);
-
-        Matrix_27x9  dgrad_chidF;
-        Matrix_27x27 dgrad_chidgrad_phi;
+        //The partial derivatives of grad_chi w.r.t. F and grad_phi are applied
+        //through their fixed sparsity rather than formed and multiplied (see
+        //apply_dgrad_chidF and apply_dgrad_chidgrad_phi).
+        Matrix_9x9  dAdF_9;  //!The contribution of grad_chi to the derivative of a second order stress w.r.t. F
+        Matrix_27x9 dAdF_27; //!The contribution of grad_chi to the derivative of a third order stress w.r.t. F
 
         //Define the derivative of the deformation gradient w.r.t. the gradient of u w.r.t. the local coordinates.
         Matrix_9x9 dFdgrad_u;
         compute_dFdgrad_u(F,dFdgrad_u);
-        compute_dgrad_chidF(grad_phi, dgrad_chidF);
-        compute_dgrad_chidgrad_phi(F,dgrad_chidgrad_phi);
 
         //Compute the total derivatives w.r.t. the deformation gradient.
-        DPK2Dgrad_u    = (dPK2dF   + dPK2dgrad_chi*dgrad_chidF)*dFdgrad_u;
-        DSIGMADgrad_u  = (dSIGMAdF + dSIGMAdgrad_chi*dgrad_chidF)*dFdgrad_u;
-        DMDgrad_u      = (dMdF     + dMdgrad_chi*dgrad_chidF)*dFdgrad_u;
+        apply_dgrad_chidF(dPK2dgrad_chi, grad_phi, dAdF_9);
+        DPK2Dgrad_u    = (dPK2dF   + dAdF_9)*dFdgrad_u;
+
+        apply_dgrad_chidF(dSIGMAdgrad_chi, grad_phi, dAdF_9);
+        DSIGMADgrad_u  = (dSIGMAdF + dAdF_9)*dFdgrad_u;
+
+        apply_dgrad_chidF(dMdgrad_chi, grad_phi, dAdF_27);
+        DMDgrad_u      = (dMdF     + dAdF_27)*dFdgrad_u;
 
         //Compute the total derivatives w.r.t. the gradient of the micro-displacement dof.
-        DPK2Dgrad_phi   = dPK2dgrad_chi*dgrad_chidgrad_phi;
-        DSIGMADgrad_phi = dSIGMAdgrad_chi*dgrad_chidgrad_phi;
-        DMDgrad_phi     = dMdgrad_chi*dgrad_chidgrad_phi;
+        apply_dgrad_chidgrad_phi(dPK2dgrad_chi,   F, DPK2Dgrad_phi);
+        apply_dgrad_chidgrad_phi(dSIGMAdgrad_chi, F, DSIGMADgrad_phi);
+        apply_dgrad_chidgrad_phi(dMdgrad_chi,     F, DMDgrad_phi);
 
         return;
     }
@@ -126,6 +126,37 @@ namespace deformation_measures
     
     void compute_dgrad_chidF(const Vector_27 &grad_phi, Matrix_27x9 &dgrad_chidF);
 
+    //Apply the gradients of the deformation measures to the gradient of a quantity w.r.t.
+    //the deformation measure (e.g. dAdF = dAdRCG*dRCGdF) using their fixed Kronecker
+    //structure without forming them. The result must not alias the input.
+    void apply_dRCGdF(const Matrix_9x9  &dAdRCG, const Matrix_3x3 &F, Matrix_9x9  &dAdF);
+
+    void apply_dRCGdF(const Matrix_27x9 &dAdRCG, const Matrix_3x3 &F, Matrix_27x9 &dAdF);
+
+    void apply_dPsidF(const Matrix_9x9  &dAdPsi, const Matrix_3x3 &chi, Matrix_9x9  &dAdF);
+
+    void apply_dPsidF(const Matrix_27x9 &dAdPsi, const Matrix_3x3 &chi, Matrix_27x9 &dAdF);
+
+    void apply_dPsidchi(const Matrix_9x9  &dAdPsi, const Matrix_3x3 &F, Matrix_9x9  &dAdchi);
+
+    void apply_dPsidchi(const Matrix_27x9 &dAdPsi, const Matrix_3x3 &F, Matrix_27x9 &dAdchi);
+
+    void apply_dGammadF(const Matrix_9x27  &dAdGamma, const Vector_27 &grad_chi, Matrix_9x9  &dAdF);
+
+    void apply_dGammadF(const Matrix_27x27 &dAdGamma, const Vector_27 &grad_chi, Matrix_27x9 &dAdF);
+
+    void apply_dGammadgrad_chi(const Matrix_9x27  &dAdGamma, const Matrix_3x3 &F, Matrix_9x27  &dAdgrad_chi);
+
+    void apply_dGammadgrad_chi(const Matrix_27x27 &dAdGamma, const Matrix_3x3 &F, Matrix_27x27 &dAdgrad_chi);
+
+    void apply_dgrad_chidgrad_phi(const Matrix_9x27  &dAdgrad_chi, const Matrix_3x3 &F, Matrix_9x27  &dAdgrad_phi);
+
+    void apply_dgrad_chidgrad_phi(const Matrix_27x27 &dAdgrad_chi, const Matrix_3x3 &F, Matrix_27x27 &dAdgrad_phi);
+
+    void apply_dgrad_chidF(const Matrix_9x27  &dAdgrad_chi, const Vector_27 &grad_phi, Matrix_9x9  &dAdF);
+
+    void apply_dgrad_chidF(const Matrix_27x27 &dAdgrad_chi, const Vector_27 &grad_phi, Matrix_27x9 &dAdF);
+
     void compute_dFdgrad_u(const Matrix_3x3 &F, Matrix_9x9 &dFdgrad_u);
     
     void compute_dAinvdA(const Matrix_3x3 &A, Matrix_9x9 &dAinvdA);
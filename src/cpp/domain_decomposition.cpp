@@ -0,0 +1,617 @@
+/*!=======================================================
+  |                                                     |
+  |              domain_decomposition.cpp               |
+  |                                                     |
+  -------------------------------------------------------
+  | The partitioning of the elements of the finite      |
+  | element model between MPI ranks and the exchange of |
+  | the values at the nodes shared between the ranks.   |
+  =======================================================
+  | Dependencies:                                       |
+  | MPI: (optional) Any implementation of the MPI       |
+  |      standard e.g. Open MPI or MPICH                |
+  =======================================================*/
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <domain_decomposition.h>
+
+namespace domain_decomposition{
+
+    struct PointComparison{
+        /*!Order the points along an axis with ties broken by the
+        point number so that the partition does not depend on the
+        implementation of the selection algorithm*/
+
+        const std::vector< std::array< double, 3 > > *points; //!The points
+        unsigned int axis;                                     //!The axis along which the points are ordered
+
+        bool operator()(const unsigned int &a, const unsigned int &b) const{
+            if((*points)[a][axis]!=(*points)[b][axis]){return (*points)[a][axis]<(*points)[b][axis];}
+            return a<b;
+        }
+    };
+
+    static void bisect(const std::vector< std::array< double, 3 > > &points,
+                       std::vector< unsigned int >::iterator begin, std::vector< unsigned int >::iterator end,
+                       const unsigned int &nparts, const unsigned int &first_part, std::vector< unsigned int > &parts){
+        /*!================
+        |    bisect    |
+        ================
+
+        Split the points between begin and end into
+        nparts parts numbered from first_part by
+        recursively bisecting them normal to the
+        longest side of their bounding box. The
+        number of points in each half is proportional
+        to the number of parts assigned to it.
+
+        */
+
+        if((nparts<=1) || (end-begin<=1)){
+            for(std::vector< unsigned int >::iterator it=begin; it!=end; it++){parts[*it] = first_part;}
+            return;
+        }
+
+        //Find the longest side of the bounding box
+        std::array< double, 3 > lower = points[*begin];
+        std::array< double, 3 > upper = points[*begin];
+        for(std::vector< unsigned int >::iterator it=begin; it!=end; it++){
+            for(int i=0; i<3; i++){
+                lower[i] = std::min(lower[i],points[*it][i]);
+                upper[i] = std::max(upper[i],points[*it][i]);
+            }
+        }
+
+        PointComparison comparison;
+        comparison.points = &points;
+        comparison.axis   = 0;
+        for(int i=1; i<3; i++){
+            if((upper[i]-lower[i])>(upper[comparison.axis]-lower[comparison.axis])){comparison.axis = i;}
+        }
+
+        //Split the points in proportion to the number of parts on each side
+        unsigned int nlower = nparts/2;
+        std::vector< unsigned int >::iterator split = begin + ((end-begin)*nlower)/nparts;
+
+        std::nth_element(begin, split, end, comparison);
+
+        bisect(points, begin, split, nlower, first_part, parts);
+        bisect(points, split, end, nparts-nlower, first_part+nlower, parts);
+    }
+
+    std::vector< unsigned int > recursive_coordinate_bisection(const std::vector< std::array< double, 3 > > &points, const unsigned int &nparts){
+        /*!========================================
+        |    recursive_coordinate_bisection    |
+        ========================================
+
+        Partition the points into nparts parts of
+        (nearly) equal size by recursive coordinate
+        bisection.
+
+        input:
+            points: The points to partition e.g. the element centroids
+            nparts: The number of parts
+
+        returns:
+            The part of each point
+
+        */
+
+        std::vector< unsigned int > parts(points.size(),0);
+        std::vector< unsigned int > order(points.size(),0);
+        for(unsigned int i=0; i<order.size(); i++){order[i] = i;}
+
+        bisect(points, order.begin(), order.end(), std::max(nparts,(unsigned int)1), 0, parts);
+
+        return parts;
+    }
+
+    static unsigned int level_structure(const std::vector< std::vector< unsigned int > > &adjacency, const unsigned int &start,
+                                        std::vector< unsigned int > &level, const unsigned int &stamp,
+                                        std::vector< unsigned int > &last_level){
+        /*!=========================
+        |    level_structure    |
+        =========================
+
+        Form the breadth first level structure of the
+        connected component of start. Nodes are marked
+        as reached by setting level to stamp plus their
+        depth so the workspace does not need to be reset
+        between calls with increasing stamps.
+
+        returns:
+            The depth of the level structure. The nodes of
+            the deepest level are returned in last_level.
+
+        */
+
+        std::vector< unsigned int > current(1,start);
+        std::vector< unsigned int > next;
+        unsigned int depth = 0;
+
+        level[start] = stamp;
+
+        while(true){
+            next.clear();
+            for(unsigned int i=0; i<current.size(); i++){
+                for(unsigned int j=0; j<adjacency[current[i]].size(); j++){
+                    unsigned int m = adjacency[current[i]][j];
+                    if(level[m]<stamp){
+                        level[m] = stamp+depth+1;
+                        next.push_back(m);
+                    }
+                }
+            }
+            if(next.size()==0){break;}
+            current.swap(next);
+            depth++;
+        }
+
+        last_level = current;
+        return depth;
+    }
+
+    std::vector< unsigned int > reverse_cuthill_mckee(const std::vector< std::vector< unsigned int > > &adjacency){
+        /*!===============================
+        |    reverse_cuthill_mckee    |
+        ===============================
+
+        Order the nodes of a graph to reduce the
+        bandwidth of its adjacency matrix. Each
+        connected component is traversed breadth
+        first from a pseudo-peripheral node visiting
+        the neighbors in order of increasing degree
+        and the resulting Cuthill-McKee order is
+        reversed.
+
+        input:
+            adjacency: The neighbors of each node (not including the node)
+
+        returns:
+            The order of the nodes i.e. the original
+            number of the node at each new position
+
+        */
+
+        const unsigned int n = adjacency.size();
+
+        std::vector< unsigned int > order;
+        order.reserve(n);
+
+        std::vector< bool > numbered(n,false);
+        std::vector< unsigned int > level(n,0);  //!The level structure workspace
+        std::vector< unsigned int > last_level;
+        unsigned int stamp = 1;
+
+        std::vector< unsigned int > by_degree(n);
+        for(unsigned int i=0; i<n; i++){by_degree[i] = i;}
+        std::stable_sort(by_degree.begin(), by_degree.end(),
+                         [&adjacency](const unsigned int &a, const unsigned int &b){return adjacency[a].size()<adjacency[b].size();});
+
+        std::vector< unsigned int > neighbors;
+
+        for(unsigned int k=0; k<n; k++){
+            unsigned int start = by_degree[k];
+            if(numbered[start]){continue;}
+
+            //Find a pseudo-peripheral node of the component (George and Liu)
+            unsigned int depth = level_structure(adjacency, start, level, stamp, last_level);
+            stamp += n+1;
+            while(true){
+                unsigned int candidate = last_level[0];
+                for(unsigned int i=1; i<last_level.size(); i++){
+                    if(adjacency[last_level[i]].size()<adjacency[candidate].size()){candidate = last_level[i];}
+                }
+                unsigned int candidate_depth = level_structure(adjacency, candidate, level, stamp, last_level);
+                stamp += n+1;
+                if(candidate_depth<=depth){break;}
+                start = candidate;
+                depth = candidate_depth;
+            }
+
+            //Cuthill-McKee traversal of the component
+            unsigned int head = order.size();
+            order.push_back(start);
+            numbered[start] = true;
+            while(head<order.size()){
+                unsigned int current = order[head];
+                head++;
+
+                neighbors.clear();
+                for(unsigned int j=0; j<adjacency[current].size(); j++){
+                    if(!numbered[adjacency[current][j]]){
+                        neighbors.push_back(adjacency[current][j]);
+                        numbered[adjacency[current][j]] = true;
+                    }
+                }
+                std::sort(neighbors.begin(), neighbors.end(),
+                          [&adjacency](const unsigned int &a, const unsigned int &b){
+                              if(adjacency[a].size()!=adjacency[b].size()){return adjacency[a].size()<adjacency[b].size();}
+                              return a<b;
+                          });
+                order.insert(order.end(), neighbors.begin(), neighbors.end());
+            }
+        }
+
+        std::reverse(order.begin(), order.end());
+
+        return order;
+    }
+
+    static uint64_t spread_bits(uint64_t x){
+        /*!Spread the lowest 21 bits of x so that there are two zero bits between each of them*/
+        x &= 0x1fffff;
+        x = (x | (x << 32)) & 0x1f00000000ffffULL;
+        x = (x | (x << 16)) & 0x1f0000ff0000ffULL;
+        x = (x | (x <<  8)) & 0x100f00f00f00f00fULL;
+        x = (x | (x <<  4)) & 0x10c30c30c30c30c3ULL;
+        x = (x | (x <<  2)) & 0x1249249249249249ULL;
+        return x;
+    }
+
+    std::vector< unsigned int > morton_order(const std::vector< std::array< double, 3 > > &points){
+        /*!======================
+        |    morton_order    |
+        ======================
+
+        Order the points along a Morton (Z-order)
+        space filling curve through their bounding
+        box. Points which are close in the order are
+        close in space.
+
+        input:
+            points: The points to order e.g. the nodal coordinates
+
+        returns:
+            The order of the points i.e. the original
+            number of the point at each new position
+
+        */
+
+        std::vector< unsigned int > order(points.size());
+        for(unsigned int i=0; i<order.size(); i++){order[i] = i;}
+        if(points.size()==0){return order;}
+
+        std::array< double, 3 > lower = points[0];
+        std::array< double, 3 > upper = points[0];
+        for(unsigned int p=0; p<points.size(); p++){
+            for(int i=0; i<3; i++){
+                lower[i] = std::min(lower[i],points[p][i]);
+                upper[i] = std::max(upper[i],points[p][i]);
+            }
+        }
+
+        //Quantize the coordinates on a common scale so the cells of the curve are cubes
+        double extent = std::max(upper[0]-lower[0], std::max(upper[1]-lower[1], upper[2]-lower[2]));
+        double scale  = (extent>0) ? 2097151./extent : 0.;
+
+        std::vector< uint64_t > keys(points.size());
+        for(unsigned int p=0; p<points.size(); p++){
+            uint64_t key = 0;
+            for(int i=0; i<3; i++){
+                key |= spread_bits((uint64_t)((points[p][i]-lower[i])*scale)) << i;
+            }
+            keys[p] = key;
+        }
+
+        std::sort(order.begin(), order.end(),
+                  [&keys](const unsigned int &a, const unsigned int &b){
+                      if(keys[a]!=keys[b]){return keys[a]<keys[b];}
+                      return a<b;
+                  });
+
+        return order;
+    }
+
+    unsigned int bandwidth(const std::vector< std::vector< unsigned int > > &adjacency, const std::vector< unsigned int > &order){
+        /*!===================
+        |    bandwidth    |
+        ===================
+
+        Compute the bandwidth of the adjacency
+        matrix of a graph with the nodes numbered
+        in the given order.
+
+        */
+
+        std::vector< unsigned int > position(order.size());
+        for(unsigned int i=0; i<order.size(); i++){position[order[i]] = i;}
+
+        unsigned int result = 0;
+        for(unsigned int a=0; a<adjacency.size(); a++){
+            for(unsigned int j=0; j<adjacency[a].size(); j++){
+                unsigned int b = adjacency[a][j];
+                result = std::max(result, (position[a]>position[b]) ? position[a]-position[b] : position[b]-position[a]);
+            }
+        }
+
+        return result;
+    }
+
+    Decomposition::Decomposition(){
+        /*!Default constructor (a single rank)*/
+    }
+
+    Decomposition::Decomposition(unsigned int _rank, unsigned int _size){
+        /*!Full constructor*/
+        rank = _rank;
+        size = _size;
+
+        if(rank>=size){
+            std::cout << "Error: Rank " << rank << " is not less than the number of ranks " << size << "\n";
+            assert(1==0);
+        }
+    }
+
+    void Decomposition::build(const std::vector< std::array< double, 3 > > &centroids,
+                              const std::vector< std::vector< unsigned int > > &element_nodes,
+                              const unsigned int &num_nodes){
+        /*!===============
+        |    build    |
+        ===============
+
+        Partition the elements, assign the owners of
+        the nodes and form the lists of the nodes
+        exchanged with each neighboring rank. Every
+        rank builds the same partition from the
+        complete mesh so no communication is required.
+
+        input:
+            centroids:     The centroid of each element
+            element_nodes: The (internal) node numbers of each element
+            num_nodes:     The number of nodes in the mesh
+
+        */
+
+        element_rank = recursive_coordinate_bisection(centroids, size);
+
+        //Collect the ranks which integrate an element of each node
+        std::vector< std::vector< unsigned int > > node_ranks(num_nodes);
+        for(unsigned int e=0; e<element_nodes.size(); e++){
+            for(unsigned int n=0; n<element_nodes[e].size(); n++){
+                std::vector< unsigned int > &ranks = node_ranks[element_nodes[e][n]];
+                if(std::find(ranks.begin(), ranks.end(), element_rank[e])==ranks.end()){
+                    ranks.push_back(element_rank[e]);
+                }
+            }
+        }
+
+        //The lowest rank owns the node (nodes without elements are owned by rank 0)
+        node_owner = std::vector< unsigned int >(num_nodes,0);
+        for(unsigned int n=0; n<num_nodes; n++){
+            if(node_ranks[n].size()>0){
+                node_owner[n] = *std::min_element(node_ranks[n].begin(), node_ranks[n].end());
+            }
+        }
+
+        //Form the exchange lists in ascending node order
+        std::vector< std::vector< unsigned int > > rank_send_nodes(size);
+        std::vector< std::vector< unsigned int > > rank_recv_nodes(size);
+        for(unsigned int n=0; n<num_nodes; n++){
+            bool touched = std::find(node_ranks[n].begin(), node_ranks[n].end(), rank)!=node_ranks[n].end();
+            if(owns_node(n)){
+                for(unsigned int i=0; i<node_ranks[n].size(); i++){
+                    if(node_ranks[n][i]!=rank){rank_send_nodes[node_ranks[n][i]].push_back(n);}
+                }
+            }
+            else if(touched){
+                rank_recv_nodes[node_owner[n]].push_back(n);
+            }
+        }
+
+        neighbors.clear();
+        send_nodes.clear();
+        recv_nodes.clear();
+        for(unsigned int r=0; r<size; r++){
+            if((rank_send_nodes[r].size()>0) || (rank_recv_nodes[r].size()>0)){
+                neighbors.push_back(r);
+                send_nodes.push_back(rank_send_nodes[r]);
+                recv_nodes.push_back(rank_recv_nodes[r]);
+            }
+        }
+    }
+
+    #ifdef MICROMORPHIC_MPI
+    static void exchange(const std::vector< unsigned int > &neighbors,
+                         const std::vector< std::vector< unsigned int > > &pack_nodes,
+                         const std::vector< std::vector< unsigned int > > &unpack_nodes,
+                         const std::vector< double > &values, const unsigned int &stride, const int &tag,
+                         std::vector< std::vector< double > > &buffers){
+        /*!==================
+        |    exchange    |
+        ==================
+
+        Send the values of pack_nodes to each neighbor
+        and receive the values of its unpack_nodes into
+        buffers.
+
+        */
+
+        std::vector< std::vector< double > > send_buffers(neighbors.size());
+        std::vector< MPI_Request > requests(2*neighbors.size());
+
+        buffers.resize(neighbors.size());
+        for(unsigned int i=0; i<neighbors.size(); i++){
+            buffers[i].resize(unpack_nodes[i].size()*stride);
+            MPI_Irecv(buffers[i].data(), buffers[i].size(), MPI_DOUBLE, neighbors[i], tag, MPI_COMM_WORLD, &requests[i]);
+        }
+
+        for(unsigned int i=0; i<neighbors.size(); i++){
+            send_buffers[i].resize(pack_nodes[i].size()*stride);
+            for(unsigned int j=0; j<pack_nodes[i].size(); j++){
+                for(unsigned int k=0; k<stride; k++){
+                    send_buffers[i][k+j*stride] = values[k+pack_nodes[i][j]*stride];
+                }
+            }
+            MPI_Isend(send_buffers[i].data(), send_buffers[i].size(), MPI_DOUBLE, neighbors[i], tag, MPI_COMM_WORLD, &requests[neighbors.size()+i]);
+        }
+
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+    #endif
+
+    void Decomposition::update_ghosts(std::vector< double > &values, const unsigned int &stride) const{
+        /*!=======================
+        |    update_ghosts    |
+        =======================
+
+        Copy the values of the owned nodes to the
+        ghost copies held by the neighboring ranks.
+
+        input:
+            values: The node-major values of all of the nodes
+            stride: The number of values at each node
+
+        */
+
+        if(neighbors.size()==0){return;}
+
+        #ifdef MICROMORPHIC_MPI
+        std::vector< std::vector< double > > buffers;
+        exchange(neighbors, send_nodes, recv_nodes, values, stride, 1, buffers);
+
+        for(unsigned int i=0; i<neighbors.size(); i++){
+            for(unsigned int j=0; j<recv_nodes[i].size(); j++){
+                for(unsigned int k=0; k<stride; k++){
+                    values[k+recv_nodes[i][j]*stride] = buffers[i][k+j*stride];
+                }
+            }
+        }
+        #else
+        std::cout << "Error: The decomposition has neighboring ranks but MPI is not enabled.\n"
+                  << "       Compile with -DMICROMORPHIC_MPI\n";
+        assert(1==0);
+        #endif
+    }
+
+    void Decomposition::accumulate_ghosts(std::vector< double > &values, const unsigned int &stride) const{
+        /*!===========================
+        |    accumulate_ghosts    |
+        ===========================
+
+        Add the values of the ghost nodes to the
+        values of their owners. The contributions
+        are added in ascending rank order so the
+        result does not depend on the order in which
+        the messages arrive. The values of the ghost
+        nodes are not modified.
+
+        input:
+            values: The node-major values of all of the nodes
+            stride: The number of values at each node
+
+        */
+
+        if(neighbors.size()==0){return;}
+
+        #ifdef MICROMORPHIC_MPI
+        std::vector< std::vector< double > > buffers;
+        exchange(neighbors, recv_nodes, send_nodes, values, stride, 2, buffers);
+
+        for(unsigned int i=0; i<neighbors.size(); i++){
+            for(unsigned int j=0; j<send_nodes[i].size(); j++){
+                for(unsigned int k=0; k<stride; k++){
+                    values[k+send_nodes[i][j]*stride] += buffers[i][k+j*stride];
+                }
+            }
+        }
+        #else
+        std::cout << "Error: The decomposition has neighboring ranks but MPI is not enabled.\n"
+                  << "       Compile with -DMICROMORPHIC_MPI\n";
+        assert(1==0);
+        #endif
+    }
+
+    void Decomposition::gather(std::vector< double > &values, const unsigned int &stride) const{
+        /*!================
+        |    gather    |
+        ================
+
+        Set the values of every node on every rank
+        to the values held by its owner.
+
+        input:
+            values: The node-major values of all of the nodes
+            stride: The number of values at each node
+
+        */
+
+        if(size==1){return;}
+
+        #ifdef MICROMORPHIC_MPI
+        std::vector< double > owned_values(values.size(),0.);
+        for(unsigned int n=0; n<node_owner.size(); n++){
+            if(owns_node(n)){
+                for(unsigned int k=0; k<stride; k++){owned_values[k+n*stride] = values[k+n*stride];}
+            }
+        }
+        MPI_Allreduce(owned_values.data(), values.data(), values.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        #endif
+    }
+
+    void Decomposition::sum(double *values, const unsigned int &n) const{
+        /*!=============
+        |    sum    |
+        =============
+
+        Replace the n values with their sum over
+        all of the ranks.
+
+        */
+
+        if(size==1){return;}
+
+        #ifdef MICROMORPHIC_MPI
+        MPI_Allreduce(MPI_IN_PLACE, values, n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        #endif
+    }
+
+    void Decomposition::maximum(double *values, const unsigned int &n) const{
+        /*!=================
+        |    maximum    |
+        =================
+
+        Replace the n values with their maximum over
+        all of the ranks.
+
+        */
+
+        if(size==1){return;}
+
+        #ifdef MICROMORPHIC_MPI
+        MPI_Allreduce(MPI_IN_PLACE, values, n, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        #endif
+    }
+
+    Decomposition world_decomposition(){
+        /*!=============================
+        |    world_decomposition    |
+        =============================
+
+        Construct the (unbuilt) decomposition of
+        all of the ranks of MPI_COMM_WORLD. A single
+        rank is used if MPI is not enabled or has
+        not been initialized.
+
+        */
+
+        #ifdef MICROMORPHIC_MPI
+        int initialized = 0;
+        MPI_Initialized(&initialized);
+        if(initialized){
+            int rank;
+            int size;
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+            MPI_Comm_size(MPI_COMM_WORLD, &size);
+            return Decomposition(rank, size);
+        }
+        #endif
+
+        return Decomposition();
+    }
+}
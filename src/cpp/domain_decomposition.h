@@ -0,0 +1,117 @@
+/*!=======================================================
+  |                                                     |
+  |               domain_decomposition.h                |
+  |                                                     |
+  -------------------------------------------------------
+  | The partitioning of the elements of the finite      |
+  | element model between MPI ranks and the exchange of |
+  | the values at the nodes shared between the ranks.   |
+  |                                                     |
+  | The elements are partitioned by recursive           |
+  | coordinate bisection of their centroids. Every node |
+  | is owned by the lowest rank which integrates one of |
+  | its elements. The other ranks which integrate an    |
+  | element of the node hold a ghost copy of its values.|
+  |                                                     |
+  | The locality preserving orderings of the nodes      |
+  | (reverse Cuthill-McKee and a Morton space filling   |
+  | curve) used to renumber the mesh are also defined.  |
+  |                                                     |
+  | The MPI communication is only compiled if           |
+  | MICROMORPHIC_MPI is defined. Otherwise there is a   |
+  | single rank and all of the exchanges are empty.     |
+  =======================================================
+  | Dependencies:                                       |
+  | MPI: (optional) Any implementation of the MPI       |
+  |      standard e.g. Open MPI or MPICH                |
+  =======================================================*/
+
+#ifndef DOMAIN_DECOMPOSITION_H
+#define DOMAIN_DECOMPOSITION_H
+
+#include <iostream>
+#include <vector>
+#include <array>
+
+#ifdef MICROMORPHIC_MPI
+#include <mpi.h>
+#endif
+
+namespace domain_decomposition{
+
+    std::vector< unsigned int > recursive_coordinate_bisection(const std::vector< std::array< double, 3 > > &points, const unsigned int &nparts);
+
+    std::vector< unsigned int > reverse_cuthill_mckee(const std::vector< std::vector< unsigned int > > &adjacency);
+
+    std::vector< unsigned int > morton_order(const std::vector< std::array< double, 3 > > &points);
+
+    unsigned int bandwidth(const std::vector< std::vector< unsigned int > > &adjacency, const std::vector< unsigned int > &order);
+
+    class Decomposition{
+        /*!===
+           |
+           | D e c o m p o s i t i o n
+           |
+          ===
+
+            The partition of the elements and the nodes
+            of a mesh between the ranks and the lists
+            of the nodes exchanged with each of the
+            neighboring ranks.
+
+            Nodal values are stored node-major with a
+            fixed stride so the same exchange is used
+            for the degree of freedom vectors (stride
+            node_dof) and the nodal blocks of the
+            jacobian (stride node_dof*node_dof).
+
+        */
+
+        public:
+            unsigned int rank = 0;                                  //!The rank of this process
+            unsigned int size = 1;                                  //!The number of ranks
+
+            std::vector< unsigned int > element_rank;               //!The rank which integrates each element
+            std::vector< unsigned int > node_owner;                 //!The rank which owns each node
+
+            std::vector< unsigned int > neighbors;                  //!The ranks which share nodes with this rank (ascending)
+            std::vector< std::vector< unsigned int > > send_nodes;  //!The owned nodes which each neighbor holds as ghosts (ascending)
+            std::vector< std::vector< unsigned int > > recv_nodes;  //!The ghost nodes owned by each neighbor (ascending)
+
+            //!|=> Constructors
+
+            Decomposition();
+
+            Decomposition(unsigned int _rank, unsigned int _size);
+
+            //!|=> Methods
+
+            void build(const std::vector< std::array< double, 3 > > &centroids,
+                       const std::vector< std::vector< unsigned int > > &element_nodes,
+                       const unsigned int &num_nodes);
+
+            bool owns_node(const unsigned int &n) const{
+                /*!Check if the node is owned by this rank*/
+                return node_owner[n]==rank;
+            }
+
+            bool owns_element(const unsigned int &e) const{
+                /*!Check if the element is integrated by this rank*/
+                return element_rank[e]==rank;
+            }
+
+            void update_ghosts(std::vector< double > &values, const unsigned int &stride) const;
+
+            void accumulate_ghosts(std::vector< double > &values, const unsigned int &stride) const;
+
+            void gather(std::vector< double > &values, const unsigned int &stride) const;
+
+            void sum(double *values, const unsigned int &n) const;
+
+            void maximum(double *values, const unsigned int &n) const;
+    };
+
+    Decomposition world_decomposition();
+}
+
+#endif
@@ -32,13 +32,25 @@
 #include <string>
 #include <cstdlib>
 #include <vector>
+#include <sstream>
 #include <tensor.h>
 #include <micro_element.h>
 #include <tardigrade_micromorphic_linear_elasticity.h>
 #include <newton_krylov.h>
 #include <driver.h>
+#include <domain_decomposition.h>
+#include <instrumentation.h>
 #include <ctime>
+#include <chrono>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstddef>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 std::string trim(const std::string& str, const std::string& whitespace){
     /*!==============
@@ -181,6 +193,67 @@ NodeSet::NodeSet(std::string _name, std::vector< unsigned int> _nodes){
     nodes          = _nodes;
 }
 
+MappedFile::MappedFile(const std::string &filename){
+    /*!====================
+    |    MappedFile    |
+    ====================
+    
+    Map a file read only into memory.
+    
+    input:
+        filename: The name of the file to map
+    
+    */
+    
+    address = NULL;
+    length  = 0;
+    
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd<0){
+        std::cout << "Error: Could not open " << filename << "\n";
+        assert(1==0);
+    }
+    
+    struct stat file_stat;
+    if(fstat(fd, &file_stat)<0){
+        close(fd);
+        std::cout << "Error: Could not determine the size of " << filename << "\n";
+        assert(1==0);
+    }
+    
+    length = file_stat.st_size;
+    
+    if(length>0){
+        void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping==MAP_FAILED){
+            close(fd);
+            std::cout << "Error: Could not map " << filename << " into memory\n";
+            assert(1==0);
+        }
+        address = (const char*)mapping;
+    }
+    
+    //The mapping remains valid after the file is closed
+    close(fd);
+}
+
+MappedFile::~MappedFile(){
+    /*!Remove the mapping*/
+    if(address!=NULL){
+        munmap((void*)address, length);
+    }
+}
+
+const char* MappedFile::data() const{
+    /*!Return the start of the mapping*/
+    return address;
+}
+
+size_t MappedFile::size() const{
+    /*!Return the length of the mapping in bytes*/
+    return length;
+}
+
 std::vector< double > mms_const_u(std::array< double, 3 > coords, double t){
     /*!=====================
     |    mms_const_u    |
@@ -237,10 +310,7 @@ InputParser::InputParser(){
     /*Default constructor*/
     filename    = "";
     keyword_fxn = &InputParser::default_function;
-    nodes.resize(0);
-    elements.resize(0);
     fprops.resize(0);
-    svars.resize(0);
     nodesets.resize(0);
 }
             
@@ -248,10 +318,7 @@ InputParser::InputParser(std::string _filename){
     filename     = _filename;
     path_to_file = filename.substr(0,filename.find_last_of("/\\"));
     keyword_fxn  = &InputParser::default_function;
-    nodes.resize(0);
-    elements.resize(0);
     fprops.resize(0);
-    svars.resize(0);
     nodesets.resize(0);
 }
 
@@ -265,24 +332,106 @@ void InputParser::read_input(){
     ====================
     
     Read the input file (filename) and parse the 
-    information into the class structure.
+    information into the class structure. Binary 
+    input decks are identified by their header and 
+    are memory mapped rather than parsed. The input 
+    deck embedded in a checkpoint is read in the 
+    same way and restart is set so that FEAModel 
+    restores the state of the checkpoint.
     
     */
     
+    MICROMORPHIC_TIME_SCOPE("io read input");
+    
     std::cout << "\n=================================================\n"<<
                    "|                                               |\n"<<
                    "|                  INPUT PARSER                 |\n"<<
                    "|                                               |\n"<<
                    "=================================================\n";
     
+    //Read in the input deck
+    std::cout << "Reading data from " << filename << "\n";
+    
+    if(is_checkpoint_input()){
+        read_checkpoint_input();
+    }
+    else if(is_binary_input()){
+        read_binary_input();
+    }
+    else{
+        read_text_input();
+    }
+    
+    std::cout << "\n=================================================\n"<<
+                   "|                                               |\n"<<
+                   "|             INPUT PARSER COMPLETED            |\n"<<
+                   "|                                               |\n"<<
+                   "=================================================\n";
+    return;
+}
+
+static bool starts_with_magic(const std::string &filename, const char (&identifier)[8]){
+    /*!===========================
+    |    starts_with_magic    |
+    ===========================
+    
+    Check if a file starts with the identifier 
+    of one of the binary formats.
+    
+    input:
+        filename:   The name of the file
+        identifier: The identifier of the format
+    
+    */
+    
+    char magic[sizeof(identifier)];
+    
+    std::ifstream f(filename, std::ios::binary);
+    if(!f.read(magic, sizeof(magic))){return false;}
+    
+    return std::equal(magic, magic + sizeof(magic), identifier);
+}
+    
+bool InputParser::is_binary_input(){
+    /*!=========================
+    |    is_binary_input    |
+    =========================
+    
+    Check if the input file starts with the 
+    binary input deck identifier.
+    
+    */
+    
+    return starts_with_magic(filename, binary_mesh_magic);
+}
+
+bool InputParser::is_checkpoint_input(){
+    /*!=============================
+    |    is_checkpoint_input    |
+    =============================
+    
+    Check if the input file starts with the 
+    checkpoint identifier.
+    
+    */
+    
+    return starts_with_magic(filename, checkpoint_magic);
+}
+
+void InputParser::read_text_input(){
+    /*!=========================
+    |    read_text_input    |
+    =========================
+    
+    Read a keyword formatted input deck.
+    
+    */
+    
     //Initialize line string
     std::string line;
     //Initialize the line numbers
     unsigned int line_number=0;
     
-    //Read in the input deck
-    std::cout << "Reading data from " << filename << "\n";
-    
     //Open the file
     std::ifstream f(filename);
     
@@ -306,191 +455,606 @@ void InputParser::read_input(){
     //Close the file
     f.close();
     
-    std::cout << "\n=================================================\n"<<
-                   "|                                               |\n"<<
-                   "|             INPUT PARSER COMPLETED            |\n"<<
-                   "|                                               |\n"<<
-                   "=================================================\n";
+    //Hand the parsed nodes and elements to the views
+    nodes    = ArrayView< Node >(std::move(parsed_nodes));
+    elements = ArrayView< Element >(std::move(parsed_elements));
+    parsed_nodes.clear();
+    parsed_elements.clear();
+    
     return;
 }
 
-void InputParser::process_keyword(const unsigned int &line_number, std::string &line){
-    /*!=========================
-    |    process_keyword    |
-    =========================
+static const char* binary_section(const char *data, uint64_t size, const BinarySection &section, size_t entry_size, size_t alignment, const char *name){
+    /*!========================
+    |    binary_section    |
+    ========================
     
-    Process a line which has a keyword 
-    defined in it.
+    Return a pointer to a section of a binary 
+    input deck or checkpoint after checking that 
+    it lies within the file and is aligned for 
+    its entries.
+    
+    input:
+        data:       The start of the mapped file (eight byte aligned)
+        size:       The size of the mapped file in bytes
+        section:    The section description from the header
+        entry_size: The size of each entry in bytes
+        alignment:  The required alignment of the section
+        name:       The name of the section (used for error handling)
     
     */
     
-    if (line.find("*LATEX") != std::string::npos){
-        std::cout << "Keyword *LATEX found\n";
-        keyword_fxn = &InputParser::parse_latex;
-        line.erase(line.begin(), line.begin()+6);
-    }
-    else if (line.find("*NODES") != std::string::npos){
-        std::cout << "Keyword *NODES found\n";
-        keyword_fxn = &InputParser::parse_nodes;
-        line.erase(line.begin(), line.begin()+6);
-    }
-    else if (line.find("*DIRICHLET_BCS") != std::string::npos){
-        std::cout << "Keyword *DIRICHLET_BCS found\n";
-        std::cout << "Error: Not currently implemented.\n";
-        assert(1==0);
-    }
-    else if (line.find("*ELEMENTS") != std::string::npos){
-        std::cout << "Keyword *ELEMENTS found\n";
-        keyword_fxn = &InputParser::parse_elements;
-        line.erase(line.begin(), line.begin()+9);
-    }
-    else if (line.find("*PROPERTIES") != std::string::npos){
-        std::cout << "Keyword *PROPERTIES found\n";
-        keyword_fxn = &InputParser::parse_properties;
-        line.erase(line.begin(), line.begin()+11);
-    }
-    else if (line.find("*NSET") != std::string::npos){
-        std::cout << "Keyword *NSET found\n";
-        keyword_fxn = &InputParser::parse_nodesets;
-        line.erase(line.begin(), line.begin()+5);
-    }
-    else if (line.find("*MMS") != std::string::npos){
-        std::cout << "Keyword *MMS found\n";
-        keyword_fxn = &InputParser::parse_manufactured_solution;
-        line.erase(line.begin(), line.begin()+4);
-    }
-    else{
-        std::cout << "Error: Keyword not recognized\n";
+    if((section.offset%alignment != 0) || (section.offset > size) ||
+       (section.count > (size - section.offset)/entry_size)){
+        std::cout << "Error: The " << name << " section of the binary file is malformed.\n";
         assert(1==0);
     }
-    return;
+    
+    return data + section.offset;
 }
 
-void InputParser::default_function(unsigned int line_number, std::string line){
-    /*!==========================
-    |    default_function    |
-    ==========================
+static std::string binary_string(const std::string &strings, const BinaryString &string, const char *name){
+    /*!=======================
+    |    binary_string    |
+    =======================
     
-    The default function which executes if a 
-    line is read in prior to a keyword.
+    Return a string stored in the string 
+    section of a binary input deck.
+    
+    input:
+        strings: The string section
+        string:  The string description
+        name:    The name of the string (used for error handling)
     
     */
     
-    std::cout << "Warning: Line " << line_number << " is not associated\n"
-              << "         with a keyword. It will be ignored.\n";
-    return;
+    if((string.offset > strings.size()) || (string.length > strings.size() - string.offset)){
+        std::cout << "Error: The " << name << " string of the binary input deck is malformed.\n";
+        assert(1==0);
+    }
+    
+    return strings.substr(string.offset, string.length);
 }
 
-void InputParser::parse_latex(unsigned int line_number, std::string line){
-    /*!=====================
-    |    parse_latex    |
-    =====================
+//!The node and element sections are used in place so the classes 
+//!must have the layout described in driver.h
+static_assert(sizeof(Node)==32 && offsetof(Node,coordinates)==8, "Node does not match the binary input deck layout");
+static_assert(sizeof(Element)==36 && offsetof(Element,nodes)==4, "Element does not match the binary input deck layout");
+
+void InputParser::read_binary_input(){
+    /*!===========================
+    |    read_binary_input    |
+    ===========================
     
-    Parse the fine when triggered by a latex keyword
+    Read a binary input deck written by 
+    write_binary_input. The file is memory 
+    mapped and the nodes and elements are 
+    views of the mapping so they are not 
+    copied. The remaining (small) sections 
+    are copied into the class.
     
-    Appends the line whole to latex_string
+    */
     
-    input:
-        line_number: The number of the line (used primarily for error handling)
-        line:        The line read from the file
+    std::shared_ptr< MappedFile > file = std::make_shared< MappedFile >(filename);
+    read_binary_input(file, 0, file->size());
     
-    */
-    latex_string += line + "\n";
     return;
 }
 
-void InputParser::parse_nodes(unsigned int line_number, std::string line){
-    /*!=====================
-    |    parse_nodes    |
-    =====================
-    
-    Parse the fine when triggered by a node keyword
+void InputParser::read_binary_input(const std::shared_ptr< MappedFile > &file, uint64_t begin, uint64_t size){
+    /*!===========================
+    |    read_binary_input    |
+    ===========================
     
-    Appends a new node to the node vector
+    Read a binary input deck which occupies 
+    part of a mapped file (e.g. the mesh 
+    section of a checkpoint).
     
     input:
-        line_number: The number of the line (used primarily for error handling)
-        line:        The line read from the file
+        file:  The mapped file
+        begin: The offset of the input deck in the file (a multiple of eight)
+        size:  The size of the input deck in bytes
     
     */
     
-    //Initialize the split line
-    std::vector< std::string> split_line;
+    const char *deck = file->data() + begin;
     
-    //Check if the line has length
-    if(line.length()>0){
-        //Split the line at the commas
-        split_line =  split(line);
+    if(size < sizeof(BinaryMeshHeader)){
+        std::cout << "Error: The binary input deck is too small to contain a header.\n";
+        assert(1==0);
+    }
+    
+    BinaryMeshHeader header;
+    std::memcpy(&header, deck, sizeof(header));
+    
+    if(!std::equal(header.magic, header.magic + sizeof(header.magic), binary_mesh_magic)){
+        std::cout << "Error: The binary input deck does not start with the binary input deck identifier.\n";
+        assert(1==0);
+    }
+    
+    if(header.byte_order != binary_mesh_byte_order){
+        std::cout << "Error: The binary input deck was written with a different byte order.\n";
+        assert(1==0);
+    }
+    
+    if(header.version != binary_mesh_version){
+        std::cout << "Error: Binary input deck version " << header.version << " is not supported.\n";
+        assert(1==0);
+    }
+    
+    if(header.file_size != size){
+        std::cout << "Error: The binary input deck is truncated.\n";
+        assert(1==0);
+    }
+    
+    //Map the nodes and elements
+    const Node    *node_data    = (const Node*)binary_section(deck, size, header.nodes, sizeof(Node), 8, "node");
+    const Element *element_data = (const Element*)binary_section(deck, size, header.elements, sizeof(Element), 4, "element");
+    
+    nodes    = ArrayView< Node >(file, node_data, header.nodes.count);
+    elements = ArrayView< Element >(file, element_data, header.elements.count);
+    node_dof = header.node_dof;
+    
+    //Copy the properties
+    const char *fprop_data = binary_section(deck, size, header.fprops, sizeof(double), 8, "fprops");
+    const char *iprop_data = binary_section(deck, size, header.iprops, sizeof(int32_t), 4, "iprops");
+    
+    fprops.resize(header.fprops.count);
+    iprops.resize(header.iprops.count);
+    
+    for(unsigned int i=0; i<fprops.size(); i++){std::memcpy(&fprops[i], fprop_data + i*sizeof(double), sizeof(double));}
+    for(unsigned int i=0; i<iprops.size(); i++){
+        int32_t value;
+        std::memcpy(&value, iprop_data + i*sizeof(int32_t), sizeof(int32_t));
+        iprops[i] = value;
+    }
+    
+    //Copy the dirichlet boundary conditions
+    const char *dbc_data = binary_section(deck, size, header.dirichlet_bcs, sizeof(BinaryDirichletBC), 8, "dirichlet bc");
+    
+    dirichlet_bcs.resize(header.dirichlet_bcs.count);
+    for(unsigned int i=0; i<dirichlet_bcs.size(); i++){
+        BinaryDirichletBC dbc;
+        std::memcpy(&dbc, dbc_data + i*sizeof(BinaryDirichletBC), sizeof(BinaryDirichletBC));
+        dirichlet_bcs[i] = DirichletBC(dbc.node_number, dbc.dof_number, dbc.value);
+    }
+    
+    //Copy the strings
+    const char *string_data = binary_section(deck, size, header.strings, 1, 1, "string");
+    std::string strings(string_data, header.strings.count);
+    
+    latex_string  = binary_string(strings, header.latex, "latex");
+    mms_name      = binary_string(strings, header.mms_name, "manufactured solution");
+    solver        = binary_string(strings, header.solver, "solver");
+    node_ordering = binary_string(strings, header.node_ordering, "node ordering");
+    
+    quadrature_order      = header.quadrature_order;
+    hourglass_coefficient = header.hourglass_coefficient;
+    
+    //Copy the nodesets
+    const char     *nodeset_data      = binary_section(deck, size, header.nodesets, sizeof(BinaryNodeSet), 8, "nodeset");
+    const uint32_t *nodeset_node_data = (const uint32_t*)binary_section(deck, size, header.nodeset_nodes, sizeof(uint32_t), 4, "nodeset node");
+    
+    nodesets.resize(header.nodesets.count);
+    for(unsigned int i=0; i<nodesets.size(); i++){
+        BinaryNodeSet nodeset;
+        std::memcpy(&nodeset, nodeset_data + i*sizeof(BinaryNodeSet), sizeof(BinaryNodeSet));
         
-        if(split_line.size()==1){node_dof = std::strtoul(split_line[0].c_str(),NULL,10);} //Handle the case when the original line was *NODE,node_dof
-        else if(split_line.size()==4){
-            nodes.push_back(Node(std::strtoul(split_line[0].c_str(),NULL,10),
-                                 std::strtod( split_line[1].c_str(),NULL),
-                                 std::strtod( split_line[2].c_str(),NULL),
-                                 std::strtod( split_line[3].c_str(),NULL))); //Convert to uint and double and create a node
-        }
-        else{
-            std::cout << "Error: On line " << line_number << ", a node must be defined by its number,"<<
-                         "       followed by its x,y,z coordinates.\n";
+        if((nodeset.nodes_begin > header.nodeset_nodes.count) || (nodeset.nodes_count > header.nodeset_nodes.count - nodeset.nodes_begin)){
+            std::cout << "Error: Nodeset " << i << " of the binary input deck is malformed.\n";
             assert(1==0);
         }
         
-        if(verbose){
-            if(nodes.size()>0){
-                std::cout << "node number: " << nodes[nodes.size()-1].number;
-                std::cout << " coordinates: ";
-                for(int i=0; i<3; i++){std::cout << " " << nodes[nodes.size()-1].coordinates[i];}
-                std::cout << "\n";
-            }
-        } 
+        nodesets[i] = NodeSet(binary_string(strings, nodeset.name, "nodeset name"),
+                              std::vector< unsigned int >(nodeset_node_data + nodeset.nodes_begin,
+                                                          nodeset_node_data + nodeset.nodes_begin + nodeset.nodes_count));
+    }
+    
+    //Set the manufactured solution
+    mms_dirichlet_set_number = header.mms_dirichlet_set_number;
+    if(mms_name.length()>0){
+        set_manufactured_solution(0, mms_name);
     }
+    
+    std::cout << "Mapped " << nodes.size() << " nodes and " << elements.size() << " elements\n";
+    
     return;
 }
 
-void InputParser::parse_elements(unsigned int line_number, std::string line){
-    /*!========================
-    |    parse_elements    |
-    ========================
+static uint64_t align_binary_offset(uint64_t offset){
+    /*!=============================
+    |    align_binary_offset    |
+    =============================
     
-    Parse the fine when triggered by a element keyword
+    Round an offset up to a multiple of eight bytes.
     
-    Appends a new element to the element vector
+    */
+    
+    return (offset + 7) & ~((uint64_t)7);
+}
+
+void InputParser::write_binary_input(const std::string &binary_filename) const{
+    /*!============================
+    |    write_binary_input    |
+    ============================
+    
+    Write the input deck in the binary format 
+    described in driver.h so that it can be 
+    memory mapped by read_input.
     
     input:
-        line_number: The number of the line (used primarily for error handling)
-        line:        The line read from the file
+        binary_filename: The name of the file to write
     
     */
     
-    //Initialize the split line
-    std::vector< std::string> split_line;
+    MICROMORPHIC_TIME_SCOPE("io write binary input");
     
-    if(line.size()>0){ //Check if the line has useful information
-        
-        split_line = split(line); //Split the line
-        
-        //Only allow elements defined by the element number and eight nodes
-        if(split_line.size()<9){
-            std::cout << line;
+    std::ofstream f(binary_filename, std::ios::binary | std::ios::trunc);
+    if(!f.is_open()){
+        std::cout << "Error: Could not open " << binary_filename << " for writing\n";
+        assert(1==0);
+    }
+    
+    write_binary_input(f);
+    
+    f.close();
+    
+    std::cout << "Wrote " << nodes.size() << " nodes and " << elements.size() << " elements to " << binary_filename << "\n";
+    
+    return;
+}
+
+void InputParser::write_binary_input(std::ostream &f) const{
+    /*!============================
+    |    write_binary_input    |
+    ============================
+    
+    Write the input deck in the binary format 
+    to a stream. The stream is positioned at 
+    the start of the input deck which must be 
+    eight byte aligned in the file.
+    
+    input:
+        f: The stream to write to
+    
+    */
+    
+    //Collect the strings and the nodeset descriptions
+    std::string strings;
+    std::vector< BinaryNodeSet > binary_nodesets(nodesets.size());
+    std::vector< uint32_t >      nodeset_nodes;
+    
+    BinaryMeshHeader header;
+    std::memset(&header, 0, sizeof(header));
+    
+    header.latex.offset    = strings.size(); header.latex.length    = latex_string.size(); strings += latex_string;
+    header.mms_name.offset = strings.size(); header.mms_name.length = mms_name.size();     strings += mms_name;
+    header.solver.offset   = strings.size(); header.solver.length   = solver.size();       strings += solver;
+    header.node_ordering.offset = strings.size(); header.node_ordering.length = node_ordering.size(); strings += node_ordering;
+    
+    for(unsigned int i=0; i<nodesets.size(); i++){
+        binary_nodesets[i].name.offset = strings.size();
+        binary_nodesets[i].name.length = nodesets[i].name.size();
+        binary_nodesets[i].nodes_begin = nodeset_nodes.size();
+        binary_nodesets[i].nodes_count = nodesets[i].nodes.size();
+        
+        strings += nodesets[i].name;
+        nodeset_nodes.insert(nodeset_nodes.end(), nodesets[i].nodes.begin(), nodesets[i].nodes.end());
+    }
+    
+    std::vector< BinaryDirichletBC > binary_dbcs(dirichlet_bcs.size());
+    for(unsigned int i=0; i<dirichlet_bcs.size(); i++){
+        binary_dbcs[i].node_number = dirichlet_bcs[i].node_number;
+        binary_dbcs[i].dof_number  = dirichlet_bcs[i].dof_number;
+        binary_dbcs[i].value       = dirichlet_bcs[i].value;
+    }
+    
+    std::vector< int32_t > binary_iprops(iprops.begin(), iprops.end());
+    
+    //Lay out the sections
+    std::memcpy(header.magic, binary_mesh_magic, sizeof(binary_mesh_magic));
+    header.version                  = binary_mesh_version;
+    header.byte_order               = binary_mesh_byte_order;
+    header.node_dof                 = node_dof;
+    header.quadrature_order         = quadrature_order;
+    header.hourglass_coefficient    = hourglass_coefficient;
+    header.mms_dirichlet_set_number = mms_dirichlet_set_number;
+    
+    uint64_t offset = align_binary_offset(sizeof(BinaryMeshHeader));
+    
+    BinarySection *sections[8]     = {&header.nodes, &header.elements, &header.fprops, &header.iprops,
+                                      &header.dirichlet_bcs, &header.nodesets, &header.nodeset_nodes, &header.strings};
+    const char    *section_data[8] = {(const char*)nodes.data(), (const char*)elements.data(), (const char*)fprops.data(),
+                                      (const char*)binary_iprops.data(), (const char*)binary_dbcs.data(),
+                                      (const char*)binary_nodesets.data(), (const char*)nodeset_nodes.data(), strings.data()};
+    uint64_t       counts[8]       = {nodes.size(), elements.size(), fprops.size(), binary_iprops.size(),
+                                      binary_dbcs.size(), binary_nodesets.size(), nodeset_nodes.size(), strings.size()};
+    uint64_t       entry_sizes[8]  = {sizeof(Node), sizeof(Element), sizeof(double), sizeof(int32_t),
+                                      sizeof(BinaryDirichletBC), sizeof(BinaryNodeSet), sizeof(uint32_t), 1};
+    
+    for(int i=0; i<8; i++){
+        sections[i]->count  = counts[i];
+        sections[i]->offset = offset;
+        offset              = align_binary_offset(offset + counts[i]*entry_sizes[i]);
+    }
+    header.file_size = offset;
+    
+    //Write the input deck
+    const char padding[8] = {0,0,0,0,0,0,0,0};
+    uint64_t   position   = sizeof(header);
+    
+    f.write((const char*)&header, sizeof(header));
+    for(int i=0; i<8; i++){
+        f.write(padding, sections[i]->offset - position);
+        f.write(section_data[i], counts[i]*entry_sizes[i]);
+        position = sections[i]->offset + counts[i]*entry_sizes[i];
+    }
+    f.write(padding, header.file_size - position);
+    
+    return;
+}
+
+static CheckpointHeader checkpoint_header(const MappedFile &file, const std::string &filename){
+    /*!===========================
+    |    checkpoint_header    |
+    ===========================
+    
+    Return the header of a mapped checkpoint 
+    after checking that it was written in a 
+    compatible format and is complete.
+    
+    input:
+        file:     The mapped checkpoint
+        filename: The name of the checkpoint (used for error handling)
+    
+    */
+    
+    if(file.size() < sizeof(CheckpointHeader)){
+        std::cout << "Error: " << filename << " is too small to contain a checkpoint header.\n";
+        assert(1==0);
+    }
+    
+    CheckpointHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    
+    if(!std::equal(header.magic, header.magic + sizeof(header.magic), checkpoint_magic)){
+        std::cout << "Error: " << filename << " is not a checkpoint.\n";
+        assert(1==0);
+    }
+    
+    if(header.byte_order != binary_mesh_byte_order){
+        std::cout << "Error: The checkpoint " << filename << " was written with a different byte order.\n";
+        assert(1==0);
+    }
+    
+    if(header.version != checkpoint_version){
+        std::cout << "Error: Checkpoint version " << header.version << " is not supported.\n";
+        assert(1==0);
+    }
+    
+    if(header.file_size != file.size()){
+        std::cout << "Error: The checkpoint " << filename << " is truncated.\n";
+        assert(1==0);
+    }
+    
+    return header;
+}
+
+void InputParser::read_checkpoint_input(){
+    /*!===============================
+    |    read_checkpoint_input    |
+    ===============================
+    
+    Read the binary input deck embedded in a 
+    checkpoint written by FEAModel::write_checkpoint. 
+    The keyword input deck is not needed (or 
+    parsed) on restart.
+    
+    */
+    
+    std::shared_ptr< MappedFile > file = std::make_shared< MappedFile >(filename);
+    CheckpointHeader header = checkpoint_header(*file, filename);
+    
+    binary_section(file->data(), file->size(), header.mesh, 1, 8, "mesh");
+    read_binary_input(file, header.mesh.offset, header.mesh.count);
+    
+    restart = true;
+    
+    return;
+}
+
+void InputParser::process_keyword(const unsigned int &line_number, std::string &line){
+    /*!=========================
+    |    process_keyword    |
+    =========================
+    
+    Process a line which has a keyword 
+    defined in it.
+    
+    */
+    
+    if (line.find("*LATEX") != std::string::npos){
+        std::cout << "Keyword *LATEX found\n";
+        keyword_fxn = &InputParser::parse_latex;
+        line.erase(line.begin(), line.begin()+6);
+    }
+    else if (line.find("*NODES") != std::string::npos){
+        std::cout << "Keyword *NODES found\n";
+        keyword_fxn = &InputParser::parse_nodes;
+        line.erase(line.begin(), line.begin()+6);
+    }
+    else if (line.find("*DIRICHLET_BCS") != std::string::npos){
+        std::cout << "Keyword *DIRICHLET_BCS found\n";
+        std::cout << "Error: Not currently implemented.\n";
+        assert(1==0);
+    }
+    else if (line.find("*ELEMENTS") != std::string::npos){
+        std::cout << "Keyword *ELEMENTS found\n";
+        keyword_fxn = &InputParser::parse_elements;
+        line.erase(line.begin(), line.begin()+9);
+    }
+    else if (line.find("*PROPERTIES") != std::string::npos){
+        std::cout << "Keyword *PROPERTIES found\n";
+        keyword_fxn = &InputParser::parse_properties;
+        line.erase(line.begin(), line.begin()+11);
+    }
+    else if (line.find("*NSET") != std::string::npos){
+        std::cout << "Keyword *NSET found\n";
+        keyword_fxn = &InputParser::parse_nodesets;
+        line.erase(line.begin(), line.begin()+5);
+    }
+    else if (line.find("*MMS") != std::string::npos){
+        std::cout << "Keyword *MMS found\n";
+        keyword_fxn = &InputParser::parse_manufactured_solution;
+        line.erase(line.begin(), line.begin()+4);
+    }
+    else if (line.find("*SOLVER") != std::string::npos){
+        std::cout << "Keyword *SOLVER found\n";
+        keyword_fxn = &InputParser::parse_solver;
+        line.erase(line.begin(), line.begin()+7);
+    }
+    else if (line.find("*NODE_ORDERING") != std::string::npos){
+        std::cout << "Keyword *NODE_ORDERING found\n";
+        keyword_fxn = &InputParser::parse_node_ordering;
+        line.erase(line.begin(), line.begin()+14);
+    }
+    else if (line.find("*QUADRATURE") != std::string::npos){
+        std::cout << "Keyword *QUADRATURE found\n";
+        keyword_fxn = &InputParser::parse_quadrature;
+        line.erase(line.begin(), line.begin()+11);
+    }
+    else{
+        std::cout << "Error: Keyword not recognized\n";
+        assert(1==0);
+    }
+    return;
+}
+
+void InputParser::default_function(unsigned int line_number, std::string line){
+    /*!==========================
+    |    default_function    |
+    ==========================
+    
+    The default function which executes if a 
+    line is read in prior to a keyword.
+    
+    */
+    
+    std::cout << "Warning: Line " << line_number << " is not associated\n"
+              << "         with a keyword. It will be ignored.\n";
+    return;
+}
+
+void InputParser::parse_latex(unsigned int line_number, std::string line){
+    /*!=====================
+    |    parse_latex    |
+    =====================
+    
+    Parse the fine when triggered by a latex keyword
+    
+    Appends the line whole to latex_string
+    
+    input:
+        line_number: The number of the line (used primarily for error handling)
+        line:        The line read from the file
+    
+    */
+    latex_string += line + "\n";
+    return;
+}
+
+void InputParser::parse_nodes(unsigned int line_number, std::string line){
+    /*!=====================
+    |    parse_nodes    |
+    =====================
+    
+    Parse the fine when triggered by a node keyword
+    
+    Appends a new node to the node vector
+    
+    input:
+        line_number: The number of the line (used primarily for error handling)
+        line:        The line read from the file
+    
+    */
+    
+    //Initialize the split line
+    std::vector< std::string> split_line;
+    
+    //Check if the line has length
+    if(line.length()>0){
+        //Split the line at the commas
+        split_line =  split(line);
+        
+        if(split_line.size()==1){node_dof = std::strtoul(split_line[0].c_str(),NULL,10);} //Handle the case when the original line was *NODE,node_dof
+        else if(split_line.size()==4){
+            parsed_nodes.push_back(Node(std::strtoul(split_line[0].c_str(),NULL,10),
+                                        std::strtod( split_line[1].c_str(),NULL),
+                                        std::strtod( split_line[2].c_str(),NULL),
+                                        std::strtod( split_line[3].c_str(),NULL))); //Convert to uint and double and create a node
+        }
+        else{
+            std::cout << "Error: On line " << line_number << ", a node must be defined by its number,"<<
+                         "       followed by its x,y,z coordinates.\n";
+            assert(1==0);
+        }
+        
+        if(verbose){
+            if(parsed_nodes.size()>0){
+                std::cout << "node number: " << parsed_nodes[parsed_nodes.size()-1].number;
+                std::cout << " coordinates: ";
+                for(int i=0; i<3; i++){std::cout << " " << parsed_nodes[parsed_nodes.size()-1].coordinates[i];}
+                std::cout << "\n";
+            }
+        } 
+    }
+    return;
+}
+
+void InputParser::parse_elements(unsigned int line_number, std::string line){
+    /*!========================
+    |    parse_elements    |
+    ========================
+    
+    Parse the fine when triggered by a element keyword
+    
+    Appends a new element to the element vector
+    
+    input:
+        line_number: The number of the line (used primarily for error handling)
+        line:        The line read from the file
+    
+    */
+    
+    //Initialize the split line
+    std::vector< std::string> split_line;
+    
+    if(line.size()>0){ //Check if the line has useful information
+        
+        split_line = split(line); //Split the line
+        
+        //Only allow elements defined by the element number and eight nodes
+        if(split_line.size()<9){
+            std::cout << line;
             std::cout << "Error: On line " << line_number << ", an element must be defined by the number and 8 nodes.";
             assert(1==0);
         }
         else{
-            elements.push_back(Element(std::strtoul(split_line[0].c_str(),NULL,10),
-                                       std::strtoul(split_line[1].c_str(),NULL,10),
-                                       std::strtoul(split_line[2].c_str(),NULL,10),
-                                       std::strtoul(split_line[3].c_str(),NULL,10),
-                                       std::strtoul(split_line[4].c_str(),NULL,10),
-                                       std::strtoul(split_line[5].c_str(),NULL,10),
-                                       std::strtoul(split_line[6].c_str(),NULL,10),
-                                       std::strtoul(split_line[7].c_str(),NULL,10),
-                                       std::strtoul(split_line[8].c_str(),NULL,10)));
+            parsed_elements.push_back(Element(std::strtoul(split_line[0].c_str(),NULL,10),
+                                              std::strtoul(split_line[1].c_str(),NULL,10),
+                                              std::strtoul(split_line[2].c_str(),NULL,10),
+                                              std::strtoul(split_line[3].c_str(),NULL,10),
+                                              std::strtoul(split_line[4].c_str(),NULL,10),
+                                              std::strtoul(split_line[5].c_str(),NULL,10),
+                                              std::strtoul(split_line[6].c_str(),NULL,10),
+                                              std::strtoul(split_line[7].c_str(),NULL,10),
+                                              std::strtoul(split_line[8].c_str(),NULL,10)));
         }
         if(verbose){
-            if(elements.size()>0){
-                std::cout << "element number: " << elements[elements.size()-1].number;
+            if(parsed_elements.size()>0){
+                std::cout << "element number: " << parsed_elements[parsed_elements.size()-1].number;
                 std::cout << " nodes: ";
-                for(int i=0; i<8; i++){std::cout << " " << elements[elements.size()-1].nodes[i];}
+                for(int i=0; i<8; i++){std::cout << " " << parsed_elements[parsed_elements.size()-1].nodes[i];}
                     std::cout << "\n";
                 }
             }
@@ -605,15 +1169,7 @@ void InputParser::parse_manufactured_solution(unsigned int line_number, std::str
         
         if((split_line.size()==1) && (mms_fxn==NULL)){ //Try to find the manufactured solution function name
             fxn_name = trim(split_line[0]); //Remove white space
-            if(!fxn_name.compare("const_u")){mms_fxn = &mms_const_u;}
-            else if(!fxn_name.compare("linear_u")){mms_fxn = &mms_linear_u;}
-            else{
-                std::cout << "Error: On line " << line_number << ", Method of Manufactured Solutions function name not found.";
-                assert(1==0);
-            }
-            if(verbose){
-                std::cout << "Manufactured Solution Function: " << fxn_name << "\n";
-            }
+            set_manufactured_solution(line_number, fxn_name);
         }
         else if(split_line.size()<2){
             std::cout << "Error: On line " << line_number << ", the nodeset for the method of manufactured\n"<<
@@ -634,34 +1190,208 @@ void InputParser::parse_manufactured_solution(unsigned int line_number, std::str
     }
 }
 
-FEAModel::FEAModel(){
-    /*!Default constructor*/
-}
-    
-FEAModel::FEAModel(InputParser _input){
-    /*!The full constructor*/
+void InputParser::set_manufactured_solution(unsigned int line_number, const std::string &fxn_name){
+    /*!===================================
+    |    set_manufactured_solution    |
+    ===================================
     
-    std::cout << "=\n|=> Constructing FEA Model\n=\n";
+    Set the manufactured solution function 
+    from its name.
     
-    input = _input; //!Copy input
+    input:
+        line_number: The number of the line (used primarily for error handling)
+        fxn_name:    The name of the manufactured solution
     
-    //!Set the vector sizes
-    total_ndof = input.nodes.size()*input.node_dof;
-    up         = std::vector< double >(total_ndof,0.);
-    u          = std::vector< double >(total_ndof,0.);
-    du         = std::vector< double >(total_ndof,0.);
+    */
     
-    //!Initialize the size of the dirichlet boundary condition vector
-    dbcdof.resize(0);
+    if(!fxn_name.compare("const_u")){mms_fxn = &mms_const_u;}
+    else if(!fxn_name.compare("linear_u")){mms_fxn = &mms_linear_u;}
+    else{
+        std::cout << "Error: On line " << line_number << ", Method of Manufactured Solutions function name not found.";
+        assert(1==0);
+    }
+    mms_name = fxn_name;
+    
+    if(verbose){
+        std::cout << "Manufactured Solution Function: " << fxn_name << "\n";
+    }
+}
+
+void InputParser::parse_solver(unsigned int line_number, std::string line){
+    /*!======================
+    |    parse_solver    |
+    ======================
+    
+    Parse the line when triggered by a solver keyword
+    
+    Sets the solution technique. Options are:
+        NewtonKrylov:        Jacobian free Newton-Krylov (default)
+        NewtonKrylovTangent: Newton-Krylov where the matrix-vector products 
+                             use the element jacobians cached in the residual 
+                             evaluation
+        NewtonKrylovBlockJacobi, NewtonKrylovTangentBlockJacobi: 
+                             As above with GMRES right preconditioned by the 
+                             factored nodal blocks of the jacobian
+        NewtonDirect:        Newton-Raphson with a sparse direct (LU) solve
+        NewtonBiCGSTAB:      Newton-Raphson with an ILUT preconditioned BiCGSTAB solve
+                             (NewtonDirect and NewtonBiCGSTAB require a single rank)
+        ExplicitCentralDifference: 
+                             Explicit dynamics with the central difference method 
+                             and a lumped mass (no global matrix is formed)
+    
+    input:
+        line_number: The number of the line (used primarily for error handling)
+        line:        The line read from the file
+    
+    */
+    
+    line = trim(line);
+    
+    if(line.length()>0){
+        if((!line.compare("NewtonKrylov")) || (!line.compare("NewtonKrylovTangent")) ||
+           (!line.compare("NewtonKrylovBlockJacobi")) || (!line.compare("NewtonKrylovTangentBlockJacobi")) ||
+           (!line.compare("NewtonDirect")) || (!line.compare("NewtonBiCGSTAB")) ||
+           (!line.compare("ExplicitCentralDifference"))){
+            solver = line;
+        }
+        else{
+            std::cout << "Error: On line " << line_number << ", solver " << line << " not recognized.\n";
+            assert(1==0);
+        }
+        
+        if(verbose){
+            std::cout << "solver: " << solver << "\n";
+        }
+    }
+}
+
+void InputParser::parse_node_ordering(unsigned int line_number, std::string line){
+    /*!=============================
+    |    parse_node_ordering    |
+    =============================
+    
+    Parse the line when triggered by a node ordering keyword
+    
+    Sets the ordering of the internal nodes and hence 
+    of the degrees of freedom. The output is written 
+    in the order of the input deck for all of the 
+    orderings. Options are:
+        Input: The order of the nodes in the input deck (default)
+        RCM:   Reverse Cuthill-McKee ordering of the node connectivity 
+               which reduces the bandwidth of the jacobian
+        SFC:   The order of the nodes along a Morton space filling curve
+    
+    input:
+        line_number: The number of the line (used primarily for error handling)
+        line:        The line read from the file
+    
+    */
+    
+    line = trim(line);
+    
+    if(line.length()>0){
+        if((!line.compare("Input")) || (!line.compare("RCM")) || (!line.compare("SFC"))){
+            node_ordering = line;
+        }
+        else{
+            std::cout << "Error: On line " << line_number << ", node ordering " << line << " not recognized.\n";
+            assert(1==0);
+        }
+        
+        if(verbose){
+            std::cout << "node ordering: " << node_ordering << "\n";
+        }
+    }
+}
+
+void InputParser::parse_quadrature(unsigned int line_number, std::string line){
+    /*!==========================
+    |    parse_quadrature    |
+    ==========================
+    
+    Parse the line when triggered by a quadrature keyword
+    
+    The line is 
+    
+        order[, hourglass_coefficient]
+    
+    where order is the number of gauss points in 
+    each direction of the elements (1, 2, or 3, 
+    default 2). The single point rule is stabilized 
+    against the hourglass modes with a stiffness of 
+    hourglass_coefficient (default 0.05) times 
+    lambda + 2 mu (see Hex8::add_hourglass_stabilization).
+    
+    input:
+        line_number: The number of the line (used primarily for error handling)
+        line:        The line read from the file
+    
+    */
+    
+    line = trim(line);
+    
+    if(line.length()>0){
+        std::vector< std::string > split_line = split(line);
+        
+        quadrature_order = std::atoi(split_line[0].c_str());
+        if((quadrature_order<1) || (quadrature_order>3)){
+            std::cout << "Error: On line " << line_number << ", quadrature order " << split_line[0] << " not supported (1, 2, or 3).\n";
+            assert(1==0);
+        }
+        
+        if(split_line.size()>1){
+            hourglass_coefficient = std::strtod(split_line[1].c_str(),NULL);
+        }
+        
+        if(verbose){
+            std::cout << "quadrature order: " << quadrature_order << "\n";
+            std::cout << "hourglass coefficient: " << hourglass_coefficient << "\n";
+        }
+    }
+}
+
+FEAModel::FEAModel(){
+    /*!Default constructor*/
+}
+    
+FEAModel::FEAModel(InputParser _input){
+    /*!The full constructor*/
+    
+    std::cout << "=\n|=> Constructing FEA Model\n=\n";
+    
+    input  = _input;       //!Copy input
+    solver = input.solver; //!Set the solution technique
+    
+    //!Set the vector sizes
+    total_ndof = input.nodes.size()*input.node_dof;
+    up         = std::vector< double >(total_ndof,0.);
+    u          = std::vector< double >(total_ndof,0.);
+    du         = std::vector< double >(total_ndof,0.);
+    
+    //!Initialize the size of the dirichlet boundary condition vector
+    dbcdof.resize(0);
     
     //!Define the internal node numbering of the elements
     map_element_nodes();
     
+    //!Reorder the internal nodes and the elements
+    renumber_nodes();
+    
+    //!Keep the elements integrated by this rank
+    partition_elements();
+    
     map_nodesets();
     
+    map_node_elements();
+    
     //!Initialize the degree of freedom vector
     initialize_dof();
     
+    //!Restore the state of a restarted model
+    if(input.restart){
+        read_checkpoint(input.filename);
+    }
+    
     if(input.verbose){
         for(int i=0; i<mapped_elements.size(); i++){
             std::cout << "Element " << mapped_elements[i].number << " internal node numbers:";
@@ -684,38 +1414,202 @@ void FEAModel::map_element_nodes(){
     
     Map the nodes that define each element 
     as the user defined them to the internal 
-    node numbering.
+    node numbering. The user defined numbers 
+    are looked up in a hashed map so the cost 
+    is linear in the size of the mesh.
     
     */
     
     std::cout << "\n|=> Mapping element nodes\n";
     
-    bool node_number_check = false;                         //!Boolean which checks that the node numbers are 
-                                                            //!set coorectly
-    unsigned int current_node_number;                       //!The current node number as defined by the user
-    std::vector< unsigned int > internal_node_numbers(8,0); //!The internal node numbers for a given element
+    std::unordered_map< unsigned int, unsigned int > node_index; //!The internal number of each user defined node number
+    node_index.reserve(input.nodes.size());
+    for(unsigned int n=0; n<input.nodes.size(); n++){
+        node_index[input.nodes[n].number] = n; //The last definition of a node is used
+    }
+    
+    std::unordered_map< unsigned int, unsigned int >::const_iterator node; //!The node found for the current user defined number
+    std::vector< unsigned int > internal_node_numbers(8,0);                 //!The internal node numbers for a given element
     
+    mapped_elements.reserve(input.elements.size());
     for(int e=0; e<input.elements.size(); e++){//Iterate through the elements
         for(int el_n=0; el_n<input.elements[e].nodes.size(); el_n++){//Iterate through the nodes in the element
-            current_node_number = input.elements[e].nodes[el_n]; //Set the current user defined node number
-            node_number_check   = false;                         //Reset the node number check boolean
-            for(int n=0; n<input.nodes.size(); n++){             //Search the list of nodes to find the indicated number
-                if(input.nodes[n].number==current_node_number){
-                    internal_node_numbers[el_n] = n;
-                    node_number_check = true;
-                }
-            }
-            if(!node_number_check){//Check for if the indicated node is not defined
+            node = node_index.find(input.elements[e].nodes[el_n]);
+            if(node==node_index.end()){//Check for if the indicated node is not defined
                 std::cout << "Error: Element "<<input.elements[e].number<< " calls for node number " << input.elements[e].nodes[el_n] <<
                              "       which is not defined.\n";
                 assert(1==0);
             }
+            internal_node_numbers[el_n] = node->second;
         }
         mapped_elements.push_back(Element(input.elements[e].number, internal_node_numbers));
     } 
     std::cout << "\n|=> Mapping complete\n";
 }
     
+void FEAModel::renumber_nodes(){
+    /*!========================
+    |    renumber_nodes    |
+    ========================
+    
+    Renumber the internal nodes in the ordering 
+    requested by the input deck and sort the 
+    elements by their lowest internal node. The 
+    degrees of freedom of a node are numbered 
+    consecutively so nodes (and elements) which 
+    are close in the ordering access nearby 
+    entries of the degree of freedom vectors and 
+    the jacobian.
+    
+    The nodes keep their user defined numbers so 
+    the nodesets and the boundary conditions are 
+    mapped as before and input_node_order is used 
+    to write the output in the order of the input 
+    deck. The nodes and the elements of the input 
+    are stored in the new order so that the deck 
+    written to a checkpoint reproduces the internal 
+    numbering with the Input ordering.
+    
+    */
+    
+    input_node_order.resize(input.nodes.size());
+    for(unsigned int n=0; n<input_node_order.size(); n++){input_node_order[n] = n;}
+    
+    if(!input.node_ordering.compare("Input")){return;}
+    
+    std::cout << "\n|=> Renumbering nodes (" << input.node_ordering << ")\n";
+    
+    //Form the node connectivity
+    std::vector< std::vector< unsigned int > > adjacency(input.nodes.size()); //!The nodes which share an element with each node
+    for(int e=0; e<mapped_elements.size(); e++){
+        for(int a=0; a<mapped_elements[e].nodes.size(); a++){
+            for(int b=0; b<mapped_elements[e].nodes.size(); b++){
+                if(a!=b){adjacency[mapped_elements[e].nodes[a]].push_back(mapped_elements[e].nodes[b]);}
+            }
+        }
+    }
+    for(unsigned int n=0; n<adjacency.size(); n++){
+        std::sort(adjacency[n].begin(), adjacency[n].end());
+        adjacency[n].erase(std::unique(adjacency[n].begin(), adjacency[n].end()), adjacency[n].end());
+    }
+    
+    std::vector< unsigned int > order; //!The previous internal number of the node at each new position
+    if(!input.node_ordering.compare("RCM")){
+        order = domain_decomposition::reverse_cuthill_mckee(adjacency);
+    }
+    else if(!input.node_ordering.compare("SFC")){
+        std::vector< std::array< double, 3 > > coordinates(input.nodes.size());
+        for(unsigned int n=0; n<coordinates.size(); n++){coordinates[n] = input.nodes[n].coordinates;}
+        order = domain_decomposition::morton_order(coordinates);
+    }
+    else{
+        std::cout << "Error: node ordering " << input.node_ordering << " not recognized.\n";
+        assert(1==0);
+    }
+    
+    std::cout << "  bandwidth of the node connectivity: " << domain_decomposition::bandwidth(adjacency, input_node_order)
+              << " -> " << domain_decomposition::bandwidth(adjacency, order) << "\n";
+    
+    //Reorder the nodes
+    std::vector< Node > nodes(input.nodes.size());
+    for(unsigned int n=0; n<order.size(); n++){
+        nodes[n] = input.nodes[order[n]];
+        input_node_order[order[n]] = n;
+    }
+    input.nodes = ArrayView< Node >(std::move(nodes));
+    
+    for(int e=0; e<mapped_elements.size(); e++){
+        for(int n=0; n<mapped_elements[e].nodes.size(); n++){
+            mapped_elements[e].nodes[n] = input_node_order[mapped_elements[e].nodes[n]];
+        }
+    }
+    
+    //Sort the elements by their lowest internal node keeping the input order for ties
+    std::vector< unsigned int > lowest_node(mapped_elements.size());
+    std::vector< unsigned int > element_order(mapped_elements.size());
+    for(int e=0; e<mapped_elements.size(); e++){
+        lowest_node[e]   = *std::min_element(mapped_elements[e].nodes.begin(), mapped_elements[e].nodes.end());
+        element_order[e] = e;
+    }
+    std::stable_sort(element_order.begin(), element_order.end(),
+                     [&lowest_node](const unsigned int &a, const unsigned int &b){return lowest_node[a]<lowest_node[b];});
+    
+    std::vector< Element > elements(mapped_elements.size());
+    std::vector< Element > input_elements(mapped_elements.size());
+    for(unsigned int e=0; e<element_order.size(); e++){
+        elements[e]       = mapped_elements[element_order[e]];
+        input_elements[e] = input.elements[element_order[e]];
+    }
+    mapped_elements = elements;
+    input.elements  = ArrayView< Element >(std::move(input_elements));
+    
+    std::cout << "\n|=> Renumbering complete\n";
+}
+    
+void FEAModel::partition_elements(){
+    /*!============================
+    |    partition_elements    |
+    ============================
+    
+    Partition the elements between the MPI ranks by 
+    recursive coordinate bisection of their centroids 
+    and keep only the elements integrated by this 
+    rank. The element data (the residuals, jacobians 
+    and shape function caches) is then only stored 
+    for the local elements. The nodes and the degree 
+    of freedom vectors are held by every rank but 
+    each node is owned by a single rank which solves 
+    for its degrees of freedom. The memory of the 
+    element data scales with the number of ranks but 
+    that of the nodes and degrees of freedom does not.
+    
+    The sparse Newton-Raphson solvers assemble and 
+    factor the global jacobian on a single rank so 
+    they are rejected here, before any assembly, if 
+    there is more than one rank.
+    
+    With a single rank all of the elements and nodes 
+    are local and owned.
+    
+    */
+    
+    decomposition = domain_decomposition::world_decomposition();
+    
+    std::vector< std::array< double, 3 > > centroids(mapped_elements.size()); //!The centroids of the elements
+    std::vector< std::vector< unsigned int > > element_nodes(mapped_elements.size()); //!The internal nodes of the elements
+    
+    for(int e=0; e<mapped_elements.size(); e++){
+        centroids[e] = { {0., 0., 0.} };
+        for(int n=0; n<mapped_elements[e].nodes.size(); n++){
+            for(int i=0; i<3; i++){
+                centroids[e][i] += input.nodes[mapped_elements[e].nodes[n]].coordinates[i]/mapped_elements[e].nodes.size();
+            }
+        }
+        element_nodes[e].assign(mapped_elements[e].nodes.begin(), mapped_elements[e].nodes.end());
+    }
+    
+    decomposition.build(centroids, element_nodes, input.nodes.size());
+    
+    if((decomposition.size>1) && ((!solver.compare("NewtonDirect")) || (!solver.compare("NewtonBiCGSTAB")))){
+        std::cout << "Error: solver " << solver << " assembles the jacobian on a single rank and can not be used with "
+                  << decomposition.size << " ranks. Use one of the NewtonKrylov solvers.\n";
+        assert(1==0);
+    }
+    
+    if(decomposition.size>1){
+        std::vector< Element > local_elements; //!The elements integrated by this rank
+        for(int e=0; e<mapped_elements.size(); e++){
+            if(decomposition.owns_element(e)){local_elements.push_back(mapped_elements[e]);}
+        }
+        
+        std::cout << "\n|=> Rank " << decomposition.rank << " of " << decomposition.size << " integrates "
+                  << local_elements.size() << " of " << mapped_elements.size() << " elements and exchanges nodes with "
+                  << decomposition.neighbors.size() << " ranks\n";
+        
+        mapped_elements = local_elements;
+    }
+}
+    
 void FEAModel::map_nodesets(){
     /*!======================
     |    map_nodesets    |
@@ -755,6 +1649,43 @@ void FEAModel::map_nodesets(){
     std::cout << "\n|=> Mapping complete\n";
 }
     
+void FEAModel::map_node_elements(){
+    /*!===========================
+    |    map_node_elements    |
+    ===========================
+    
+    Map each of the internal nodes to the 
+    elements which contain it and the local 
+    node number within those elements. The 
+    elements are stored in ascending order 
+    so that the assembly of the global vectors 
+    always sums the element contributions in 
+    the same order.
+    
+    */
+    
+    node_elements = std::vector< std::vector< std::array< unsigned int, 2 > > >(input.nodes.size());
+    
+    for(unsigned int e=0; e<mapped_elements.size(); e++){//Iterate through the elements
+        for(unsigned int n=0; n<mapped_elements[e].nodes.size(); n++){//Iterate through the nodes of the element
+            node_elements[mapped_elements[e].nodes[n]].push_back({ {e,n} });
+        }
+    }
+    
+    element_RHS = std::vector< std::vector< double > >(mapped_elements.size(), std::vector< double >(8*input.node_dof,0.));
+    
+    element_cache_state = std::vector< unsigned char >(mapped_elements.size(),0);
+    
+    element_cost = std::vector< double >(mapped_elements.size(),0.);
+    
+    shape_function_caches.resize(mapped_elements.size());
+    
+    //Each block of the store holds the gauss points of one element so that the 
+    //elements can view their state variables in place
+    const unsigned int num_gauss_points = input.quadrature_order*input.quadrature_order*input.quadrature_order;
+    state_variables.resize(mapped_elements.size(), num_gauss_points, input.num_sdvs, num_gauss_points);
+}
+    
 /*!=
 |=> Degrees of freedom methods
 =*/
@@ -827,6 +1758,8 @@ bool FEAModel::solve(){
     ===============
         
     Solve the finite element problem
+    
+    The timestep is controlled by advance_timestep.
         
     */
         
@@ -836,8 +1769,17 @@ bool FEAModel::solve(){
                    "|                                               |\n"<<
                    "=================================================\n";
     
-    input.t += input.tp+input.dt; //!Set initial timestep increment
+    input.t = input.tp+input.dt;  //!Set initial timestep increment (tp is not zero on restart)
     bool result;                  //!The result of the simulation
+    
+    if(!solver.compare("ExplicitCentralDifference")){//The explicit solver takes its own (stable) timesteps
+        if(!run_explicit_dynamics()){
+            if(input.mms_fxn!=NULL){
+                compare_manufactured_solution();
+            }
+            return false;
+        }
+    }
         
     while(input.tp<input.total_time){  //Iterate through the timesteps
     
@@ -847,20 +1789,8 @@ bool FEAModel::solve(){
             
         result = increment_solution(); //Increment the solution at the timestep
             
-        if(result){
-            input.tp = input.t;          //Increment time
-            input.t  = input.t+input.dt;
-            if(input.t>input.total_time){
-                input.t  = input.total_time;
-                input.dt = input.t - input.tp;
-            }
-            
-            for(int i=0; i<u.size(); i++){
-                up[i] = u[i]; //Set the previous dof vector to the current
-            }
-                
-        }
-        else{
+        if(!advance_timestep(result)){
+            wait_for_checkpoint();
             if(input.mms_fxn!=NULL){
                 compare_manufactured_solution();
             }
@@ -868,6 +1798,8 @@ bool FEAModel::solve(){
         }
             
     }
+    
+    wait_for_checkpoint();
         
     std::cout << "\n=================================================\n"<<
                    "|                                               |\n"<<
@@ -882,19 +1814,120 @@ bool FEAModel::solve(){
     return true;
 }
     
+bool FEAModel::advance_timestep(const bool converged){
+    /*!==========================
+    |    advance_timestep    |
+    ==========================
+    
+    Advance the time after an increment.
+    
+    A converged increment becomes the previous 
+    state and the time is incremented. If 
+    checkpoint_filename is set a checkpoint is 
+    written after every checkpoint_interval 
+    converged increments.
+    
+    If adaptive_timestep is set a failed increment 
+    (the Newton iteration did not converge or the 
+    residual could not be evaluated) is rolled back 
+    to the last converged state and re-attempted 
+    with the timestep reduced by cutback_factor 
+    until it reaches dt_min. The timestep is grown 
+    by growth_factor (up to dt_max) after each 
+    increment which converges in fast_iterations or 
+    fewer Newton iterations. Otherwise the timestep 
+    is fixed and a failed increment ends the solve.
+    
+    Input:
+        converged: Flag indicating if the increment converged
+    
+    returns:
+        true if the solve can continue
+    
+    */
+    
+    if(converged){
+        if(adaptive_timestep && (newton_iterations<=fast_iterations)){ //Grow the timestep after a quick increment
+            input.dt = std::min(growth_factor*input.dt, dt_max*input.total_time);
+        }
+        
+        input.tp = input.t;          //Increment time
+        input.t  = input.t+input.dt;
+        if(input.t>input.total_time){
+            input.t  = input.total_time;
+            input.dt = input.t - input.tp;
+        }
+        
+        for(int i=0; i<u.size(); i++){
+            up[i] = u[i]; //Set the previous dof vector to the current
+        }
+        
+        state_variables.commit();    //Accept the state variables of the converged increment
+        
+        if((checkpoint_filename.size()>0) && (increment_number%checkpoint_interval==0)){
+            write_checkpoint(checkpoint_filename);
+        }
+        
+        return true;
+    }
+    
+    if(adaptive_timestep && (cutback_factor*input.dt>=dt_min*input.total_time)){
+        std::cout << "\n|=> Increment " << increment_number << " failed. Cutting back the timestep from "
+                  << input.dt << " to " << cutback_factor*input.dt << "\n";
+        MICROMORPHIC_COUNT("timestep cutbacks",1);
+        
+        rollback_increment();
+        
+        input.dt *= cutback_factor;
+        input.t   = input.tp+input.dt;
+        
+        return true;
+    }
+    
+    return false;
+}
+    
 bool FEAModel::increment_solution(){
     /*!============================
     |    increment_solution    |
     ============================
         
     Perform a timestep of the solution
+    
+    returns:
+        true if the increment converged
         
     */
         
     initialize_timestep();
-    update_increment();
-        
-    return true;
+    return update_increment();
+}
+    
+void FEAModel::rollback_increment(){
+    /*!============================
+    |    rollback_increment    |
+    ============================
+    
+    Restore the degree of freedom vectors and the 
+    state variables to the last converged increment 
+    so that the increment can be attempted again 
+    with a different timestep.
+    
+    */
+    
+    for(int i=0; i<u.size(); i++){
+        u[i]  = up[i];
+        du[i] = 0.;
+    }
+    
+    state_variables.discard();
+    
+    increment_number -= 1;
+    
+    //!The retried increment starts from a new jacobian
+    tangent_valid = false;
+    
+    return;
 }
     
 void FEAModel::initialize_timestep(){
@@ -913,15 +1946,20 @@ void FEAModel::initialize_timestep(){
     return;
 }
     
-void FEAModel::update_increment(){
+bool FEAModel::update_increment(){
     /*!==========================
     |    update_increment    |
     ==========================
         
     Update the increment using the 
     chosen solution technique.
+    
+    returns:
+        true if the solution technique converged
         
     */
+    
+    bool converged = false; //!Flag indicating if the solution technique converged
         
     std::cout << "=\n|=> Begining solution of increment " << increment_number << "\n=\n";
         
@@ -944,8 +1982,22 @@ void FEAModel::update_increment(){
         }
     }
         
-    if(!solver.compare("NewtonKrylov")){//Solve the equations using a Jacobian free Newton-Krylov method
-        run_newton_krylov();
+    if((!solver.compare("NewtonKrylov")) || (!solver.compare("NewtonKrylovBlockJacobi"))){//Solve the equations using a Jacobian free Newton-Krylov method
+        analytic_matvec = false;
+        block_jacobi    = !solver.compare("NewtonKrylovBlockJacobi");
+        converged       = run_newton_krylov();
+    }
+    else if((!solver.compare("NewtonKrylovTangent")) || (!solver.compare("NewtonKrylovTangentBlockJacobi"))){//Solve the equations using Newton-Krylov with the element jacobians
+        analytic_matvec = true;
+        block_jacobi    = !solver.compare("NewtonKrylovTangentBlockJacobi");
+        converged       = run_newton_krylov();
+    }
+    else if((!solver.compare("NewtonDirect")) || (!solver.compare("NewtonBiCGSTAB"))){//Solve the equations using Newton-Raphson
+        converged = run_newton_sparse();                                              //with the assembled sparse jacobian (single rank)
+    }
+    else{
+        std::cout << "Error: solver " << solver << " not recognized.\n";
+        assert(1==0);
     }
     
     if(input.verbose){
@@ -959,44 +2011,231 @@ void FEAModel::update_increment(){
         }
     }
     
-    for(int i=0; i<u.size(); i++){
-        up[i] = u[i];              //Update the previous value of u
+    if(converged){
+        for(int i=0; i<u.size(); i++){
+            up[i] = u[i];              //Update the previous value of u
+        }
     }
     
-    return;
+    return converged;
 }
     
-void FEAModel::run_newton_krylov(){
+bool FEAModel::run_newton_krylov(){
     /*!===========================
     |    run_newton_krylov    |
     ===========================
         
     Run the Newton-Krylov solver.
+    
+    returns:
+        true if the solver converged
         
     */
     
     std::vector< double > ub_du = get_unbound_du();
-    FEAKrylovSolver krylov_solver = FEAKrylovSolver(*this, ub_du, 10, 40, true);
+    FEAKrylovSolver krylov_solver = FEAKrylovSolver(*this, ub_du, krylov_maxiter, 40, true);
+    krylov_solver.rmax = gmres_cycles;
     krylov_solver.solve();
-    return;
+    newton_iterations = krylov_solver.NKi;
+    return !krylov_solver.inconv_flg;
 }
 
-void FEAModel::id_unbound_dof(){
-    /*!========================
-    |    id_unbound_dof    |
-    ========================
-    
-    Identify the degrees of freedom 
-    which are unbound.
+void FEAModel::form_jacobian_sparsity(){
+    /*!================================
+    |    form_jacobian_sparsity    |
+    ================================
+    
+    Form the sparsity pattern of the jacobian of the 
+    unbound degrees of freedom from the element 
+    connectivity and precompute the location of each 
+    term of the element jacobians in the value array 
+    of the global matrix so that the assembly is a 
+    direct indexed addition.
     
     */
     
-    std::vector< bool > unbound_dof_bool(total_ndof,true); //!A vector indicating if a 
-                                                           //!degree of freedom is unbound or not
-    std::vector< unsigned int > dof_tmp(input.node_dof,0); //!A temporary vector of degrees of freedom
+    std::cout << "\n|=> Forming the sparsity pattern of the jacobian\n";
     
-    if(input.mms_dirichlet_set_number>0){ //!Identify all of the dof associated with the dirichlet set if it exists
-        for(int i=0; i<mapped_nodesets[input.mms_dirichlet_set_number].nodes.size(); i++){//Index through the dirichlet bc set
+    unsigned int element_ndof = 8*input.node_dof; //!The number of degrees of freedom in an element
+    std::vector< unsigned int > element_dof(element_ndof,0); //!The global degrees of freedom of the element
+    std::vector< Eigen::Triplet< double > > triplets;       //!The non-zero terms
+    
+    for(int e=0; e<mapped_elements.size(); e++){//Iterate through the elements
+        for(int n=0; n<8; n++){
+            for(int i=0; i<input.node_dof; i++){
+                element_dof[i+n*input.node_dof] = internal_nodes_dof[mapped_elements[e].nodes[n]][i];
+            }
+        }
+        
+        for(int a=0; a<element_ndof; a++){
+            for(int b=0; b<element_ndof; b++){
+                if((unbound_index[element_dof[a]]>=0) && (unbound_index[element_dof[b]]>=0)){
+                    triplets.push_back(Eigen::Triplet< double >(unbound_index[element_dof[a]],unbound_index[element_dof[b]],0.));
+                }
+            }
+        }
+    }
+    
+    jacobian.resize(unbound_dof.size(),unbound_dof.size());
+    jacobian.setFromTriplets(triplets.begin(),triplets.end());
+    jacobian.makeCompressed();
+    
+    //Locate each term of the element jacobians in the value array
+    element_jacobian_index = std::vector< std::vector< int > >(mapped_elements.size(), std::vector< int >(element_ndof*element_ndof,-1));
+    
+    int row;                                 //!The row of the jacobian
+    int col;                                 //!The column of the jacobian
+    const int *outer = jacobian.outerIndexPtr(); //!The column start indices
+    const int *inner = jacobian.innerIndexPtr(); //!The row indices
+    
+    for(int e=0; e<mapped_elements.size(); e++){//Iterate through the elements
+        for(int n=0; n<8; n++){
+            for(int i=0; i<input.node_dof; i++){
+                element_dof[i+n*input.node_dof] = internal_nodes_dof[mapped_elements[e].nodes[n]][i];
+            }
+        }
+        
+        for(int a=0; a<element_ndof; a++){
+            row = unbound_index[element_dof[a]];
+            if(row<0){continue;}
+            for(int b=0; b<element_ndof; b++){
+                col = unbound_index[element_dof[b]];
+                if(col<0){continue;}
+                element_jacobian_index[e][b+a*element_ndof] = std::lower_bound(inner+outer[col],inner+outer[col+1],row) - inner;
+            }
+        }
+    }
+    
+    std::cout << "\n|=> Jacobian has " << jacobian.nonZeros() << " non-zero terms\n";
+}
+
+bool FEAModel::run_newton_sparse(){
+    /*!===========================
+    |    run_newton_sparse    |
+    ===========================
+    
+    Run a Newton-Raphson solver using the 
+    assembled sparse jacobian. The linear 
+    system is solved with either a sparse 
+    LU factorization (NewtonDirect) or ILUT 
+    preconditioned BiCGSTAB (NewtonBiCGSTAB).
+    
+    If modified_newton is set the residual is 
+    evaluated without the jacobian and the 
+    factorization of an earlier iteration (or 
+    increment) is used while reuse_tangent 
+    accepts the convergence rate.
+    
+    returns:
+        true if the solver converged
+    
+    */
+    
+    if(element_jacobian_index.size()!=mapped_elements.size()){//Form the sparsity pattern if required
+        form_jacobian_sparsity();
+    }
+    
+    std::vector< double > ub_du = get_unbound_du(); //!The change in the unbound dof
+    std::vector< double > R;                        //!The residual of the unbound dof
+    Eigen::VectorXd b(ub_du.size());                //!The right hand side of the linear system
+    Eigen::VectorXd x(ub_du.size());                //!The solution of the linear system
+    double R0;                                      //!The initial residual norm
+    double R_norm;                                  //!The current residual norm
+    
+    if(!direct_solver && !solver.compare("NewtonDirect")){
+        direct_solver = std::make_shared< Eigen::SparseLU< Eigen::SparseMatrix< double > > >();
+        direct_solver->analyzePattern(jacobian); //The sparsity pattern is fixed so it only needs to be analyzed once
+    }
+    if(!iterative_solver && solver.compare("NewtonDirect")){
+        iterative_solver = std::make_shared< Eigen::BiCGSTAB< Eigen::SparseMatrix< double >, Eigen::IncompleteLUT< double > > >();
+        iterative_solver->setTolerance(linear_tol);
+    }
+    
+    for(int iter=0; iter<maxiter; iter++){
+        
+        //Compute the residual and the jacobian (unless the jacobian of an earlier iteration may be reused)
+        const bool cached = modified_newton && tangent_valid;
+        form_jacobian = !cached;
+        R = krylov_residual(ub_du);
+        form_jacobian = false;
+        
+        R_norm = vector_norm(R);
+        if(iter==0){R0 = R_norm;}
+        
+        std::cout << "Iteration: " << iter << " residual norm: " << R_norm << "\n";
+        
+        newton_iterations = iter;
+        
+        if(!std::isfinite(R_norm)){
+            std::cout << "Warning: the residual is not finite\n";
+            return false;
+        }
+        
+        if((R_norm<atol) || (R_norm<rtol*R0)){
+            std::cout << "Newton-Raphson solver converged\n";
+            return true;
+        }
+        
+        for(int i=0; i<R.size(); i++){b(i) = -R[i];}
+        
+        const bool reuse = reuse_tangent(iter, R_norm);
+        if(!reuse && cached){//The residual was evaluated without the jacobian
+            form_jacobian = true;
+            krylov_residual(ub_du);
+            form_jacobian = false;
+        }
+        
+        MICROMORPHIC_TIME_SCOPE("linear solve");
+        
+        if(!solver.compare("NewtonDirect")){
+            if(!reuse){
+                direct_solver->factorize(jacobian);
+                if(direct_solver->info()!=Eigen::Success){
+                    std::cout << "Error: factorization of the jacobian failed\n";
+                    assert(1==0);
+                }
+            }
+            x = direct_solver->solve(b);
+        }
+        else{
+            if(!reuse){
+                iterative_solver->compute(jacobian);
+            }
+            x = iterative_solver->solve(b);
+            MICROMORPHIC_COUNT("krylov iterations",iterative_solver->iterations());
+            if(iterative_solver->info()!=Eigen::Success){
+                std::cout << "Warning: iterative linear solve did not converge (" << iterative_solver->iterations() << " iterations)\n";
+            }
+        }
+        
+        tangent_valid = true;
+        
+        for(int i=0; i<ub_du.size(); i++){ub_du[i] += alpha*x(i);}
+    }
+    
+    //Update the solution with the final iterate
+    krylov_residual(ub_du);
+    
+    std::cout << "Warning: Newton-Raphson solver did not converge in " << maxiter << " iterations\n";
+    return false;
+}
+
+void FEAModel::id_unbound_dof(){
+    /*!========================
+    |    id_unbound_dof    |
+    ========================
+    
+    Identify the degrees of freedom 
+    which are unbound.
+    
+    */
+    
+    std::vector< bool > unbound_dof_bool(total_ndof,true); //!A vector indicating if a 
+                                                           //!degree of freedom is unbound or not
+    std::vector< unsigned int > dof_tmp(input.node_dof,0); //!A temporary vector of degrees of freedom
+    
+    if(input.mms_dirichlet_set_number<mapped_nodesets.size()){ //!Identify all of the dof associated with the dirichlet set if it exists
+        for(int i=0; i<mapped_nodesets[input.mms_dirichlet_set_number].nodes.size(); i++){//Index through the dirichlet bc set
             dof_tmp = internal_nodes_dof[mapped_nodesets[input.mms_dirichlet_set_number].nodes[i]];
             for(int j=0; j<dof_tmp.size(); j++){
                 unbound_dof_bool[dof_tmp[j]] = false;
@@ -1004,7 +2243,7 @@ void FEAModel::id_unbound_dof(){
         }
     }
     
-    for(int i=0; dbcdof.size(); i++){//Identify all of the dof associated with Dirichlet boundary conditions
+    for(int i=0; i<dbcdof.size(); i++){//Identify all of the dof associated with Dirichlet boundary conditions
         unbound_dof_bool[dbcdof[i].dof_number] = false;
     }
     
@@ -1014,6 +2253,19 @@ void FEAModel::id_unbound_dof(){
         }
     }
     
+    unbound_index = std::vector< int >(total_ndof,-1);
+    for(int i=0; i<unbound_dof.size(); i++){unbound_index[unbound_dof[i]] = i;}
+    
+    //The Krylov vectors hold the unbound dof of the nodes owned by this rank
+    krylov_dof.clear();
+    krylov_index = std::vector< int >(total_ndof,-1);
+    for(int i=0; i<unbound_dof.size(); i++){
+        if(decomposition.owns_node(unbound_dof[i]/input.node_dof)){
+            krylov_index[unbound_dof[i]] = krylov_dof.size();
+            krylov_dof.push_back(unbound_dof[i]);
+        }
+    }
+    
     if(input.verbose){
         std::cout << "unbound dof: ";
         for(int i=0; i<unbound_dof.size(); i++){std::cout << " " << unbound_dof[i];}
@@ -1026,48 +2278,592 @@ std::vector< double > FEAModel::get_unbound_du(){
     |    get_unbound_du    |
     ========================
     
-    Get the change in all of the 
-    unbound degrees of freedom
+    Get the change in all of the 
+    unbound degrees of freedom owned 
+    by this rank
+    
+    */
+    
+    std::vector< double > ub_du(0,0);
+    
+    for(int i=0; i<krylov_dof.size(); i++){
+        ub_du.push_back(du[krylov_dof[i]]);
+    }
+    
+    return ub_du;
+}
+    
+std::vector< double > FEAModel::krylov_residual(std::vector<double> ub_du){
+    /*!=========================
+    |    krylov_residual    |
+    =========================
+        
+    Access the RHS vector in a way useful to the 
+    Krylov solver. The vectors hold the unbound 
+    degrees of freedom owned by this rank. The 
+    values at the ghost nodes are updated from 
+    their owners prior to the assembly.
+        
+    */
+    
+    unsigned int dof_num;
+        
+    for(int i=0; i<ub_du.size(); i++){
+        dof_num = krylov_dof[i];
+        du[dof_num]  = ub_du[i];                       //Update du
+        u[dof_num]   = up[dof_num] + du[dof_num];      //Update u
+    }
+    
+    decomposition.update_ghosts(du,input.node_dof);
+    decomposition.update_ghosts(u,input.node_dof);
+    
+    assemble_RHS_and_jacobian_matrix(); //Compute the RHS
+    
+    std::vector< double > sub_RHS(ub_du.size(),0.); //Get the residual values associated 
+                                                    //with the degrees of freedom
+    
+    for(int i=0; i<krylov_dof.size(); i++){
+        sub_RHS[i] = RHS[krylov_dof[i]];            //Get the RHS values not on the boundary
+    }
+    
+    return sub_RHS;                         //Return the residual
+}
+    
+std::vector< double > FEAModel::krylov_jacobian_product(const std::vector< double > &v){
+    /*!=================================
+    |    krylov_jacobian_product    |
+    =================================
+    
+    Compute the product of the jacobian of the 
+    unbound RHS with the vector v using the 
+    element jacobians cached during the last 
+    residual evaluation. The constitutive model 
+    is not re-evaluated.
+    
+    The global and element products are formed 
+    in workspaces of the model which are sized 
+    on the first product so the iterations of 
+    the Krylov solver do not allocate them.
+    
+    */
+    
+    unsigned int element_ndof = 8*input.node_dof; //!The number of degrees of freedom in an element
+    std::vector< double > Jv(v.size(),0.);        //!The resulting product
+    
+    if(element_AMATRX.size()!=mapped_elements.size()){
+        std::cout << "Error: The element jacobians have not been computed\n";
+        assert(1==0);
+    }
+    
+    //The values of v at all of the dof (the bound dof are zero) and the product at all of the dof
+    global_v.assign(total_ndof,0.);
+    global_Jv.assign(total_ndof,0.);
+    element_Jv.resize(mapped_elements.size()*element_ndof);
+    
+    //Scatter v to the global dof and update the ghost nodes
+    for(int i=0; i<krylov_dof.size(); i++){global_v[krylov_dof[i]] = v[i];}
+    decomposition.update_ghosts(global_v,input.node_dof);
+    
+    #pragma omp parallel num_threads(num_threads)
+    {
+        std::vector< double > element_v(element_ndof,0.); //!The values of v at the element dof
+        
+        #pragma omp for schedule(static)
+        for(int e=0; e<mapped_elements.size(); e++){//Iterate through the elements
+            
+            //Gather the values of v
+            for(int n=0; n<8; n++){
+                for(int i=0; i<input.node_dof; i++){
+                    element_v[i+n*input.node_dof] = global_v[internal_nodes_dof[mapped_elements[e].nodes[n]][i]];
+                }
+            }
+            
+            //Compute the element product
+            for(int a=0; a<element_ndof; a++){
+                element_Jv[a+e*element_ndof] = 0.;
+                for(int b=0; b<element_ndof; b++){
+                    element_Jv[a+e*element_ndof] += element_AMATRX[e][b+a*element_ndof]*element_v[b];
+                }
+            }
+        }
+        
+        //Gather the product at the nodes in element order
+        #pragma omp for schedule(static)
+        for(int n=0; n<node_elements.size(); n++){
+            for(int i=0; i<input.node_dof; i++){
+                for(int k=0; k<node_elements[n].size(); k++){
+                    global_Jv[internal_nodes_dof[n][i]] += element_Jv[i+node_elements[n][k][1]*input.node_dof+node_elements[n][k][0]*element_ndof];
+                }
+            }
+        }
+    }
+    
+    //Add the contributions of the other ranks to the owned nodes
+    decomposition.accumulate_ghosts(global_Jv,input.node_dof);
+    
+    for(int i=0; i<krylov_dof.size(); i++){Jv[i] = global_Jv[krylov_dof[i]];}
+    
+    return Jv;
+}
+    
+void FEAModel::form_block_jacobi_preconditioner(){
+    /*!==========================================
+    |    form_block_jacobi_preconditioner    |
+    ==========================================
+    
+    Form and factor the node_dof x node_dof diagonal 
+    block of the jacobian at each internal node from 
+    the cached element jacobians. The contributions 
+    of the elements of other ranks are added to the 
+    blocks of the owned nodes. The rows and columns 
+    of the bound degrees of freedom (and all of the 
+    rows and columns of the nodes owned by other 
+    ranks) are replaced by those of the identity so 
+    every block is regular.
+    
+    */
+    
+    MICROMORPHIC_TIME_SCOPE("krylov preconditioner");
+    
+    unsigned int element_ndof = 8*input.node_dof; //!The number of degrees of freedom in an element
+    
+    if(element_AMATRX.size()!=mapped_elements.size()){
+        std::cout << "Error: The element jacobians have not been computed\n";
+        assert(1==0);
+    }
+    
+    unsigned int block_size   = input.node_dof*input.node_dof; //!The number of terms in a nodal block
+    std::vector< double > blocks(node_elements.size()*block_size,0.); //!The nodal blocks stored row-major
+    
+    nodal_block_factors.resize(node_elements.size());
+    
+    #pragma omp parallel num_threads(num_threads)
+    {
+        unsigned int e;                                       //!The element number
+        unsigned int a;                                       //!The local node number in the element
+        
+        //Sum the contributions of the elements in element order
+        #pragma omp for schedule(static)
+        for(int n=0; n<node_elements.size(); n++){
+            for(int k=0; k<node_elements[n].size(); k++){
+                e = node_elements[n][k][0];
+                a = node_elements[n][k][1];
+                for(int i=0; i<input.node_dof; i++){
+                    for(int j=0; j<input.node_dof; j++){
+                        blocks[j+i*input.node_dof+n*block_size] += element_AMATRX[e][(j+a*input.node_dof)+(i+a*input.node_dof)*element_ndof];
+                    }
+                }
+            }
+        }
+    }
+    
+    decomposition.accumulate_ghosts(blocks,block_size);
+    
+    #pragma omp parallel num_threads(num_threads)
+    {
+        Eigen::MatrixXd block(input.node_dof,input.node_dof); //!The diagonal block of the node
+        
+        #pragma omp for schedule(static)
+        for(int n=0; n<node_elements.size(); n++){
+            for(int i=0; i<input.node_dof; i++){
+                for(int j=0; j<input.node_dof; j++){
+                    block(i,j) = blocks[j+i*input.node_dof+n*block_size];
+                }
+            }
+            
+            //Decouple the bound and not owned degrees of freedom
+            for(int i=0; i<input.node_dof; i++){
+                if((krylov_index[internal_nodes_dof[n][i]]<0) || (node_elements[n].size()==0)){
+                    block.row(i).setZero();
+                    block.col(i).setZero();
+                    block(i,i) = 1.;
+                }
+            }
+            
+            nodal_block_factors[n].compute(block);
+        }
+    }
+    
+    return;
+}
+
+void FEAModel::apply_block_jacobi_preconditioner(const std::vector< double > &v, std::vector< double > &z) const{
+    /*!===========================================
+    |    apply_block_jacobi_preconditioner    |
+    ===========================================
+    
+    Apply the inverse of the nodal block-Jacobi 
+    preconditioner to the unbound vector v.
+    
+    input:
+        v: The vector defined on the unbound degrees of freedom owned by this rank
+        z: The preconditioned vector
+    
+    */
+    
+    if(nodal_block_factors.size()!=node_elements.size()){
+        std::cout << "Error: The block-Jacobi preconditioner has not been formed\n";
+        assert(1==0);
+    }
+    
+    z.resize(v.size());
+    
+    #pragma omp parallel num_threads(num_threads)
+    {
+        Eigen::VectorXd node_v(input.node_dof); //!The values of v at the node
+        Eigen::VectorXd node_z(input.node_dof); //!The values of z at the node
+        int index;                              //!The index of the dof in v
+        
+        #pragma omp for schedule(static)
+        for(int n=0; n<node_elements.size(); n++){
+            if(!decomposition.owns_node(n)){continue;}
+            
+            for(int i=0; i<input.node_dof; i++){
+                index = krylov_index[internal_nodes_dof[n][i]];
+                node_v(i) = (index>=0) ? v[index] : 0.;
+            }
+            
+            node_z = nodal_block_factors[n].solve(node_v);
+            
+            for(int i=0; i<input.node_dof; i++){
+                index = krylov_index[internal_nodes_dof[n][i]];
+                if(index>=0){z[index] = node_z(i);}
+            }
+        }
+    }
+    
+    return;
+}
+
+bool FEAModel::reuse_tangent(const unsigned int iteration, const double &residual_norm){
+    /*!=======================
+    |    reuse_tangent    |
+    =======================
+    
+    Decide if the jacobian (the element jacobians 
+    and any factorization or preconditioner formed 
+    from them) of an earlier Newton iteration is 
+    reused for the current iteration of modified 
+    Newton. The jacobian is kept across iterations 
+    and increments until the ratio of successive 
+    residual norms within an increment exceeds 
+    tangent_reuse_rate.
+    
+    input:
+        iteration:     The Newton iteration of the increment
+        residual_norm: The residual norm at the current iterate
+    
+    returns:
+        true if the jacobian is reused
+    
+    */
+    
+    bool reuse = modified_newton && tangent_valid &&
+                 ((iteration==0) || (residual_norm<=tangent_reuse_rate*previous_residual_norm));
+    
+    previous_residual_norm = residual_norm;
+    
+    if(modified_newton){
+        if(reuse){
+            MICROMORPHIC_COUNT("tangents reused",1);
+        }
+        else{
+            std::cout << "| Forming the tangent\n";
+            MICROMORPHIC_COUNT("tangents formed",1);
+        }
+    }
+    
+    return reuse;
+}
+
+/*!=
+|=> Explicit dynamics methods
+=*/
+
+void FEAModel::assemble_lumped_mass(){
+    /*!==============================
+    |    assemble_lumped_mass    |
+    ==============================
+    
+    Assemble the lumped (diagonal) mass of the
+    global degrees of freedom from the lumped mass
+    of the elements (see Hex8::set_lumped_mass).
+    Only the reference shape functions of the
+    elements are evaluated. The contributions of
+    the elements of the other ranks are added to
+    the owned nodes and the ghost nodes are then
+    updated so every rank holds the mass of all
+    of the nodes of its elements.
+    
+    */
+    
+    std::cout << "\n|=> Assembling the lumped mass\n";
+    
+    lumped_mass = std::vector< double >(total_ndof,0.);
+    
+    std::vector< double > element_coordinates(24,0.);          //!The coordinates of the nodes in a given element
+    std::vector< double > element_zero(input.node_dof*8,0.);   //!The degree of freedom vector of the element (unused)
+    unsigned int internal_node_number;                         //!The number of the node as defined in the code
+    
+    micro_element::Hex8 current_element;                       //!The element workspace
+    current_element.set_quadrature_rule(input.quadrature_order);
+    current_element.reference_micro_inertia = micro_inertia;
+    
+    for(int e=0; e<mapped_elements.size(); e++){
+        for(int n=0; n<8; n++){
+            internal_node_number = mapped_elements[e].nodes[n];
+            for(int i=0; i<3; i++){
+                element_coordinates[i+n*3] = input.nodes[internal_node_number].coordinates[i];
+            }
+        }
+        
+        current_element.reset(element_coordinates, element_zero, element_zero,
+                              input.fprops, input.iprops);
+        
+        if(cache_shape_functions){
+            if(!shape_function_caches[e].is_set){
+                current_element.build_shape_function_cache(shape_function_caches[e]);
+            }
+            current_element.set_shape_function_cache(&shape_function_caches[e]);
+        }
+        
+        current_element.set_lumped_mass(hrz_lumping);
+        
+        for(int n=0; n<8; n++){
+            internal_node_number = mapped_elements[e].nodes[n];
+            for(int i=0; i<input.node_dof; i++){
+                lumped_mass[internal_nodes_dof[internal_node_number][i]] += current_element.lumped_mass(i+n*input.node_dof);
+            }
+        }
+    }
+    
+    decomposition.accumulate_ghosts(lumped_mass,input.node_dof);
+    decomposition.update_ghosts(lumped_mass,input.node_dof);
+    
+    for(int i=0; i<krylov_dof.size(); i++){
+        if(!(lumped_mass[krylov_dof[i]]>0)){
+            std::cout << "Error: The lumped mass of degree of freedom " << krylov_dof[i] << " is not positive ("
+                      << lumped_mass[krylov_dof[i]] << ")\n";
+            assert(1==0);
+        }
+    }
+}
+
+double FEAModel::estimate_stable_timestep(){
+    /*!==================================
+    |    estimate_stable_timestep    |
+    ==================================
+    
+    Estimate the largest stable timestep of the
+    central difference integration as
+        
+        dt = 2/omega_max
+    
+    where omega_max is the largest natural frequency
+    of the elements which bounds the largest natural
+    frequency of the lumped mass model. omega_max^2
+    is the largest eigenvalue of
+        
+        M^(-1/2) K M^(-1/2)
+    
+    where M is the lumped mass of the element and
+    K is the symmetric part of its stiffness in the
+    reference configuration. The element tangents
+    are only computed once here.
+    
+    returns:
+        the estimated stable timestep (the same on all of the ranks)
+    
+    */
+    
+    std::cout << "\n|=> Estimating the stable timestep\n";
+    
+    const unsigned int element_ndof = 8*input.node_dof;        //!The number of degrees of freedom in an element
+    std::vector< double > element_coordinates(24,0.);          //!The coordinates of the nodes in a given element
+    std::vector< double > element_zero(element_ndof,0.);       //!The degree of freedom vector of the element
+    unsigned int internal_node_number;                         //!The number of the node as defined in the code
+    double omega_squared = 0.;                                 //!The largest squared natural frequency
+    
+    Eigen::MatrixXd scaled_stiffness(element_ndof,element_ndof);  //!The scaled element stiffness
+    Eigen::VectorXd inverse_root_mass(element_ndof);              //!The inverse of the square root of the lumped mass
+    Eigen::SelfAdjointEigenSolver< Eigen::MatrixXd > eigensolver; //!The eigenvalue solver
+    
+    micro_element::Hex8 current_element;                       //!The element workspace
+    current_element.set_quadrature_rule(input.quadrature_order);
+    current_element.hourglass_coefficient   = input.hourglass_coefficient;
+    current_element.reference_micro_inertia = micro_inertia;
+    
+    for(int e=0; e<mapped_elements.size(); e++){
+        for(int n=0; n<8; n++){
+            internal_node_number = mapped_elements[e].nodes[n];
+            for(int i=0; i<3; i++){
+                element_coordinates[i+n*3] = input.nodes[internal_node_number].coordinates[i];
+            }
+        }
+        
+        current_element.reset(element_coordinates, element_zero, element_zero,
+                              input.fprops, input.iprops);
+        
+        if(cache_shape_functions){
+            if(!shape_function_caches[e].is_set){
+                current_element.build_shape_function_cache(shape_function_caches[e]);
+            }
+            current_element.set_shape_function_cache(&shape_function_caches[e]);
+        }
+        
+        current_element.integrate_element(true);
+        current_element.set_lumped_mass(hrz_lumping);
+        
+        for(int i=0; i<element_ndof; i++){
+            inverse_root_mass(i) = (current_element.lumped_mass(i)>0) ? 1./sqrt(current_element.lumped_mass(i)) : 0.;
+        }
+        
+        //AMATRX is dRHSdU so the stiffness is its negative
+        scaled_stiffness = -0.5*inverse_root_mass.asDiagonal()*(current_element.AMATRX + current_element.AMATRX.transpose())*inverse_root_mass.asDiagonal();
+        
+        eigensolver.compute(scaled_stiffness, Eigen::EigenvaluesOnly);
+        omega_squared = std::max(omega_squared, eigensolver.eigenvalues().maxCoeff());
+    }
+    
+    decomposition.maximum(&omega_squared,1);
+    
+    if(!(omega_squared>0)){
+        std::cout << "Error: The largest natural frequency of the elements is not positive\n";
+        assert(1==0);
+    }
+    
+    return 2./sqrt(omega_squared);
+}
+
+bool FEAModel::run_explicit_dynamics(){
+    /*!===============================
+    |    run_explicit_dynamics    |
+    ===============================
+    
+    Integrate the equations of motion
+        
+        M ddot(u) = RHS(u)
+    
+    from rest with the central difference method
+    and the lumped mass M
+        
+        v_(n+1/2) = v_(n-1/2) + 0.5*(dt_(n-1) + dt_n) a_n
+        u_(n+1)   = u_n + dt_n v_(n+1/2)
+        a_(n+1)   = RHS(u_(n+1))/M
+    
+    No global matrix is formed or solved. Each
+    timestep is one evaluation of the residual.
+    
+    The timestep is explicit_dt if it is positive
+    and explicit_safety times the estimated stable
+    timestep otherwise. The dirichlet boundary
+    conditions are ramped linearly in time as in
+    the implicit solvers and the manufactured
+    solution (if any) is applied at each timestep.
+    
+    returns:
+        false if the residual could not be evaluated
     
     */
     
-    std::vector< double > ub_du(0,0);
+    std::cout << "\n|=> Beginning the explicit central difference integration\n";
     
-    for(int i=0; i<unbound_dof.size(); i++){
-        ub_du.push_back(du[unbound_dof[i]]);
+    bool incremental_assembly_flag = incremental_assembly; //!All of the degrees of freedom change at every timestep
+    incremental_assembly = false;
+    form_jacobian        = false;
+    
+    assemble_lumped_mass();
+    
+    double dt = explicit_dt;                                //!The timestep
+    if(!(dt>0)){
+        double dt_stable = estimate_stable_timestep();
+        dt = explicit_safety*dt_stable;
+        std::cout << "\n|=> Estimated stable timestep: " << dt_stable << "\n";
     }
+    std::cout << "\n|=> Explicit timestep: " << dt << "\n";
     
-    return ub_du;
-}
+    velocity     = std::vector< double >(total_ndof,0.);
+    acceleration = std::vector< double >(total_ndof,0.);
     
-std::vector< double > FEAModel::krylov_residual(std::vector<double> ub_du){
-    /*!=========================
-    |    krylov_residual    |
-    =========================
+    double dt_previous = 0.;                                //!The previous timestep
+    double dt_step;                                         //!The current timestep
+    unsigned int report_interval = std::max(1., std::ceil(0.01*input.total_time/dt)); //!The number of timesteps between reports
+    
+    input.tp = 0.;
+    input.t  = 0.;
+    
+    if(input.mms_fxn!=NULL){
+        apply_manufactured_solution();
+    }
+    
+    up = u;
+    assemble_RHS_and_jacobian_matrix();
+    for(int i=0; i<krylov_dof.size(); i++){
+        acceleration[krylov_dof[i]] = RHS[krylov_dof[i]]/lumped_mass[krylov_dof[i]];
+    }
+    
+    while(input.t<input.total_time){
+        dt_step = std::min(dt, input.total_time-input.t);
         
-    Access the RHS vector in a way useful to the 
-    Krylov solver.
+        input.tp  = input.t;
+        input.t  += dt_step;
+        input.dt  = dt_step;
+        increment_number += 1;
         
-    */
-    
-    unsigned int dof_num;
+        for(int i=0; i<u.size(); i++){up[i] = u[i];}
         
-    for(int i=0; i<ub_du.size(); i++){
-        dof_num = unbound_dof[i];
-        du[dof_num]  = ub_du[i];                       //Update du
-        u[dof_num]   = up[dof_num] + du[dof_num];      //Update u
+        if(input.mms_fxn!=NULL){
+            apply_manufactured_solution();
+        }
+        
+        //Update the velocity at the middle of the timestep and the unbound degrees of freedom
+        for(int i=0; i<krylov_dof.size(); i++){
+            velocity[krylov_dof[i]] += 0.5*(dt_previous+dt_step)*acceleration[krylov_dof[i]];
+            u[krylov_dof[i]]        += dt_step*velocity[krylov_dof[i]];
+        }
+        
+        //Ramp the dirichlet boundary conditions
+        for(int dbc=0; dbc<dbcdof.size(); dbc++){
+            u[dbcdof[dbc].dof_number] = (input.t/input.total_time)*dbcdof[dbc].value;
+        }
+        
+        decomposition.update_ghosts(u,input.node_dof);
+        for(int i=0; i<u.size(); i++){du[i] = u[i]-up[i];}
+        
+        assemble_RHS_and_jacobian_matrix();
+        
+        double residual_norm = 0.;                                   //!The norm of the residual
+        for(int i=0; i<krylov_dof.size(); i++){
+            acceleration[krylov_dof[i]] = RHS[krylov_dof[i]]/lumped_mass[krylov_dof[i]];
+            residual_norm += RHS[krylov_dof[i]]*RHS[krylov_dof[i]];
+        }
+        decomposition.sum(&residual_norm,1);
+        
+        if(!std::isfinite(residual_norm)){
+            std::cout << "\n|=> Error: The residual is not finite at time " << input.t << " (increment " << increment_number << ")\n";
+            incremental_assembly = incremental_assembly_flag;
+            return false;
+        }
+        
+        state_variables.commit();
+        
+        if((increment_number%report_interval==0) || !(input.t<input.total_time)){
+            std::cout << "\n|=> Increment " << increment_number << " time " << input.t << " residual norm " << sqrt(residual_norm) << "\n";
+        }
+        
+        dt_previous = dt_step;
     }
     
-    assemble_RHS_and_jacobian_matrix(); //Compute the RHS
+    for(int i=0; i<krylov_dof.size(); i++){
+        velocity[krylov_dof[i]] += 0.5*dt_previous*acceleration[krylov_dof[i]]; //Synchronize the velocity with the final time
+    }
     
-    std::vector< double > sub_RHS(ub_du.size(),0.); //Get the residual values associated 
-                                                    //with the degrees of freedom
+    for(int i=0; i<u.size(); i++){up[i] = u[i];}
+    input.tp = input.t;
     
-    for(int i=0; i<unbound_dof.size(); i++){
-        sub_RHS[i] = RHS[unbound_dof[i]];           //Get the RHS values not on the boundary
-    }
+    incremental_assembly = incremental_assembly_flag;
     
-    return sub_RHS;                         //Return the residual
+    return true;
 }
     
 void FEAModel::form_increment_dof_vector(){
@@ -1130,11 +2926,42 @@ void FEAModel::assemble_RHS_and_jacobian_matrix(){
         
     */
        
+    MICROMORPHIC_TIME_SCOPE("assembly");
+    
     RHS = std::vector< double >(total_ndof,0.); //Zero the residual vector
     
-    if(input.mms_fxn!=NULL){//Add the manufactured solution forcing function if required
+    if(form_jacobian && (element_AMATRX.size()!=mapped_elements.size())){//Allocate the element jacobians if required
+        element_AMATRX = std::vector< std::vector< double > >(mapped_elements.size(), std::vector< double >(64*input.node_dof*input.node_dof,0.));
+    }
+    
+    //Find the nodes whose degrees of freedom changed since the last assembly
+    std::vector< unsigned char > changed_nodes;
+    flag_changed_nodes(changed_nodes);
+    
+    const unsigned char required_state = form_jacobian ? 2 : 1; //!The cached element values required by this assembly
+    
+    //Collect the elements which must be integrated (an element is re-used if its 
+    //cached values are valid and its nodes are unchanged)
+    std::vector< unsigned int > integration_order; //!The elements to integrate in the order they are scheduled
+    integration_order.reserve(mapped_elements.size());
+    for(unsigned int e=0; e<mapped_elements.size(); e++){
+        bool changed = (element_cache_state[e]<required_state);
+        for(int n=0; (n<8) && !changed; n++){changed = changed_nodes[mapped_elements[e].nodes[n]];}
+        if(changed){integration_order.push_back(e);}
+    }
+    
+    //Schedule the most expensive elements of the previous evaluation first so that the 
+    //threads finish together (longest processing time first)
+    if(num_threads>1){
+        std::stable_sort(integration_order.begin(), integration_order.end(),
+                         [this](const unsigned int &a, const unsigned int &b){return element_cost[a]>element_cost[b];});
+    }
+    
+    if(input.mms_fxn!=NULL){//Add the manufactured solution forcing function to the owned nodes if required
         for(int i=0; i<RHS.size(); i++){
-            RHS[i] = -F[i];   //Negative because the RHS is the residual for the nonlinear calculation
+            if(decomposition.owns_node(i/input.node_dof)){
+                RHS[i] = -F[i];   //Negative because the RHS is the residual for the nonlinear calculation
+            }
         }
     }
         
@@ -1142,66 +2969,426 @@ void FEAModel::assemble_RHS_and_jacobian_matrix(){
                 "| Computing RHS and global stiffness matrix\n"<<
                 "=\n";
         
-    std::vector< double > element_coordinates(24,0.);      //!The coordinates of the nodes in a given element
-    unsigned int internal_node_number;                     //!The number of the node as defined in the code
-    std::vector< double > element_u(input.node_dof*8,0.);  //!The solution variable for the element
-    std::vector< double > element_du(input.node_dof*8,0.); //!The change in solution variable for the element
-        
-    micro_element::Hex8 current_element;                   //!The current element
-        
-    for(int e=0; e<mapped_elements.size(); e++){//Iterate through the elements
-        //Construct the reference coordinates of the element
-        for(int n=0; n<8; n++){
+    /*!The elements are integrated independently (in parallel if num_threads>1) and 
+    their contributions are stored in element_RHS. The threads take the elements 
+    one at a time in order of decreasing cost so the balance follows changes in 
+    the cost of the elements e.g. as a plastic zone moves through the mesh. The 
+    contributions are then gathered at the nodes in ascending element order so 
+    no two threads ever write to the same degree of freedom and the result is 
+    identical to the serial sum.*/
+    
+    #pragma omp parallel num_threads(num_threads)
+    {
+        std::vector< double > element_coordinates(24,0.);      //!The coordinates of the nodes in a given element
+        unsigned int internal_node_number;                     //!The number of the node as defined in the code
+        std::vector< double > element_u(input.node_dof*8,0.);  //!The solution variable for the element
+        std::vector< double > element_du(input.node_dof*8,0.); //!The change in solution variable for the element
+        
+        micro_element::Hex8 current_element;                   //!The element workspace (one per thread)
+        current_element.set_quadrature_rule(input.quadrature_order);
+        current_element.hourglass_coefficient = input.hourglass_coefficient;
+        
+        #pragma omp for schedule(dynamic,1)
+        for(int k=0; k<integration_order.size(); k++){//Iterate through the elements to be integrated
+            const unsigned int e = integration_order[k];
+            
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            
+            //Construct the reference coordinates of the element
+            for(int n=0; n<8; n++){
                 
-            internal_node_number = mapped_elements[e].nodes[n];
+                internal_node_number = mapped_elements[e].nodes[n];
                 
-            for(int i=0; i<input.nodes[internal_node_number].coordinates.size(); i++){
-                element_coordinates[i+n*input.nodes[internal_node_number].coordinates.size()] = input.nodes[internal_node_number].coordinates[i];
+                for(int i=0; i<input.nodes[internal_node_number].coordinates.size(); i++){
+                    element_coordinates[i+n*input.nodes[internal_node_number].coordinates.size()] = input.nodes[internal_node_number].coordinates[i];
+                }
             }
-        }
             
-        if(input.verbose){
-            std::cout << "Element " << mapped_elements[e].number << " reference coords";
-            for(int i=0; i<element_coordinates.size(); i++){std::cout << " " << element_coordinates[i];}
-            std::cout << "\n";
-        }
+            if(input.verbose){
+                #pragma omp critical
+                {
+                    std::cout << "Element " << mapped_elements[e].number << " reference coords";
+                    for(int i=0; i<element_coordinates.size(); i++){std::cout << " " << element_coordinates[i];}
+                    std::cout << "\n";
+                }
+            }
             
-        //Construct the u vector and du for the element
-        for(int n=0; n<8; n++){
-            internal_node_number = mapped_elements[e].nodes[n];
-            for(int i=0; i<input.node_dof; i++){
-                element_u[i+n*input.node_dof]  =  u[internal_nodes_dof[internal_node_number][i]];
-                element_du[i+n*input.node_dof] = du[internal_nodes_dof[internal_node_number][i]];
+            //Construct the u vector and du for the element
+            for(int n=0; n<8; n++){
+                internal_node_number = mapped_elements[e].nodes[n];
+                for(int i=0; i<input.node_dof; i++){
+                    element_u[i+n*input.node_dof]  =  u[internal_nodes_dof[internal_node_number][i]];
+                    element_du[i+n*input.node_dof] = du[internal_nodes_dof[internal_node_number][i]];
+                }
+            }
+            
+            //Reset the element workspace to the current element
+            current_element.reset(element_coordinates, element_u, element_du,
+                                  input.fprops, input.iprops);
+            
+            //The element updates its trial state variables from the committed values in place
+            current_element.set_state_variables(state_variables.committed_block(e), state_variables.trial_block(e),
+                                                state_variables.num_sdvs());
+            
+            //Use the cached reference shape function values (built on the first evaluation)
+            if(cache_shape_functions){
+                if(!shape_function_caches[e].is_set){
+                    current_element.build_shape_function_cache(shape_function_caches[e]);
+                }
+                current_element.set_shape_function_cache(&shape_function_caches[e]);
             }
-        }
             
-        //Construct the element
-        current_element = micro_element::Hex8(element_coordinates, element_u, element_du,
-                                              input.fprops, input.iprops);
+            //Integrate the element
+            current_element.integrate_element(form_jacobian);
+            
+            //Store the element contribution to the RHS vector
+            for(int i=0; i<8*input.node_dof; i++){
+                element_RHS[e][i] = current_element.RHS(i);
+            }
             
-        //Integrate the element
-        current_element.integrate_element();
+            //Store the element jacobian
+            if(form_jacobian){
+                for(int i=0; i<8*input.node_dof; i++){
+                    for(int j=0; j<8*input.node_dof; j++){
+                        element_AMATRX[e][j+i*8*input.node_dof] = current_element.AMATRX(i,j);
+                    }
+                }
+            }
             
+            element_cache_state[e] = required_state;
+            element_cost[e]        = std::chrono::duration< double >(std::chrono::steady_clock::now()-start).count();
+        }
+        
         //Update the RHS vector and jacobian matrix
-        for(int n=0; n<8; n++){
-            internal_node_number = mapped_elements[e].nodes[n];
-            for(int i=0; i<input.node_dof; i++){
-                RHS[internal_nodes_dof[internal_node_number][i]] += current_element.RHS(i+n*input.node_dof);
+        #pragma omp for schedule(static)
+        for(int n=0; n<node_elements.size(); n++){//Iterate through the nodes
+            for(int k=0; k<node_elements[n].size(); k++){//Iterate through the elements connected to the node
+                for(int i=0; i<input.node_dof; i++){
+                    RHS[internal_nodes_dof[n][i]] += element_RHS[node_elements[n][k][0]][i+node_elements[n][k][1]*input.node_dof];
+                }
             }
         }
+    }
+    
+    //Add the contributions of the elements of the other ranks to the owned nodes
+    decomposition.accumulate_ghosts(RHS,input.node_dof);
+    
+    //Record the state of the cached element values
+    const unsigned int integrated_elements = integration_order.size();
+    num_integrated_elements = integrated_elements;
+    if(incremental_assembly){
+        assembled_u  = u;
+        assembled_du = du;
+    }
+    
+    MICROMORPHIC_COUNT("elements integrated",integrated_elements);
+    MICROMORPHIC_COUNT("elements reused",mapped_elements.size()-integrated_elements);
+    
+    if(incremental_assembly){
+        std::cout << "| Integrated " << integrated_elements << " of " << mapped_elements.size() << " elements\n";
+    }
+    
+    if(form_jacobian && (element_jacobian_index.size()==mapped_elements.size())){//Assemble the global jacobian in element order
+        std::fill(jacobian.valuePtr(),jacobian.valuePtr()+jacobian.nonZeros(),0.);
         
-        //for(int n=0; n<8; n++){
-        //    std::cout << "Element node " << n+1 << " RHS:";
-        //    for(int i=0; i<input.node_dof; i++){
-        //        std::cout << " " << current_element.RHS[i+n*input.node_dof];
-        //    }
-        //    std::cout << "\n";
-        //}
+        for(int e=0; e<mapped_elements.size(); e++){
+            for(int k=0; k<element_jacobian_index[e].size(); k++){
+                if(element_jacobian_index[e][k]>=0){
+                    jacobian.valuePtr()[element_jacobian_index[e][k]] += element_AMATRX[e][k];
+                }
+            }
+        }
     }
     //assert(1==0);
     return;
 }
     
+void FEAModel::flag_changed_nodes(std::vector< unsigned char > &changed_nodes) const{
+    /*!============================
+    |    flag_changed_nodes    |
+    ============================
+    
+    Flag the nodes with a degree of freedom (in 
+    u or du) which differs from the values of the 
+    last assembly. The elements are integrated 
+    from the nodal values alone so an element 
+    whose nodes are all unchanged has the same 
+    RHS and jacobian as in the last assembly. 
+    Every node is flagged if incremental assembly 
+    is disabled or there was no previous assembly.
+    
+    The values are compared exactly so any change, 
+    including a finite difference perturbation, 
+    flags the node.
+    
+    */
+    
+    if((!incremental_assembly) || (assembled_u.size()!=u.size()) || (assembled_du.size()!=du.size())){
+        changed_nodes = std::vector< unsigned char >(internal_nodes_dof.size(),1);
+        return;
+    }
+    
+    changed_nodes = std::vector< unsigned char >(internal_nodes_dof.size(),0);
+    for(unsigned int n=0; n<internal_nodes_dof.size(); n++){
+        for(unsigned int i=0; i<internal_nodes_dof[n].size(); i++){
+            unsigned int dof = internal_nodes_dof[n][i];
+            if((u[dof]!=assembled_u[dof]) || (du[dof]!=assembled_du[dof])){
+                changed_nodes[n] = 1;
+                break;
+            }
+        }
+    }
+}
+    
+/*!=
+|=> Checkpoint methods
+=*/
+    
+void FEAModel::write_checkpoint(const std::string &filename){
+    /*!==========================
+    |    write_checkpoint    |
+    ==========================
+    
+    Write the state of the model at the last 
+    converged increment to a checkpoint in the 
+    format described in driver.h.
+    
+    The state is copied into a buffer and the 
+    file is written by a separate thread so that 
+    the solution can continue. The checkpoint is 
+    written to filename.tmp and renamed once it 
+    is complete so that filename always holds a 
+    complete checkpoint. Only one checkpoint is 
+    written at a time.
+    
+    input:
+        filename: The name of the checkpoint
+    
+    */
+    
+    MICROMORPHIC_TIME_SCOPE("io write checkpoint");
+    
+    wait_for_checkpoint();
+    
+    //The input deck does not change so it is only serialized once. The nodes and elements
+    //are already in the internal order so it is written with the Input ordering and the
+    //order of the original deck is restored from input_node_order.
+    if(!checkpoint_mesh){
+        InputParser checkpoint_input = input;
+        checkpoint_input.node_ordering = "Input";
+        
+        std::ostringstream mesh;
+        checkpoint_input.write_binary_input(mesh);
+        checkpoint_mesh = std::make_shared< const std::string >(mesh.str());
+    }
+    
+    std::vector< uint32_t > nodes_dof;
+    for(unsigned int n=0; n<internal_nodes_dof.size(); n++){
+        nodes_dof.insert(nodes_dof.end(), internal_nodes_dof[n].begin(), internal_nodes_dof[n].end());
+    }
+    std::vector< uint32_t > node_order(input_node_order.begin(), input_node_order.end());
+    
+    std::vector< double > sdvs;
+    sdvs.reserve((size_t)state_variables.num_points()*state_variables.num_sdvs());
+    for(unsigned int e=0; e<state_variables.num_elements(); e++){
+        for(unsigned int g=0; g<state_variables.num_gauss_points(); g++){
+            for(unsigned int i=0; i<state_variables.num_sdvs(); i++){
+                sdvs.push_back(state_variables.committed(e, g, i));
+            }
+        }
+    }
+    
+    //Lay out the sections
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    
+    std::memcpy(header.magic, checkpoint_magic, sizeof(checkpoint_magic));
+    header.version          = checkpoint_version;
+    header.byte_order       = binary_mesh_byte_order;
+    header.rank             = decomposition.rank;
+    header.num_ranks        = decomposition.size;
+    header.increment_number = increment_number;
+    header.node_dof         = input.node_dof;
+    header.total_ndof       = total_ndof;
+    header.t                = input.t;
+    header.tp               = input.tp;
+    header.dt               = input.dt;
+    header.total_time       = input.total_time;
+    
+    uint64_t offset = align_binary_offset(sizeof(CheckpointHeader));
+    
+    BinarySection *sections[7]     = {&header.u, &header.up, &header.du, &header.internal_nodes_dof,
+                                      &header.input_node_order, &header.state_variables, &header.mesh};
+    const char    *section_data[6] = {(const char*)u.data(), (const char*)up.data(), (const char*)du.data(),
+                                      (const char*)nodes_dof.data(), (const char*)node_order.data(),
+                                      (const char*)sdvs.data()};
+    uint64_t       counts[7]       = {u.size(), up.size(), du.size(), nodes_dof.size(), node_order.size(),
+                                      sdvs.size(), checkpoint_mesh->size()};
+    uint64_t       entry_sizes[7]  = {sizeof(double), sizeof(double), sizeof(double), sizeof(uint32_t),
+                                      sizeof(uint32_t), sizeof(double), 1};
+    
+    for(int i=0; i<7; i++){
+        sections[i]->count  = counts[i];
+        sections[i]->offset = offset;
+        offset              = align_binary_offset(offset + counts[i]*entry_sizes[i]);
+    }
+    header.file_size = offset;
+    
+    //Copy everything but the input deck into the buffer which is written
+    std::shared_ptr< std::string > buffer = std::make_shared< std::string >(header.mesh.offset, '\0');
+    std::memcpy(&(*buffer)[0], &header, sizeof(header));
+    for(int i=0; i<6; i++){
+        std::memcpy(&(*buffer)[sections[i]->offset], section_data[i], counts[i]*entry_sizes[i]);
+    }
+    
+    std::shared_ptr< const std::string > mesh = checkpoint_mesh;
+    uint64_t padding = header.file_size - header.mesh.offset - mesh->size();
+    
+    std::thread *writer = new std::thread([buffer, mesh, padding, filename](){
+        MICROMORPHIC_TIME_SCOPE("io write checkpoint file");
+        
+        std::string temporary_filename = filename + ".tmp";
+        std::ofstream f(temporary_filename, std::ios::binary | std::ios::trunc);
+        
+        f.write(buffer->data(), buffer->size());
+        f.write(mesh->data(), mesh->size());
+        f.write(std::string(padding, '\0').data(), padding);
+        f.close();
+        
+        if(!f || (std::rename(temporary_filename.c_str(), filename.c_str())!=0)){
+            std::cout << "Warning: Could not write the checkpoint " << filename << "\n";
+        }
+    });
+    
+    //The writer is joined when it is released
+    checkpoint_writer = std::shared_ptr< std::thread >(writer, [](std::thread *thread){
+        if(thread->joinable()){thread->join();}
+        delete thread;
+    });
+    
+    std::cout << "\n|=> Writing checkpoint of increment " << increment_number << " to " << filename << "\n";
+    
+    return;
+}
+    
+void FEAModel::wait_for_checkpoint(){
+    /*!=============================
+    |    wait_for_checkpoint    |
+    =============================
+    
+    Wait until the last checkpoint has been 
+    written.
+    
+    */
+    
+    if(checkpoint_writer && checkpoint_writer->joinable()){
+        checkpoint_writer->join();
+    }
+    checkpoint_writer.reset();
+    
+    return;
+}
+    
+void FEAModel::read_checkpoint(const std::string &filename){
+    /*!=========================
+    |    read_checkpoint    |
+    =========================
+    
+    Restore the state of the model from a 
+    checkpoint written by write_checkpoint. The 
+    model must have been constructed from the 
+    input deck embedded in the checkpoint and the 
+    same decomposition. The embedded deck holds 
+    the nodes in the internal order so the order 
+    of the original deck (input_node_order) is 
+    restored from the checkpoint.
+    
+    input:
+        filename: The name of the checkpoint
+    
+    */
+    
+    MICROMORPHIC_TIME_SCOPE("io read checkpoint");
+    
+    MappedFile file(filename);
+    CheckpointHeader header = checkpoint_header(file, filename);
+    
+    if((header.rank!=decomposition.rank) || (header.num_ranks!=decomposition.size)){
+        std::cout << "Error: The checkpoint " << filename << " was written by rank " << header.rank << " of "
+                  << header.num_ranks << " ranks\n";
+        assert(1==0);
+    }
+    
+    if((header.total_ndof!=total_ndof) || (header.node_dof!=input.node_dof)){
+        std::cout << "Error: The checkpoint " << filename << " has " << header.total_ndof
+                  << " degrees of freedom but the model has " << total_ndof << "\n";
+        assert(1==0);
+    }
+    
+    const char *data = file.data();
+    const char *u_data  = binary_section(data, file.size(), header.u,  sizeof(double), 8, "u");
+    const char *up_data = binary_section(data, file.size(), header.up, sizeof(double), 8, "up");
+    const char *du_data = binary_section(data, file.size(), header.du, sizeof(double), 8, "du");
+    const uint32_t *nodes_dof  = (const uint32_t*)binary_section(data, file.size(), header.internal_nodes_dof, sizeof(uint32_t), 4, "internal nodes dof");
+    const uint32_t *node_order = (const uint32_t*)binary_section(data, file.size(), header.input_node_order, sizeof(uint32_t), 4, "input node order");
+    const double   *sdv_data   = (const double*)binary_section(data, file.size(), header.state_variables, sizeof(double), 8, "state variables");
+    
+    //The order of the original deck must be a permutation of the nodes
+    std::vector< bool > ordered(input_node_order.size(), false);
+    bool valid_order = (header.input_node_order.count==input_node_order.size());
+    for(unsigned int n=0; valid_order && (n<input_node_order.size()); n++){
+        valid_order = (node_order[n]<ordered.size()) && !ordered[node_order[n]];
+        if(valid_order){ordered[node_order[n]] = true;}
+    }
+    
+    //The degree of freedom vectors are only meaningful if the dof are numbered in the same way
+    bool same_numbering = valid_order && (header.u.count==total_ndof) && (header.up.count==total_ndof) && (header.du.count==total_ndof);
+    
+    uint64_t index = 0;
+    for(unsigned int n=0; same_numbering && (n<internal_nodes_dof.size()); n++){
+        same_numbering = (internal_nodes_dof[n].size() <= header.internal_nodes_dof.count - index) &&
+                         std::equal(internal_nodes_dof[n].begin(), internal_nodes_dof[n].end(), nodes_dof + index);
+        index += internal_nodes_dof[n].size();
+    }
+    
+    if(!same_numbering || (index!=header.internal_nodes_dof.count)){
+        std::cout << "Error: The degrees of freedom of the checkpoint " << filename << " are numbered differently than the model\n";
+        assert(1==0);
+    }
+    
+    std::memcpy(u.data(),  u_data,  total_ndof*sizeof(double));
+    std::memcpy(up.data(), up_data, total_ndof*sizeof(double));
+    std::memcpy(du.data(), du_data, total_ndof*sizeof(double));
+    
+    if(header.state_variables.count!=(uint64_t)state_variables.num_points()*state_variables.num_sdvs()){
+        std::cout << "Error: The checkpoint " << filename << " has " << header.state_variables.count
+                  << " state variables but the model has " << state_variables.num_points()*state_variables.num_sdvs() << "\n";
+        assert(1==0);
+    }
+    
+    std::vector< double > sdvs(state_variables.num_sdvs());
+    for(unsigned int e=0; e<state_variables.num_elements(); e++){
+        for(unsigned int g=0; g<state_variables.num_gauss_points(); g++){
+            sdvs.assign(sdv_data, sdv_data + sdvs.size());
+            state_variables.set_committed(e, g, sdvs);
+            sdv_data += sdvs.size();
+        }
+    }
+    state_variables.discard();
+    
+    input_node_order.assign(node_order, node_order + input_node_order.size());
+    
+    increment_number = header.increment_number;
+    input.t          = header.t;
+    input.tp         = header.tp;
+    input.dt         = header.dt;
+    input.total_time = header.total_time;
+    
+    std::cout << "=\n|=> Restarted from increment " << increment_number << " at time " << input.tp << "\n=\n";
+    
+    return;
+}
+    
 /*!=
 |=> Manufactured solutions methods
 =*/
@@ -1297,7 +3484,7 @@ void FEAModel::compute_mms_bc_values(){
     std::array< double, 3 > coordinates;            //!The coordinates of the node
     std::vector< unsigned int > internal_dof;       //!The internal numbering of the degree of freedom at the internal numbering of the nodes
         
-    if(input.mms_dirichlet_set_number>0){
+    if(input.mms_dirichlet_set_number<mapped_nodesets.size()){
         for(int n=0; n<mapped_nodesets[input.mms_dirichlet_set_number].nodes.size(); n++){//Iterate through the boundary nodes (internal numbering)
             node_number = mapped_nodesets[input.mms_dirichlet_set_number].nodes[n];       //Set the internal node number
             
@@ -1331,6 +3518,18 @@ void FEAModel::compare_manufactured_solution(){
     double max_relative_error=0;
     double error;
     double relative_error;
+    
+    decomposition.gather(u,input.node_dof); //Collect the solution from the owners of the nodes
+    
+    //Write the solutions in the order of the nodes in the input deck
+    std::vector< double > output_u(u.size());
+    std::vector< double > output_mms_u(mms_u.size());
+    for(unsigned int n=0; n<input_node_order.size(); n++){
+        for(unsigned int i=0; i<input.node_dof; i++){
+            output_u[i+n*input.node_dof]     = u[i+input_node_order[n]*input.node_dof];
+            output_mms_u[i+n*input.node_dof] = mms_u[i+input_node_order[n]*input.node_dof];
+        }
+    }
         
     for(int i=0; i<mms_u.size(); i++){
         error          = fabs(mms_u[i]-u[i]);
@@ -1346,11 +3545,13 @@ void FEAModel::compare_manufactured_solution(){
     }
     else{
         std::cout << "Error: Manufactured solution did not pass\n";
-        print_vector("u",u);
-        print_vector("mms_u",mms_u);
+        print_vector("u",output_u);
+        print_vector("mms_u",output_mms_u);
     }
     
     std::cout << "\nMaximum error: " << max_error << "\n";
+    
+    if(decomposition.rank>0){return;} //!The output files are written by the first rank
 
     //!Output the description file
     std::ofstream fn;
@@ -1368,26 +3569,85 @@ void FEAModel::compare_manufactured_solution(){
         fn << "False\n";
     }
     fn << "\nManufactured Solution:\n";
-    for(int i=0; i<mms_u.size(); i++){
-        fn << mms_u[i] << "\n";
+    for(int i=0; i<output_mms_u.size(); i++){
+        fn << output_mms_u[i] << "\n";
     }
     fn << "\n";
 
     fn << "\nFEA Solution:\n";
-    for(int i=0; i<u.size(); i++){
-        fn  << u[i] << "\n";
+    for(int i=0; i<output_u.size(); i++){
+        fn  << output_u[i] << "\n";
     }
     fn << "\n";
 
     fn << "\nDifference:\n";
-    for(int i=0; i<u.size(); i++){
-        fn << mms_u[i] - u[i] << "\n";
+    for(int i=0; i<output_u.size(); i++){
+        fn << output_mms_u[i] - output_u[i] << "\n";
     }
     fn << "\n";
     fn.close();
 
 }
 
+bool FEAModel::write_instrumentation_summary(const std::string &filename) const{
+    /*!=======================================
+    |    write_instrumentation_summary    |
+    =======================================
+    
+    Write the counts and cumulative times of the 
+    instrumented phases (material evaluation, 
+    element integration, assembly, the linear 
+    solver and I/O) merged over all of the threads. 
+    Filenames ending in .json are written as JSON 
+    and all others as a table.
+    
+    Returns false if the file could not be written 
+    or the code was compiled without 
+    MICROMORPHIC_INSTRUMENTATION.
+    
+    input:
+        filename: The name of the summary file
+    
+    */
+    
+    #ifdef MICROMORPHIC_INSTRUMENTATION
+    return instrumentation::write_summary(filename);
+    #else
+    std::cout << "Warning: compiled without MICROMORPHIC_INSTRUMENTATION. No summary written to " << filename << "\n";
+    return false;
+    #endif
+}
+
+#ifndef MICROMORPHIC_DRIVER_NO_MAIN
+//!The driver executable. Defining MICROMORPHIC_DRIVER_NO_MAIN allows the 
+//!FEAModel to be linked into other programs (e.g. the benchmarks)
+static std::string rank_filename(const std::string &filename, const domain_decomposition::Decomposition &world){
+    /*!=======================
+    |    rank_filename    |
+    =======================
+    
+    Return the name of the file of this rank by 
+    inserting .rank<rank> before the extension if 
+    there is more than one rank.
+    
+    input:
+        filename: The name of the file
+        world:    The decomposition of the ranks
+    
+    */
+    
+    if(world.size<2){return filename;}
+    
+    std::string rank_string = ".rank" + std::to_string(world.rank);
+    std::string result      = filename;
+    std::size_t extension   = result.rfind(".");
+    
+    if(extension==std::string::npos){result += rank_string;}
+    else{result.insert(extension, rank_string);}
+    
+    return result;
+}
+
 int main( int argc, char *argv[] ){
     /*!===
        |
@@ -1399,17 +3659,109 @@ int main( int argc, char *argv[] ){
         micromorphic finite elements written for use in Abaqus UEL 
         subroutines.
         
+        If compiled with MICROMORPHIC_MPI the elements are partitioned 
+        between the ranks (e.g. mpirun -np 4 driver <filename>) and only 
+        the first rank writes to std::cout. Every rank holds all of the 
+        nodes and degree of freedom vectors. The NewtonDirect and 
+        NewtonBiCGSTAB solvers are rejected with more than one rank.
+        
+        If the environment variable MICROMORPHIC_GMRES_CYCLES is set each 
+        Newton-Krylov iteration runs up to that many GMRES cycles, restarting 
+        GMRES when it has not converged (default 1).
+        
+        If the environment variable MICROMORPHIC_TANGENT_REUSE_RATE is set 
+        the Newton solvers reuse the jacobian of earlier iterations while 
+        the ratio of successive residual norms is below its value (modified 
+        Newton).
+        
+        If the environment variable MICROMORPHIC_ADAPTIVE_TIMESTEP is set to 
+        a non-zero value failed increments are rolled back and re-attempted 
+        with a smaller timestep and the timestep grows after quickly 
+        converged increments (default 0, a fixed timestep).
+        
+        If the environment variable MICROMORPHIC_CHECKPOINT_OUTPUT is set 
+        each rank writes a checkpoint to that file (with the rank inserted 
+        before the extension) every MICROMORPHIC_CHECKPOINT_INTERVAL 
+        (default 1) converged increments. A run is restarted with 
+        driver --restart <checkpoint> which reads the checkpoint of each 
+        rank in place of the input deck.
+        
     */
     
-    if (argc != 2){ // We expect two arguments for use of the code
-        std::cout << "usage: " << argv[0] << " <filename>\n";
+    #ifdef MICROMORPHIC_MPI
+    MPI_Init(&argc, &argv);
+    #endif
+    
+    domain_decomposition::Decomposition world = domain_decomposition::world_decomposition();
+    if(world.rank>0){std::cout.setstate(std::ios_base::failbit);}
+    
+    // A restart reads the checkpoint of each rank in place of the input deck
+    const bool restart  = (argc > 1) && (!std::string(argv[1]).compare("--restart"));
+    const int  argument = restart ? 2 : 1;
+    
+    if ((argc == 4) && (!std::string(argv[1]).compare("--convert"))){
+        // Convert a keyword input deck to the binary format
+        InputParser IP(argv[2]);
+        IP.read_input();
+        IP.write_binary_input(argv[3]);
+    }
+    else if ((argc != argument+1) && (argc != argument+2)){ // We expect a filename and optionally the number of threads
+        std::cout << "usage: " << argv[0] << " <filename> [num_threads]\n";
+        std::cout << "       " << argv[0] << " --restart <checkpoint> [num_threads]\n";
+        std::cout << "       " << argv[0] << " --convert <input deck> <binary input deck>\n";
     }
     else{
         // The first argument is assumed to be a filename to open
-        InputParser IP(argv[1]);
+        InputParser IP(restart ? rank_filename(argv[argument], world) : std::string(argv[argument]));
         IP.read_input();
         FEAModel FM = FEAModel(IP);
+        
+        // The optional next argument is the number of assembly threads
+        if(argc == argument+2){
+            FM.num_threads = std::max(1, std::atoi(argv[argument+1]));
+        }
+        
+        // Restart GMRES within each Newton-Krylov iteration if requested
+        const char *gmres_cycles = std::getenv("MICROMORPHIC_GMRES_CYCLES");
+        if(gmres_cycles){
+            FM.gmres_cycles = std::max(1, std::atoi(gmres_cycles));
+        }
+        
+        // Reuse the jacobian while the ratio of successive residual norms is below the given rate if requested
+        const char *tangent_reuse_rate = std::getenv("MICROMORPHIC_TANGENT_REUSE_RATE");
+        if(tangent_reuse_rate){
+            FM.modified_newton    = true;
+            FM.tangent_reuse_rate = std::atof(tangent_reuse_rate);
+        }
+        
+        // Cut back the timestep of failed increments and grow it after quick ones if requested
+        const char *adaptive_timestep = std::getenv("MICROMORPHIC_ADAPTIVE_TIMESTEP");
+        if(adaptive_timestep){
+            FM.adaptive_timestep = std::atoi(adaptive_timestep) != 0;
+        }
+        
+        // Write checkpoints if requested (one file per rank if there is more than one)
+        const char *checkpoint_output   = std::getenv("MICROMORPHIC_CHECKPOINT_OUTPUT");
+        const char *checkpoint_interval = std::getenv("MICROMORPHIC_CHECKPOINT_INTERVAL");
+        if(checkpoint_output){
+            FM.checkpoint_filename = rank_filename(checkpoint_output, world);
+        }
+        if(checkpoint_interval){
+            FM.checkpoint_interval = std::max(1, std::atoi(checkpoint_interval));
+        }
+        
         FM.solve();
+        
+        // Write the instrumentation summary if requested (one file per rank if there is more than one)
+        const char *instrumentation_output = std::getenv("MICROMORPHIC_INSTRUMENTATION_OUTPUT");
+        if(instrumentation_output){
+            FM.write_instrumentation_summary(rank_filename(instrumentation_output, world));
+        }
     }
+    
+    #ifdef MICROMORPHIC_MPI
+    MPI_Finalize();
+    #endif
         
 }
+#endif
@@ -25,6 +25,10 @@
   |                proof of concept prior to the        |
   |                implementation of a more traditional |
   |                Newton-Raphson method.               |
+  | domain_decomposition:                               |
+  |                The partition of the elements        |
+  |                between MPI ranks and the exchange   |
+  |                of the shared nodal values.          |
   =======================================================*/
   
 #include <iostream>
@@ -32,7 +36,17 @@
 #include <string>
 #include <cstdlib>
 #include <vector>
+#include <array>
+#include <unordered_map>
 #include <ctime>
+#include <memory>
+#include <thread>
+#include <cstdint>
+#include <algorithm>
+#include <Eigen/Sparse>
+#include <Eigen/Dense>
+#include <domain_decomposition.h>
+#include <state_variable_store.h>
 
 std::string trim(const std::string& str, const std::string& whitespace = " \t");
 
@@ -123,6 +137,216 @@ class NodeSet{
     NodeSet(std::string _name, std::vector< unsigned int> _nodes);
 };
 
+template< typename T > class ArrayView{
+    /*!===
+       |
+       | A r r a y V i e w
+       |
+      ===
+        
+        A read only view of a contiguous array. The 
+        storage (a vector or a memory mapped file) is 
+        shared by all of the copies of the view and is 
+        released when the last copy is destroyed.
+        
+    */
+    
+    public:
+        ArrayView(){
+            /*!Default constructor*/
+            values = NULL;
+            length = 0;
+        }
+        
+        ArrayView(std::shared_ptr< const void > _owner, const T *_values, size_t _length){
+            /*!Full constructor*/
+            owner  = _owner;
+            values = _values;
+            length = _length;
+        }
+        
+        ArrayView(std::vector< T > &&_values){
+            /*!Take ownership of a vector*/
+            std::shared_ptr< std::vector< T > > storage = std::make_shared< std::vector< T > >(std::move(_values));
+            owner  = storage;
+            values = storage->data();
+            length = storage->size();
+        }
+        
+        size_t size() const{return length;}
+        
+        const T* data() const{return values;}
+        
+        const T* begin() const{return values;}
+        
+        const T* end() const{return values + length;}
+        
+        const T& operator[](size_t i) const{return values[i];}
+        
+    private:
+        std::shared_ptr< const void > owner;  //!The owner of the storage
+        const T                      *values; //!The first value
+        size_t                        length; //!The number of values
+};
+
+class MappedFile{
+    /*!===
+       |
+       | M a p p e d F i l e
+       |
+      ===
+        
+        A file mapped read only into memory. The 
+        mapping is removed when the object is destroyed.
+        
+    */
+    
+    public:
+        MappedFile(const std::string &filename);
+        
+        ~MappedFile();
+        
+        const char* data() const;
+        
+        size_t size() const;
+        
+    private:
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+        
+        const char *address; //!The start of the mapping
+        size_t      length;  //!The length of the mapping in bytes
+};
+
+/*!=
+   |=> Binary mesh format
+   =
+
+   The binary input deck is a header followed by 
+   the sections it describes. Every section starts 
+   at a multiple of eight bytes so the node and 
+   element sections can be used in place as arrays 
+   of Node and Element. All values are written in 
+   the byte order of the machine which wrote them 
+   and the header records that order.
+   
+   Section            | Contents
+   -------------------+-------------------------------------------
+   nodes              | Node[num_nodes]
+   elements           | Element[num_elements]
+   fprops             | double[num_fprops]
+   iprops             | int32_t[num_iprops]
+   dirichlet_bcs      | BinaryDirichletBC[num_dirichlet_bcs]
+   nodesets           | BinaryNodeSet[num_nodesets]
+   nodeset_nodes      | uint32_t[num_nodeset_nodes]
+   strings            | char[strings_size]
+
+*/
+
+const char     binary_mesh_magic[8]  = {'M','I','C','R','O','M','S','H'}; //!Identifies a binary input deck
+const uint32_t binary_mesh_version   = 3;                                 //!The version of the binary format
+const uint32_t binary_mesh_byte_order = 0x01020304;                       //!Used to detect a change of byte order
+
+struct BinaryString{
+    uint64_t offset; //!The offset of the string in the string section
+    uint64_t length; //!The length of the string
+};
+
+struct BinarySection{
+    uint64_t count;  //!The number of entries in the section
+    uint64_t offset; //!The offset of the section from the start of the file
+};
+
+struct BinaryDirichletBC{
+    uint32_t node_number; //!The node number at which the BC is applied
+    int32_t  dof_number;  //!The local degree of freedom which is constrained
+    double   value;       //!The value of the boundary condition
+};
+
+struct BinaryNodeSet{
+    BinaryString name;        //!The nodeset name
+    uint64_t     nodes_begin; //!The index of the first node in the nodeset node section
+    uint64_t     nodes_count; //!The number of nodes in the nodeset
+};
+
+struct BinaryMeshHeader{
+    char          magic[8];                 //!The binary_mesh_magic characters
+    uint32_t      version;                  //!The version of the format
+    uint32_t      byte_order;               //!binary_mesh_byte_order as written
+    uint32_t      node_dof;                 //!The number of degrees of freedom at a node
+    uint32_t      mms_dirichlet_set_number; //!The nodeset used for the manufactured solution boundary
+    uint64_t      file_size;                //!The total size of the file in bytes
+    BinarySection nodes;                    //!The nodes
+    BinarySection elements;                 //!The elements
+    BinarySection fprops;                   //!The floating point properties
+    BinarySection iprops;                   //!The integer properties
+    BinarySection dirichlet_bcs;            //!The dirichlet boundary conditions
+    BinarySection nodesets;                 //!The nodeset descriptions
+    BinarySection nodeset_nodes;            //!The nodes of all of the nodesets
+    BinarySection strings;                  //!The characters of all of the strings
+    BinaryString  latex;                    //!The description of the input deck
+    BinaryString  mms_name;                 //!The name of the manufactured solution
+    BinaryString  solver;                   //!The solution technique
+    BinaryString  node_ordering;            //!The ordering of the internal nodes
+    uint32_t      quadrature_order;         //!The number of gauss points in each direction of the elements
+    uint32_t      reserved;                 //!Padding (zero)
+    double        hourglass_coefficient;    //!The hourglass stiffness of the single point rule
+};
+
+/*!=
+   |=> Checkpoint format
+   =
+
+   A checkpoint is a header followed by the 
+   sections it describes using the same layout 
+   rules as the binary input deck. The mesh 
+   section is a complete binary input deck so 
+   a checkpoint can be restarted without the 
+   original input deck. The nodes and elements 
+   of the mesh are stored in the internal order 
+   (with the Input node ordering) and 
+   input_node_order maps the nodes of the 
+   original deck to them. Each rank writes its 
+   own checkpoint.
+   
+   Section            | Contents
+   -------------------+-------------------------------------------
+   u                  | double[total_ndof]
+   up                 | double[total_ndof]
+   du                 | double[total_ndof]
+   internal_nodes_dof | uint32_t[num_nodes*node_dof]
+   input_node_order   | uint32_t[num_nodes]
+   state_variables    | double[num_elements*num_gauss_points*num_sdvs]
+   mesh               | char[mesh_size] (a binary input deck)
+
+*/
+
+const char     checkpoint_magic[8] = {'M','I','C','R','O','C','K','P'}; //!Identifies a checkpoint
+const uint32_t checkpoint_version  = 3;                                 //!The version of the checkpoint format
+
+struct CheckpointHeader{
+    char          magic[8];           //!The checkpoint_magic characters
+    uint32_t      version;            //!The version of the format
+    uint32_t      byte_order;         //!binary_mesh_byte_order as written
+    uint32_t      rank;               //!The rank which wrote the checkpoint
+    uint32_t      num_ranks;          //!The number of ranks of the decomposition
+    uint32_t      increment_number;   //!The number of the last converged increment
+    uint32_t      node_dof;           //!The number of degrees of freedom at a node
+    uint64_t      total_ndof;         //!The total number of degrees of freedom
+    uint64_t      file_size;          //!The total size of the file in bytes
+    double        t;                  //!The time at the end of the next increment
+    double        tp;                 //!The time of the last converged increment
+    double        dt;                 //!The timestep of the next increment
+    double        total_time;         //!The total time of the simulation
+    BinarySection u;                  //!The current degree of freedom vector
+    BinarySection up;                 //!The previous degree of freedom vector
+    BinarySection du;                 //!The change in the degree of freedom vector
+    BinarySection internal_nodes_dof; //!The global degrees of freedom of each internal node
+    BinarySection input_node_order;   //!The internal number of each node of the input deck
+    BinarySection state_variables;    //!The committed state variables [element][gauss point][state variable]
+    BinarySection mesh;               //!The binary input deck of the model
+};
+
 std::vector< double > mms_const_u(std::array< double, 3 > coords, double t);
 
 std::vector< double > mms_linear_u(std::array< double, 3 > coords, double t);
@@ -149,15 +373,15 @@ class InputParser{
             std::string path_to_file;                                                 //!String giving the path to the file
             
             std::string latex_string;                                                 //!The description of the input deck
-            std::vector< Node > nodes;                                                //!List of the nodes in the finite element model
+            ArrayView< Node > nodes;                                                  //!List of the nodes in the finite element model
                                                                                       //!and their coordinates
             std::vector< DirichletBC > dirichlet_bcs;                                 //!A list of the dirichlet boundary conditions
             
             unsigned int node_dof;                                                    //!The number of degrees of freedom at a node
-            std::vector< Element > elements;                                          //!A list of the elements as defined by their nodes in the model
+            ArrayView< Element > elements;                                            //!A list of the elements as defined by their nodes in the model
             std::vector< double > fprops;                                             //!The floating point properties of the material model
             std::vector< int   > iprops;                                              //!The integer properties of the material model
-            std::vector< std::vector< float > > svars;                                //!A list of the state variables for each element
+            unsigned int num_sdvs = 0;                                                //!The number of state variables at each gauss point
             std::vector< NodeSet > nodesets;                                          //!A list of the nodesets
             
             std::string mms_name = "";                                                //!The name of the manufactured solution being tested
@@ -170,7 +394,16 @@ class InputParser{
             double t          = 0.0;                                                  //!The current value of the time
             double dt         = 0.3;                                                  //!The current timestep
             
+            std::string solver = "NewtonKrylov";                                      //!The solution technique (NewtonKrylov, NewtonKrylovTangent, 
+                                                                                      //!NewtonKrylovBlockJacobi, NewtonKrylovTangentBlockJacobi, 
+                                                                                      //!NewtonDirect, NewtonBiCGSTAB, or ExplicitCentralDifference)
+            std::string node_ordering = "Input";                                      //!The ordering of the internal nodes (Input, RCM, or SFC)
+            int    quadrature_order      = 2;                                         //!The number of gauss points in each direction of the elements
+            double hourglass_coefficient = 0.05;                                      //!The hourglass stiffness of the single point rule
+            
             bool verbose = false;                                                     //!The verbosity of the output
+            bool restart = false;                                                     //!The input was read from a checkpoint which is restored 
+                                                                                      //!by FEAModel
             void (InputParser::* keyword_fxn)(unsigned int, std::string);             //!The keyword processing function
             
             //!=
@@ -187,12 +420,33 @@ class InputParser{
             
             void read_input();
             
+            void write_binary_input(const std::string &binary_filename) const;
+            
+            void write_binary_input(std::ostream &f) const;
+            
+            void read_binary_input(const std::shared_ptr< MappedFile > &file, uint64_t begin, uint64_t size);
+            
         private:
             //!Private attributes
             char comment = '#'; //!Character which indicates a comment
             char keyword = '*'; //!Character which indicates a keyword
             
+            std::vector< Node >    parsed_nodes;    //!The nodes read from a text input deck
+            std::vector< Element > parsed_elements; //!The elements read from a text input deck
+            
             //!Private methods
+            bool is_binary_input();
+            
+            bool is_checkpoint_input();
+            
+            void read_text_input();
+            
+            void read_binary_input();
+            
+            void read_checkpoint_input();
+            
+            void set_manufactured_solution(unsigned int line_number, const std::string &fxn_name);
+            
             void process_keyword(const unsigned int &line_number, std::string &line);
             
             void default_function(unsigned int line_number, std::string line);
@@ -208,6 +462,12 @@ class InputParser{
             void parse_nodesets(unsigned int line_number, std::string line);
             
             void parse_manufactured_solution(unsigned int line_number, std::string line);
+            
+            void parse_solver(unsigned int line_number, std::string line);
+            
+            void parse_node_ordering(unsigned int line_number, std::string line);
+            
+            void parse_quadrature(unsigned int line_number, std::string line);
 };
 
 class FEAModel{
@@ -235,21 +495,102 @@ class FEAModel{
         
         std::vector< Element > mapped_elements;   //!The elements defined with internal node numbering
         std::vector< NodeSet > mapped_nodesets;   //!A list of the nodesets mapped to the internal node numbering
+        std::vector< unsigned int > input_node_order; //!The internal number of each node in the order of the input deck
         std::vector< unsigned int > unbound_dof;  //!A list of all of the unbound degrees of freedom
         
         std::vector< double > RHS;                //!The right hand side vector
         
         int maxiter = 20;                         //!The maximum number of iterations allowed at each timestep
+        unsigned int krylov_maxiter = 10;         //!The maximum number of Newton-Krylov iterations allowed at each timestep
         double atol = 1e-9;                       //!The absolute tolerance on the solver
         double rtol = 1e-7;                       //!The relative tolerance on the solver
         double mms_tol = 1e-6;                    //!The tolerance on the method of manufactured solutions comparison
         unsigned int increment_number = 0;        //!The current increment number
+        unsigned int newton_iterations = 0;       //!The number of Newton iterations of the last increment
+        
+        bool adaptive_timestep = false;           //!Cut back the timestep of failed increments and grow it after quick ones
+        double dt_min = 1e-3;                     //!The smallest timestep as a fraction of the total time
+        double dt_max = 1.0;                      //!The largest timestep as a fraction of the total time
+        double cutback_factor = 0.5;              //!The factor on the timestep after a failed increment
+        double growth_factor = 1.5;               //!The factor on the timestep after a quickly converged increment
+        unsigned int fast_iterations = 4;         //!The largest number of Newton iterations of a quickly converged increment
         
         std::vector< double > F;                  //!The forcing function for the method of manufactured solutions
         std::vector< double > mms_u;              //!The manufactured solution.
         
         double alpha = 1.0;                       //!The relaxation parameter
+        unsigned int gmres_cycles = 1;            //!The maximum number of GMRES cycles of each Newton-Krylov 
+                                                  //!iteration (more than one restarts GMRES)
         std::string solver = "NewtonKrylov";      //!The solution to use
+        
+        unsigned int num_threads = 1;             //!The number of threads used in the element assembly
+        std::vector< std::vector< std::array< unsigned int, 2 > > > node_elements; //!The elements and local node numbers connected to each 
+                                                                                   //!internal node ordered by element number
+        std::vector< std::vector< double > > element_RHS;                          //!The right hand side vector of each element
+        
+        bool incremental_assembly = true;                                          //!Only integrate the elements whose degrees of freedom changed 
+                                                                                   //!since the last assembly
+        std::vector< double > assembled_u;                                         //!The degree of freedom vector of the last assembly
+        std::vector< double > assembled_du;                                        //!The change in the degree of freedom vector of the last assembly
+        std::vector< unsigned char > element_cache_state;                          //!The cached element values which are valid for the last assembly 
+                                                                                   //!(0: none, 1: element_RHS, 2: element_RHS and element_AMATRX)
+        unsigned int num_integrated_elements = 0;                                  //!The number of elements integrated in the last assembly
+        std::vector< double > element_cost;                                        //!The time in seconds of the last integration of each element 
+                                                                                   //!(used to order the elements in the threaded assembly)
+        
+        bool cache_shape_functions = true;                                         //!Cache the reference shape function values of each element
+        std::vector< micro_element::ShapeFunctionCache > shape_function_caches;    //!The cached reference shape function values of each element
+        
+        micromorphic_material_library::StateVariableStore state_variables;         //!The committed and trial state variables of the gauss points 
+                                                                                   //!indexed by mapped element (one block per element)
+        
+        bool form_jacobian = false;                                                //!Flag which indicates if the global jacobian should be assembled
+        std::vector< int > unbound_index;                                          //!The index of each global dof in unbound_dof (-1 if the dof is bound)
+        std::vector< std::vector< int > > element_jacobian_index;                  //!The location in the global jacobian's value array of each term 
+                                                                                   //!of the element jacobian (-1 if the term is not assembled)
+        std::vector< std::vector< double > > element_AMATRX;                       //!The jacobian of each element (dRHSdU) stored row-major
+        std::vector< double > element_Jv;                                          //!The workspace of the element products of krylov_jacobian_product 
+                                                                                   //![element][element dof]
+        std::vector< double > global_v;                                            //!The workspace of the vector of krylov_jacobian_product at all of the dof
+        std::vector< double > global_Jv;                                           //!The workspace of the product of krylov_jacobian_product at all of the dof
+        Eigen::SparseMatrix< double > jacobian;                                    //!The jacobian of the unbound RHS w.r.t. the unbound dof
+        double linear_tol = 1e-12;                                                 //!The relative tolerance of the iterative linear solver
+        bool analytic_matvec = false;                                              //!Use the cached element jacobians for the Krylov matrix-vector products
+        bool block_jacobi = false;                                                 //!Precondition the Krylov solve with the nodal blocks of the jacobian
+        
+        bool modified_newton = false;                                              //!Reuse the jacobian (and its factorization) of an earlier iteration 
+                                                                                   //!or increment while the residual converges quickly
+        double tangent_reuse_rate = 0.25;                                          //!The largest ratio of successive residual norms for which the 
+                                                                                   //!jacobian is reused
+        bool tangent_valid = false;                                                //!The jacobian of an earlier iteration is available for reuse
+        double previous_residual_norm = 0.;                                        //!The residual norm of the previous Newton iteration
+        std::shared_ptr< Eigen::SparseLU< Eigen::SparseMatrix< double > > > direct_solver; //!The factorized jacobian (NewtonDirect)
+        std::shared_ptr< Eigen::BiCGSTAB< Eigen::SparseMatrix< double >, Eigen::IncompleteLUT< double > > > iterative_solver; //!The preconditioned 
+                                                                                   //!iterative solver of the jacobian (NewtonBiCGSTAB)
+        std::vector< Eigen::PartialPivLU< Eigen::MatrixXd > > nodal_block_factors; //!The factored diagonal node_dof x node_dof block of each internal node
+        
+        std::vector< double > lumped_mass;                                         //!The lumped (diagonal) mass of each global dof
+        std::vector< double > velocity;                                            //!The velocity of the degrees of freedom (at the middle of the 
+                                                                                   //!last timestep of the explicit solver)
+        std::vector< double > acceleration;                                        //!The acceleration of the degrees of freedom
+        bool hrz_lumping = false;                                                  //!Use the HRZ rather than the row-sum lumped mass
+        std::vector< double > micro_inertia = {1,0,0,0,1,0,0,0,1};                 //!The micro-inertia per unit mass of the elements in the reference 
+                                                                                   //!configuration (row-major)
+        double explicit_dt = 0.;                                                   //!The timestep of the explicit solver (0 uses the estimated 
+                                                                                   //!stable timestep)
+        double explicit_safety = 0.9;                                              //!The fraction of the estimated stable timestep used by the 
+                                                                                   //!explicit solver
+        
+        domain_decomposition::Decomposition decomposition;                         //!The partition of the elements and the nodes between the MPI ranks
+        std::vector< unsigned int > krylov_dof;                                    //!The global dof of the Krylov vectors (the unbound dof owned by this rank)
+        std::vector< int > krylov_index;                                           //!The index of each global dof in krylov_dof (-1 if the dof is bound 
+                                                                                   //!or owned by another rank)
+        
+        std::string checkpoint_filename = "";                                      //!The file the checkpoints of this rank are written to (empty 
+                                                                                   //!disables checkpointing)
+        unsigned int checkpoint_interval = 1;                                      //!The number of converged increments between checkpoints
+        std::shared_ptr< const std::string > checkpoint_mesh;                      //!The binary input deck written to each checkpoint
+        std::shared_ptr< std::thread > checkpoint_writer;                          //!The thread writing the last checkpoint (joined when released)
     
     FEAModel();
     
@@ -257,8 +598,14 @@ class FEAModel{
     
     void map_element_nodes();
     
+    void renumber_nodes();
+    
+    void partition_elements();
+    
     void map_nodesets();
     
+    void map_node_elements();
+    
     /*!=
     |=> Degrees of freedom methods
     =*/
@@ -279,20 +626,58 @@ class FEAModel{
     
     bool solve();
     
+    bool advance_timestep(const bool converged);
+    
     bool increment_solution();
     
     void initialize_timestep();
     
-    void update_increment();
+    bool update_increment();
+    
+    void rollback_increment();
     
     void assemble_RHS_and_jacobian_matrix();
     
-    void run_newton_krylov();
+    void flag_changed_nodes(std::vector< unsigned char > &changed_nodes) const;
+    
+    bool run_newton_krylov();
+    
+    void form_jacobian_sparsity();
+    
+    bool run_newton_sparse();
     
     std::vector< double > krylov_residual(std::vector<double> _du);
     
+    std::vector< double > krylov_jacobian_product(const std::vector< double > &v);
+    
     std::vector< double > get_unbound_du();
     
+    void form_block_jacobi_preconditioner();
+    
+    void apply_block_jacobi_preconditioner(const std::vector< double > &v, std::vector< double > &z) const;
+    
+    bool reuse_tangent(const unsigned int iteration, const double &residual_norm);
+    
+    /*!=
+    |=> Explicit dynamics methods
+    =*/
+    
+    void assemble_lumped_mass();
+    
+    double estimate_stable_timestep();
+    
+    bool run_explicit_dynamics();
+    
+    /*!=
+    |=> Checkpoint methods
+    =*/
+    
+    void write_checkpoint(const std::string &filename);
+    
+    void wait_for_checkpoint();
+    
+    void read_checkpoint(const std::string &filename);
+    
     /*!=
     |=> Manufactured solutions methods
     =*/
@@ -306,6 +691,12 @@ class FEAModel{
     void compute_mms_bc_values();
     
     void compare_manufactured_solution();
+    
+    /*!=
+    |=> Instrumentation methods
+    =*/
+    
+    bool write_instrumentation_summary(const std::string &filename) const;
 };
 
 typedef std::vector<double> (FEAModel::*residual_function)(const std::vector<double>&); //!Type definition for a newton-krylov residual function
@@ -352,10 +743,76 @@ class FEAKrylovSolver: public KrylovSolver{
     */
     public:
         FEAKrylovSolver(FEAModel &model, std::vector< double > _u,
-                        unsigned int _imax, unsigned int _kmax, bool _verbose):KrylovSolver(&model, _u, _imax, _kmax, _verbose){};
+                        unsigned int _imax, unsigned int _kmax, bool _verbose):KrylovSolver(&model, _u, _imax, _kmax, _verbose){
+            /*!The vectors are distributed between the ranks so the norm of 
+            u and the limit on kmax use the global values which are the 
+            same on every rank*/
+            double global_size = u.size();
+            global_sum(&global_size,1);
+            kmax   = std::min(_kmax, (unsigned int)global_size);
+            norm_u = vector_norm(u);
+        };
+        
+        void global_sum(double *values, const unsigned int &n){
+            /*!Redefine the global_sum method to sum over the ranks of the 
+            decomposition of the model*/
+            model->decomposition.sum(values,n);
+        }
                     
         std::vector< double > get_residual(std::vector< double > du){
-            /*!Redefine the get_residual method to use the desired method of model*/
-            return model->krylov_residual(du);
+            /*!Redefine the get_residual method to use the desired method of model. 
+            If the analytic matrix-vector product is used the element jacobians 
+            are computed along with the residual.*/
+            model->form_jacobian = model->analytic_matvec && !model->modified_newton;
+            std::vector< double > residual = model->krylov_residual(du);
+            model->form_jacobian = false;
+            return residual;
+        }
+        
+        std::vector< double > jacobian_vector_product(const std::vector< double > &s){
+            /*!Redefine the jacobian_vector_product method to use the cached element 
+            jacobians of the model if requested*/
+            if(model->analytic_matvec){
+                return model->krylov_jacobian_product(s);
+            }
+            return residual_derivative(s);
+        }
+        
+        void update_preconditioner(){
+            /*!Form and factor the nodal block-Jacobi preconditioner at the 
+            current solution if requested. The element jacobians are only 
+            computed with the residual when the analytic matrix-vector 
+            product is used so they are formed here otherwise.
+            
+            With modified Newton the residual is evaluated without the 
+            element jacobians. The element jacobians and the preconditioner 
+            of an earlier iteration are kept unless the convergence has 
+            slowed in which case they are formed at the current solution.*/
+            if(model->modified_newton && (model->analytic_matvec || model->block_jacobi)){
+                if(model->reuse_tangent(NKi, vector_norm(R))){return;}
+                model->form_jacobian = true;
+                model->krylov_residual(u);
+                model->form_jacobian = false;
+                if(model->block_jacobi){model->form_block_jacobi_preconditioner();}
+                model->tangent_valid = true;
+                return;
+            }
+            if(!model->block_jacobi){return;}
+            if(!model->analytic_matvec){
+                model->form_jacobian = true;
+                model->krylov_residual(u);
+                model->form_jacobian = false;
+            }
+            model->form_block_jacobi_preconditioner();
+        }
+        
+        void apply_preconditioner(const std::vector< double > &v, std::vector< double > &z){
+            /*!Redefine the apply_preconditioner method to use the nodal 
+            block-Jacobi preconditioner of the model if requested*/
+            if(model->block_jacobi){
+                model->apply_block_jacobi_preconditioner(v,z);
+                return;
+            }
+            z = v;
         }
 };
\ No newline at end of file
@@ -0,0 +1,343 @@
+/*!=======================================================
+  |                                                     |
+  |                  instrumentation.h                  |
+  |                                                     |
+  -------------------------------------------------------
+  | Counters and cumulative timers for the hot paths    |
+  | of the element, the driver and the material         |
+  | library.                                            |
+  |                                                     |
+  | The instrumentation is only compiled in when        |
+  | MICROMORPHIC_INSTRUMENTATION is defined. Otherwise  |
+  | the macros expand to nothing.                       |
+  |                                                     |
+  | Each thread records into its own counters which     |
+  | are merged when the summary is written or the       |
+  | thread exits. If the environment variable           |
+  | MICROMORPHIC_INSTRUMENTATION_OUTPUT is set the      |
+  | summary is written to that file at exit if it has   |
+  | not been written already. Filenames ending in .json |
+  | are written as JSON and all others as a table.      |
+  =======================================================*/
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#ifdef MICROMORPHIC_INSTRUMENTATION
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace instrumentation{
+
+    const unsigned int max_counters = 64; //!The maximum number of distinct counters
+
+    struct ThreadCounters;
+
+    struct Totals{
+        /*!===
+         |
+         | T o t a l s
+         |
+        ===
+
+        The merged counts and times of a counter.
+
+        */
+
+        std::string        name;
+        unsigned long long count;
+        unsigned long long nanoseconds;
+    };
+
+    class Registry{
+        /*!===
+         |
+         | R e g i s t r y
+         |
+        ===
+
+        The process wide list of counter names, the
+        counters of the live threads and the totals
+        of the threads which have exited.
+
+        The registry is never destroyed so that it
+        remains valid for thread_local destructors
+        and the atexit handler.
+
+        */
+
+        public:
+            static Registry& get(){
+                /*!The registry of the process*/
+                static Registry *registry = new Registry();
+                return *registry;
+            }
+
+            unsigned int counter_id(const std::string &name);
+
+            void attach(ThreadCounters *counters){
+                /*!Register the counters of a new thread*/
+                std::lock_guard<std::mutex> lock(mutex);
+                threads.insert(counters);
+            }
+
+            void retire(ThreadCounters *counters);
+
+            std::vector<Totals> totals();
+
+            void write_summary(std::ostream &out);
+
+            void write_json(std::ostream &out);
+
+            bool write(const std::string &filename);
+
+            bool written(){
+                /*!Whether a summary has been written to a file*/
+                return has_written.load();
+            }
+
+            void reset();
+
+        private:
+            Registry() : has_written(false){
+                if(std::getenv("MICROMORPHIC_INSTRUMENTATION_OUTPUT")){std::atexit(write_at_exit);}
+            }
+
+            static void write_at_exit(){
+                /*!Write the summary to MICROMORPHIC_INSTRUMENTATION_OUTPUT if nothing was written yet*/
+                Registry &registry = get();
+                const char *filename = std::getenv("MICROMORPHIC_INSTRUMENTATION_OUTPUT");
+                if(filename && !registry.written()){registry.write(filename);}
+            }
+
+            std::mutex                 mutex;                            //!Guards the names, threads and retired totals
+            std::vector<std::string>   names;                            //!The names of the counters
+            std::set<ThreadCounters*>  threads;                          //!The counters of the live threads
+            unsigned long long         retired_count[max_counters]       = {}; //!The counts of the exited threads
+            unsigned long long         retired_nanoseconds[max_counters] = {}; //!The times of the exited threads
+            std::atomic<bool>          has_written;                      //!Whether a summary file has been written
+    };
+
+    struct ThreadCounters{
+        /*!===
+         |
+         | T h r e a d C o u n t e r s
+         |
+        ===
+
+        The counters of a single thread. Only the
+        owning thread writes to them so relaxed
+        atomics are enough for the registry to read
+        them while the thread is running.
+
+        */
+
+        std::atomic<unsigned long long> count[max_counters];
+        std::atomic<unsigned long long> nanoseconds[max_counters];
+
+        ThreadCounters(){
+            for(unsigned int i=0; i<max_counters; i++){
+                count[i].store(0,std::memory_order_relaxed);
+                nanoseconds[i].store(0,std::memory_order_relaxed);
+            }
+            Registry::get().attach(this);
+        }
+
+        ~ThreadCounters(){
+            Registry::get().retire(this);
+        }
+
+        void add(unsigned int id, unsigned long long n, unsigned long long ns){
+            /*!Add to the count and time of a counter*/
+            count[id].store(count[id].load(std::memory_order_relaxed)+n,std::memory_order_relaxed);
+            nanoseconds[id].store(nanoseconds[id].load(std::memory_order_relaxed)+ns,std::memory_order_relaxed);
+        }
+    };
+
+    inline ThreadCounters& local_counters(){
+        /*!The counters of the calling thread*/
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    inline unsigned int Registry::counter_id(const std::string &name){
+        /*!
+        Get the id of the counter with the given name
+        creating it if required. Once the maximum
+        number of counters is reached the remaining
+        names are recorded under "other".
+        */
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for(unsigned int i=0; i<names.size(); i++){
+            if(names[i]==name){return i;}
+        }
+        if(names.size()==max_counters-1){names.push_back("other");}
+        if(names.size()>=max_counters){return max_counters-1;}
+        names.push_back(name);
+        return names.size()-1;
+    }
+
+    inline void Registry::retire(ThreadCounters *counters){
+        /*!Merge the counters of an exiting thread into the retired totals*/
+        std::lock_guard<std::mutex> lock(mutex);
+        for(unsigned int i=0; i<max_counters; i++){
+            retired_count[i]       += counters->count[i].load(std::memory_order_relaxed);
+            retired_nanoseconds[i] += counters->nanoseconds[i].load(std::memory_order_relaxed);
+        }
+        threads.erase(counters);
+    }
+
+    inline std::vector<Totals> Registry::totals(){
+        /*!Merge the counters of all of the threads*/
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<Totals> result(names.size());
+        for(unsigned int i=0; i<names.size(); i++){
+            result[i].name        = names[i];
+            result[i].count       = retired_count[i];
+            result[i].nanoseconds = retired_nanoseconds[i];
+            for(std::set<ThreadCounters*>::iterator it=threads.begin(); it!=threads.end(); it++){
+                result[i].count       += (*it)->count[i].load(std::memory_order_relaxed);
+                result[i].nanoseconds += (*it)->nanoseconds[i].load(std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
+    inline void Registry::write_summary(std::ostream &out){
+        /*!Write the merged counters as a table*/
+        std::vector<Totals> result = totals();
+        out << std::left << std::setw(40) << "name" << std::right << std::setw(16) << "count"
+            << std::setw(16) << "total (s)" << std::setw(16) << "mean (us)" << "\n";
+        for(unsigned int i=0; i<result.size(); i++){
+            double seconds = 1e-9*result[i].nanoseconds;
+            double mean    = (result[i].count>0) ? 1e6*seconds/result[i].count : 0.;
+            out << std::left << std::setw(40) << result[i].name << std::right << std::setw(16) << result[i].count
+                << std::setw(16) << std::setprecision(6) << seconds << std::setw(16) << mean << "\n";
+        }
+    }
+
+    inline void Registry::write_json(std::ostream &out){
+        /*!Write the merged counters as a JSON object keyed by the counter names*/
+        std::vector<Totals> result = totals();
+        out << "{";
+        for(unsigned int i=0; i<result.size(); i++){
+            if(i>0){out << ",";}
+            out << "\n  \"";
+            for(unsigned int j=0; j<result[i].name.size(); j++){
+                char c = result[i].name[j];
+                if((c=='"') || (c=='\\')){out << '\\';}
+                out << c;
+            }
+            out << "\": {\"count\": " << result[i].count << ", \"seconds\": " << std::setprecision(9)
+                << 1e-9*result[i].nanoseconds << "}";
+        }
+        out << "\n}\n";
+    }
+
+    inline bool Registry::write(const std::string &filename){
+        /*!Write the summary to a file. Returns false if the file could not be opened*/
+        std::ofstream out(filename.c_str());
+        if(!out.is_open()){
+            std::cout << "Error: Could not open instrumentation output file " << filename << "\n";
+            return false;
+        }
+        if((filename.size()>=5) && (filename.compare(filename.size()-5,5,".json")==0)){write_json(out);}
+        else{write_summary(out);}
+        has_written.store(true);
+        return true;
+    }
+
+    inline void Registry::reset(){
+        /*!Zero all of the counters. The counter names are kept*/
+        std::lock_guard<std::mutex> lock(mutex);
+        for(unsigned int i=0; i<max_counters; i++){
+            retired_count[i]       = 0;
+            retired_nanoseconds[i] = 0;
+            for(std::set<ThreadCounters*>::iterator it=threads.begin(); it!=threads.end(); it++){
+                (*it)->count[i].store(0,std::memory_order_relaxed);
+                (*it)->nanoseconds[i].store(0,std::memory_order_relaxed);
+            }
+        }
+    }
+
+    class ScopedTimer{
+        /*!===
+         |
+         | S c o p e d T i m e r
+         |
+        ===
+
+        Count one call of a counter and add the
+        time until the timer goes out of scope.
+
+        */
+
+        public:
+            explicit ScopedTimer(unsigned int _id) : id(_id), start(std::chrono::steady_clock::now()){}
+
+            ~ScopedTimer(){
+                unsigned long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                            std::chrono::steady_clock::now()-start).count();
+                local_counters().add(id,1,ns);
+            }
+
+        private:
+            ScopedTimer(const ScopedTimer&);
+            ScopedTimer& operator=(const ScopedTimer&);
+
+            unsigned int                          id;    //!The counter
+            std::chrono::steady_clock::time_point start; //!The time the timer was created
+    };
+
+    inline void add_count(unsigned int id, unsigned long long n){
+        /*!Add to the count of a counter without timing it*/
+        local_counters().add(id,n,0);
+    }
+
+    inline bool write_summary(const std::string &filename){
+        /*!Write the summary of all of the counters to a file*/
+        return Registry::get().write(filename);
+    }
+}
+
+#define MICROMORPHIC_INSTRUMENTATION_CONCAT_(a,b) a##b
+#define MICROMORPHIC_INSTRUMENTATION_CONCAT(a,b) MICROMORPHIC_INSTRUMENTATION_CONCAT_(a,b)
+
+//!Time the enclosing scope under a fixed name
+#define MICROMORPHIC_TIME_SCOPE(name)                                                                            \
+    static const unsigned int MICROMORPHIC_INSTRUMENTATION_CONCAT(instrumentation_id_,__LINE__) =               \
+        instrumentation::Registry::get().counter_id(name);                                                       \
+    instrumentation::ScopedTimer MICROMORPHIC_INSTRUMENTATION_CONCAT(instrumentation_timer_,__LINE__)(           \
+        MICROMORPHIC_INSTRUMENTATION_CONCAT(instrumentation_id_,__LINE__))
+
+//!Time the enclosing scope under a name only known at run time ( e.g. the material model name )
+#define MICROMORPHIC_TIME_SCOPE_DYNAMIC(name)                                                                    \
+    instrumentation::ScopedTimer MICROMORPHIC_INSTRUMENTATION_CONCAT(instrumentation_timer_,__LINE__)(           \
+        instrumentation::Registry::get().counter_id(name))
+
+//!Add to the count of a fixed name
+#define MICROMORPHIC_COUNT(name,n)                                                                               \
+    {                                                                                                            \
+        static const unsigned int instrumentation_count_id = instrumentation::Registry::get().counter_id(name);  \
+        instrumentation::add_count(instrumentation_count_id,n);                                                   \
+    }
+
+#else
+
+#define MICROMORPHIC_TIME_SCOPE(name)
+#define MICROMORPHIC_TIME_SCOPE_DYNAMIC(name)
+#define MICROMORPHIC_COUNT(name,n)
+
+#endif
+
+#endif
@@ -1,4 +1,148 @@
 #include<material_python_interface.h>
+#include<micromorphic_material_dispatch.h>
+#include<algorithm>
+#include<instrumentation.h>
+
+namespace{
+
+    template< class Material >
+    int evaluate_points( Material &material, const unsigned int npoints,
+                         const std::vector< double > &time, const std::vector< double > &fparams,
+                         const double *current_grad_u, const double *current_phi, const double *current_grad_phi,
+                         const double *previous_grad_u, const double *previous_phi, const double *previous_grad_phi,
+                         const unsigned int nsdvs, double *SDVS,
+                         double *PK2, double *SIGMA, double *M,
+                         double *DPK2Dgrad_u, double *DPK2Dphi, double *DPK2Dgrad_phi,
+                         double *DSIGMADgrad_u, double *DSIGMADphi, double *DSIGMADgrad_phi,
+                         double *DMDgrad_u, double *DMDphi, double *DMDgrad_phi,
+                         int *errorCodes, std::string &output_message ){
+        /*!
+         * The point loop of materialPythonInterface::evaluate_model_batch templated on the material type so that
+         * the model selected at configure time can be inlined into the loop.
+         *
+         * :param Material &material: The material model
+         *
+         * The remaining arguments are the same as for evaluate_model_batch.
+         */
+
+        const bool compute_jacobians = DPK2Dgrad_u   || DPK2Dphi   || DPK2Dgrad_phi   ||
+                                       DSIGMADgrad_u || DSIGMADphi || DSIGMADgrad_phi ||
+                                       DMDgrad_u     || DMDphi     || DMDgrad_phi;
+
+        //Scratch space for the jacobians which were not requested
+        double _DPK2Dgrad_u[ 9 ][ 9 ],    _DPK2Dphi[ 9 ][ 9 ],    _DPK2Dgrad_phi[ 9 ][ 27 ];
+        double _DSIGMADgrad_u[ 9 ][ 9 ],  _DSIGMADphi[ 9 ][ 9 ],  _DSIGMADgrad_phi[ 9 ][ 27 ];
+        double _DMDgrad_u[ 27 ][ 9 ],     _DMDphi[ 27 ][ 9 ],     _DMDgrad_phi[ 27 ][ 27 ];
+
+        const std::vector< double > ADD_DOF;
+        const std::vector< std::vector< double > > ADD_grad_DOF;
+
+        std::vector< double > SDVS_p( nsdvs ), PK2_p, SIGMA_p, M_p;
+        std::vector< std::vector< double > > ADD_TERMS;
+        std::vector< std::vector< std::vector< double > > > ADD_JACOBIANS;
+
+        std::string message;
+
+        int result = 0;
+
+        typedef double matrix_3x3[ 3 ][ 3 ];
+        typedef double vector_9[ 9 ];
+        typedef double vector_27[ 27 ];
+        typedef double matrix_9x3[ 9 ][ 3 ];
+        typedef double matrix_9x9[ 9 ][ 9 ];
+        typedef double matrix_9x27[ 9 ][ 27 ];
+        typedef double matrix_27x9[ 27 ][ 9 ];
+        typedef double matrix_27x27[ 27 ][ 27 ];
+
+        for ( unsigned int p = 0; p < npoints; p++ ){
+
+            const matrix_3x3 &current_grad_u_p    = *reinterpret_cast< const matrix_3x3* >( current_grad_u + 9 * p );
+            const vector_9   &current_phi_p       = *reinterpret_cast< const vector_9* >( current_phi + 9 * p );
+            const matrix_9x3 &current_grad_phi_p  = *reinterpret_cast< const matrix_9x3* >( current_grad_phi + 27 * p );
+            const matrix_3x3 &previous_grad_u_p   = *reinterpret_cast< const matrix_3x3* >( previous_grad_u + 9 * p );
+            const vector_9   &previous_phi_p      = *reinterpret_cast< const vector_9* >( previous_phi + 9 * p );
+            const matrix_9x3 &previous_grad_phi_p = *reinterpret_cast< const matrix_9x3* >( previous_grad_phi + 27 * p );
+
+            vector_9  &PK2_out   = *reinterpret_cast< vector_9* >( PK2 + 9 * p );
+            vector_9  &SIGMA_out = *reinterpret_cast< vector_9* >( SIGMA + 9 * p );
+            vector_27 &M_out     = *reinterpret_cast< vector_27* >( M + 27 * p );
+
+            SDVS_p.assign( SDVS + nsdvs * p, SDVS + nsdvs * ( p + 1 ) );
+
+            message = "";
+
+            int errorCode;
+
+            if ( compute_jacobians ){
+
+                errorCode = micromorphic_material_library::evaluate_material_flat( material, time, fparams,
+                                                                                   current_grad_u_p,  current_phi_p,  current_grad_phi_p,
+                                                                                   previous_grad_u_p, previous_phi_p, previous_grad_phi_p,
+                                                                                   SDVS_p,
+                                                                                   ADD_DOF, ADD_grad_DOF,
+                                                                                   ADD_DOF, ADD_grad_DOF,
+                                                                                   PK2_out, SIGMA_out, M_out,
+                                                                                   DPK2Dgrad_u     ? *reinterpret_cast< matrix_9x9* >( DPK2Dgrad_u + 81 * p )       : _DPK2Dgrad_u,
+                                                                                   DPK2Dphi        ? *reinterpret_cast< matrix_9x9* >( DPK2Dphi + 81 * p )          : _DPK2Dphi,
+                                                                                   DPK2Dgrad_phi   ? *reinterpret_cast< matrix_9x27* >( DPK2Dgrad_phi + 243 * p )   : _DPK2Dgrad_phi,
+                                                                                   DSIGMADgrad_u   ? *reinterpret_cast< matrix_9x9* >( DSIGMADgrad_u + 81 * p )     : _DSIGMADgrad_u,
+                                                                                   DSIGMADphi      ? *reinterpret_cast< matrix_9x9* >( DSIGMADphi + 81 * p )        : _DSIGMADphi,
+                                                                                   DSIGMADgrad_phi ? *reinterpret_cast< matrix_9x27* >( DSIGMADgrad_phi + 243 * p ) : _DSIGMADgrad_phi,
+                                                                                   DMDgrad_u       ? *reinterpret_cast< matrix_27x9* >( DMDgrad_u + 243 * p )       : _DMDgrad_u,
+                                                                                   DMDphi          ? *reinterpret_cast< matrix_27x9* >( DMDphi + 243 * p )          : _DMDphi,
+                                                                                   DMDgrad_phi     ? *reinterpret_cast< matrix_27x27* >( DMDgrad_phi + 729 * p )    : _DMDgrad_phi,
+                                                                                   ADD_TERMS, ADD_JACOBIANS, message );
+
+            }
+            else{
+
+                errorCode = material.evaluate_model( time, fparams,
+                                                     current_grad_u_p,  current_phi_p,  current_grad_phi_p,
+                                                     previous_grad_u_p, previous_phi_p, previous_grad_phi_p,
+                                                     SDVS_p,
+                                                     ADD_DOF, ADD_grad_DOF,
+                                                     ADD_DOF, ADD_grad_DOF,
+                                                     PK2_p, SIGMA_p, M_p,
+                                                     ADD_TERMS, message );
+
+                if ( ( errorCode == 0 ) && ( ( PK2_p.size( ) != 9 ) || ( SIGMA_p.size( ) != 9 ) || ( M_p.size( ) != 27 ) ) ){
+                    message = "Error: evaluate_model returned stresses of unexpected size";
+                    errorCode = 2;
+                }
+
+                if ( errorCode == 0 ){
+                    std::copy( PK2_p.begin( ),   PK2_p.end( ),   PK2_out );
+                    std::copy( SIGMA_p.begin( ), SIGMA_p.end( ), SIGMA_out );
+                    std::copy( M_p.begin( ),     M_p.end( ),     M_out );
+                }
+
+            }
+
+            if ( ( errorCode == 0 ) && ( SDVS_p.size( ) != nsdvs ) ){
+                message = "Error: evaluate_model returned " + std::to_string( SDVS_p.size( ) ) + " state variables but " + std::to_string( nsdvs ) + " were provided";
+                errorCode = 2;
+            }
+
+            if ( errorCode == 0 ){
+                std::copy( SDVS_p.begin( ), SDVS_p.end( ), SDVS + nsdvs * p );
+            }
+            else if ( result == 0 ){
+                output_message = "Error in evaluate_model_batch at point " + std::to_string( p ) + "\n" + message;
+            }
+
+            if ( errorCodes ){
+                errorCodes[ p ] = errorCode;
+            }
+
+            result = std::max( result, errorCode );
+
+        }
+
+        return result;
+
+    }
+
+}
 
 namespace materialPythonInterface{
 
@@ -88,7 +232,9 @@ namespace materialPythonInterface{
          */
     
         auto &factory = micromorphic_material_library::MaterialFactory::Instance( );
-        auto material = factory.GetMaterial( model_name );
+        auto material = factory.GetSharedMaterial( model_name );
+
+        MICROMORPHIC_TIME_SCOPE_DYNAMIC( "material " + model_name );
     
         int errorCode = material->evaluate_model( time, fparams,
                                                   current_grad_u, current_phi, current_grad_phi,
@@ -105,4 +251,103 @@ namespace materialPythonInterface{
         return errorCode;
     
     }
+
+    int evaluate_model_batch( const std::string &model_name, const unsigned int npoints,
+                              const std::vector< double > &time, const std::vector< double > &fparams,
+                              const double *current_grad_u, const double *current_phi, const double *current_grad_phi,
+                              const double *previous_grad_u, const double *previous_phi, const double *previous_grad_phi,
+                              const unsigned int nsdvs, double *SDVS,
+                              double *PK2, double *SIGMA, double *M,
+                              double *DPK2Dgrad_u, double *DPK2Dphi, double *DPK2Dgrad_phi,
+                              double *DSIGMADgrad_u, double *DSIGMADphi, double *DSIGMADgrad_phi,
+                              double *DMDgrad_u, double *DMDphi, double *DMDgrad_phi,
+                              int *errorCodes, std::string &output_message ){
+        /*!
+         * Evaluate the material model at npoints points which share the same time and parameters.
+         *
+         * All of the point-wise arrays are C-contiguous with the point as the slowest index i.e. the values of
+         * point p start at p times the size of the per-point quantity ( ( npoints, 3, 3 ) for the displacement
+         * gradients, ( npoints, 9 ) for phi, etc. ) so they can be handed over directly from numpy arrays. The
+         * results are written in place and no call is made back into python so the caller may release the GIL.
+         *
+         * The jacobian arrays may be NULL in which case they are not returned. If all of them are NULL the
+         * model is evaluated without the jacobians. Additional degrees of freedom are not supported.
+         *
+         * :param const std::string &model_name: The name of the model to be evaluated
+         * :param const unsigned int npoints: The number of points to evaluate
+         * :param const std::vector< double > &time: The current time and the timestep
+         *     [ current_t, dt ]
+         * :param const std::vector< double > ( &fparams ): The parameters for the constitutive model
+         * :param const double *current_grad_u: The current displacement gradients ( npoints, 3, 3 )
+         * :param const double *current_phi: The current micro displacements ( npoints, 9 )
+         * :param const double *current_grad_phi: The current micro displacement gradients ( npoints, 9, 3 )
+         * :param const double *previous_grad_u: The previous displacement gradients ( npoints, 3, 3 )
+         * :param const double *previous_phi: The previous micro displacements ( npoints, 9 )
+         * :param const double *previous_grad_phi: The previous micro displacement gradients ( npoints, 9, 3 )
+         * :param const unsigned int nsdvs: The number of state variables at each point
+         * :param double *SDVS: The previously converged state variables which are overwritten with the updated
+         *     values ( npoints, nsdvs )
+         * :param double *PK2: The second Piola Kirchhoff stresses ( npoints, 9 )
+         * :param double *SIGMA: The reference symmetric micro stresses ( npoints, 9 )
+         * :param double *M: The reference higher order stresses ( npoints, 27 )
+         * :param double *DPK2Dgrad_u: The Jacobians of PK2 w.r.t. the displacement gradient ( npoints, 9, 9 )
+         * :param double *DPK2Dphi: The Jacobians of PK2 w.r.t. the micro displacement ( npoints, 9, 9 )
+         * :param double *DPK2Dgrad_phi: The Jacobians of PK2 w.r.t. the micro displacement gradient
+         *     ( npoints, 9, 27 )
+         * :param double *DSIGMADgrad_u: The Jacobians of SIGMA w.r.t. the displacement gradient ( npoints, 9, 9 )
+         * :param double *DSIGMADphi: The Jacobians of SIGMA w.r.t. the micro displacement ( npoints, 9, 9 )
+         * :param double *DSIGMADgrad_phi: The Jacobians of SIGMA w.r.t. the micro displacement gradient
+         *     ( npoints, 9, 27 )
+         * :param double *DMDgrad_u: The Jacobians of M w.r.t. the displacement gradient ( npoints, 27, 9 )
+         * :param double *DMDphi: The Jacobians of M w.r.t. the micro displacement ( npoints, 27, 9 )
+         * :param double *DMDgrad_phi: The Jacobians of M w.r.t. the micro displacement gradient ( npoints, 27, 27 )
+         * :param int *errorCodes: The error code of each point ( npoints ). May be NULL.
+         * :param std::string &output_message: The output message of the first point which reported an error.
+         *
+         * Returns the largest error code of the points:
+         *     0: No errors. Solution converged.
+         *     1: Convergence Error. Request timestep cutback.
+         *     2: Fatal Errors encountered. Terminate the simulation.
+         */
+
+        output_message = "";
+
+        if ( npoints == 0 ){
+            return 0;
+        }
+
+        auto &factory = micromorphic_material_library::MaterialFactory::Instance( );
+        auto material = factory.GetSharedMaterial( model_name );
+
+        if ( !material ){
+            output_message = "Error: material model " + model_name + " not found";
+            return 2;
+        }
+
+        MICROMORPHIC_TIME_SCOPE_DYNAMIC( "material " + model_name + " batch" );
+
+        auto selected = micromorphic_material_library::get_static_material( material );
+
+        if ( selected ){
+            //Call the model selected at configure time directly
+            return evaluate_points( *selected, npoints, time, fparams,
+                                    current_grad_u,  current_phi,  current_grad_phi,
+                                    previous_grad_u, previous_phi, previous_grad_phi,
+                                    nsdvs, SDVS, PK2, SIGMA, M,
+                                    DPK2Dgrad_u,   DPK2Dphi,   DPK2Dgrad_phi,
+                                    DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi,
+                                    DMDgrad_u,     DMDphi,     DMDgrad_phi,
+                                    errorCodes, output_message );
+        }
+
+        return evaluate_points( *material, npoints, time, fparams,
+                                current_grad_u,  current_phi,  current_grad_phi,
+                                previous_grad_u, previous_phi, previous_grad_phi,
+                                nsdvs, SDVS, PK2, SIGMA, M,
+                                DPK2Dgrad_u,   DPK2Dphi,   DPK2Dgrad_phi,
+                                DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi,
+                                DMDgrad_u,     DMDphi,     DMDgrad_phi,
+                                errorCodes, output_message );
+
+    }
 }
@@ -16,4 +16,15 @@ namespace materialPythonInterface{
                         std::vector< std::vector< double > > &DMDgrad_u, std::vector< std::vector< double > > &DMDphi, std::vector< std::vector< double > > &DMDgrad_phi,
                         std::vector< std::vector< double > > &ADD_TERMS, std::vector< std::vector< std::vector< double > > > &ADD_JACOBIANS,
                         std::string &output_message );
+
+    int evaluate_model_batch( const std::string &model_name, const unsigned int npoints,
+                              const std::vector< double > &time, const std::vector< double > &fparams,
+                              const double *current_grad_u, const double *current_phi, const double *current_grad_phi,
+                              const double *previous_grad_u, const double *previous_phi, const double *previous_grad_phi,
+                              const unsigned int nsdvs, double *SDVS,
+                              double *PK2, double *SIGMA, double *M,
+                              double *DPK2Dgrad_u, double *DPK2Dphi, double *DPK2Dgrad_phi,
+                              double *DSIGMADgrad_u, double *DSIGMADphi, double *DSIGMADgrad_phi,
+                              double *DMDgrad_u, double *DMDphi, double *DMDgrad_phi,
+                              int *errorCodes, std::string &output_message );
 }
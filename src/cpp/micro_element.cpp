@@ -17,8 +17,14 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <unistd.h>
 #include <tensor.h>
 #include <micro_element.h>
+#include <instrumentation.h>
 #include <tardigrade_micromorphic_linear_elasticity.h>
 #include <ctime>
   
@@ -258,7 +264,7 @@ namespace micro_element
         for(int i=0; i<_iparams.size(); i++){iparams(i) = _iparams[i];}
     }
     
-    Hex8::Hex8(double *_RHS,          double *_AMATRX,      Vector &_SVARS, energy_vector &ENERGY,
+    Hex8::Hex8(double *_RHS,          double *_AMATRX,      double *_SVARS, int NSVARS,     energy_vector &ENERGY,
                Vector &PROPS,         Matrix_RM &COORDS,    Vector &U,      Vector &DU,
                Vector &V,             Vector &A,            double TIME[2], double DTIME, 
                int KSTEP,             int KINC,             int JELEM,      params_vector &PARAMS,
@@ -293,6 +299,7 @@ namespace micro_element
             RHS:    A pointer to the RHS array
             AMATRX: A pointer to the AMATRX array
             SVARS:  A pointer to the SVARS array
+            NSVARS: The number of state variables of the element
             ENERGY: A Eigen::Map which contians a pointer to the ENERGY array
             PROPS:  A Eigen::Map which contains a pointer to the PROPS array
             COORDS: A Eigen::Map which contains a pointer to the COORDS array
@@ -385,12 +392,15 @@ namespace micro_element
             node_phis[n](1,0) = dof_at_nodes[n][11];
         }
         
-        //Set the state variables
-        SVARS   = _SVARS;
-
         //Set the material parameters
         fparams = PROPS;
         iparams = JPROPS;
+        
+        //Set the quadrature rule from the integer properties
+        set_quadrature_from_iparams();
+        
+        //View the state variables which Abaqus updates in place
+        set_state_variables(_SVARS, _SVARS, NSVARS/number_gauss_points);
 
         //Set the output filename
         output_name = output_fn;
@@ -402,6 +412,201 @@ namespace micro_element
     
     
     
+    //!==
+    //!|
+    //!| Reinitialization
+    //!|
+    //!==
+    
+    void Hex8::reset(const std::vector< double > &rcs, const std::vector< double > &U, const std::vector< double > &dU,
+                     const std::vector< double > &_fparams, const std::vector< int > &_iparams){
+        /*!===============
+        |    reset    |
+        ===============
+        
+        Reset the element to a new set of nodal 
+        coordinates and degrees of freedom. This 
+        has the same result as constructing a new 
+        element with 
+        
+        Hex8(rcs, U, dU, _fparams, _iparams)
+        
+        but the storage of the element (the RHS, 
+        AMATRX, stresses, and tangents) is reused 
+        rather than reallocated so a single element 
+        can be used as a workspace for many elements.
+        
+        Any shape function cache and view of the 
+        state variables are released.
+        
+        Input:
+            rcs:     The coordinates of the nodes
+            U:       The degree of freedom vector
+            dU:      The change in the degree of freedom vector
+            fparams: Floating point parameters for the constitutive model
+            iparams: Integer parameters for the constitutive model
+        */
+        
+        zero_element_storage();
+        
+        shape_function_cache = NULL;
+        set_state_variables(NULL, NULL, 0);
+        
+        assign_incoming_vectors(1, rcs.data(), reference_coords);
+        assign_incoming_vectors(2, U.data(),   dof_at_nodes);
+        assign_incoming_vectors(2, dU.data(),  Delta_dof_at_nodes);
+        
+        set_nodal_values();
+        
+        //Set the material parameters
+        if(fparams.size()!=_fparams.size()){fparams.resize(_fparams.size(),1);}
+        if(iparams.size()!=_iparams.size()){iparams.resize(_iparams.size(),1);}
+        for(int i=0; i<_fparams.size(); i++){fparams(i) = _fparams[i];}
+        for(int i=0; i<_iparams.size(); i++){iparams(i) = _iparams[i];}
+    }
+    
+    void Hex8::reset(double *_RHS,          double *_AMATRX,        double *_SVARS, int NSVARS,
+                     Vector &PROPS,         Matrix_RM &COORDS,      Vector &U,      Vector &DU,
+                     int KSTEP,             int KINC,               int JELEM,      Vectori &JPROPS,
+                     std::string output_fn){
+        /*!===============
+        |    reset    |
+        ===============
+        
+        Reset the element for the Abaqus implementation. 
+        This has the same result as the Abaqus constructor 
+        (only the arguments that the constructor uses are 
+        required) but reuses the storage of the element.
+        
+        Input:
+            RHS:    A pointer to the RHS array
+            AMATRX: A pointer to the AMATRX array
+            SVARS:  A pointer to the SVARS array
+            NSVARS: The number of state variables of the element
+            PROPS:  The floating point properties
+            COORDS: The nodal coordinates
+            U:      The degree of freedom vector
+            DU:     The change in the degree of freedom vector
+            KSTEP:  The step count
+            KINC:   The increment count
+            JELEM:  The user-defined element number
+            JPROPS: The integer properties
+            output_fn: The output filename
+        */
+        
+        zero_element_storage();
+        
+        shape_function_cache = NULL;
+        
+        //Assign the RHS and AMATRX arrays
+        RHS    = Matrix_Xd_Map(_RHS,96,1);
+        AMATRX = Matrix_Xd_Map(_AMATRX,96,96);
+        
+        assign_incoming_vectors(1, COORDS.data(), reference_coords);
+        assign_incoming_vectors(2, U.data(),      dof_at_nodes);
+        assign_incoming_vectors(2, DU.data(),     Delta_dof_at_nodes);
+        
+        set_nodal_values();
+        
+        //Set the material parameters
+        fparams = PROPS;
+        iparams = JPROPS;
+        
+        //Set the quadrature rule from the integer properties
+        set_quadrature_from_iparams();
+        
+        //View the state variables which Abaqus updates in place
+        set_state_variables(_SVARS, _SVARS, NSVARS/number_gauss_points);
+        
+        //Set the output filename
+        output_name = output_fn;
+        step_num    = KSTEP;
+        inc_num     = KINC;
+        el_num      = JELEM;
+    }
+    
+    void Hex8::set_state_variables(const double *_previous_SVARS, double *_SVARS, unsigned int _num_sdvs){
+        /*!=============================
+        |    set_state_variables    |
+        =============================
+        
+        Set the view of the state variables of the 
+        gauss points. State variable i of gauss point 
+        g is at [i*number_gauss_points+g] of each 
+        array. The updated state variables of every 
+        gauss point are written when the stresses are 
+        set. The arrays are not copied so they must 
+        outlive the integration of the element.
+        
+        Input:
+            _previous_SVARS: The state variables of the last converged increment
+            _SVARS:          The updated state variables (may be _previous_SVARS)
+            _num_sdvs:       The number of state variables at each gauss point
+        */
+        
+        previous_SVARS = _previous_SVARS;
+        SVARS          = _SVARS;
+        num_sdvs       = _num_sdvs;
+    }
+    
+    void Hex8::zero_element_storage(){
+        /*!==============================
+        |    zero_element_storage    |
+        ==============================
+        
+        Set the residual, stiffness, mass, stress, 
+        and tangent storage of the element to zero 
+        without reallocating it.
+        
+        */
+        
+        RHS.setZero();
+        AMATRX.setZero();
+        mini_mass.setZero();
+        
+        for(int i=0; i<number_gauss_points; i++){
+            PK2[i].zero();
+            SIGMA[i].zero();
+            M[i].zero();
+        }
+        
+        reset_tangents();
+        
+        gpt_num = -1;
+    }
+    
+    void Hex8::set_nodal_values(){
+        /*!==========================
+        |    set_nodal_values    |
+        ==========================
+        
+        Set the current coordinates and the micro 
+        displacements at the nodes from the reference 
+        coordinates and the degree of freedom vector.
+        
+        */
+        
+        for(int n=0; n<reference_coords.size(); n++){
+            current_coords[n].resize(3);
+            for(int i=0; i<3; i++){
+                current_coords[n][i] = reference_coords[n][i]+dof_at_nodes[n][i];
+            }
+            
+            //!NOTE: Assumes dof vector is set up as phi_11, phi_22, phi_33,
+            //!                                      phi_23, phi_13, phi_12,
+            //!                                      phi_32, phi_31, phi_21
+            node_phis[n](0,0) = dof_at_nodes[n][ 3];
+            node_phis[n](1,1) = dof_at_nodes[n][ 4];
+            node_phis[n](2,2) = dof_at_nodes[n][ 5];
+            node_phis[n](1,2) = dof_at_nodes[n][ 6];
+            node_phis[n](0,2) = dof_at_nodes[n][ 7];
+            node_phis[n](0,1) = dof_at_nodes[n][ 8];
+            node_phis[n](2,1) = dof_at_nodes[n][ 9];
+            node_phis[n](2,0) = dof_at_nodes[n][10];
+            node_phis[n](1,0) = dof_at_nodes[n][11];
+        }
+    }
+    
     //!==
     //!|
     //!| Operators
@@ -426,6 +631,128 @@ namespace micro_element
     //!|
     //!==
     
+    //!=
+    //!| Quadrature
+    //!=
+    
+    void Hex8::set_quadrature_rule(int order){
+        /*!=============================
+        |    set_quadrature_rule    |
+        =============================
+        
+        Set the gauss quadrature used to integrate 
+        the element to the tensor product of the 
+        order point Gauss-Legendre rule. The points 
+        are ordered with the third local coordinate 
+        varying fastest.
+        
+        order = 1: Reduced integration at the center 
+                   of the element. The hourglass modes 
+                   are resisted by the stiffness from 
+                   add_hourglass_stabilization.
+        order = 2: Full 2x2x2 integration (default)
+        order = 3: 3x3x3 integration for strongly 
+                   distorted elements
+        
+        The stress storage is resized to the number 
+        of gauss points. Any shape function cache 
+        must be built after the rule is set.
+        
+        Input:
+            order: The number of gauss points in each direction
+        
+        */
+        
+        std::vector< double > abscissae;
+        std::vector< double > line_weights;
+        
+        if(order==1){
+            abscissae    = {0.};
+            line_weights = {2.};
+        }
+        else if(order==2){
+            abscissae    = {-0.57735026918962573, 0.57735026918962573};
+            line_weights = {1., 1.};
+        }
+        else if(order==3){
+            abscissae    = {-0.77459666924148338, 0., 0.77459666924148338};
+            line_weights = {5./9., 8./9., 5./9.};
+        }
+        else{
+            std::cout << "Error: Quadrature order " << order << " is not supported (1, 2, or 3).\n";
+            assert(1==0);
+        }
+        
+        quadrature_order    = order;
+        number_gauss_points = order*order*order;
+        
+        points.resize(number_gauss_points);
+        weights.resize(number_gauss_points);
+        
+        int gpt = 0;
+        for(int i=0; i<order; i++){
+            for(int j=0; j<order; j++){
+                for(int k=0; k<order; k++){
+                    points[gpt]  = {abscissae[i], abscissae[j], abscissae[k]};
+                    weights[gpt] = line_weights[i]*line_weights[j]*line_weights[k];
+                    gpt++;
+                }
+            }
+        }
+        
+        //Resize the stress measure vectors
+        PK2.resize(number_gauss_points);
+        SIGMA.resize(number_gauss_points);
+        M.resize(number_gauss_points);
+        
+        for(int i=0; i<number_gauss_points; i++){
+            PK2[i]   = tensor::Tensor23({3,3});
+            SIGMA[i] = tensor::Tensor23({3,3});
+            M[i]     = tensor::Tensor33({3,3,3});
+        }
+        
+        gpt_num = -1;
+        
+        return;
+    }
+    
+    void Hex8::set_quadrature_from_iparams(){
+        /*!=====================================
+        |    set_quadrature_from_iparams    |
+        =====================================
+        
+        Set the quadrature rule from the integer 
+        properties (JPROPS for the Abaqus UEL)
+        
+        iparams(0): The number of gauss points in each 
+                    direction (see set_quadrature_rule). 
+                    Zero or absent uses the full 2x2x2 rule.
+        iparams(1): The hourglass coefficient in thousandths 
+                    (e.g. 50 for 0.05). Absent uses the 
+                    default value.
+        
+        The rule is only changed if it differs from 
+        the current one so the storage of an element 
+        which is reset for every call is reused.
+        
+        */
+        
+        int order = 2;
+        if((iparams.size()>0) && (iparams(0)>0)){
+            order = iparams(0);
+        }
+        
+        if(iparams.size()>1){
+            hourglass_coefficient = 1e-3*iparams(1);
+        }
+        
+        if(order!=quadrature_order){
+            set_quadrature_rule(order);
+        }
+        
+        return;
+    }
+    
     //!=
     //!| Shape Functions
     //!=
@@ -441,9 +768,17 @@ namespace micro_element
         
         */
         
-        set_shape_functions();                  //!Set N for each node at the current gauss point in private attributes
-        set_local_gradient_shape_functions();   //!Set dNdxi for each node at the current gauss point in private attributes
-        set_global_gradient_shape_functions(0); //!Set dNdX for each node at the current gauss point in private attributes
+        if(shape_function_cache!=NULL){//Use the cached reference configuration values
+            Ns      = shape_function_cache->Ns[gpt_num];
+            dNdxis  = shape_function_cache->dNdxis[gpt_num];
+            dNdXs   = shape_function_cache->dNdXs[gpt_num];
+            Jhatdet = shape_function_cache->Jhatdets[gpt_num];
+        }
+        else{
+            set_shape_functions();                  //!Set N for each node at the current gauss point in private attributes
+            set_local_gradient_shape_functions();   //!Set dNdxi for each node at the current gauss point in private attributes
+            set_global_gradient_shape_functions(0); //!Set dNdX for each node at the current gauss point in private attributes
+        }
         set_global_gradient_shape_functions(1); //!Set dNdx for each node at the current gauss point in private attributes
         if(compute_mass){
             update_mini_mass();
@@ -632,6 +967,78 @@ namespace micro_element
         return;
     }
     
+    void Hex8::build_shape_function_cache(ShapeFunctionCache &cache){
+        /*!====================================
+        |    build_shape_function_cache    |
+        ====================================
+        
+        Compute the shape function values, their 
+        local and reference gradients, and the 
+        determinant of the reference jacobian at 
+        all of the gauss points of the element and 
+        store them in cache.
+        
+        Input:
+            cache: The cache to populate
+        
+        */
+        
+        cache.Ns.resize(number_gauss_points);
+        cache.dNdxis.resize(number_gauss_points);
+        cache.dNdXs.resize(number_gauss_points);
+        cache.Jhatdets.resize(number_gauss_points);
+        
+        for(int i=0; i<number_gauss_points; i++){
+            gpt_num = i;
+            
+            set_shape_functions();
+            set_local_gradient_shape_functions();
+            set_global_gradient_shape_functions(0);
+            
+            cache.Ns[i]       = Ns;
+            cache.dNdxis[i]   = dNdxis;
+            cache.dNdXs[i]    = dNdXs;
+            cache.Jhatdets[i] = Jhatdet;
+        }
+        
+        gpt_num      = -1;
+        cache.is_set = true;
+        
+        return;
+    }
+    
+    void Hex8::set_shape_function_cache(const ShapeFunctionCache *cache){
+        /*!==================================
+        |    set_shape_function_cache    |
+        ==================================
+        
+        Set the cache of the reference configuration 
+        shape function values to be used by the element. 
+        The cache must have been built for an element 
+        with the same reference coordinates. NULL 
+        returns the element to computing the values 
+        at every gauss point.
+        
+        Input:
+            cache: A pointer to the cache
+        
+        */
+        
+        if((cache!=NULL) && (!cache->is_set)){
+            std::cout << "Error: The shape function cache has not been built.\n";
+            assert(1==0);
+        }
+        
+        if((cache!=NULL) && (cache->Ns.size()!=number_gauss_points)){
+            std::cout << "Error: The shape function cache was built for a different quadrature rule.\n";
+            assert(1==0);
+        }
+        
+        shape_function_cache = cache;
+        
+        return;
+    }
+    
     void Hex8::update_mini_mass(){
         /*!==========================
         |    update_mini_mass    |
@@ -648,8 +1055,8 @@ namespace micro_element
         
         */
         
-        for(int i=0; i<number_gauss_points; i++){
-            for(int j=0; j<number_gauss_points; j++){
+        for(int i=0; i<reference_coords.size(); i++){
+            for(int j=0; j<reference_coords.size(); j++){
                 mini_mass(i,j) += Ns[i]*Ns[j]*fparams(0)*Jhatdet*weights[gpt_num];
             }
         }
@@ -668,8 +1075,8 @@ namespace micro_element
         
         */
         
-        for(int i=0; i<number_gauss_points; i++){
-            for(int j=0; j<number_gauss_points; j++){
+        for(int i=0; i<reference_coords.size(); i++){
+            for(int j=0; j<reference_coords.size(); j++){
                 for(int k=0; k<12; k++){
                     AMATRX(k+12*i,k+12*j) = mini_mass(i,j);
                 }
@@ -677,6 +1084,105 @@ namespace micro_element
         }
     }
     
+    void Hex8::set_lumped_mass(bool hrz){
+        /*!=========================
+        |    set_lumped_mass    |
+        =========================
+        
+        Set lumped_mass to the diagonal mass of
+        each of the 96 degrees of freedom for use
+        in explicit dynamics. Only the reference
+        shape functions are required so the
+        material model is not evaluated and AMATRX
+        is not modified.
+        
+        The nodal mass m_n is either the row-sum of
+        the consistent mass matrix
+            
+            m_n = int rho_0 N_n dV
+        
+        or, if hrz is true, the diagonal of the
+        consistent mass matrix scaled to conserve
+        the total mass (Hinton, Rock, and Zienkiewicz)
+            
+            m_n = M int rho_0 N_n N_n dV / sum_m int rho_0 N_m N_m dV
+        
+        where M is the mass of the element. The
+        second is preferred for distorted elements
+        and higher order rules.
+        
+        The displacement degrees of freedom have
+        the mass m_n. The inertia couple of the
+        balance of the first moment of momentum
+        (balance_equations::compute_inertia_couple)
+        is -N rho_0 I_IJ ddot(chi)_iI chi_jJ which is
+        linearized about chi = I so that the micro
+        displacement degree of freedom phi_iJ (the
+        ij equation) has the mass I_JJ m_n. The off
+        diagonal terms of the micro-inertia are not
+        lumped.
+        
+        Input:
+            hrz: Flag indicating if the HRZ lumping
+                 is used rather than the row-sum
+        
+        */
+        
+        const int mass_index[9] = {0,1,2,2,2,1,1,0,0}; //!The second index of the micro displacement
+                                                       //!degrees of freedom (11,22,33,23,13,12,32,31,21)
+        
+        double nodal_mass[8] = {0,0,0,0,0,0,0,0}; //!The lumped mass of each node
+        double total_mass    = 0;                 //!The mass of the element
+        double diagonal_sum  = 0;                 //!The sum of the diagonal of the consistent mass matrix
+        double dV;                                //!The weighted volume of the gauss point
+        
+        for(int i=0; i<number_gauss_points; i++){
+            gpt_num = i;
+            
+            if(shape_function_cache!=NULL){
+                Ns      = shape_function_cache->Ns[gpt_num];
+                Jhatdet = shape_function_cache->Jhatdets[gpt_num];
+            }
+            else{
+                set_shape_functions();
+                set_local_gradient_shape_functions();
+                set_global_gradient_shape_functions(0);
+            }
+            
+            dV          = fparams(0)*Jhatdet*weights[gpt_num];
+            total_mass += dV;
+            
+            for(int n=0; n<reference_coords.size(); n++){
+                if(hrz){
+                    nodal_mass[n] += Ns[n]*Ns[n]*dV;
+                    diagonal_sum  += Ns[n]*Ns[n]*dV;
+                }
+                else{
+                    nodal_mass[n] += Ns[n]*dV;
+                }
+            }
+        }
+        
+        gpt_num = -1;
+        
+        if(hrz){
+            for(int n=0; n<reference_coords.size(); n++){nodal_mass[n] *= total_mass/diagonal_sum;}
+        }
+        
+        if(lumped_mass.size()!=96){lumped_mass.resize(96);}
+        
+        for(int n=0; n<reference_coords.size(); n++){
+            for(int k=0; k<3; k++){
+                lumped_mass(k+12*n) = nodal_mass[n];
+            }
+            for(int k=0; k<9; k++){
+                lumped_mass(k+3+12*n) = reference_micro_inertia[4*mass_index[k]]*nodal_mass[n];
+            }
+        }
+        
+        return;
+    }
+    
     //!=
     //!| Fundamental Deformation Measures
     //!=
@@ -716,30 +1222,35 @@ namespace micro_element
         */
         
         //Initialize vectors
-        tensor::Tensor23 dxdxi({3,3}); //!The derivative of the current coordinates w.r.t. the local coordinates
-        tensor::Tensor23 dXdxi({3,3}); //!The derivative of the reference coordinates w.r.t. the local coordinates
+        tensor::FixedTensor23 dxdxi; //!The derivative of the current coordinates w.r.t. the local coordinates
+        tensor::FixedTensor23 dXdxi; //!The derivative of the reference coordinates w.r.t. the local coordinates
         
         //Compute the derivatives of the reference and current coordinates w.r.t. xi
         for(int n=0; n<reference_coords.size(); n++){
-            dxdxi += vector_dyadic_product(current_coords[n],  dNdxis[n]);
-            dXdxi += vector_dyadic_product(reference_coords[n],dNdxis[n]);
+            for(int i=0; i<3; i++){
+                for(int k=0; k<3; k++){
+                    dxdxi(i,k) += current_coords[n][i]*dNdxis[n][k];
+                    dXdxi(i,k) += reference_coords[n][i]*dNdxis[n][k];
+                }
+            }
         }
         
-        tensor::Tensor23 dxidX = dXdxi.inverse(); //!The derivative of the local coordinates w.r.t. the reference coordinates
+        tensor::FixedTensor23 dxidX = tensor::inverse(dXdxi); //!The derivative of the local coordinates w.r.t. the reference coordinates
         
-        //Reset F to zero
-        F.data.setZero(); //!The deformation gradient
+        tensor::FixedTensor23 F_fixed; //!The deformation gradient
         
         for(int i = 0; i<3; i++){
             for(int J=0; J<3; J++){
                 for(int k=0; k<3; k++){
-                    F(i,J) += dxdxi(i,k)*dxidX(k,J);
+                    F_fixed(i,J) += dxdxi(i,k)*dxidX(k,J);
                 }
             }
         }
         
+        F_fixed.to_base_tensor(F);
+        
         //Compute the determinant of F to ensure they are consistent
-        Fdet = F.det();
+        Fdet = tensor::det(F_fixed);
         
         return;
     }
@@ -753,16 +1264,21 @@ namespace micro_element
         chi at the current gauss point.
         
         */
-        //Reset chi to zero
-        chi.data.setZero();
+        tensor::FixedTensor23 chi_fixed; //!The microdisplacement tensor
         
         //Interpolate the nodal phis to xi
         for(int n=0; n<reference_coords.size(); n++){
-            chi += Ns[n]*node_phis[n];
+            for(int i=0; i<3; i++){
+                for(int J=0; J<3; J++){
+                    chi_fixed(i,J) += Ns[n]*node_phis[n](i,J);
+                }
+            }
         }
-        chi(0,0) += 1;
-        chi(1,1) += 1;
-        chi(2,2) += 1;
+        chi_fixed(0,0) += 1;
+        chi_fixed(1,1) += 1;
+        chi_fixed(2,2) += 1;
+        
+        chi_fixed.to_base_tensor(chi);
         return;
     }
     
@@ -777,23 +1293,24 @@ namespace micro_element
         */
         
         //Initialize vectors
-        tensor::Tensor23 chi_n({3,3});          //!The value of chi at a node
-        tensor::Tensor23 I     = tensor::eye(); //!The second order identity tensor
-        
-        //Set grad_chi to zero
-        grad_chi.data.setZero();
+        tensor::FixedTensor23 chi_n;          //!The value of chi at a node
+        tensor::FixedTensor33 grad_chi_fixed; //!The gradient of the microdisplacement tensor
         
         for(int n=0; n<reference_coords.size(); n++){
-            chi_n = node_phis[n]+I;
+            chi_n.from_base_tensor(node_phis[n]);
+            chi_n(0,0) += 1;
+            chi_n(1,1) += 1;
+            chi_n(2,2) += 1;
             for(int i=0; i<3; i++){
                 for(int J=0; J<3; J++){
                     for(int K=0; K<3; K++){
-                        grad_chi(i,J,K) += chi_n(i,J)*dNdXs[n][K];
+                        grad_chi_fixed(i,J,K) += chi_n(i,J)*dNdXs[n][K];
                     }
                 }
             }
         }
         
+        grad_chi_fixed.to_base_tensor(grad_chi);
         return;
     }
     
@@ -831,20 +1348,23 @@ namespace micro_element
         
         */
         
-        //Zero the contents of C
-        C.data.setZero();
+        tensor::FixedTensor23 F_fixed; //!The deformation gradient
+        tensor::FixedTensor23 C_fixed; //!The right Cauchy-Green deformation tensor
+        F_fixed.from_base_tensor(F);
         
         //Form the right Cauchy-Green deformation tensor
         for(int I=0; I<3; I++){
             for(int J=0; J<3; J++){
                 for(int i=0; i<3; i++){
-                    C(I,J) += F(i,I)*F(i,J);
+                    C_fixed(I,J) += F_fixed(i,I)*F_fixed(i,J);
                 }
             }
         }
         
+        C_fixed.to_base_tensor(C);
+        
         //Set the inverse of C so they are consistent
-        Cinv = C.inverse();
+        tensor::inverse(C_fixed).to_base_tensor(Cinv);
     }
     
     void Hex8::compute_Psi(){
@@ -858,17 +1378,22 @@ namespace micro_element
         
         */
         
-        //Zero the contents of Psi
-        Psi.data.setZero();
+        tensor::FixedTensor23 F_fixed;   //!The deformation gradient
+        tensor::FixedTensor23 chi_fixed; //!The microdisplacement tensor
+        tensor::FixedTensor23 Psi_fixed; //!The micro deformation tensor
+        F_fixed.from_base_tensor(F);
+        chi_fixed.from_base_tensor(chi);
         
         //Form Psi
         for(int I=0; I<3; I++){
             for(int J=0; J<3; J++){
                 for(int i=0; i<3; i++){
-                    Psi(I,J) += F(i,I)*chi(i,J);
+                    Psi_fixed(I,J) += F_fixed(i,I)*chi_fixed(i,J);
                 }
             }
         }
+        
+        Psi_fixed.to_base_tensor(Psi);
     }
     
     void Hex8::compute_Gamma(){
@@ -883,19 +1408,24 @@ namespace micro_element
         
         */
         
-        //Zero the contents of Gamma
-        Gamma.data.setZero();
+        tensor::FixedTensor23 F_fixed;        //!The deformation gradient
+        tensor::FixedTensor33 grad_chi_fixed; //!The gradient of the microdisplacement tensor
+        tensor::FixedTensor33 Gamma_fixed;    //!The higher order deformation tensor
+        F_fixed.from_base_tensor(F);
+        grad_chi_fixed.from_base_tensor(grad_chi);
         
         //Form Gamma
         for(int I=0; I<3; I++){
             for(int J=0; J<3; J++){
                 for(int K=0; K<3; K++){
                     for(int i=0; i<3; i++){
-                        Gamma(I,J,K) += F(i,I)*grad_chi(i,J,K);
+                        Gamma_fixed(I,J,K) += F_fixed(i,I)*grad_chi_fixed(i,J,K);
                     }
                 }
             }
         }
+        
+        Gamma_fixed.to_base_tensor(Gamma);
     }
     
     //!=
@@ -909,10 +1439,13 @@ namespace micro_element
         
         Set the stresses computed from the 
         constitutive model at the current 
-        gauss point.
+        gauss point and update its state 
+        variables.
         
         */
         
+        MICROMORPHIC_TIME_SCOPE("material micro_material");
+        
         if(set_tangents){
             micro_material::get_stress(     fparams,       iparams,
                                                   C,           Psi,        Gamma,
@@ -927,6 +1460,13 @@ namespace micro_element
         else{
             micro_material::get_stress(fparams,iparams,C,Psi,Gamma,PK2[gpt_num],SIGMA[gpt_num],M[gpt_num]);
         }
+        
+        //The micro_material model has no state variables so those of the gauss point are carried over
+        if(SVARS!=previous_SVARS){
+            for(unsigned int i=0; i<num_sdvs; i++){
+                SVARS[i*number_gauss_points+gpt_num] = previous_SVARS[i*number_gauss_points+gpt_num];
+            }
+        }
 
         return;
     }
@@ -1595,6 +2135,124 @@ namespace micro_element
         return;
     }
     
+    //!=
+    //!| Hourglass Control
+    //!=
+    
+    void Hex8::add_hourglass_stabilization(bool set_tangents, bool ignore_RHS){
+        /*!=====================================
+        |    add_hourglass_stabilization    |
+        =====================================
+        
+        Add the stiffness based hourglass control of 
+        Flanagan and Belytschko to an element which is 
+        integrated with the single point rule. Nothing 
+        is added for the other rules.
+        
+        The gauss point at the center of the element 
+        does not sense the four hourglass patterns 
+        h_a = xi eta, eta zeta, zeta xi, xi eta zeta of 
+        the nodal values. They are made orthogonal to 
+        the linear fields of the reference configuration 
+        
+        gamma_a_n = h_a_n - (sum_m h_a_m X_m_i) dNdX_n_i
+        
+        where dNdX is evaluated at the center of the 
+        element. Every degree of freedom k is resisted by 
+        
+        RHS(k+12n) -= kappa sum_a gamma_a_n sum_m gamma_a_m U_k_m
+        
+        with kappa = hourglass_coefficient*(lambda + 2 mu)*V^(1/3) 
+        so rigid body motions and homogeneous deformations 
+        are unaffected. lambda and mu are taken from 
+        fparams(1) and fparams(2) in the same way that 
+        the mass matrix takes the density from fparams(0). 
+        The same stiffness is applied to the displacement 
+        and the micro-displacement degrees of freedom.
+        
+        Input:
+            set_tangents: Flag indicating if the (constant) tangent should be added to AMATRX
+            ignore_RHS:   Flag indicating if the RHS should not be updated
+        
+        */
+        
+        if((quadrature_order!=1) || (hourglass_coefficient<=0) || (fparams.size()<3)){return;}
+        
+        const int num_nodes = reference_coords.size();
+        
+        //The jacobian of the reference map at the center of the element
+        Eigen::Matrix3d J0 = Eigen::Matrix3d::Zero();
+        for(int n=0; n<num_nodes; n++){
+            for(int i=0; i<3; i++){
+                for(int j=0; j<3; j++){
+                    J0(i,j) += reference_coords[n][i]*0.125*local_coords[n][j];
+                }
+            }
+        }
+        
+        Eigen::Matrix3d J0inv = J0.inverse();
+        double volume         = 8*J0.determinant();
+        double kappa          = hourglass_coefficient*(fparams(1) + 2*fparams(2))*std::cbrt(fabs(volume));
+        
+        //The gradients of the shape functions at the center of the element
+        double dNdX0[8][3];
+        for(int n=0; n<num_nodes; n++){
+            for(int i=0; i<3; i++){
+                dNdX0[n][i] = 0;
+                for(int j=0; j<3; j++){
+                    dNdX0[n][i] += 0.125*local_coords[n][j]*J0inv(j,i);
+                }
+            }
+        }
+        
+        //The hourglass shape vectors
+        double gamma[4][8];
+        for(int a=0; a<4; a++){
+            double h[8];
+            for(int n=0; n<num_nodes; n++){
+                const std::vector< double > &xi = local_coords[n];
+                h[n] = (a==0) ? xi[0]*xi[1] : (a==1) ? xi[1]*xi[2] : (a==2) ? xi[2]*xi[0] : xi[0]*xi[1]*xi[2];
+            }
+            
+            double hX[3] = {0,0,0};
+            for(int m=0; m<num_nodes; m++){
+                for(int i=0; i<3; i++){hX[i] += h[m]*reference_coords[m][i];}
+            }
+            
+            for(int n=0; n<num_nodes; n++){
+                gamma[a][n] = h[n] - hX[0]*dNdX0[n][0] - hX[1]*dNdX0[n][1] - hX[2]*dNdX0[n][2];
+            }
+        }
+        
+        //Add the hourglass forces
+        if(!ignore_RHS){
+            for(int a=0; a<4; a++){
+                for(int k=0; k<12; k++){
+                    double q = 0;
+                    for(int m=0; m<num_nodes; m++){q += gamma[a][m]*dof_at_nodes[m][k];}
+                    for(int n=0; n<num_nodes; n++){
+                        RHS(k+12*n) -= kappa*gamma[a][n]*q;
+                    }
+                }
+            }
+        }
+        
+        //Add the hourglass stiffness (AMATRX is the derivative of RHS)
+        if(set_tangents){
+            for(int n=0; n<num_nodes; n++){
+                for(int m=0; m<num_nodes; m++){
+                    double stiffness = 0;
+                    for(int a=0; a<4; a++){stiffness += gamma[a][n]*gamma[a][m];}
+                    for(int k=0; k<12; k++){
+                        AMATRX(k+12*n,k+12*m) -= kappa*stiffness;
+                    }
+                }
+            }
+        }
+        
+        return;
+    }
+    
     //!=
     //!| Element Integration 
     //!=
@@ -1637,6 +2295,36 @@ namespace micro_element
         return;
     }
     
+    void Hex8::integrate_gauss_point(int gpt, bool set_tangents, bool ignore_RHS, bool compute_mass){
+        /*!===============================
+        |    integrate_gauss_point    |
+        ===============================
+        
+        Add the contribution of a single gauss 
+        point to the element RHS and AMATRX.
+        
+        Input:
+            gpt:          The gauss point number
+            set_tangents: Flag indicating if the tangents should be computed
+            ignore_RHS:   Flag indicating if the RHS should not be updated
+            compute_mass: Flag indicating if the mass matrix is being computed
+        
+        */
+        
+        gpt_num = gpt;                                 //Update the gauss point number
+        update_gauss_point(set_tangents,compute_mass); //Update all of the gauss points
+        if(!ignore_RHS){
+            add_all_forces();                          //Update the RHS vector from all of the forces
+            add_all_moments();                         //Update the RHS vector from all of the stresses
+        }
+        if(set_tangents){                              //Update AMATRX from the forces and stresses
+            set_force_tangent();
+            set_moment_tangent();
+        }
+        
+        return;
+    }
+    
     void Hex8::integrate_element(bool set_tangents, bool ignore_RHS, bool compute_mass, bool output_stress){
         /*!===========================
         |    integrate_element    |
@@ -1646,18 +2334,13 @@ namespace micro_element
         
         */
         
+        MICROMORPHIC_TIME_SCOPE("element integration");
+        
         for(int i=0; i<number_gauss_points; i++){
-            gpt_num = i;                                   //Update the gauss point number
-            update_gauss_point(set_tangents,compute_mass); //Update all of the gauss points
-            if(!ignore_RHS){
-                add_all_forces();                          //Update the RHS vector from all of the forces
-                add_all_moments();                         //Update the RHS vector from all of the stresses
-            }
-            if(set_tangents){                              //Update AMATRX from the forces and stresses
-                set_force_tangent();
-                set_moment_tangent();
-            }
+            integrate_gauss_point(i, set_tangents, ignore_RHS, compute_mass);
         }
+        
+        add_hourglass_stabilization(set_tangents, ignore_RHS);
 
         if(output_stress){write_output();}
         
@@ -1672,6 +2355,104 @@ namespace micro_element
         return;
     }
     
+    void Hex8::integrate_element(GaussPointPool &pool, bool set_tangents, bool ignore_RHS, bool compute_mass, bool output_stress){
+        /*!===========================
+        |    integrate_element    |
+        ===========================
+        
+        Integrate the element evaluating the 
+        gauss points in parallel on the pool.
+        
+        Each gauss point is evaluated on a per-thread 
+        copy of the element and its contribution is 
+        stored separately. The contributions are then 
+        summed in gauss point order so the result does 
+        not depend on which thread evaluated which 
+        gauss point. It may differ from the serial 
+        integration by round-off since the serial 
+        integration accumulates into a single matrix.
+        
+        The mass matrix accumulates into the element 
+        over the gauss points so its computation, or 
+        a pool without workers, uses the serial 
+        integration.
+        
+        Input:
+            pool:          The pool to evaluate the gauss points on
+            set_tangents:  Flag indicating if the tangents should be computed
+            ignore_RHS:    Flag indicating if the RHS should not be updated
+            compute_mass:  Flag indicating if the mass matrix should be computed
+            output_stress: Flag indicating if the stresses should be written out
+        
+        */
+        
+        if(compute_mass || (pool.size()==0)){
+            integrate_element(set_tangents, ignore_RHS, compute_mass, output_stress);
+            return;
+        }
+        
+        MICROMORPHIC_TIME_SCOPE("element integration");
+        
+        //!The gauss point contributions are kept for the submitting thread 
+        //!so that their storage is reused between elements.
+        static thread_local std::vector< Matrix_RM > gpt_RHS;
+        static thread_local std::vector< Matrix_RM > gpt_AMATRX;
+        static thread_local std::vector< tensor::Tensor23 > gpt_PK2;
+        static thread_local std::vector< tensor::Tensor23 > gpt_SIGMA;
+        static thread_local std::vector< tensor::Tensor33 > gpt_M;
+        
+        gpt_RHS.resize(number_gauss_points);
+        gpt_AMATRX.resize(number_gauss_points);
+        gpt_PK2.resize(number_gauss_points);
+        gpt_SIGMA.resize(number_gauss_points);
+        gpt_M.resize(number_gauss_points);
+        
+        //!The references are captured so that a task stolen by another 
+        //!submitting thread writes into this thread's storage.
+        std::vector< Matrix_RM > &RHS_contributions       = gpt_RHS;
+        std::vector< Matrix_RM > &AMATRX_contributions    = gpt_AMATRX;
+        std::vector< tensor::Tensor23 > &PK2_values       = gpt_PK2;
+        std::vector< tensor::Tensor23 > &SIGMA_values     = gpt_SIGMA;
+        std::vector< tensor::Tensor33 > &M_values         = gpt_M;
+        const Hex8 &source                                = *this;
+        
+        pool.parallel_for(number_gauss_points, [&](int i){
+            static thread_local Hex8 workspace;
+            
+            workspace = source;
+            workspace.RHS.setZero();
+            workspace.AMATRX.setZero();
+            workspace.integrate_gauss_point(i, set_tangents, ignore_RHS, false);
+            
+            RHS_contributions[i]    = workspace.RHS;
+            AMATRX_contributions[i] = workspace.AMATRX;
+            PK2_values[i]           = workspace.PK2[i];
+            SIGMA_values[i]         = workspace.SIGMA[i];
+            M_values[i]             = workspace.M[i];
+        });
+        
+        //!Reduce the contributions in a fixed order
+        for(int i=0; i<number_gauss_points; i++){
+            if(!ignore_RHS){
+                RHS += gpt_RHS[i];
+            }
+            if(set_tangents){
+                AMATRX += gpt_AMATRX[i];
+            }
+            PK2[i]   = gpt_PK2[i];
+            SIGMA[i] = gpt_SIGMA[i];
+            M[i]     = gpt_M[i];
+        }
+        
+        gpt_num = number_gauss_points-1;
+        
+        add_hourglass_stabilization(set_tangents, ignore_RHS);
+        
+        if(output_stress){write_output();}
+        
+        return;
+    }
+    
     //!=
     //!| Output functions
     //!=
@@ -1681,44 +2462,62 @@ namespace micro_element
         |    write_output    |
         ======================
 
-        Write the data to the output file. This 
-        may be used as an error reporting method 
-        in the future.
+        Write the stresses at the gauss points to 
+        the binary stress output of output_name. 
+        The records are buffered and written in 
+        the background (see StressWriter).
+        
+        The writer is looked up once per thread and 
+        again only when the output name changes so 
+        that the registry lock is not taken for 
+        every element.
 
         */
         
-
-        std::ofstream f;
-        f.open(output_name + '_' + std::to_string(el_num) + "_" + std::to_string(step_num) + "_" + std::to_string(inc_num));
-
-        for(int i=0; i<8; i++){
-            //Output the PK2 stress
-            f << "PK2\n";
-            f << PK2[i](0,0) << ", " << PK2[i](1,1) << ", " << PK2[i](2,2) << ", " <<
-                 PK2[i](1,2) << ", " << PK2[i](0,2) << ", " << PK2[i](0,1) << ", " <<
-                 PK2[i](2,1) << ", " << PK2[i](2,0) << ", " << PK2[i](1,0) << "\n";
-
-            //Output the symmetric stress
-            f << "SIGMA\n";
-            f << SIGMA[i](0,0) << ", " << SIGMA[i](1,1) << ", " << SIGMA[i](2,2) << ", " <<
-                 SIGMA[i](1,2) << ", " << SIGMA[i](0,2) << ", " << SIGMA[i](0,1) << "\n";
-
-            //Output the higher order couple stress
-            f << "M\n";
-            f << M[i](0,0,0) << ", " << M[i](1,1,0) << ", " << M[i](2,2,0) << ", " <<
-                 M[i](1,2,0) << ", " << M[i](0,2,0) << ", " << M[i](0,1,0) << ", " <<
-                 M[i](2,1,0) << ", " << M[i](2,0,0) << ", " << M[i](1,0,0) << "\n" <<
-                 M[i](0,0,1) << ", " << M[i](1,1,1) << ", " << M[i](2,2,1) << ", " <<
-                 M[i](1,2,1) << ", " << M[i](0,2,1) << ", " << M[i](0,1,1) << ", " <<
-                 M[i](2,1,1) << ", " << M[i](2,0,1) << ", " << M[i](1,0,1) << "\n" <<
-                 M[i](0,0,2) << ", " << M[i](1,1,2) << ", " << M[i](2,2,2) << ", " <<
-                 M[i](1,2,2) << ", " << M[i](0,2,2) << ", " << M[i](0,1,2) << ", " <<
-                 M[i](2,1,2) << ", " << M[i](2,0,2) << ", " << M[i](1,0,2) << "\n";
-
+        static thread_local std::vector< StressRecord > records;
+        records.resize(number_gauss_points);
+        
+        //The order of the components (see StressRecord)
+        const int first[9]  = {0,1,2,1,0,0,2,2,1};
+        const int second[9] = {0,1,2,2,2,1,1,0,0};
+        
+        for(int i=0; i<number_gauss_points; i++){
+            StressRecord &record = records[i];
+            
+            record.element     = el_num;
+            record.step        = step_num;
+            record.increment   = inc_num;
+            record.gauss_point = i;
+            
+            //The PK2 stress
+            for(int j=0; j<9; j++){
+                record.PK2[j] = PK2[i](first[j],second[j]);
+            }
+            
+            //The symmetric stress
+            for(int j=0; j<6; j++){
+                record.SIGMA[j] = SIGMA[i](first[j],second[j]);
+            }
+            
+            //The higher order couple stress
+            for(int k=0; k<3; k++){
+                for(int j=0; j<9; j++){
+                    record.M[j+9*k] = M[i](first[j],second[j],k);
+                }
+            }
         }
-        f.close();
-
-
+        
+        //Resolve the writer only when the output name changes
+        static thread_local std::string  writer_name;
+        static thread_local StressWriter *writer = NULL;
+        if((!writer) || (writer_name.compare(output_name))){
+            writer      = &get_stress_writer(output_name);
+            writer_name = output_name;
+        }
+        
+        writer->write(records.data(), records.size());
+        
+        return;
     }
 
     //!=
@@ -2383,6 +3182,40 @@ namespace micro_element
         return parsed_vector;
     }
     
+    void Hex8::assign_incoming_vectors(int mode, const double *incoming, std::vector< std::vector< double > > &parsed_vector){
+        /*!=================================
+        |    assign_incoming_vectors    |
+        =================================
+        
+        Copy an incoming contiguous array into an 
+        existing vector of vectors form. This is the 
+        in-place counterpart of parse_incoming_vectors 
+        and only allocates if parsed_vector does not 
+        already have the correct size.
+        
+        */
+        
+        int factor; //! The number of dof associated with a given mode
+        
+        if(mode==1){//Parse an incoming coordinate array
+            factor = 3;
+        }
+        else if(mode==2){//Parse an incoming dof array
+            factor = 12;
+        }
+        else{//Unrecognized mode
+            std::cout << "\nError: The mode value of " << mode << " is not recognized.\n";
+            assert(1==0);
+        }
+        
+        parsed_vector.resize(reference_coords.size());
+        
+        for(int n=0; n<reference_coords.size(); n++){
+            parsed_vector[n].resize(factor);
+            for(int i=0; i<factor; i++){parsed_vector[n][i] = incoming[i+n*factor];}
+        }
+    }
+    
     //!==
     //!|
     //!| Functions
@@ -2422,4 +3255,513 @@ namespace micro_element
         tensor::Tensor23 T = tensor::Tensor23(shape,data);
         return T;
     }
+
+    //!==
+    //!|
+    //!| Gauss Point Pool
+    //!|
+    //!==
+    
+    GaussPointPool::GaussPointPool(unsigned int num_workers){
+        /*!========================
+        |    GaussPointPool    |
+        ========================
+        
+        Construct the pool and start the worker threads.
+        
+        Input:
+            num_workers: The number of worker threads
+        
+        */
+        
+        queues.resize(num_workers);
+        for(unsigned int i=0; i<num_workers; i++){
+            queues[i] = new TaskQueue;
+        }
+        
+        workers.reserve(num_workers);
+        for(unsigned int i=0; i<num_workers; i++){
+            workers.push_back(std::thread(&GaussPointPool::worker_loop, this, i));
+        }
+    }
+    
+    GaussPointPool::~GaussPointPool(){
+        /*!=========================
+        |    ~GaussPointPool    |
+        =========================
+        
+        Stop and join the worker threads.
+        
+        */
+        
+        {
+            std::lock_guard< std::mutex > lock(sleep_mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        
+        for(unsigned int i=0; i<workers.size(); i++){
+            workers[i].join();
+        }
+        
+        for(unsigned int i=0; i<queues.size(); i++){
+            delete queues[i];
+        }
+    }
+    
+    unsigned int GaussPointPool::size() const{
+        /*!==============
+        |    size    |
+        ==============
+        
+        Return the number of worker threads.
+        
+        */
+        
+        return workers.size();
+    }
+    
+    void GaussPointPool::parallel_for(int num_tasks, const std::function< void(int) > &function){
+        /*!======================
+        |    parallel_for    |
+        ======================
+        
+        Evaluate function(i) for i in [0,num_tasks) 
+        and return when all of the tasks have 
+        completed. The calling thread executes 
+        tasks while it waits. Several threads may 
+        submit tasks to the pool at the same time.
+        
+        If a task throws, the first exception is 
+        rethrown once all of the tasks have completed.
+        
+        Input:
+            num_tasks: The number of tasks
+            function:  The function to evaluate for each task
+        
+        */
+        
+        if(num_tasks<=0){return;}
+        
+        if(workers.size()==0){
+            for(int i=0; i<num_tasks; i++){
+                function(i);
+            }
+            return;
+        }
+        
+        Job job;
+        job.function  = &function;
+        job.remaining = num_tasks;
+        
+        //!Distribute the tasks across the worker queues
+        unsigned int start;
+        {
+            std::lock_guard< std::mutex > lock(sleep_mutex);
+            start      = next_queue;
+            next_queue = (next_queue + num_tasks)%queues.size();
+        }
+        
+        for(int i=0; i<num_tasks; i++){
+            Task task;
+            task.job   = &job;
+            task.index = i;
+            
+            TaskQueue *queue = queues[(start + i)%queues.size()];
+            std::lock_guard< std::mutex > lock(queue->mutex);
+            queue->tasks.push_back(task);
+        }
+        
+        {
+            std::lock_guard< std::mutex > lock(sleep_mutex);
+            pending += num_tasks;
+        }
+        wake.notify_all();
+        
+        //!Help execute the queued tasks
+        Task task;
+        while(pop_task(start, task)){
+            execute(task);
+        }
+        
+        //!Wait for the tasks being executed by the workers
+        std::unique_lock< std::mutex > lock(job.mutex);
+        job.finished.wait(lock, [&job]{return job.remaining==0;});
+        
+        if(job.error){
+            std::rethrow_exception(job.error);
+        }
+        
+        return;
+    }
+    
+    bool GaussPointPool::pop_task(unsigned int home, Task &task){
+        /*!==================
+        |    pop_task    |
+        ==================
+        
+        Take a task from the home queue or, if it is 
+        empty, steal one from the other queues.
+        
+        Input:
+            home: The index of the queue to check first
+            task: The task which was taken
+        
+        */
+        
+        unsigned int num_queues = queues.size();
+        
+        for(unsigned int i=0; i<num_queues; i++){
+            TaskQueue *queue = queues[(home + i)%num_queues];
+            
+            std::unique_lock< std::mutex > lock(queue->mutex);
+            if(queue->tasks.empty()){continue;}
+            
+            //!The owner takes the most recent task and thieves take the oldest
+            if(i==0){
+                task = queue->tasks.back();
+                queue->tasks.pop_back();
+            }
+            else{
+                task = queue->tasks.front();
+                queue->tasks.pop_front();
+            }
+            lock.unlock();
+            
+            std::lock_guard< std::mutex > sleep_lock(sleep_mutex);
+            pending--;
+            return true;
+        }
+        
+        return false;
+    }
+    
+    void GaussPointPool::execute(const Task &task){
+        /*!=================
+        |    execute    |
+        =================
+        
+        Execute a task and mark it as completed.
+        
+        Input:
+            task: The task to execute
+        
+        */
+        
+        std::exception_ptr error;
+        
+        try{
+            (*task.job->function)(task.index);
+        }
+        catch(...){
+            error = std::current_exception();
+        }
+        
+        //!The job is owned by the submitting thread which returns 
+        //!once remaining reaches zero so it may not be accessed 
+        //!after the lock is released.
+        std::lock_guard< std::mutex > lock(task.job->mutex);
+        if(error && !task.job->error){
+            task.job->error = error;
+        }
+        task.job->remaining--;
+        if(task.job->remaining==0){
+            task.job->finished.notify_all();
+        }
+        
+        return;
+    }
+    
+    void GaussPointPool::worker_loop(unsigned int id){
+        /*!=====================
+        |    worker_loop    |
+        =====================
+        
+        The loop run by each of the worker threads.
+        
+        Input:
+            id: The index of the worker's queue
+        
+        */
+        
+        Task task;
+        
+        while(true){
+            if(pop_task(id, task)){
+                execute(task);
+                continue;
+            }
+            
+            std::unique_lock< std::mutex > lock(sleep_mutex);
+            wake.wait(lock, [this]{return stop || (pending>0);});
+            if(stop){return;}
+        }
+    }
+    
+    static unsigned int read_gauss_point_threads(){
+        /*!==================================
+        |    read_gauss_point_threads    |
+        ==================================
+        
+        Read the number of gauss point worker threads 
+        from the environment. The calling thread also 
+        executes tasks so one fewer worker than the 
+        requested number of threads is created.
+        
+        */
+        
+        const char *value = std::getenv("MICROMORPHIC_GAUSS_POINT_THREADS");
+        if(value==NULL){return 0;}
+        
+        int num_threads = std::atoi(value);
+        if(num_threads<=1){return 0;}
+        
+        return num_threads-1;
+    }
+    
+    GaussPointPool& get_gauss_point_pool(){
+        /*!==============================
+        |    get_gauss_point_pool    |
+        ==============================
+        
+        Return the pool used to evaluate the gauss 
+        points of the elements. The pool is created 
+        once per process the first time it is requested.
+        
+        The number of workers is read from the 
+        environment variable MICROMORPHIC_GAUSS_POINT_THREADS. 
+        If it is not defined, the pool has no workers and 
+        elements are integrated serially.
+        
+        */
+        
+        static GaussPointPool pool(read_gauss_point_threads());
+        
+        return pool;
+    }
+
+    //!==
+    //!|
+    //!| Stress Writer
+    //!|
+    //!==
+    
+    StressWriter::StressWriter(const std::string &filename, unsigned int _chunk_size){
+        /*!======================
+        |    StressWriter    |
+        ======================
+        
+        Open the output file and start the 
+        background flush thread. Records are 
+        appended if the file already exists.
+        
+        Input:
+            filename:   The name of the output file
+            chunk_size: The number of records which triggers a write
+        
+        */
+        
+        chunk_size = std::max(_chunk_size, (unsigned int)1);
+        chunk.reserve(chunk_size);
+        
+        file.open(filename, std::ios::binary | std::ios::app);
+        if(!file.is_open()){
+            std::cout << "Error: Could not open " << filename << " for stress output\n";
+            assert(1==0);
+        }
+        
+        //Write the file header if the file is new
+        if(file.tellp()==0){
+            const char     magic[8]    = {'M','I','C','R','O','S','T','R'};
+            const uint32_t version     = 1;
+            const uint32_t record_size = sizeof(StressRecord);
+            
+            file.write(magic, sizeof(magic));
+            file.write((const char*)&version,     sizeof(version));
+            file.write((const char*)&record_size, sizeof(record_size));
+            file.flush();
+        }
+        
+        flusher = std::thread(&StressWriter::flush_loop, this);
+    }
+    
+    StressWriter::~StressWriter(){
+        /*!=======================
+        |    ~StressWriter    |
+        =======================
+        
+        Write any buffered records, stop the 
+        flush thread, and close the file.
+        
+        */
+        
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+            queue_chunk();
+            stop = true;
+        }
+        chunk_queued.notify_all();
+        flusher.join();
+        
+        file.close();
+    }
+    
+    void StressWriter::write(const StressRecord *records, unsigned int num_records){
+        /*!===============
+        |    write    |
+        ===============
+        
+        Buffer records for output. The records are 
+        copied so the caller may reuse them as soon 
+        as the call returns.
+        
+        Input:
+            records:     The records to write
+            num_records: The number of records
+        
+        */
+        
+        bool queued = false;
+        
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+            chunk.insert(chunk.end(), records, records + num_records);
+            if(chunk.size()>=chunk_size){
+                queue_chunk();
+                queued = true;
+            }
+        }
+        
+        if(queued){chunk_queued.notify_one();}
+        
+        return;
+    }
+    
+    void StressWriter::flush(){
+        /*!===============
+        |    flush    |
+        ===============
+        
+        Return once all of the records written 
+        so far are in the file.
+        
+        */
+        
+        std::unique_lock< std::mutex > lock(mutex);
+        queue_chunk();
+        chunk_queued.notify_one();
+        
+        uint64_t target = chunks_queued;
+        chunk_written.wait(lock, [this, target]{return chunks_written>=target;});
+        
+        return;
+    }
+    
+    void StressWriter::queue_chunk(){
+        /*!=====================
+        |    queue_chunk    |
+        =====================
+        
+        Move the chunk being filled to the queue of 
+        chunks to write. The mutex must be held.
+        
+        */
+        
+        if(chunk.empty()){return;}
+        
+        queued_chunks.push_back(std::vector< StressRecord >());
+        queued_chunks.back().swap(chunk);
+        chunks_queued++;
+        
+        //Reuse the storage of a chunk which has been written
+        if(!spare_chunks.empty()){
+            chunk.swap(spare_chunks.back());
+            spare_chunks.pop_back();
+        }
+        chunk.clear();
+        chunk.reserve(chunk_size);
+        
+        return;
+    }
+    
+    void StressWriter::flush_loop(){
+        /*!====================
+        |    flush_loop    |
+        ====================
+        
+        The loop run by the background thread. 
+        Queued chunks are written as they arrive 
+        and a partially filled chunk is written 
+        after a second without a full one.
+        
+        */
+        
+        std::unique_lock< std::mutex > lock(mutex);
+        
+        while(true){
+            if(queued_chunks.empty()){
+                if(stop){return;}
+                
+                if(!chunk_queued.wait_for(lock, std::chrono::seconds(1), [this]{return stop || !queued_chunks.empty();})){
+                    queue_chunk();
+                }
+                continue;
+            }
+            
+            std::vector< StressRecord > records;
+            records.swap(queued_chunks.front());
+            queued_chunks.pop_front();
+            
+            //The file is only accessed by this thread so the write 
+            //does not need to hold the lock
+            lock.unlock();
+            
+            {
+                MICROMORPHIC_TIME_SCOPE("io stress output");
+                const uint64_t num_records = records.size();
+                file.write((const char*)&num_records, sizeof(num_records));
+                file.write((const char*)records.data(), num_records*sizeof(StressRecord));
+                file.flush();
+            }
+            
+            lock.lock();
+            spare_chunks.push_back(std::vector< StressRecord >());
+            spare_chunks.back().swap(records);
+            chunks_written++;
+            chunk_written.notify_all();
+        }
+    }
+    
+    StressWriter& get_stress_writer(const std::string &output_name){
+        /*!===========================
+        |    get_stress_writer    |
+        ===========================
+        
+        Return the stress writer for an output name. 
+        The writer is created the first time it is 
+        requested and flushed when the process exits. 
+        The process id is included in the filename 
+        so that processes sharing an output name do 
+        not write to the same file.
+        
+        The writers live until the process exits so 
+        the returned reference may be cached.
+        
+        Input:
+            output_name: The output name of the element
+        
+        */
+        
+        static std::mutex                                             writers_mutex;
+        static std::map< std::string, std::unique_ptr< StressWriter > > writers;
+        
+        std::lock_guard< std::mutex > lock(writers_mutex);
+        
+        std::unique_ptr< StressWriter > &writer = writers[output_name];
+        if(!writer){
+            writer.reset(new StressWriter(output_name + "_" + std::to_string(getpid()) + ".stress"));
+        }
+        
+        return *writer;
+    }
 }
@@ -16,6 +16,16 @@
   
 #include <iostream>
 #include <vector>
+#include <deque>
+#include <functional>
+#include <exception>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <cstdint>
 
 //!Type definitions for maps between pointers and eigen maps
 typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> Matrix_RM;
@@ -37,6 +47,186 @@ typedef Eigen::Matrix<double,8,8> Matrix_8d;
   
 namespace micro_element
 {
+    class ShapeFunctionCache{
+        /*!===
+         |
+         | S h a p e F u n c t i o n C a c h e
+         |
+        ===
+        
+        The values of the shape functions, their gradients 
+        w.r.t. the local and reference coordinates, and 
+        the determinant of the jacobian of transformation 
+        to the reference configuration at each of the 
+        gauss points of an element.
+        
+        None of these change as the element deforms so 
+        they can be computed once for a fixed reference 
+        mesh and reused for every evaluation.
+        
+        */
+        
+        public:
+            std::vector< std::vector< double > >                Ns;       //!The shape function values [gpt][node]
+            std::vector< std::vector< std::vector< double > > > dNdxis;   //!The local gradients of the shape functions [gpt][node][i]
+            std::vector< std::vector< std::vector< double > > > dNdXs;    //!The reference gradients of the shape functions [gpt][node][i]
+            std::vector< double >                               Jhatdets; //!The determinant of the reference jacobian [gpt]
+            bool                                                is_set = false; //!Flag indicating if the cache has been populated
+    };
+    
+    class GaussPointPool{
+        /*!===
+         |
+         | G a u s s P o i n t P o o l
+         |
+        ===
+        
+        A persistent pool of worker threads used to 
+        evaluate the gauss points of an element in 
+        parallel.
+        
+        Each worker owns a queue of tasks. Tasks are 
+        distributed across the queues when they are 
+        submitted and a worker which runs out of work 
+        steals tasks from the other queues. The thread 
+        which submits the tasks helps to execute them 
+        so that a pool with no workers evaluates all 
+        tasks serially.
+        
+        The threads are created once when the pool is 
+        constructed and joined when it is destroyed.
+        
+        */
+        
+        public:
+            GaussPointPool(unsigned int num_workers = 0);
+            ~GaussPointPool();
+            
+            unsigned int size() const;
+            
+            void parallel_for(int num_tasks, const std::function< void(int) > &function);
+            
+        private:
+            struct Job{
+                const std::function< void(int) > *function; //!The function to evaluate for each task
+                int                               remaining; //!The number of tasks which have not completed
+                std::mutex                        mutex;     //!The mutex protecting remaining and error
+                std::condition_variable           finished;  //!Signalled when the last task completes
+                std::exception_ptr                error;     //!The first exception thrown by a task
+            };
+            
+            struct Task{
+                Job *job;   //!The job the task belongs to
+                int  index; //!The index of the task in the job
+            };
+            
+            struct TaskQueue{
+                std::mutex         mutex; //!The mutex protecting the queue
+                std::deque< Task > tasks; //!The queued tasks
+            };
+            
+            GaussPointPool(const GaussPointPool&);
+            GaussPointPool& operator=(const GaussPointPool&);
+            
+            bool pop_task(unsigned int home, Task &task);
+            void execute(const Task &task);
+            void worker_loop(unsigned int id);
+            
+            std::vector< std::thread >  workers;          //!The worker threads
+            std::vector< TaskQueue* >   queues;           //!The task queue of each worker
+            std::mutex                  sleep_mutex;      //!The mutex protecting pending and stop
+            std::condition_variable     wake;             //!Signalled when tasks are added or the pool stops
+            int                         pending    = 0;   //!The number of queued tasks
+            bool                        stop       = false; //!Flag indicating the workers should exit
+            unsigned int                next_queue = 0;   //!The queue the next submitted task is placed in
+    };
+    
+    GaussPointPool& get_gauss_point_pool();
+    
+    struct StressRecord{
+        /*!===
+         |
+         | S t r e s s R e c o r d
+         |
+        ===
+        
+        The stresses at a gauss point as written 
+        to the binary stress output. The components 
+        are in the same order as the historical text 
+        output i.e.
+        
+        PK2:   11, 22, 33, 23, 13, 12, 32, 31, 21
+        SIGMA: 11, 22, 33, 23, 13, 12
+        M:     the PK2 ordering of the first two indices 
+               for the third index equal to 1, 2, and 3
+        
+        */
+        
+        int32_t element;     //!The element number
+        int32_t step;        //!The step number
+        int32_t increment;   //!The increment number
+        int32_t gauss_point; //!The gauss point number
+        double  PK2[9];      //!The second Piola-Kirchhoff stress
+        double  SIGMA[6];    //!The symmetric micro stress
+        double  M[27];       //!The higher order couple stress
+    };
+    
+    class StressWriter{
+        /*!===
+         |
+         | S t r e s s W r i t e r
+         |
+        ===
+        
+        A buffered writer of the gauss point stresses 
+        of all of the elements to a single append-only 
+        binary file.
+        
+        Records are copied into an in-memory chunk 
+        by the calling thread. Full chunks, and any 
+        partially filled chunk once a second, are 
+        written by a background thread so that the 
+        caller does not wait on the filesystem.
+        
+        The file starts with the characters MICROSTR, 
+        the format version and the size of a record 
+        (all uint32_t) and is followed by chunks 
+        consisting of the number of records (uint64_t) 
+        and the StressRecords.
+        
+        */
+        
+        public:
+            StressWriter(const std::string &filename, unsigned int chunk_size = 4096);
+            ~StressWriter();
+            
+            void write(const StressRecord *records, unsigned int num_records);
+            
+            void flush();
+            
+        private:
+            StressWriter(const StressWriter&);
+            StressWriter& operator=(const StressWriter&);
+            
+            void queue_chunk();
+            void flush_loop();
+            
+            std::ofstream                                file;            //!The output file
+            unsigned int                                 chunk_size;      //!The number of records in a full chunk
+            std::vector< StressRecord >                  chunk;           //!The chunk being filled
+            std::deque< std::vector< StressRecord > >    queued_chunks;   //!The chunks waiting to be written
+            std::vector< std::vector< StressRecord > >   spare_chunks;    //!Written chunks whose storage is reused
+            std::mutex                                   mutex;           //!The mutex protecting the chunks and counters
+            std::condition_variable                      chunk_queued;    //!Signalled when a chunk is queued or the writer stops
+            std::condition_variable                      chunk_written;   //!Signalled when a chunk has been written
+            uint64_t                                     chunks_queued  = 0;     //!The number of chunks which have been queued
+            uint64_t                                     chunks_written = 0;     //!The number of chunks which have been written
+            bool                                         stop           = false; //!Flag indicating the flush thread should exit
+            std::thread                                  flusher;         //!The background flush thread
+    };
+    
+    StressWriter& get_stress_writer(const std::string &output_name);
+    
     class Hex8{
         /*!===
          |
@@ -77,7 +267,9 @@ namespace micro_element
             //!=
             //!| Gauss Quadrature
             //!=
-            int number_gauss_points = 8; //!The number of gauss points
+            int    quadrature_order      = 2;    //!The number of gauss points in each direction (see set_quadrature_rule)
+            double hourglass_coefficient = 0.05; //!The hourglass stiffness relative to lambda + 2 mu (single point rule only)
+            int    number_gauss_points   = 8;    //!The number of gauss points
             
             std::vector< std::vector< double > > points  = {{-0.57735026918962573, -0.57735026918962573, -0.57735026918962573},
                                                             {-0.57735026918962573, -0.57735026918962573,  0.57735026918962573},
@@ -118,6 +310,15 @@ namespace micro_element
             
             Matrix_8d mini_mass;
             
+            //!=
+            //!| Lumped Mass
+            //!=
+            
+            Vector lumped_mass;                                             //!The diagonal (lumped) mass of each of the 96 degrees of freedom
+            std::vector< double > reference_micro_inertia = {1,0,0,         //!The micro-inertia tensor per unit mass in the reference 
+                                                             0,1,0,         //!configuration (row-major). The identity is consistent 
+                                                             0,0,1};        //!with the mass matrix of set_mass_matrix.
+            
             //!=
             //!| Constitutive model parameters
             //!=
@@ -133,7 +334,12 @@ namespace micro_element
             //!| State variables
             //!=
             
-            Vector SVARS;
+            //!The state variables are viewed rather than copied. State variable i of 
+            //!gauss point g is at [i*number_gauss_points+g] of both arrays which may 
+            //!be the same array (e.g. the SVARS of Abaqus).
+            const double *previous_SVARS = NULL; //!The state variables of the last converged increment
+            double       *SVARS          = NULL; //!The updated state variables
+            unsigned int  num_sdvs       = 0;    //!The number of state variables at each gauss point
             
             //!=
             //!| Incoming values from Abaqus
@@ -174,7 +380,7 @@ namespace micro_element
             Hex8(std::vector< double >, std::vector< double >, std::vector< double >, std::vector<double> _fparams = {}, std::vector<int> _iparams = {});
             
             //!Constructor for Abaqus implementation
-            Hex8(double *_RHS,          double *_AMATRX,        Vector &_SVARS, energy_vector &ENERGY,
+            Hex8(double *_RHS,          double *_AMATRX,        double *_SVARS, int NSVARS,     energy_vector &ENERGY,
                  Vector &PROPS,         Matrix_RM &COORDS,      Vector &U,      Vector &DU,
                  Vector &V,             Vector &A,              double TIME[2], double DTIME, 
                  int KSTEP,             int KINC,               int JELEM,      params_vector &PARAMS,
@@ -182,6 +388,25 @@ namespace micro_element
                  lflags_vector &LFLAGS, Matrix_RM &DDLMAG,      double PNEWDT,  Vectori &JPROPS,
                  double PERIOD,         std::string output_fn);
                  
+            //!==
+            //!|
+            //!| Reinitialization
+            //!|
+            //!==
+            
+            //!Reset the element to new nodal values without reallocating its storage
+            void reset(const std::vector< double > &rcs, const std::vector< double > &U, const std::vector< double > &dU,
+                       const std::vector< double > &_fparams = {}, const std::vector< int > &_iparams = {});
+            
+            //!Reset the element for the Abaqus implementation
+            void reset(double *_RHS,          double *_AMATRX,        double *_SVARS, int NSVARS,
+                       Vector &PROPS,         Matrix_RM &COORDS,      Vector &U,      Vector &DU,
+                       int KSTEP,             int KINC,               int JELEM,      Vectori &JPROPS,
+                       std::string output_fn);
+            
+            //!Set the view of the state variables of the gauss points
+            void set_state_variables(const double *_previous_SVARS, double *_SVARS, unsigned int _num_sdvs);
+            
             //!==
             //!|
             //!| Destructors
@@ -208,6 +433,13 @@ namespace micro_element
             //!|
             //!==
             
+            //!=
+            //!| Quadrature
+            //!=
+            
+            void set_quadrature_rule(int order);
+            void set_quadrature_from_iparams();
+            
             //!=
             //!| Shape Functions
             //!=
@@ -227,6 +459,10 @@ namespace micro_element
             
             void update_mini_mass();
             void set_mass_matrix();
+            void set_lumped_mass(bool hrz = false);
+            
+            void build_shape_function_cache(ShapeFunctionCache &);
+            void set_shape_function_cache(const ShapeFunctionCache *);
             
             //!=
             //!| Fundamental Deformation Measures
@@ -312,12 +548,20 @@ namespace micro_element
             //!|=> Tangent utilities
             void reset_tangents();
             
+            //!=
+            //!| Hourglass Control
+            //!=
+            
+            void add_hourglass_stabilization(bool set_tangents = false, bool ignore_RHS = false);
+            
             //!=
             //!| Element Integration 
             //!=
             
             void update_gauss_point(bool set_tangents = false, bool compute_mass = false);
+            void integrate_gauss_point(int gpt, bool set_tangents = false, bool ignore_RHS = false, bool compute_mass = false);
             void integrate_element(bool set_tangents = false, bool ignore_RHS = false, bool compute_mass = false, bool output_stress = false);
+            void integrate_element(GaussPointPool &pool, bool set_tangents = false, bool ignore_RHS = false, bool compute_mass = false, bool output_stress = false);
             
             //!=
             //!| Element Output
@@ -370,6 +614,7 @@ namespace micro_element
             std::vector< int > sot_shape = {3,3};
             
             int gpt_num             = -1;                               //!The current gauss point number
+            const ShapeFunctionCache *shape_function_cache = NULL;      //!The cached reference shape function values (if defined)
             std::vector< double >                Ns;                    //!The shape function values
             std::vector< std::vector< double > > dNdxis;                //!The derivatives of the shape function with respect
                                                                         //!to the local coordinates.
@@ -448,6 +693,14 @@ namespace micro_element
             
             std::vector< std::vector< double > > parse_incoming_vectors(int,const std::vector< double > &);
             std::vector< std::vector< double > > parse_incoming_vectors(int,const Matrix_RM&);
+            void assign_incoming_vectors(int, const double *, std::vector< std::vector< double > > &);
+            
+            //!=
+            //!| Reinitialization utilities
+            //!=
+            
+            void zero_element_storage();
+            void set_nodal_values();
     };
     
     //!==
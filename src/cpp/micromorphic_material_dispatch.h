@@ -0,0 +1,56 @@
+/*!
+=====================================================================
+|                 micromorphic_material_dispatch.h                  |
+=====================================================================
+| Compile time selection of the material model. By default the      |
+| material models are looked up by name in the MaterialFactory and  |
+| evaluated through the virtual IMaterial interface. A build which  |
+| only uses one model can define                                    |
+|                                                                   |
+|     MICROMORPHIC_STATIC_MATERIAL: The type of the model           |
+|     MICROMORPHIC_STATIC_MATERIAL_HEADER: The header defining it   |
+|                                                                   |
+| ( set by the TARDIGRADE_MICROMORPHIC_ELEMENT_STATIC_MATERIAL      |
+| CMake option ) and code templated on the material type can then   |
+| call the model directly so that it may be inlined.                |
+=====================================================================
+*/
+
+#ifndef MICROMORPHIC_MATERIAL_DISPATCH_H
+#define MICROMORPHIC_MATERIAL_DISPATCH_H
+
+#include <micromorphic_material_library.h>
+
+#ifdef MICROMORPHIC_STATIC_MATERIAL
+#ifndef MICROMORPHIC_STATIC_MATERIAL_HEADER
+#error "MICROMORPHIC_STATIC_MATERIAL_HEADER must be defined along with MICROMORPHIC_STATIC_MATERIAL"
+#endif
+#include MICROMORPHIC_STATIC_MATERIAL_HEADER
+#endif
+
+namespace micromorphic_material_library {
+
+#ifdef MICROMORPHIC_STATIC_MATERIAL
+    /* The material model selected at configure time */
+    typedef MICROMORPHIC_STATIC_MATERIAL StaticMaterial;
+#else
+    /* No model selected at configure time. Dispatch through the virtual interface. */
+    typedef IMaterial StaticMaterial;
+#endif
+
+    inline std::shared_ptr<StaticMaterial> get_static_material(const std::shared_ptr<IMaterial> &material) {
+        /*!
+         * Get a material served by the MaterialFactory as the material type selected at configure time
+         *
+         * Returns NULL if the material is of a different type in which case the caller should fall back to the
+         * virtual interface. If no material was selected at configure time the material is always returned.
+         *
+         * :param const std::shared_ptr< IMaterial > &material: The material
+         */
+
+        return std::dynamic_pointer_cast<StaticMaterial>(material);
+    }
+
+}  // namespace micromorphic_material_library
+
+#endif
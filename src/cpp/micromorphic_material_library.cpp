@@ -17,10 +17,34 @@
 
 #include "micromorphic_material_library.h"
 
+#include <algorithm>
+#include <array>
+#include <exception>
 #include <iostream>
+#include <thread>
 
 namespace micromorphic_material_library {
 
+    namespace {
+
+        void zero_jacobian(std::vector<std::vector<double> > &jacobian, const std::size_t rows,
+                           const std::size_t cols) {
+            /*!
+             * Set a nested vector jacobian to zero with the given shape re-using its existing storage
+             *
+             * :param std::vector< std::vector< double > > &jacobian: The jacobian
+             * :param const std::size_t rows: The number of rows
+             * :param const std::size_t cols: The number of columns
+             */
+
+            jacobian.resize(rows);
+            for (auto &row : jacobian) {
+                row.assign(cols, 0);
+            }
+        }
+
+    }  // namespace
+
     // IMaterial::~Imaterial(){}
 
     // IMaterialRegistrar::~IMaterialRegistrar(){}
@@ -42,7 +66,7 @@ namespace micromorphic_material_library {
         std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG,
 
 #endif
-        double delta) {
+        double delta, const NumericGradientScheme scheme, const unsigned int num_threads) {
 
         /*!
          * Evaluate the jacobian of the material model using a numeric gradient
@@ -90,8 +114,13 @@ namespace micromorphic_material_library {
          * std::vector< double > > &DMDgrad_phi: The Jacobian of the reference higher order stress w.r.t. the gradient
          * of the micro displacement. :param std::vector< std::vector< double > > &ADD_TERMS: Additional terms :param
          * std::vector< std::vector< std::vector< double > > > &ADD_JACOBIANS: The jacobians of the additional terms
-         * w.r.t. the deformation :param std::string &output_message: The output message string. :param double delta =
-         * 1e-6: The perturbation to be applied to the incoming degrees of freedom.
+         * w.r.t. the deformation :param std::string &output_message: The output message string. Only built if the
+         * evaluation fails. :param double delta = 1e-6: The perturbation to be applied to the incoming degrees of
+         * freedom.
+         * :param const NumericGradientScheme scheme = CENTRAL_DIFFERENCE: The finite difference scheme.
+         *     FORWARD_DIFFERENCE re-uses the evaluation at the set point and so calls the model about half as often.
+         * :param const unsigned int num_threads = 1: The number of threads used to evaluate the perturbations. If
+         *     greater than one, evaluate_model must be safe to call concurrently on the same material.
          *
          * Returns:
          *     0: No errors. Solution converged.
@@ -99,11 +128,74 @@ namespace micromorphic_material_library {
          *     2: Fatal Errors encountered. Terminate the simulation.
          */
 
+        thread_local MaterialDiagnostic diagnostic;
+
+        int errorCode = evaluate_model_numeric_gradients(
+            time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+            previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+            PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+            DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, diagnostic,
+#ifdef DEBUG_MODE
+            DEBUG,
+#endif
+            delta, scheme, num_threads);
+
+        // The message is only built if the evaluation failed
+        if (errorCode > 0) {
+            output_message = diagnostic.message();
+        }
+
+        return errorCode;
+    }
+
+    int IMaterial::evaluate_model_numeric_gradients(
+        const std::vector<double> &time, const std::vector<double>(&fparams), const double (&current_grad_u)[3][3],
+        const double (&current_phi)[9], const double (&current_grad_phi)[9][3], const double (&previous_grad_u)[3][3],
+        const double (&previous_phi)[9], const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS,
+        const std::vector<double> &current_ADD_DOF, const std::vector<std::vector<double> > &current_ADD_grad_DOF,
+        const std::vector<double> &previous_ADD_DOF, const std::vector<std::vector<double> > &previous_ADD_grad_DOF,
+        std::vector<double> &PK2, std::vector<double> &SIGMA, std::vector<double> &M,
+        std::vector<std::vector<double> > &DPK2Dgrad_u, std::vector<std::vector<double> > &DPK2Dphi,
+        std::vector<std::vector<double> > &DPK2Dgrad_phi, std::vector<std::vector<double> > &DSIGMADgrad_u,
+        std::vector<std::vector<double> > &DSIGMADphi, std::vector<std::vector<double> > &DSIGMADgrad_phi,
+        std::vector<std::vector<double> > &DMDgrad_u, std::vector<std::vector<double> > &DMDphi,
+        std::vector<std::vector<double> > &DMDgrad_phi, std::vector<std::vector<double> > &ADD_TERMS,
+        std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS, MaterialDiagnostic &diagnostic,
+#ifdef DEBUG_MODE
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG,
+
+#endif
+        double delta, const NumericGradientScheme scheme, const unsigned int num_threads) {
+
+        /*!
+         * Evaluate the jacobian of the material model using a numeric gradient reporting failures through a
+         * diagnostic record rather than a message string.
+         *
+         * The scratch storage of the perturbed evaluations is kept per thread and the jacobians are resized in place
+         * so repeated calls with the same material perform no heap allocations unless the model fails ( or allocates
+         * itself ) when a single thread is used.
+         *
+         * The arguments are the same as for the std::string form of evaluate_model_numeric_gradients except
+         *
+         * :param MaterialDiagnostic &diagnostic: The record of the failure. Cleared on entry and set if the return
+         *     value is non-zero. The perturbed degree of freedom is recorded if a perturbed evaluation failed.
+         *
+         * Returns:
+         *     0: No errors. Solution converged.
+         *     1: Convergence Error. Request timestep cutback.
+         *     2: Fatal Errors encountered. Terminate the simulation.
+         */
+
+        diagnostic.clear();
+
         // Evaluate the model at the set point
-        std::vector<double> SDVS_previous = SDVS;
+        thread_local std::vector<double> SDVS_previous;
+        SDVS_previous.assign(SDVS.begin(), SDVS.end());
+
         int errorCode = evaluate_model(time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u,
                                        previous_phi, previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF,
-                                       previous_ADD_DOF, previous_ADD_grad_DOF, PK2, SIGMA, M, ADD_TERMS, output_message
+                                       previous_ADD_DOF, previous_ADD_grad_DOF, PK2, SIGMA, M, ADD_TERMS,
+                                       diagnostic.detail
 #ifdef DEBUG_MODE
                                        ,
                                        DEBUG
@@ -115,245 +207,662 @@ namespace micromorphic_material_library {
 #endif
 
         if (errorCode > 0) {
-            return errorCode;
+            return diagnostic.fail(errorCode, nullptr);
         }
 
-        // Assemble the Jacobians w.r.t. the macro displacement gradient
-        DPK2Dgrad_u   = std::vector<std::vector<double> >(PK2.size(), std::vector<double>(9, 0));
-        DSIGMADgrad_u = std::vector<std::vector<double> >(SIGMA.size(), std::vector<double>(9, 0));
-        DMDgrad_u     = std::vector<std::vector<double> >(M.size(), std::vector<double>(9, 0));
+        diagnostic.detail.clear();
+
+        // The degrees of freedom are ordered as [ grad_u ( 9 ), phi ( 9 ), grad_phi ( 27 ) ]
+        const unsigned int ndof = 45;
+
+        double deltas[ndof];
         for (unsigned int i = 0; i < 9; i++) {
-            std::vector<std::vector<double> > deltaMatrix(3, std::vector<double>(3, 0));
-            deltaMatrix[i / 3][i % 3] = delta * fabs(current_grad_u[i / 3][i % 3]) + delta;
-
-            double current_grad_u_P[3][3] = {
-                {current_grad_u[0][0] + deltaMatrix[0][0], current_grad_u[0][1] + deltaMatrix[0][1],
-                 current_grad_u[0][2] + deltaMatrix[0][2]},
-                {current_grad_u[1][0] + deltaMatrix[1][0], current_grad_u[1][1] + deltaMatrix[1][1],
-                 current_grad_u[1][2] + deltaMatrix[1][2]},
-                {current_grad_u[2][0] + deltaMatrix[2][0], current_grad_u[2][1] + deltaMatrix[2][1],
-                 current_grad_u[2][2] + deltaMatrix[2][2]}
-            };
-
-            double current_grad_u_M[3][3] = {
-                {current_grad_u[0][0] - deltaMatrix[0][0], current_grad_u[0][1] - deltaMatrix[0][1],
-                 current_grad_u[0][2] - deltaMatrix[0][2]},
-                {current_grad_u[1][0] - deltaMatrix[1][0], current_grad_u[1][1] - deltaMatrix[1][1],
-                 current_grad_u[1][2] - deltaMatrix[1][2]},
-                {current_grad_u[2][0] - deltaMatrix[2][0], current_grad_u[2][1] - deltaMatrix[2][1],
-                 current_grad_u[2][2] - deltaMatrix[2][2]}
-            };
-
-            std::vector<double> PK2_P, SIGMA_P, M_P, PK2_M, SIGMA_M, M_M;
-
-            std::vector<double> SDVS_P, SDVS_M;
-            SDVS_P = SDVS_previous;
-            SDVS_M = SDVS_previous;
+            deltas[i]     = delta * fabs(current_grad_u[i / 3][i % 3]) + delta;
+            deltas[9 + i] = delta * fabs(current_phi[i]) + delta;
+        }
+        for (unsigned int i = 0; i < 27; i++) {
+            deltas[18 + i] = delta * fabs(current_grad_phi[i / 3][i % 3]) + delta;
+        }
+
+        zero_jacobian(DPK2Dgrad_u, PK2.size(), 9);
+        zero_jacobian(DSIGMADgrad_u, SIGMA.size(), 9);
+        zero_jacobian(DMDgrad_u, M.size(), 9);
+        zero_jacobian(DPK2Dphi, PK2.size(), 9);
+        zero_jacobian(DSIGMADphi, SIGMA.size(), 9);
+        zero_jacobian(DMDphi, M.size(), 9);
+        zero_jacobian(DPK2Dgrad_phi, PK2.size(), 27);
+        zero_jacobian(DSIGMADgrad_phi, SIGMA.size(), 27);
+        zero_jacobian(DMDgrad_phi, M.size(), 27);
+
+        // The degrees of freedom are distributed over the threads in an interleaved fashion. Each column of the
+        // Jacobians is written by only one thread so the result doesn't depend on the number of threads. There is
+        // at most one thread per degree of freedom so the per-thread records are fixed size.
+        const unsigned int nthreads = std::max(1u, std::min(num_threads, ndof));
+
+        std::array<MaterialDiagnostic, ndof>  threadDiagnostics;
+        std::array<std::exception_ptr, ndof> threadExceptions;
+
+        auto evaluate_columns = [&](const unsigned int thread) {
+            try {
+                // The perturbation buffers are reused for all of the degrees of freedom
+                double grad_u_P[3][3], phi_P[9], grad_phi_P[9][3];
+                std::copy(&current_grad_u[0][0], &current_grad_u[0][0] + 9, &grad_u_P[0][0]);
+                std::copy(current_phi, current_phi + 9, phi_P);
+                std::copy(&current_grad_phi[0][0], &current_grad_phi[0][0] + 27, &grad_phi_P[0][0]);
+
+                // The model outputs keep their capacity between calls on the same thread
+                thread_local std::vector<double>                PK2_P, SIGMA_P, M_P, PK2_M, SIGMA_M, M_M, SDVS_P;
+                thread_local std::vector<std::vector<double> > ADD_TERMS_P;
+                thread_local std::string                        message;
+
+                MaterialDiagnostic &threadDiagnostic = threadDiagnostics[thread];
 
 #ifdef DEBUG_MODE
-            std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG_P,
-                DEBUG_M;
+                std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG_P;
 #endif
 
-            errorCode =
-                evaluate_model(time, fparams, current_grad_u_P, current_phi, current_grad_phi, previous_grad_u,
-                               previous_phi, previous_grad_phi, SDVS_P, current_ADD_DOF, current_ADD_grad_DOF,
-                               previous_ADD_DOF, previous_ADD_grad_DOF, PK2_P, SIGMA_P, M_P, ADD_TERMS, output_message
+                for (unsigned int k = thread; k < ndof; k += nthreads) {
+                    double *value = (k < 9)    ? &grad_u_P[k / 3][k % 3]
+                                    : (k < 18) ? &phi_P[k - 9]
+                                               : &grad_phi_P[(k - 18) / 3][(k - 18) % 3];
+
+                    const double original = *value;
+
+                    // The positive perturbation
+                    *value = original + deltas[k];
+                    SDVS_P.assign(SDVS_previous.begin(), SDVS_previous.end());
+                    message.clear();
+
+                    int code = evaluate_model(time, fparams, grad_u_P, phi_P, grad_phi_P, previous_grad_u,
+                                              previous_phi, previous_grad_phi, SDVS_P, current_ADD_DOF,
+                                              current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF, PK2_P,
+                                              SIGMA_P, M_P, ADD_TERMS_P, message
 #ifdef DEBUG_MODE
-                               ,
-                               DEBUG_P
+                                              ,
+                                              DEBUG_P
 #endif
-                );
+                    );
+
+                    if (code > 0) {
+                        threadDiagnostic.fail(code, "Error in evaluate_model_numeric_gradients", -1, k);
+                        threadDiagnostic.detail = message;
+                        return;
+                    }
+
+                    // The negative perturbation
+                    if (scheme == CENTRAL_DIFFERENCE) {
+                        *value = original - deltas[k];
+                        SDVS_P.assign(SDVS_previous.begin(), SDVS_previous.end());
+                        message.clear();
+
+                        code = evaluate_model(time, fparams, grad_u_P, phi_P, grad_phi_P, previous_grad_u,
+                                              previous_phi, previous_grad_phi, SDVS_P, current_ADD_DOF,
+                                              current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF, PK2_M,
+                                              SIGMA_M, M_M, ADD_TERMS_P, message
+#ifdef DEBUG_MODE
+                                              ,
+                                              DEBUG_P
+#endif
+                        );
 
-            if (errorCode > 0) {
-                return errorCode;
-            }
+                        if (code > 0) {
+                            threadDiagnostic.fail(code, "Error in evaluate_model_numeric_gradients", -1, k);
+                            threadDiagnostic.detail = message;
+                            return;
+                        }
+                    }
+                    *value = original;
 
-            errorCode =
-                evaluate_model(time, fparams, current_grad_u_M, current_phi, current_grad_phi, previous_grad_u,
-                               previous_phi, previous_grad_phi, SDVS_M, current_ADD_DOF, current_ADD_grad_DOF,
-                               previous_ADD_DOF, previous_ADD_grad_DOF, PK2_M, SIGMA_M, M_M, ADD_TERMS, output_message
 #ifdef DEBUG_MODE
-                               ,
-                               DEBUG_M
+                    DEBUG_P.clear();
 #endif
-                );
 
-            if (errorCode > 0) {
-                return errorCode;
+                    const std::vector<double> &PK2_base   = (scheme == CENTRAL_DIFFERENCE) ? PK2_M : PK2;
+                    const std::vector<double> &SIGMA_base = (scheme == CENTRAL_DIFFERENCE) ? SIGMA_M : SIGMA;
+                    const std::vector<double> &M_base     = (scheme == CENTRAL_DIFFERENCE) ? M_M : M;
+                    const double               step       = (scheme == CENTRAL_DIFFERENCE) ? 2 * deltas[k] : deltas[k];
+
+                    std::vector<std::vector<double> > &DPK2DU   = (k < 9)    ? DPK2Dgrad_u
+                                                                 : (k < 18) ? DPK2Dphi
+                                                                            : DPK2Dgrad_phi;
+                    std::vector<std::vector<double> > &DSIGMADU = (k < 9)    ? DSIGMADgrad_u
+                                                                 : (k < 18) ? DSIGMADphi
+                                                                            : DSIGMADgrad_phi;
+                    std::vector<std::vector<double> > &DMDU     = (k < 9) ? DMDgrad_u : (k < 18) ? DMDphi : DMDgrad_phi;
+                    const unsigned int                 column   = (k < 9) ? k : (k < 18) ? k - 9 : k - 18;
+
+                    for (unsigned int j = 0; j < PK2.size(); j++) {
+                        DPK2DU[j][column]   = (PK2_P[j] - PK2_base[j]) / step;
+                        DSIGMADU[j][column] = (SIGMA_P[j] - SIGMA_base[j]) / step;
+                    }
+                    for (unsigned int j = 0; j < M.size(); j++) {
+                        DMDU[j][column] = (M_P[j] - M_base[j]) / step;
+                    }
+                }
+            } catch (...) {
+                threadExceptions[thread] = std::current_exception();
             }
+        };
+
+        if (nthreads == 1) {
+            evaluate_columns(0);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(nthreads - 1);
+            for (unsigned int thread = 1; thread < nthreads; thread++) {
+                workers.emplace_back(evaluate_columns, thread);
+            }
+
+            evaluate_columns(0);
 
-            for (unsigned int j = 0; j < PK2.size(); j++) {
-                DPK2Dgrad_u[j][i]   = (PK2_P[j] - PK2_M[j]) / (2 * deltaMatrix[i / 3][i % 3]);
-                DSIGMADgrad_u[j][i] = (SIGMA_P[j] - SIGMA_M[j]) / (2 * deltaMatrix[i / 3][i % 3]);
+            for (auto &worker : workers) {
+                worker.join();
             }
-            for (unsigned int j = 0; j < M.size(); j++) {
-                DMDgrad_u[j][i] = (M_P[j] - M_M[j]) / (2 * deltaMatrix[i / 3][i % 3]);
+        }
+
+        for (unsigned int thread = 0; thread < nthreads; thread++) {
+            if (threadExceptions[thread]) {
+                std::rethrow_exception(threadExceptions[thread]);
             }
         }
 
-        // Assemble the Jacobians w.r.t. the micro displacement
-        DPK2Dphi   = std::vector<std::vector<double> >(9, std::vector<double>(9, 0));
-        DSIGMADphi = std::vector<std::vector<double> >(9, std::vector<double>(9, 0));
-        DMDphi     = std::vector<std::vector<double> >(27, std::vector<double>(9, 0));
-        for (unsigned int i = 0; i < 9; i++) {
-            std::vector<double> deltaVector(9, 0);
-            deltaVector[i] = delta * fabs(current_phi[i]) + delta;
+        // Report the error from the first degree of freedom which failed
+        unsigned int failedThread = nthreads;
+        for (unsigned int thread = 0; thread < nthreads; thread++) {
+            if ((threadDiagnostics[thread].code > 0) &&
+                ((failedThread == nthreads) ||
+                 (threadDiagnostics[thread].column < threadDiagnostics[failedThread].column))) {
+                failedThread = thread;
+            }
+        }
 
-            double current_phi_P[9] = {
-                current_phi[0] + deltaVector[0], current_phi[1] + deltaVector[1], current_phi[2] + deltaVector[2],
-                current_phi[3] + deltaVector[3], current_phi[4] + deltaVector[4], current_phi[5] + deltaVector[5],
-                current_phi[6] + deltaVector[6], current_phi[7] + deltaVector[7], current_phi[8] + deltaVector[8]};
+        if (failedThread < nthreads) {
+            std::swap(diagnostic, threadDiagnostics[failedThread]);
+            return diagnostic.code;
+        }
 
-            double current_phi_M[9] = {
-                current_phi[0] - deltaVector[0], current_phi[1] - deltaVector[1], current_phi[2] - deltaVector[2],
-                current_phi[3] - deltaVector[3], current_phi[4] - deltaVector[4], current_phi[5] - deltaVector[5],
-                current_phi[6] - deltaVector[6], current_phi[7] - deltaVector[7], current_phi[8] - deltaVector[8]};
+        return 0;
+    }
 
-            std::vector<double> PK2_P, SIGMA_P, M_P, PK2_M, SIGMA_M, M_M;
+    int IMaterial::evaluate_model_flat(
+        const std::vector<double> &time, const std::vector<double>(&fparams), const double (&current_grad_u)[3][3],
+        const double (&current_phi)[9], const double (&current_grad_phi)[9][3], const double (&previous_grad_u)[3][3],
+        const double (&previous_phi)[9], const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS,
+        const std::vector<double> &current_ADD_DOF, const std::vector<std::vector<double> > &current_ADD_grad_DOF,
+        const std::vector<double> &previous_ADD_DOF, const std::vector<std::vector<double> > &previous_ADD_grad_DOF,
+        double (&PK2)[9], double (&SIGMA)[9], double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9],
+        double (&DPK2Dgrad_phi)[9][27], double (&DSIGMADgrad_u)[9][9], double (&DSIGMADphi)[9][9],
+        double (&DSIGMADgrad_phi)[9][27], double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9],
+        double (&DMDgrad_phi)[27][27], std::vector<std::vector<double> > &ADD_TERMS,
+        std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS, std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Evaluate the material model and its jacobian writing the results into caller-owned,
+         * fixed size, row-major buffers.
+         *
+         * The default implementation calls the nested vector version of evaluate_model using
+         * per-thread scratch storage, so after the first call on a thread no further allocations
+         * are required for models which assign into their outputs. Models can override this
+         * method to write directly into the buffers, the element kernels and the batched
+         * interfaces call the override through evaluate_material_flat.
+         *
+         * The inputs are the same as for evaluate_model. The outputs are
+         *
+         * :param double ( &PK2 )[ 9 ]: The second Piola Kirchhoff stress
+         * :param double ( &SIGMA )[ 9 ]: The reference symmetric micro stress
+         * :param double ( &M )[ 27 ]: The reference higher order stress
+         * :param double ( &DPK2Dgrad_u )[ 9 ][ 9 ]: The Jacobian of the PK2 stress w.r.t. the gradient of macro
+         *     displacement.
+         * :param double ( &DPK2Dphi )[ 9 ][ 9 ]: The Jacobian of the PK2 stress w.r.t. the micro displacement.
+         * :param double ( &DPK2Dgrad_phi )[ 9 ][ 27 ]: The Jacobian of the PK2 stress w.r.t. the gradient of the
+         *     micro displacement.
+         * :param double ( &DSIGMADgrad_u )[ 9 ][ 9 ]: The Jacobian of the reference symmetric micro stress w.r.t.
+         *     the gradient of the macro displacement.
+         * :param double ( &DSIGMADphi )[ 9 ][ 9 ]: The Jacobian of the reference symmetric micro stress w.r.t. the
+         *     micro displacement.
+         * :param double ( &DSIGMADgrad_phi )[ 9 ][ 27 ]: The Jacobian of the reference symmetric micro stress w.r.t.
+         *     the gradient of the micro displacement.
+         * :param double ( &DMDgrad_u )[ 27 ][ 9 ]: The Jacobian of the reference higher order stress w.r.t. the
+         *     gradient of the macro displacement.
+         * :param double ( &DMDphi )[ 27 ][ 9 ]: The Jacobian of the reference higher order stress w.r.t. the micro
+         *     displacement.
+         * :param double ( &DMDgrad_phi )[ 27 ][ 27 ]: The Jacobian of the reference higher order stress w.r.t. the
+         *     gradient of the micro displacement.
+         * :param std::vector< std::vector< double > > &ADD_TERMS: Additional terms
+         * :param std::vector< std::vector< std::vector< double > > > &ADD_JACOBIANS: The jacobians of the additional
+         *     terms w.r.t. the deformation
+         * :param std::string &output_message: The output message string.
+         *
+         * Returns:
+         *     0: No errors. Solution converged.
+         *     1: Convergence Error. Request timestep cutback.
+         *     2: Fatal Errors encountered. Terminate the simulation.
+         */
 
-            std::vector<double> SDVS_P, SDVS_M;
-            SDVS_P = SDVS_previous;
-            SDVS_M = SDVS_previous;
+        return evaluate_material_flat_nested<IMaterial>(
+            *this, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+            previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+            PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+            DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+            ,
+            DEBUG
+#endif
+        );
+    }
 
+    int evaluate_material_flat(
+        IMaterial &material, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[9],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[9][9], double (&DSIGMADphi)[9][9], double (&DSIGMADgrad_phi)[9][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
 #ifdef DEBUG_MODE
-            std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG_P,
-                DEBUG_M;
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
 #endif
+    ) {
+        /*!
+         * Evaluate a material which is only known at run time through IMaterial::evaluate_model_flat so that models
+         * which override it are respected. Templated callers use this overload when they are instantiated with
+         * IMaterial and the template of the same name when they are instantiated with a concrete model.
+         *
+         * The arguments are the same as for IMaterial::evaluate_model_flat.
+         *
+         * :param IMaterial &material: The material model to evaluate
+         */
 
-            errorCode =
-                evaluate_model(time, fparams, current_grad_u, current_phi_P, current_grad_phi, previous_grad_u,
-                               previous_phi, previous_grad_phi, SDVS_P, current_ADD_DOF, current_ADD_grad_DOF,
-                               previous_ADD_DOF, previous_ADD_grad_DOF, PK2_P, SIGMA_P, M_P, ADD_TERMS, output_message
+        return material.evaluate_model_flat(time, fparams, current_grad_u, current_phi, current_grad_phi,
+                                            previous_grad_u, previous_phi, previous_grad_phi, SDVS, current_ADD_DOF,
+                                            current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF, PK2, SIGMA,
+                                            M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi,
+                                            DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS,
+                                            output_message
 #ifdef DEBUG_MODE
-                               ,
-                               DEBUG_P
+                                            ,
+                                            DEBUG
 #endif
-                );
+        );
+    }
 
-            if (errorCode > 0) {
-                return errorCode;
+    int IMaterial::evaluate_model_flat_symmetric(
+        const std::vector<double> &time, const std::vector<double>(&fparams), const double (&current_grad_u)[3][3],
+        const double (&current_phi)[9], const double (&current_grad_phi)[9][3], const double (&previous_grad_u)[3][3],
+        const double (&previous_phi)[9], const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS,
+        const std::vector<double> &current_ADD_DOF, const std::vector<std::vector<double> > &current_ADD_grad_DOF,
+        const std::vector<double> &previous_ADD_DOF, const std::vector<std::vector<double> > &previous_ADD_grad_DOF,
+        double (&PK2)[9], double (&SIGMA)[6], double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9],
+        double (&DPK2Dgrad_phi)[9][27], double (&DSIGMADgrad_u)[6][9], double (&DSIGMADphi)[6][9],
+        double (&DSIGMADgrad_phi)[6][27], double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9],
+        double (&DMDgrad_phi)[27][27], std::vector<std::vector<double> > &ADD_TERMS,
+        std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS, std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Evaluate the material model and its jacobian writing the results into caller-owned, fixed size, row-major
+         * buffers with the symmetric micro stress and its jacobians in the Voigt form
+         * [ SIGMA_{ 11 }, SIGMA_{ 22 }, SIGMA_{ 33 }, SIGMA_{ 23 }, SIGMA_{ 13 }, SIGMA_{ 12 } ].
+         *
+         * The default implementation calls evaluate_model_flat and averages the IJ and JI
+         * components of SIGMA and the rows of its jacobians. Models which form SIGMA in Voigt form can override this
+         * method to skip the redundant components entirely.
+         *
+         * The arguments are the same as for evaluate_model_flat except
+         *
+         * :param double ( &SIGMA )[ 6 ]: The reference symmetric micro stress in Voigt form
+         * :param double ( &DSIGMADgrad_u )[ 6 ][ 9 ]: The Jacobian of the Voigt reference symmetric micro stress
+         *     w.r.t. the gradient of the macro displacement.
+         * :param double ( &DSIGMADphi )[ 6 ][ 9 ]: The Jacobian of the Voigt reference symmetric micro stress w.r.t.
+         *     the micro displacement.
+         * :param double ( &DSIGMADgrad_phi )[ 6 ][ 27 ]: The Jacobian of the Voigt reference symmetric micro stress
+         *     w.r.t. the gradient of the micro displacement.
+         */
+
+        return evaluate_material_flat_symmetric_from_flat<IMaterial>(
+            *this, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+            previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+            PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+            DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+            ,
+            DEBUG
+#endif
+        );
+    }
+
+    int evaluate_material_flat_symmetric(
+        IMaterial &material, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[6],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[6][9], double (&DSIGMADphi)[6][9], double (&DSIGMADgrad_phi)[6][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Evaluate a material which is only known at run time through IMaterial::evaluate_model_flat_symmetric so
+         * that models which override it are respected.
+         *
+         * The arguments are the same as for IMaterial::evaluate_model_flat_symmetric.
+         *
+         * :param IMaterial &material: The material model to evaluate
+         */
+
+        return material.evaluate_model_flat_symmetric(
+            time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+            previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+            PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+            DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+            ,
+            DEBUG
+#endif
+        );
+    }
+
+    int IMaterial::evaluate_model_batch(
+        const unsigned int npoints, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double *current_grad_u, const double *current_phi, const double *current_grad_phi,
+        const double *previous_grad_u, const double *previous_phi, const double *previous_grad_phi,
+        std::vector<double> &SDVS, double *PK2, double *SIGMA, double *M, std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Evaluate the material model at npoints points which share the same time and parameters.
+         *
+         * All of the point-wise quantities are stored in structure of arrays form i.e. the value of
+         * component i at point p is located at [ i * npoints + p ]. The components of each quantity
+         * are ordered in the same way as in evaluate_model ( grad_u and grad_phi are row-major ).
+         *
+         * The state variables are updated in place using the pointer form of evaluate_model_batch.
+         * Additional degrees of freedom are not supported by the batched interface.
+         *
+         * :param const unsigned int npoints: The number of points to evaluate
+         * :param const std::vector< double > &time: The current time and the timestep
+         *     [ current_t, dt ]
+         * :param const std::vector< double > ( &fparams ): The parameters for the constitutive model
+         * :param const double *current_grad_u: The current displacement gradients ( 9 x npoints )
+         * :param const double *current_phi: The current micro displacements ( 9 x npoints )
+         * :param const double *current_grad_phi: The current micro displacement gradients ( 27 x npoints )
+         * :param const double *previous_grad_u: The previous displacement gradients ( 9 x npoints )
+         * :param const double *previous_phi: The previous micro displacements ( 9 x npoints )
+         * :param const double *previous_grad_phi: The previous micro displacement gradients ( 27 x npoints )
+         * :param std::vector< double > &SDVS: The previously converged values of the state variables
+         *     ( nsdvs x npoints ). Updated in place.
+         * :param double *PK2: The second Piola Kirchhoff stresses ( 9 x npoints )
+         * :param double *SIGMA: The reference symmetric micro stresses ( 9 x npoints )
+         * :param double *M: The reference higher order stresses ( 27 x npoints )
+         * :param std::string &output_message: The output message string.
+         *
+         * Returns:
+         *     0: No errors. Solution converged.
+         *     1: Convergence Error. Request timestep cutback.
+         *     2: Fatal Errors encountered. Terminate the simulation.
+         */
+
+        if (npoints == 0) {
+            return 0;
+        }
+
+        if ((SDVS.size() % npoints) != 0) {
+            output_message = "Error: the size of SDVS is not a multiple of the number of points";
+            return 2;
+        }
+
+        return evaluate_model_batch(npoints, time, fparams, current_grad_u, current_phi, current_grad_phi,
+                                    previous_grad_u, previous_phi, previous_grad_phi, SDVS.size() / npoints,
+                                    SDVS.data(), SDVS.data(), PK2, SIGMA, M, output_message
+#ifdef DEBUG_MODE
+                                    ,
+                                    DEBUG
+#endif
+        );
+    }
+
+    int IMaterial::evaluate_model_batch(
+        const unsigned int npoints, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double *current_grad_u, const double *current_phi, const double *current_grad_phi,
+        const double *previous_grad_u, const double *previous_phi, const double *previous_grad_phi,
+        const unsigned int nsdvs, const double *previous_SDVS, double *SDVS, double *PK2, double *SIGMA, double *M,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Evaluate the material model at npoints points which share the same time and parameters reading the
+         * state variables from one array and writing the updated values to another. This allows the committed
+         * and trial buffers of a StateVariableStore block to be used without copying them.
+         *
+         * The layout of the point-wise quantities is the same as the std::vector form of evaluate_model_batch.
+         * previous_SDVS and SDVS may be the same array.
+         *
+         * The default implementation loops over the points and calls evaluate_model. Models which
+         * can vectorize across points should override it. Additional degrees of freedom are not
+         * supported by the batched interface.
+         *
+         * :param const unsigned int npoints: The number of points to evaluate
+         * :param const std::vector< double > &time: The current time and the timestep
+         *     [ current_t, dt ]
+         * :param const std::vector< double > ( &fparams ): The parameters for the constitutive model
+         * :param const double *current_grad_u: The current displacement gradients ( 9 x npoints )
+         * :param const double *current_phi: The current micro displacements ( 9 x npoints )
+         * :param const double *current_grad_phi: The current micro displacement gradients ( 27 x npoints )
+         * :param const double *previous_grad_u: The previous displacement gradients ( 9 x npoints )
+         * :param const double *previous_phi: The previous micro displacements ( 9 x npoints )
+         * :param const double *previous_grad_phi: The previous micro displacement gradients ( 27 x npoints )
+         * :param const unsigned int nsdvs: The number of state variables at each point
+         * :param const double *previous_SDVS: The previously converged values of the state variables
+         *     ( nsdvs x npoints )
+         * :param double *SDVS: The updated values of the state variables ( nsdvs x npoints )
+         * :param double *PK2: The second Piola Kirchhoff stresses ( 9 x npoints )
+         * :param double *SIGMA: The reference symmetric micro stresses ( 9 x npoints )
+         * :param double *M: The reference higher order stresses ( 27 x npoints )
+         * :param std::string &output_message: The output message string.
+         *
+         * Returns:
+         *     0: No errors. Solution converged.
+         *     1: Convergence Error. Request timestep cutback.
+         *     2: Fatal Errors encountered. Terminate the simulation.
+         */
+
+        if (npoints == 0) {
+            return 0;
+        }
+
+        double current_grad_u_p[3][3], current_phi_p[9], current_grad_phi_p[9][3];
+        double previous_grad_u_p[3][3], previous_phi_p[9], previous_grad_phi_p[9][3];
+
+        const std::vector<double>               ADD_DOF;
+        const std::vector<std::vector<double> > ADD_grad_DOF;
+
+        // The point outputs keep their capacity between calls on the same thread
+        thread_local std::vector<double>                SDVS_p, PK2_p, SIGMA_p, M_p;
+        thread_local std::vector<std::vector<double> > ADD_TERMS;
+        thread_local MaterialDiagnostic                 diagnostic;
+
+        for (unsigned int p = 0; p < npoints; p++) {
+            // Gather the point values
+            for (unsigned int i = 0; i < 9; i++) {
+                current_grad_u_p[i / 3][i % 3]  = current_grad_u[i * npoints + p];
+                current_phi_p[i]                = current_phi[i * npoints + p];
+                previous_grad_u_p[i / 3][i % 3] = previous_grad_u[i * npoints + p];
+                previous_phi_p[i]               = previous_phi[i * npoints + p];
+            }
+
+            for (unsigned int i = 0; i < 27; i++) {
+                current_grad_phi_p[i / 3][i % 3]  = current_grad_phi[i * npoints + p];
+                previous_grad_phi_p[i / 3][i % 3] = previous_grad_phi[i * npoints + p];
+            }
+
+            SDVS_p.resize(nsdvs);
+            for (unsigned int i = 0; i < nsdvs; i++) {
+                SDVS_p[i] = previous_SDVS[i * npoints + p];
             }
 
-            errorCode =
-                evaluate_model(time, fparams, current_grad_u, current_phi_M, current_grad_phi, previous_grad_u,
-                               previous_phi, previous_grad_phi, SDVS_M, current_ADD_DOF, current_ADD_grad_DOF,
-                               previous_ADD_DOF, previous_ADD_grad_DOF, PK2_M, SIGMA_M, M_M, ADD_TERMS, output_message
+            diagnostic.clear();
+
+            int errorCode = evaluate_model(time, fparams, current_grad_u_p, current_phi_p, current_grad_phi_p,
+                                           previous_grad_u_p, previous_phi_p, previous_grad_phi_p, SDVS_p, ADD_DOF,
+                                           ADD_grad_DOF, ADD_DOF, ADD_grad_DOF, PK2_p, SIGMA_p, M_p, ADD_TERMS,
+                                           diagnostic.detail
 #ifdef DEBUG_MODE
-                               ,
-                               DEBUG_M
+                                           ,
+                                           DEBUG
 #endif
-                );
+            );
 
             if (errorCode > 0) {
+                diagnostic.fail(errorCode, "Error in evaluate_model_batch", p);
+                output_message = diagnostic.message();
                 return errorCode;
             }
 
-            for (unsigned int j = 0; j < PK2.size(); j++) {
-                DPK2Dphi[j][i]   = (PK2_P[j] - PK2_M[j]) / (2 * deltaVector[i]);
-                DSIGMADphi[j][i] = (SIGMA_P[j] - SIGMA_M[j]) / (2 * deltaVector[i]);
+            if ((PK2_p.size() != 9) || (SIGMA_p.size() != 9) || (M_p.size() != 27) || (SDVS_p.size() != nsdvs)) {
+                diagnostic.detail.clear();
+                diagnostic.fail(2, "Error: evaluate_model returned outputs of unexpected size", p);
+                output_message = diagnostic.message();
+                return 2;
             }
-            for (unsigned int j = 0; j < M.size(); j++) {
-                DMDphi[j][i] = (M_P[j] - M_M[j]) / (2 * deltaVector[i]);
+
+            // Scatter the point values
+            for (unsigned int i = 0; i < 9; i++) {
+                PK2[i * npoints + p]   = PK2_p[i];
+                SIGMA[i * npoints + p] = SIGMA_p[i];
             }
-        }
 
-        // Assemble the Jacobians w.r.t. the gradient of the micro displacement
-        DPK2Dgrad_phi   = std::vector<std::vector<double> >(PK2.size(), std::vector<double>(27, 0));
-        DSIGMADgrad_phi = std::vector<std::vector<double> >(SIGMA.size(), std::vector<double>(27, 0));
-        DMDgrad_phi     = std::vector<std::vector<double> >(M.size(), std::vector<double>(27, 0));
+            for (unsigned int i = 0; i < 27; i++) {
+                M[i * npoints + p] = M_p[i];
+            }
 
-        for (unsigned int i = 0; i < 27; i++) {
-            std::vector<std::vector<double> > deltaMatrix(9, std::vector<double>(3, 0));
-            deltaMatrix[i / 3][i % 3] = delta * fabs(current_grad_phi[i / 3][i % 3]) + delta;
-
-            double current_grad_phi_P[9][3] = {
-                {current_grad_phi[0][0] + deltaMatrix[0][0], current_grad_phi[0][1] + deltaMatrix[0][1],
-                 current_grad_phi[0][2] + deltaMatrix[0][2]},
-                {current_grad_phi[1][0] + deltaMatrix[1][0], current_grad_phi[1][1] + deltaMatrix[1][1],
-                 current_grad_phi[1][2] + deltaMatrix[1][2]},
-                {current_grad_phi[2][0] + deltaMatrix[2][0], current_grad_phi[2][1] + deltaMatrix[2][1],
-                 current_grad_phi[2][2] + deltaMatrix[2][2]},
-                {current_grad_phi[3][0] + deltaMatrix[3][0], current_grad_phi[3][1] + deltaMatrix[3][1],
-                 current_grad_phi[3][2] + deltaMatrix[3][2]},
-                {current_grad_phi[4][0] + deltaMatrix[4][0], current_grad_phi[4][1] + deltaMatrix[4][1],
-                 current_grad_phi[4][2] + deltaMatrix[4][2]},
-                {current_grad_phi[5][0] + deltaMatrix[5][0], current_grad_phi[5][1] + deltaMatrix[5][1],
-                 current_grad_phi[5][2] + deltaMatrix[5][2]},
-                {current_grad_phi[6][0] + deltaMatrix[6][0], current_grad_phi[6][1] + deltaMatrix[6][1],
-                 current_grad_phi[6][2] + deltaMatrix[6][2]},
-                {current_grad_phi[7][0] + deltaMatrix[7][0], current_grad_phi[7][1] + deltaMatrix[7][1],
-                 current_grad_phi[7][2] + deltaMatrix[7][2]},
-                {current_grad_phi[8][0] + deltaMatrix[8][0], current_grad_phi[8][1] + deltaMatrix[8][1],
-                 current_grad_phi[8][2] + deltaMatrix[8][2]}
-            };
-
-            double current_grad_phi_M[9][3] = {
-                {current_grad_phi[0][0] - deltaMatrix[0][0], current_grad_phi[0][1] - deltaMatrix[0][1],
-                 current_grad_phi[0][2] - deltaMatrix[0][2]},
-                {current_grad_phi[1][0] - deltaMatrix[1][0], current_grad_phi[1][1] - deltaMatrix[1][1],
-                 current_grad_phi[1][2] - deltaMatrix[1][2]},
-                {current_grad_phi[2][0] - deltaMatrix[2][0], current_grad_phi[2][1] - deltaMatrix[2][1],
-                 current_grad_phi[2][2] - deltaMatrix[2][2]},
-                {current_grad_phi[3][0] - deltaMatrix[3][0], current_grad_phi[3][1] - deltaMatrix[3][1],
-                 current_grad_phi[3][2] - deltaMatrix[3][2]},
-                {current_grad_phi[4][0] - deltaMatrix[4][0], current_grad_phi[4][1] - deltaMatrix[4][1],
-                 current_grad_phi[4][2] - deltaMatrix[4][2]},
-                {current_grad_phi[5][0] - deltaMatrix[5][0], current_grad_phi[5][1] - deltaMatrix[5][1],
-                 current_grad_phi[5][2] - deltaMatrix[5][2]},
-                {current_grad_phi[6][0] - deltaMatrix[6][0], current_grad_phi[6][1] - deltaMatrix[6][1],
-                 current_grad_phi[6][2] - deltaMatrix[6][2]},
-                {current_grad_phi[7][0] - deltaMatrix[7][0], current_grad_phi[7][1] - deltaMatrix[7][1],
-                 current_grad_phi[7][2] - deltaMatrix[7][2]},
-                {current_grad_phi[8][0] - deltaMatrix[8][0], current_grad_phi[8][1] - deltaMatrix[8][1],
-                 current_grad_phi[8][2] - deltaMatrix[8][2]}
-            };
-
-            std::vector<double> PK2_P, SIGMA_P, M_P, PK2_M, SIGMA_M, M_M;
-
-            std::vector<double> SDVS_P, SDVS_M;
-            SDVS_P = SDVS_previous;
-            SDVS_M = SDVS_previous;
+            for (unsigned int i = 0; i < nsdvs; i++) {
+                SDVS[i * npoints + p] = SDVS_p[i];
+            }
+        }
 
-#ifdef DEBUG_MODE
-            std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG_P,
-                DEBUG_M;
-#endif
+        return 0;
+    }
 
-            errorCode =
-                evaluate_model(time, fparams, current_grad_u, current_phi, current_grad_phi_P, previous_grad_u,
-                               previous_phi, previous_grad_phi, SDVS_P, current_ADD_DOF, current_ADD_grad_DOF,
-                               previous_ADD_DOF, previous_ADD_grad_DOF, PK2_P, SIGMA_P, M_P, ADD_TERMS, output_message
+    int evaluate_material_store(IMaterial &material, const std::vector<double> &time,
+                                const std::vector<double>(&fparams), const double *current_grad_u,
+                                const double *current_phi, const double *current_grad_phi,
+                                const double *previous_grad_u, const double *previous_phi,
+                                const double *previous_grad_phi, StateVariableStore &store, double *PK2,
+                                double *SIGMA, double *M, std::string &output_message
 #ifdef DEBUG_MODE
-                               ,
-                               DEBUG_P
+                                ,
+                                std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
 #endif
-                );
+    ) {
+        /*!
+         * Evaluate the material model at every point of a state variable store. The state variables are read
+         * from the committed blocks and the updated values are written directly to the trial blocks so no state
+         * variables are copied. Call commit on the store once the increment has converged and discard if it is
+         * rejected or an error is returned.
+         *
+         * The point-wise quantities are in the structure of arrays form of IMaterial::evaluate_model_batch with
+         * store.num_points( ) points numbered element * num_gauss_points + gauss_point.
+         *
+         * :param IMaterial &material: The material model
+         * :param const std::vector< double > &time: The current time and the timestep
+         *     [ current_t, dt ]
+         * :param const std::vector< double > ( &fparams ): The parameters for the constitutive model
+         * :param const double *current_grad_u: The current displacement gradients ( 9 x num_points )
+         * :param const double *current_phi: The current micro displacements ( 9 x num_points )
+         * :param const double *current_grad_phi: The current micro displacement gradients ( 27 x num_points )
+         * :param const double *previous_grad_u: The previous displacement gradients ( 9 x num_points )
+         * :param const double *previous_phi: The previous micro displacements ( 9 x num_points )
+         * :param const double *previous_grad_phi: The previous micro displacement gradients ( 27 x num_points )
+         * :param StateVariableStore &store: The state variables of the points
+         * :param double *PK2: The second Piola Kirchhoff stresses ( 9 x num_points )
+         * :param double *SIGMA: The reference symmetric micro stresses ( 9 x num_points )
+         * :param double *M: The reference higher order stresses ( 27 x num_points )
+         * :param std::string &output_message: The output message string.
+         *
+         * Returns:
+         *     0: No errors. Solution converged.
+         *     1: Convergence Error. Request timestep cutback.
+         *     2: Fatal Errors encountered. Terminate the simulation.
+         */
 
-            if (errorCode > 0) {
-                return errorCode;
+        const unsigned int npoints = store.num_points();
+
+        // The deformation and stresses of a block in the layout of the block
+        thread_local std::vector<double> inputs, outputs;
+        inputs.resize(90 * store.block_size());
+        outputs.resize(45 * store.block_size());
+
+        for (unsigned int b = 0; b < store.num_blocks(); b++) {
+            const unsigned int first  = b * store.block_size();
+            const unsigned int points = store.block_points(b);
+
+            // Gather the deformation of the block
+            const double      *sources[6] = {current_grad_u,  current_phi,  current_grad_phi,
+                                             previous_grad_u, previous_phi, previous_grad_phi};
+            const unsigned int sizes[6]   = {9, 9, 27, 9, 9, 27};
+            double            *block_inputs[6];
+
+            double *position = inputs.data();
+            for (unsigned int q = 0; q < 6; q++) {
+                block_inputs[q] = position;
+                for (unsigned int i = 0; i < sizes[q]; i++) {
+                    std::copy(sources[q] + i * npoints + first, sources[q] + i * npoints + first + points,
+                              position + i * points);
+                }
+                position += sizes[q] * points;
             }
 
-            errorCode =
-                evaluate_model(time, fparams, current_grad_u, current_phi, current_grad_phi_M, previous_grad_u,
-                               previous_phi, previous_grad_phi, SDVS_M, current_ADD_DOF, current_ADD_grad_DOF,
-                               previous_ADD_DOF, previous_ADD_grad_DOF, PK2_M, SIGMA_M, M_M, ADD_TERMS, output_message
+            double *block_PK2   = outputs.data();
+            double *block_SIGMA = block_PK2 + 9 * points;
+            double *block_M     = block_SIGMA + 9 * points;
+
+            int errorCode = material.evaluate_model_batch(
+                points, time, fparams, block_inputs[0], block_inputs[1], block_inputs[2], block_inputs[3],
+                block_inputs[4], block_inputs[5], store.num_sdvs(), store.committed_block(b), store.trial_block(b),
+                block_PK2, block_SIGMA, block_M, output_message
 #ifdef DEBUG_MODE
-                               ,
-                               DEBUG_P
+                ,
+                DEBUG
 #endif
-                );
+            );
 
             if (errorCode > 0) {
                 return errorCode;
             }
 
-            for (unsigned int j = 0; j < PK2.size(); j++) {
-                DPK2Dgrad_phi[j][i]   = (PK2_P[j] - PK2_M[j]) / (2 * deltaMatrix[i / 3][i % 3]);
-                DSIGMADgrad_phi[j][i] = (SIGMA_P[j] - SIGMA_M[j]) / (2 * deltaMatrix[i / 3][i % 3]);
+            // Scatter the stresses of the block
+            for (unsigned int i = 0; i < 9; i++) {
+                std::copy(block_PK2 + i * points, block_PK2 + (i + 1) * points, PK2 + i * npoints + first);
+                std::copy(block_SIGMA + i * points, block_SIGMA + (i + 1) * points, SIGMA + i * npoints + first);
             }
-            for (unsigned int j = 0; j < M.size(); j++) {
-                DMDgrad_phi[j][i] = (M_P[j] - M_M[j]) / (2 * deltaMatrix[i / 3][i % 3]);
+
+            for (unsigned int i = 0; i < 27; i++) {
+                std::copy(block_M + i * points, block_M + (i + 1) * points, M + i * npoints + first);
             }
         }
 
@@ -383,6 +892,43 @@ namespace micromorphic_material_library {
         return NULL;
     }
 
+    std::shared_ptr<IMaterial> MaterialFactory::GetSharedMaterial(const std::string &name) {
+        /*!
+         * Get a persistent instance of the material model. The instance is constructed
+         * the first time the name is requested and the same instance is returned on every
+         * subsequent call so that the map lookup and allocation can be hoisted out of
+         * the quadrature point loop.
+         *
+         * The material models are required to be stateless ( all history is carried in SDVS )
+         * so the returned instance may be evaluated concurrently.
+         *
+         * Each thread remembers the last instance it was handed. Repeated requests for the same
+         * name, e.g. once per evaluation from the python interface, are served from that copy
+         * without taking the lock or searching the map. The instances are never removed so the
+         * remembered copy stays valid.
+         *
+         * :param const std::string &name: The name of the material model
+         */
+
+        static thread_local std::string                last_name;
+        static thread_local std::shared_ptr<IMaterial> last_material;
+
+        if (last_material && (last_name == name)) {
+            return last_material;
+        }
+
+        std::lock_guard<std::mutex> lock(shared_materials_mutex_);
+
+        auto cached = shared_materials_.find(name);
+        if (cached == shared_materials_.end()) {
+            cached = shared_materials_.emplace(name, std::shared_ptr<IMaterial>(GetMaterial(name))).first;
+        }
+
+        last_name     = name;
+        last_material = cached->second;
+        return last_material;
+    }
+
     void MaterialFactory::PrintMaterials() {
         /*! Prints all of the materials registered in the library*/
         std::string message = "Materials available in the library:\n";
@@ -23,14 +23,98 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "state_variable_store.h"
+
 namespace micromorphic_material_library {
 
+    /* Finite difference schemes for the numeric material Jacobians */
+    enum NumericGradientScheme { CENTRAL_DIFFERENCE, FORWARD_DIFFERENCE };
+
+    /*
+     * A fixed size record of a failed material evaluation.
+     *
+     * The error code and the location of the failure are stored as plain values and the reason as a pointer to a
+     * string literal so that recording or clearing a failure never allocates. The message of the model is only
+     * moved into detail when the evaluation fails and the human readable message is only built when a caller asks
+     * for it. A record which is re-used by the caller therefore keeps the success path free of heap allocations.
+     */
+    struct MaterialDiagnostic {
+        int         code   = 0;        //!< The error code ( 0: success, 1: request cutback, 2: fatal )
+        const char *reason = nullptr;  //!< A string literal describing where the evaluation failed
+        int         point  = -1;       //!< The point of a batch which failed or -1
+        int         column = -1;       //!< The perturbed degree of freedom of a numeric gradient which failed or -1
+        std::string detail;            //!< The output message of the material model. Only set on failure.
+
+        void clear() {
+            /*!
+             * Reset the record to success. The capacity of detail is retained.
+             */
+
+            code   = 0;
+            reason = nullptr;
+            point  = -1;
+            column = -1;
+            detail.clear();
+        }
+
+        int fail(const int _code, const char *_reason, const int _point = -1, const int _column = -1) {
+            /*!
+             * Record a failure and return its error code
+             *
+             * :param const int _code: The error code
+             * :param const char *_reason: A string literal describing where the evaluation failed
+             * :param const int _point: The point of a batch which failed
+             * :param const int _column: The perturbed degree of freedom which failed
+             */
+
+            code   = _code;
+            reason = _reason;
+            point  = _point;
+            column = _column;
+            return code;
+        }
+
+        std::string message() const {
+            /*!
+             * Build the human readable message of the failure. Returns an empty string on success.
+             */
+
+            if (code <= 0) {
+                return "";
+            }
+
+            std::string result = reason ? reason : "";
+
+            if (point >= 0) {
+                result += " at point " + std::to_string(point);
+            }
+
+            if (column >= 0) {
+                result += " perturbing degree of freedom " + std::to_string(column);
+            }
+
+            if (!detail.empty()) {
+                result += (result.empty() ? "" : "\n") + detail;
+            }
+
+            if (result.empty()) {
+                result = "Error: evaluate_model failed with error code " + std::to_string(code);
+            }
+
+            return result;
+        }
+    };
+
     /* Base class for materials */
     class IMaterial {
        public:
@@ -189,7 +273,87 @@ namespace micromorphic_material_library {
 #ifdef DEBUG_MODE
             std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &debug,
 #endif
-            double delta = 1e-6);
+            double delta = 1e-6, const NumericGradientScheme scheme = CENTRAL_DIFFERENCE,
+            const unsigned int num_threads = 1);
+
+        int evaluate_model_numeric_gradients(
+            const std::vector<double> &time, const std::vector<double>(&fparams), const double (&current_grad_u)[3][3],
+            const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+            const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+            const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS,
+            const std::vector<double> &current_ADD_DOF, const std::vector<std::vector<double> > &current_ADD_grad_DOF,
+            const std::vector<double> &previous_ADD_DOF, const std::vector<std::vector<double> > &previous_ADD_grad_DOF,
+            std::vector<double> &PK2, std::vector<double> &SIGMA, std::vector<double> &M,
+            std::vector<std::vector<double> > &DPK2Dgrad_u, std::vector<std::vector<double> > &DPK2Dphi,
+            std::vector<std::vector<double> > &DPK2Dgrad_phi, std::vector<std::vector<double> > &DSIGMADgrad_u,
+            std::vector<std::vector<double> > &DSIGMADphi, std::vector<std::vector<double> > &DSIGMADgrad_phi,
+            std::vector<std::vector<double> > &DMDgrad_u, std::vector<std::vector<double> > &DMDphi,
+            std::vector<std::vector<double> > &DMDgrad_phi, std::vector<std::vector<double> > &ADD_TERMS,
+            std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS, MaterialDiagnostic &diagnostic,
+#ifdef DEBUG_MODE
+            std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &debug,
+#endif
+            double delta = 1e-6, const NumericGradientScheme scheme = CENTRAL_DIFFERENCE,
+            const unsigned int num_threads = 1);
+
+        virtual int evaluate_model_flat(
+            const std::vector<double> &time, const std::vector<double>(&fparams), const double (&current_grad_u)[3][3],
+            const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+            const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+            const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS,
+            const std::vector<double> &current_ADD_DOF, const std::vector<std::vector<double> > &current_ADD_grad_DOF,
+            const std::vector<double> &previous_ADD_DOF, const std::vector<std::vector<double> > &previous_ADD_grad_DOF,
+            double (&PK2)[9], double (&SIGMA)[9], double (&M)[27], double (&DPK2Dgrad_u)[9][9],
+            double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27], double (&DSIGMADgrad_u)[9][9],
+            double (&DSIGMADphi)[9][9], double (&DSIGMADgrad_phi)[9][27], double (&DMDgrad_u)[27][9],
+            double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27], std::vector<std::vector<double> > &ADD_TERMS,
+            std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS, std::string &output_message
+#ifdef DEBUG_MODE
+            ,
+            std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &debug
+#endif
+        );
+
+        virtual int evaluate_model_flat_symmetric(
+            const std::vector<double> &time, const std::vector<double>(&fparams), const double (&current_grad_u)[3][3],
+            const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+            const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+            const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS,
+            const std::vector<double> &current_ADD_DOF, const std::vector<std::vector<double> > &current_ADD_grad_DOF,
+            const std::vector<double> &previous_ADD_DOF, const std::vector<std::vector<double> > &previous_ADD_grad_DOF,
+            double (&PK2)[9], double (&SIGMA)[6], double (&M)[27], double (&DPK2Dgrad_u)[9][9],
+            double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27], double (&DSIGMADgrad_u)[6][9],
+            double (&DSIGMADphi)[6][9], double (&DSIGMADgrad_phi)[6][27], double (&DMDgrad_u)[27][9],
+            double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27], std::vector<std::vector<double> > &ADD_TERMS,
+            std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS, std::string &output_message
+#ifdef DEBUG_MODE
+            ,
+            std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &debug
+#endif
+        );
+
+        virtual int evaluate_model_batch(
+            const unsigned int npoints, const std::vector<double> &time, const std::vector<double>(&fparams),
+            const double *current_grad_u, const double *current_phi, const double *current_grad_phi,
+            const double *previous_grad_u, const double *previous_phi, const double *previous_grad_phi,
+            std::vector<double> &SDVS, double *PK2, double *SIGMA, double *M, std::string &output_message
+#ifdef DEBUG_MODE
+            ,
+            std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &debug
+#endif
+        );
+
+        virtual int evaluate_model_batch(
+            const unsigned int npoints, const std::vector<double> &time, const std::vector<double>(&fparams),
+            const double *current_grad_u, const double *current_phi, const double *current_grad_phi,
+            const double *previous_grad_u, const double *previous_phi, const double *previous_grad_phi,
+            const unsigned int nsdvs, const double *previous_SDVS, double *SDVS, double *PK2, double *SIGMA,
+            double *M, std::string &output_message
+#ifdef DEBUG_MODE
+            ,
+            std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &debug
+#endif
+        );
 
         //! Virtual destructor
         virtual ~IMaterial() = default;
@@ -221,13 +385,21 @@ namespace micromorphic_material_library {
         /* Get an instance of a material based on its name */
         /* throws out_of_range if material not found */
         std::unique_ptr<IMaterial> GetMaterial(std::string name);
+        /* Get a persistent instance of a material which is shared by all callers */
+        /* throws runtime_error if material not found. Safe to call from multiple threads */
+        /* Repeated calls for the same name from a thread do not lock */
+        std::shared_ptr<IMaterial> GetSharedMaterial(const std::string &name);
         void                       PrintMaterials();
 
        private:
         /* Holds pointers to material registrars */
         std::map<std::string, IMaterialRegistrar *> registry_;
+        /* Holds the persistent material instances served by GetSharedMaterial */
+        std::map<std::string, std::shared_ptr<IMaterial> > shared_materials_;
+        /* Guards shared_materials_ */
+        std::mutex shared_materials_mutex_;
         /* Make constructors private and forbid cloning */
-        MaterialFactory() : registry_() {};
+        MaterialFactory() : registry_(), shared_materials_() {};
         MaterialFactory(MaterialFactory const &) = delete;
         void operator=(MaterialFactory const &)  = delete;
     };
@@ -250,6 +422,57 @@ namespace micromorphic_material_library {
         std::string classname_;
     };
 
+    /* Evaluate a material through the virtual interface. See evaluate_material_flat< Material > */
+    int evaluate_material_flat(
+        IMaterial &material, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[9],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[9][9], double (&DSIGMADphi)[9][9], double (&DSIGMADgrad_phi)[9][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &debug
+#endif
+    );
+
+    /* Evaluate a material through the virtual interface. See evaluate_material_flat_symmetric< Material > */
+    int evaluate_material_flat_symmetric(
+        IMaterial &material, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[6],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[6][9], double (&DSIGMADphi)[6][9], double (&DSIGMADgrad_phi)[6][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &debug
+#endif
+    );
+
+    /* Evaluate a material at every point of a state variable store. See the definition */
+    int evaluate_material_store(IMaterial &material, const std::vector<double> &time,
+                                const std::vector<double>(&fparams), const double *current_grad_u,
+                                const double *current_phi, const double *current_grad_phi,
+                                const double *previous_grad_u, const double *previous_phi,
+                                const double *previous_grad_phi, StateVariableStore &store, double *PK2,
+                                double *SIGMA, double *M, std::string &output_message
+#ifdef DEBUG_MODE
+                                ,
+                                std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &debug
+#endif
+    );
+
     /* template functions in header */
 
     template <class TMaterial>
@@ -263,6 +486,283 @@ namespace micromorphic_material_library {
         std::unique_ptr<IMaterial> material(new TMaterial());
         return material;
     }
+
+    template <unsigned int rows, unsigned int cols>
+    int copy_jacobian(const std::vector<std::vector<double> > &source, double (&destination)[rows][cols]) {
+        /*!
+         * Copy a nested vector jacobian into a fixed size row-major array
+         *
+         * :param const std::vector< std::vector< double > > &source: The jacobian to copy
+         * :param double ( &destination )[ rows ][ cols ]: The contiguous output buffer
+         *
+         * Returns 0 if the sizes are consistent and 2 otherwise
+         */
+
+        if (source.size() != rows) {
+            return 2;
+        }
+
+        for (unsigned int i = 0; i < rows; i++) {
+            if (source[i].size() != cols) {
+                return 2;
+            }
+
+            std::copy(source[i].begin(), source[i].end(), destination[i]);
+        }
+
+        return 0;
+    }
+
+    /* The rows and columns of the Voigt components [ 11, 22, 33, 23, 13, 12 ] of a symmetric second order tensor */
+    const unsigned int symmetric_voigt_rows[6]    = {0, 1, 2, 1, 0, 0};
+    const unsigned int symmetric_voigt_columns[6] = {0, 1, 2, 2, 2, 1};
+
+    template <class Material>
+    int evaluate_material_flat_nested(
+        Material &material, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[9],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[9][9], double (&DSIGMADphi)[9][9], double (&DSIGMADgrad_phi)[9][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Evaluate the nested vector form of Material::evaluate_model with the jacobians and write the results into
+         * fixed size, row-major buffers. This is the default implementation of IMaterial::evaluate_model_flat for
+         * models which do not override it.
+         *
+         * When Material is a concrete ( final ) model rather than IMaterial the call to evaluate_model is resolved at
+         * compile time so the model can be inlined into the caller. The arguments are the same as for
+         * IMaterial::evaluate_model_flat.
+         *
+         * :param Material &material: The material model to evaluate
+         */
+
+        thread_local std::vector<double> PK2_v, SIGMA_v, M_v;
+
+        thread_local std::vector<std::vector<double> > DPK2Dgrad_u_v, DPK2Dphi_v, DPK2Dgrad_phi_v, DSIGMADgrad_u_v,
+            DSIGMADphi_v, DSIGMADgrad_phi_v, DMDgrad_u_v, DMDphi_v, DMDgrad_phi_v;
+
+        int errorCode = material.evaluate_model(
+            time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+            previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+            PK2_v, SIGMA_v, M_v, DPK2Dgrad_u_v, DPK2Dphi_v, DPK2Dgrad_phi_v, DSIGMADgrad_u_v, DSIGMADphi_v,
+            DSIGMADgrad_phi_v, DMDgrad_u_v, DMDphi_v, DMDgrad_phi_v, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+            ,
+            DEBUG
+#endif
+        );
+
+        if (errorCode > 0) {
+            return errorCode;
+        }
+
+        if ((PK2_v.size() != 9) || (SIGMA_v.size() != 9) || (M_v.size() != 27)) {
+            output_message = "Error: evaluate_model returned stresses of unexpected size";
+            return 2;
+        }
+
+        std::copy(PK2_v.begin(), PK2_v.end(), PK2);
+        std::copy(SIGMA_v.begin(), SIGMA_v.end(), SIGMA);
+        std::copy(M_v.begin(), M_v.end(), M);
+
+        if (copy_jacobian(DPK2Dgrad_u_v, DPK2Dgrad_u) || copy_jacobian(DPK2Dphi_v, DPK2Dphi) ||
+            copy_jacobian(DPK2Dgrad_phi_v, DPK2Dgrad_phi) || copy_jacobian(DSIGMADgrad_u_v, DSIGMADgrad_u) ||
+            copy_jacobian(DSIGMADphi_v, DSIGMADphi) || copy_jacobian(DSIGMADgrad_phi_v, DSIGMADgrad_phi) ||
+            copy_jacobian(DMDgrad_u_v, DMDgrad_u) || copy_jacobian(DMDphi_v, DMDphi) ||
+            copy_jacobian(DMDgrad_phi_v, DMDgrad_phi)) {
+            output_message = "Error: evaluate_model returned jacobians of unexpected size";
+            return 2;
+        }
+
+        return errorCode;
+    }
+
+    template <class Material>
+    int evaluate_material_flat(
+        Material &material, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[9],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[9][9], double (&DSIGMADphi)[9][9], double (&DSIGMADgrad_phi)[9][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Evaluate Material::evaluate_model_flat. This is the implementation of the unqualified call
+         * evaluate_material_flat( material, ... ) used by the element kernels and the batched interfaces.
+         *
+         * When Material is a concrete ( final ) model which overrides evaluate_model_flat the override is called
+         * directly so it can be inlined into the caller. Concrete models which do not override it are evaluated with
+         * evaluate_material_flat_nested< Material > and IMaterial goes through the virtual evaluate_model_flat. The
+         * arguments are the same as for IMaterial::evaluate_model_flat.
+         *
+         * :param Material &material: The material model to evaluate
+         */
+
+        if constexpr (std::is_same<Material, IMaterial>::value ||
+                      !std::is_same<decltype(&Material::evaluate_model_flat),
+                                    decltype(&IMaterial::evaluate_model_flat)>::value) {
+            return material.evaluate_model_flat(
+                time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+                previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+                PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+                DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+                ,
+                DEBUG
+#endif
+            );
+        } else {
+            return evaluate_material_flat_nested(
+                material, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+                previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+                PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+                DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+                ,
+                DEBUG
+#endif
+            );
+        }
+    }
+
+    template <class Material>
+    int evaluate_material_flat_symmetric_from_flat(
+        Material &material, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[6],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[6][9], double (&DSIGMADphi)[6][9], double (&DSIGMADgrad_phi)[6][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * Evaluate evaluate_material_flat and write the symmetric micro stress and its jacobians in the Voigt form
+         * [ 11, 22, 33, 23, 13, 12 ]. The IJ and JI components are averaged. This is the default implementation of
+         * IMaterial::evaluate_model_flat_symmetric for models which do not override it.
+         *
+         * :param Material &material: The material model to evaluate
+         */
+
+        double SIGMA_full[9];
+        double DSIGMADgrad_u_full[9][9], DSIGMADphi_full[9][9], DSIGMADgrad_phi_full[9][27];
+
+        int errorCode = evaluate_material_flat(
+            material, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+            previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+            PK2, SIGMA_full, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u_full, DSIGMADphi_full,
+            DSIGMADgrad_phi_full, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+            ,
+            DEBUG
+#endif
+        );
+
+        if (errorCode > 0) {
+            return errorCode;
+        }
+
+        for (unsigned int v = 0; v < 6; v++) {
+            const unsigned int IJ = 3 * symmetric_voigt_rows[v] + symmetric_voigt_columns[v];
+            const unsigned int JI = 3 * symmetric_voigt_columns[v] + symmetric_voigt_rows[v];
+
+            SIGMA[v] = 0.5 * (SIGMA_full[IJ] + SIGMA_full[JI]);
+
+            for (unsigned int i = 0; i < 9; i++) {
+                DSIGMADgrad_u[v][i] = 0.5 * (DSIGMADgrad_u_full[IJ][i] + DSIGMADgrad_u_full[JI][i]);
+                DSIGMADphi[v][i]    = 0.5 * (DSIGMADphi_full[IJ][i] + DSIGMADphi_full[JI][i]);
+            }
+
+            for (unsigned int i = 0; i < 27; i++) {
+                DSIGMADgrad_phi[v][i] = 0.5 * (DSIGMADgrad_phi_full[IJ][i] + DSIGMADgrad_phi_full[JI][i]);
+            }
+        }
+
+        return errorCode;
+    }
+
+    template <class Material>
+    int evaluate_material_flat_symmetric(
+        Material &material, const std::vector<double> &time, const std::vector<double>(&fparams),
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[6],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[6][9], double (&DSIGMADphi)[6][9], double (&DSIGMADgrad_phi)[6][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * The same as evaluate_material_flat except that the symmetric micro stress and its jacobians are written
+         * in the Voigt form [ 11, 22, 33, 23, 13, 12 ].
+         *
+         * Concrete models which override evaluate_model_flat_symmetric are called directly, the others are evaluated
+         * with evaluate_material_flat_symmetric_from_flat< Material > and IMaterial goes through the virtual
+         * evaluate_model_flat_symmetric.
+         *
+         * :param Material &material: The material model to evaluate
+         */
+
+        if constexpr (std::is_same<Material, IMaterial>::value ||
+                      !std::is_same<decltype(&Material::evaluate_model_flat_symmetric),
+                                    decltype(&IMaterial::evaluate_model_flat_symmetric)>::value) {
+            return material.evaluate_model_flat_symmetric(
+                time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+                previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+                PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+                DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+                ,
+                DEBUG
+#endif
+            );
+        } else {
+            return evaluate_material_flat_symmetric_from_flat(
+                material, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+                previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+                PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+                DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+                ,
+                DEBUG
+#endif
+            );
+        }
+    }
 }  // namespace micromorphic_material_library
 
 /*
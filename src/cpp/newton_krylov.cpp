@@ -7,6 +7,7 @@
 #include <vector>
 #include <typeinfo>
 #include <newton_krylov.h>
+#include <instrumentation.h>
 
 namespace krylov{
     
@@ -85,7 +86,7 @@ namespace krylov{
         
         double rel_tol = Rnorm/Rnorm_0;
         
-        while((fabs(Rnorm/Rnorm_0)>NKtol) && (fabs(Rnorm)>1e-9) && (NKi<imax) && (!inconv_flg)){
+        while((fabs(Rnorm/Rnorm_0)>NKtol) && (fabs(Rnorm)>1e-9) && (NKi<imax) && (!inconv_flg) && std::isfinite(Rnorm)){
             
             if(verbose){
                 std::cout << "\n***************************\n";
@@ -114,7 +115,7 @@ namespace krylov{
             NKi++;
         }
         
-        if((NKi>=imax)||(inconv_flg)){
+        if((NKi>=imax)||(inconv_flg)||(!std::isfinite(Rnorm))){ //A non-finite residual (e.g. a failed material evaluation) is not converged
             std::cout << "Error: Newton-Krylov failed to converge\n";
             inconv_flg = true;
         }
@@ -131,6 +132,7 @@ namespace krylov{
         /*Perform an iteration of the krylov solver*/
         //std::cout << "R:\n";
         //print_vector(R);
+        update_preconditioner();
         std::vector< double > s = gmres();
         //std::cout << "u:\n";
         //print_vector(u);
@@ -147,6 +149,7 @@ namespace krylov{
         for(int i=0; i<vec.size(); i++){
             norm += pow(vec[i],2);
         }
+        global_sum(&norm,1);
         norm = sqrt(norm);
         return norm;
     }
@@ -180,211 +183,211 @@ namespace krylov{
             ip += vec1[i]*vec2[i];
         }
         
+        global_sum(&ip,1);
+        
         //std::cout << "ip: " << ip << "\n";
         return ip;
     }
     
-    std::vector< std::vector< double > > Solver::setup_q(){
-        /*Setup the q data structure*/
-        std::vector< std::vector< double > > q; //Normalized residual structure
-        q.resize(kmax+1);
-        for(int i=0; i<=kmax; i++){
-            q[i].resize(u.size());
-        }
-        return q;
-    }
-    
-    std::vector< std::vector< double > > Solver::setup_H(){
-        /*Setup the H matrix*/
-        std::vector< std::vector< double > > H;
-        H.resize(kmax+1);
-        for(int i=0; i<kmax+1; i++){
-            H[i].resize(kmax);
-        }
-        //std::cout << "H0:\n";
-        //print_matrix(H);
-        return H;
+    void Solver::setup_workspace(){
+        /*Size the GMRES workspace. The arrays are only re-allocated 
+          when the size of the problem or kmax have changed so the 
+          same storage is used for all of the Newton iterations.*/
+        
+        const unsigned int n = u.size();
+        
+        if(Q.size()!=n*(kmax+1)){Q.resize(n*(kmax+1));}
+        if(H.size()!=(kmax+1)*kmax){H.resize((kmax+1)*kmax);}
+        if(h.size()!=kmax+1){h.resize(kmax+1);}
+        if(beta.size()!=kmax+1){beta.resize(kmax+1);}
+        if(cj.size()!=kmax){cj.resize(kmax);}
+        if(sj.size()!=kmax){sj.resize(kmax);}
+        if(w.size()!=n){w.resize(n);}
+        if(z.size()!=n){z.resize(n);}
+        if(ds.size()!=n){ds.resize(n);}
     }
     
-    std::vector< double > Solver::set_b(){
+    void Solver::set_b(std::vector< double > &b){
         /*Set the value of b*/
         
-        std::vector< double > b;
         b.resize(R.size());
         for(int i=0; i<R.size(); i++){
             b[i] = -R[i];
         }
-        return b;
     }
     
-    std::vector<double> Solver::gmres(){
-        /*Perform gmres iteration*/
-        //std::cout << "In GMRES\n";
-        
-        /*Set-up required values*/
-        std::vector< std::vector< double > > q;// = setup_q();
-        q.reserve(kmax+1);
-        
-        std::vector<double> beta;
-        beta.resize(kmax+1);
-        
-        //std::cout << "initial beta:\n";
-        //print_vector(beta);
+    void Solver::orthogonalize(const unsigned int &ncols, std::vector< double > &v, double *hcol){
+        /*!=======================
+        |    orthogonalize    |
+        =======================
         
-        std::vector< double > cj;
-        cj.resize(kmax);
+        Orthogonalize v against the first ncols columns of 
+        the Arnoldi basis using classical Gram-Schmidt with 
+        one reorthogonalization pass (CGS2). Each pass is 
+        formed of the two matrix-vector products
         
-        std::vector< double > sj;
-        sj.resize(kmax);
+        h = Q^T v
+        v = v - Q h
         
-        //std::cout << "R:\n";
-        //print_vector(R);
-        
-        //std::vector<double> b = set_b();
-        q.push_back(set_b());
+        which stream through the contiguous columns of Q. 
+        The projections of both passes are accumulated 
+        into the column of the Hessenberg matrix hcol. 
+        The projections of a pass are summed over the 
+        processes in a single reduction.
         
-        //std::cout << "b:\n";
-        //print_vector(b);
+        */
         
-        double bnorm = vector_norm(q[0]);
-        //std::cout << "bnorm: " << bnorm << "\n";
+        const unsigned int n = u.size();
         
-        normalize_vector(q[0],bnorm);
+        for(int j=0; j<ncols; j++){hcol[j] = 0.;}
         
-        //std::cout << "q.size(): " << q.size() << "\n";
+        for(int pass=0; pass<2; pass++){
+            
+            //Compute h = Q^T v
+            for(int j=0; j<ncols; j++){
+                const double *qj = &Q[j*n];
+                double ip = 0.;
+                for(int i=0; i<n; i++){
+                    ip += qj[i]*v[i];
+                }
+                h[j] = ip;
+            }
+            global_sum(&h[0],ncols);
+            
+            //Compute v = v - Q h
+            for(int j=0; j<ncols; j++){
+                const double *qj = &Q[j*n];
+                const double hj  = h[j];
+                for(int i=0; i<n; i++){
+                    v[i] -= hj*qj[i];
+                }
+                hcol[j] += hj;
+            }
+        }
+    }
+    
+    std::vector<double> Solver::gmres(){
+        /*!===============
+        |    gmres    |
+        ===============
         
-        //std::cout << "q:\n";
-        //print_matrix(q);
+        Solve J ds = -R using restarted and right 
+        preconditioned GMRES(kmax). At most rmax cycles 
+        are performed and each cycle proceeds until the 
+        norm of the linear residual is less than tol or 
+        kmax basis vectors have been formed.
         
-        beta[0] = bnorm;
+        */
         
-        std::vector< std::vector< double > > H = setup_H();
-
-        //std::cout << "beta:\n";
-        //print_vector(beta);
+        MICROMORPHIC_TIME_SCOPE("krylov gmres");
         
-        //std::cout << "kmax: " << kmax << "\n";
+        setup_workspace();
         
-        unsigned int k = 0;
+        const unsigned int n    = u.size();
+        const unsigned int ldh  = kmax+1;
+        unsigned int ktotal     = 0;
         double temp1 = 0;
         double temp2 = 0;
-        //Begin loop
-        while((k<kmax)&&(fabs(beta[k])>tol)){//&&(k<u.size())){
-            
-            q.push_back(residual_derivative(q[k]));
-            
-            //std::cout << "q[k+1]:";
-            //print_vector(q[k+1]);
+        
+        for(int i=0; i<n; i++){ds[i] = 0.;}
+        
+        for(int cycle=0; cycle<rmax; cycle++){
             
-            for(int j=0; j<=k; j++){
-                H[j][k] = inner_product(q[j],q[k+1]);
-                for(int i=0; i<u.size(); i++){
-                    q[k+1][i] -= H[j][k]*q[j][i];
+            //Compute the residual of the linear system
+            set_b(w);
+            if(cycle>0){
+                std::vector< double > Jds = jacobian_vector_product(ds);
+                for(int i=0; i<n; i++){
+                    w[i] -= Jds[i];
                 }
             }
             
-            H[k+1][k] = vector_norm(q[k+1]);
+            double bnorm = vector_norm(w);
             
-            //std::cout << "H[k+1][k]: " << H[k+1][k] << "\n";
+            if(bnorm<=tol){break;}
             
-            //std::cout << "q[k+1]:\n";
-            //print_vector(q[k+1]);
-            
-            normalize_vector(q[k+1],H[k+1][k]);
-            
-            //std::cout << "q[k+1]:\n";
-            //print_vector(q[k+1]);
-            
-//            std::cout << "Pre rotation H:\n";
-//            print_matrix(H);
-            
-                      
-//            for(int j=0; j<=k; j++){
-//                temp1 = sqrt(pow(H[j][j],2)+pow(H[j+1][j],2));
-//                //std::cout << "temp1: " << temp1 << "\n";
-//                cj[j] =   H[j][j]/temp1;
-//                sj[j] = H[j+1][j]/temp1;
-//            }
-
-            /*Apply rotations to the current column*/
-//            std::cout << "old rotations cj:\n";
-//            print_vector(cj);
-//            std::cout << "old rotations sj:\n";
-//            print_vector(sj);
-            
-            for(int j=0; j<k; j++){
-                temp1     =  cj[j]*H[j][k]+sj[j]*H[j+1][k];
-                temp2     = -sj[j]*H[j][k]+cj[j]*H[j+1][k];
-                H[j][k]   = temp1;
-                H[j+1][k] = temp2;
+            for(int i=0; i<n; i++){
+                Q[i] = w[i]/bnorm;
             }
             
-            /*Get new rotation*/
-            temp1 = sqrt(pow(H[k][k],2)+pow(H[k+1][k],2));
-            cj[k] =   H[k][k]/temp1;
-            sj[k] = H[k+1][k]/temp1;
+            for(int j=0; j<=kmax; j++){beta[j] = 0.;}
+            beta[0] = bnorm;
             
-//            std::cout << "Pre new rotation H:\n";
-//            print_matrix(H);
+            unsigned int k = 0;
             
-            for(int j=k; j<=k; j++){
-                temp1     =  cj[j]*H[j][k]+sj[j]*H[j+1][k];
-                temp2     = -sj[j]*H[j][k]+cj[j]*H[j+1][k];
-                H[j][k]   = temp1;
-                H[j+1][k] = temp2;
+            while((k<kmax)&&(fabs(beta[k])>tol)){
+                
+                MICROMORPHIC_COUNT("krylov iterations",1);
+                
+                //Form the new vector from the preconditioned basis vector
+                for(int i=0; i<n; i++){
+                    w[i] = Q[k*n+i];
+                }
+                apply_preconditioner(w,z);
+                w = jacobian_vector_product(z);
+                
+                double *Hk = &H[k*ldh];
+                
+                orthogonalize(k+1,w,Hk);
+                
+                Hk[k+1] = vector_norm(w);
+                
+                //Extend the basis unless the Krylov space is invariant
+                if(Hk[k+1]>0){
+                    double *qkp1 = &Q[(k+1)*n];
+                    for(int i=0; i<n; i++){
+                        qkp1[i] = w[i]/Hk[k+1];
+                    }
+                }
+                
+                /*Apply rotations to the current column*/
+                for(int j=0; j<k; j++){
+                    temp1   =  cj[j]*Hk[j]+sj[j]*Hk[j+1];
+                    temp2   = -sj[j]*Hk[j]+cj[j]*Hk[j+1];
+                    Hk[j]   = temp1;
+                    Hk[j+1] = temp2;
+                }
+                
+                /*Get new rotation*/
+                temp1 = sqrt(pow(Hk[k],2)+pow(Hk[k+1],2));
+                if(temp1==0){break;}
+                cj[k] =    Hk[k]/temp1;
+                sj[k] =  Hk[k+1]/temp1;
+                
+                Hk[k]   = temp1;
+                Hk[k+1] = 0.;
+                
+                temp1     =  cj[k]*beta[k]+sj[k]*beta[k+1];
+                temp2     = -sj[k]*beta[k]+cj[k]*beta[k+1];
+                beta[k]   = temp1;
+                beta[k+1] = temp2;
+                
+                k++;
             }
-
-  
-//            std::cout << "Post new rotation H:\n";
-//            print_matrix(H);
-
-            temp1     =  cj[k]*beta[k]+sj[k]*beta[k+1];
-            temp2     = -sj[k]*beta[k]+cj[k]*beta[k+1];
-            beta[k]   = temp1;
-            beta[k+1] = temp2;
             
-//            for(int j=0; j<=k; j++){
-//                temp1     =  cj[j]*beta[k]+sj[j]*beta[k+1];
-//                temp2     = -sj[j]*beta[k]+cj[j]*beta[k+1];
-//                beta[k]   = temp1;
-//                beta[k+1] = temp2;
-//            }
+            if(k==0){break;}
             
-//            std::cout << "beta:\n";
-//            print_vector(beta);
+            ktotal += k;
             
-            k++;
+            //Update the increment with the preconditioned combination of the basis vectors
+            solve_triangular(k,h);
             
-        }
-        
-//        std::cout << "H:\n";
-//        print_matrix(H);
-//        
-//        std::cout << "q:\n";
-//        print_matrix(q);
-//        
-//        std::cout << "beta:\n";
-//        print_vector(beta);
-//        
-//        std::cout << "k: " << k << "\n";
-        
-//        std::cout << "y:\n";
-//        print_vector(y);
-        
-        std::vector< double > s;
-        s.resize(u.size());
-        
-        if(k>0){
-        
-            std::vector< double > y = solve_triangular(k,H,beta);
-        
+            for(int i=0; i<n; i++){w[i] = 0.;}
             for(int j=0; j<k; j++){
-                for(int i=0; i<u.size(); i++){
-                    s[i] += y[j]*q[j][i];
+                const double *qj = &Q[j*n];
+                for(int i=0; i<n; i++){
+                    w[i] += h[j]*qj[i];
                 }
             }
+            apply_preconditioner(w,z);
+            for(int i=0; i<n; i++){
+                ds[i] += z[i];
+            }
+            
+            if(fabs(beta[k])<=tol){break;}
         }
-        else{
+        
+        if(ktotal==0){
             std::cout << "************************************************\n";
             std::cout << "Error: No significant orthonormal vectors found.\n"
                       << "       Try increasing NKtol if appropriate.\n"
@@ -394,69 +397,26 @@ namespace krylov{
             inconv_flg = true;
         }
         
-        //std::cout << "s:\n";
-        //print_vector(s);
-        
-        //assert(1==0);
-        
-        return s;
+        return ds;
   
     }  
     
-    std::vector< double > Solver::solve_triangular(const unsigned int& kub, const std::vector< std::vector< double > > &H, const std::vector< double > &beta){
-        /*Solve the triangular matrix*/
-/*        std::vector <double> y;
-        y.resize(kmax);
-        
-        
-        int kmj = 0;
-        int k = kmax-1;
-        
-        //std::cout << "k: " << k << "\n";
-        
-        y[k] = beta[k]/H[k][k];
+    void Solver::solve_triangular(const unsigned int& kub, std::vector< double > &y){
+        /*Solve the upper triangular system formed by the first kub 
+          columns of the rotated Hessenberg matrix for y*/
         
-        //std::cout << "y[k]: " << y[k] << "\n";
-        
-        for(int j=1; j<=k; j++){
-            //std::cout << "j: " << j << "\n";
-            y[k-j] = beta[k-j];
-            for(int i=(k-j+1); i<=k; i++){
-                //std::cout << "i: " << i << "\n";
-                //std::cout << "H[k-j][i]: " << H[k-j][i] << "\n";
-                //std::cout << "y[i]:      " << y[i] << "\n";
-                y[k-j] -= H[k-j][i]*y[i];
-            }
-            y[k-j] = y[k-j]/H[k-j][k-j];
-        }
-
-        return y;*/
-        std::vector <double> y;
-        y.resize(kub);
-        
-        
-        int kmj = 0;
+        const unsigned int ldh = kmax+1;
         int k = kub-1;
         
-        //std::cout << "k: " << k << "\n";
-        
-        y[k] = beta[k]/H[k][k];
-        
-        //std::cout << "y[k]: " << y[k] << "\n";
+        y[k] = beta[k]/H[k+k*ldh];
         
         for(int j=1; j<=k; j++){
-            //std::cout << "j: " << j << "\n";
             y[k-j] = beta[k-j];
             for(int i=(k-j+1); i<=k; i++){
-                //std::cout << "i: " << i << "\n";
-                //std::cout << "H[k-j][i]: " << H[k-j][i] << "\n";
-                //std::cout << "y[i]:      " << y[i] << "\n";
-                y[k-j] -= H[k-j][i]*y[i];
+                y[k-j] -= H[(k-j)+i*ldh]*y[i];
             }
-            y[k-j] = y[k-j]/H[k-j][k-j];
+            y[k-j] = y[k-j]/H[(k-j)+(k-j)*ldh];
         }
-
-        return y;
     }
     
     void Solver::print_matrix(const std::vector< std::vector< double > > &M){
@@ -9,6 +9,7 @@
 namespace krylov{
     
     typedef std::vector< double > (*residual_function)(const std::vector<double>&);
+    typedef void (*preconditioner_function)(const std::vector<double>&, std::vector<double>&);
     typedef std::vector< double > Vector;
     typedef std::vector< std::vector< double > > Matrix;
 
@@ -18,7 +19,8 @@ namespace krylov{
         public:
             unsigned int NKi  = 0;     //Overall Iteration number
             unsigned int imax = 40;    //Maximum number of Newton iterations
-            unsigned int kmax = 10;    //Maximum number of GMRES iterations
+            unsigned int kmax = 10;    //Maximum number of GMRES iterations before a restart
+            unsigned int rmax = 1;     //Maximum number of GMRES(kmax) cycles (restarts are opt in)
             bool verbose=false;        //Output root finding messages
             bool inconv_flg=false;     //Inconvergence flag
             
@@ -26,6 +28,7 @@ namespace krylov{
             double tol  = 1e-7;        //The iteration tolerance
             
             residual_function R_fxn;   //The residual function
+            preconditioner_function P_fxn = NULL; //The (optional) right preconditioner
             
             std::vector< double > R;   //The residual vector
             
@@ -50,18 +53,46 @@ namespace krylov{
             }
             
             /*Derivative Computation*/
+            virtual std::vector< double > jacobian_vector_product(const std::vector< double > &s){
+                /*Compute the product of the jacobian of the residual with s.
+                  Defaults to the finite difference approximation but may be
+                  redefined to use an analytic jacobian*/
+                return residual_derivative(s);
+            }
             std::vector< double > residual_derivative(const std::vector< double >&);
             std::vector< double > get_utrial(const double&, const std::vector< double >&);
             double get_h(std::vector< double >);
             
             
+            /*Preconditioner*/
+            virtual void apply_preconditioner(const std::vector< double > &v, std::vector< double > &z){
+                /*Apply the inverse of the right preconditioner to v.
+                  Defaults to P_fxn or to the identity if no function 
+                  has been provided but may be redefined*/
+                if(P_fxn){P_fxn(v,z);}
+                else{z = v;}
+            }
+            
+            virtual void update_preconditioner(){
+                /*Update the preconditioner at the current value of u. 
+                  Called once at the start of each Newton iteration. 
+                  Defaults to doing nothing but may be redefined*/
+            }
+            
             /*gmres functions*/
             std::vector< double > gmres();
             
-            std::vector< std::vector< double > > setup_q();
-            std::vector< std::vector< double > > setup_H();
-            std::vector< double > set_b();         
-            std::vector< double > solve_triangular(const unsigned int&, const std::vector< std::vector< double >>&, const std::vector< double >&);
+            void setup_workspace();
+            void set_b(std::vector< double >&);
+            void orthogonalize(const unsigned int&, std::vector< double >&, double*);
+            void solve_triangular(const unsigned int&, std::vector< double >&);
+            
+            /*Reductions*/
+            virtual void global_sum(double *values, const unsigned int &n){
+                /*Sum the n values over all of the processes which hold a 
+                  part of the vectors. Defaults to doing nothing (the vectors 
+                  are held by a single process) but may be redefined*/
+            }
             
             /*Vector functions*/
             double vector_norm(const std::vector< double >&);
@@ -70,6 +101,19 @@ namespace krylov{
             double inner_product(const std::vector< double >&,const std::vector< double >&);
             //Matrix ATA(const Matrix&);
             
+            /*GMRES workspace. The Arnoldi basis and the Hessenberg matrix are stored 
+              column-major in contiguous arrays which are only re-allocated when 
+              the size of the problem or kmax changes.*/
+            std::vector< double > Q;    //The Arnoldi basis (u.size() x kmax+1)
+            std::vector< double > H;    //The Hessenberg matrix (kmax+1 x kmax)
+            std::vector< double > h;    //The projection of a vector onto the basis
+            std::vector< double > beta; //The rotated residual
+            std::vector< double > cj;   //The cosines of the Givens rotations
+            std::vector< double > sj;   //The sines of the Givens rotations
+            std::vector< double > w;    //The new Arnoldi vector
+            std::vector< double > z;    //The preconditioned vector
+            std::vector< double > ds;   //The solution increment
+            
             /*Debugging functions*/
             void print_matrix(const std::vector< std::vector< double > >&);
             void print_vector(const std::vector< double >&);
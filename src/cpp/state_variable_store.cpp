@@ -0,0 +1,267 @@
+/*!
+=====================================================================
+|                     state_variable_store.cpp                      |
+=====================================================================
+| The definition of the storage of the state variables of the Gauss |
+| points of a mesh.                                                 |
+=====================================================================
+*/
+
+#include "state_variable_store.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace micromorphic_material_library {
+
+    StateVariableStore::StateVariableStore() { resize(0, 0, 0); }
+
+    StateVariableStore::StateVariableStore(const unsigned int num_elements, const unsigned int num_gauss_points,
+                                           const unsigned int num_sdvs, const unsigned int block_size) {
+        /*!
+         * Construct the store with all of the state variables set to zero
+         *
+         * :param const unsigned int num_elements: The number of elements
+         * :param const unsigned int num_gauss_points: The number of Gauss points in each element
+         * :param const unsigned int num_sdvs: The number of state variables at each Gauss point
+         * :param const unsigned int block_size: The number of points in each structure of arrays block
+         */
+
+        resize(num_elements, num_gauss_points, num_sdvs, block_size);
+    }
+
+    void StateVariableStore::resize(const unsigned int num_elements, const unsigned int num_gauss_points,
+                                    const unsigned int num_sdvs, const unsigned int block_size) {
+        /*!
+         * Resize the store. All of the state variables are set to zero.
+         *
+         * :param const unsigned int num_elements: The number of elements
+         * :param const unsigned int num_gauss_points: The number of Gauss points in each element
+         * :param const unsigned int num_sdvs: The number of state variables at each Gauss point
+         * :param const unsigned int block_size: The number of points in each structure of arrays block
+         */
+
+        num_elements_     = num_elements;
+        num_gauss_points_ = num_gauss_points;
+        num_sdvs_         = num_sdvs;
+        block_size_       = std::max(block_size, 1u);
+        num_blocks_       = (num_points() + block_size_ - 1) / block_size_;
+        committed_buffer_ = 0;
+
+        // Round the size of each block up to a whole number of cache lines
+        block_stride_ = ((std::size_t)num_sdvs_ * block_size_ + alignment_ - 1) / alignment_ * alignment_;
+
+        for (unsigned int i = 0; i < 2; i++) {
+            buffers_[i].assign(block_stride_ * num_blocks_ + alignment_, 0.);
+        }
+
+        written_.assign(num_points(), 0);
+    }
+
+    unsigned int StateVariableStore::block_points(const unsigned int block) const {
+        /*!
+         * Get the number of points stored in a block. Only the last block may be partially filled.
+         *
+         * :param const unsigned int block: The block number
+         */
+
+        return std::min(block_size_, num_points() - block * block_size_);
+    }
+
+    double &StateVariableStore::trial(const unsigned int element, const unsigned int gauss_point,
+                                      const unsigned int sdv) {
+        /*!
+         * Get a reference to a trial state variable. The trial values of the point start from the committed
+         * values the first time one of them is requested after a commit.
+         *
+         * :param const unsigned int element: The element number
+         * :param const unsigned int gauss_point: The Gauss point number
+         * :param const unsigned int sdv: The state variable number
+         */
+
+        write_point((std::size_t)element * num_gauss_points_ + gauss_point);
+
+        return buffer(1 - committed_buffer_)[index(element, gauss_point, sdv)];
+    }
+
+    double StateVariableStore::committed(const unsigned int element, const unsigned int gauss_point,
+                                         const unsigned int sdv) const {
+        /*!
+         * Get the value of a committed state variable
+         *
+         * :param const unsigned int element: The element number
+         * :param const unsigned int gauss_point: The Gauss point number
+         * :param const unsigned int sdv: The state variable number
+         */
+
+        return buffer(committed_buffer_)[index(element, gauss_point, sdv)];
+    }
+
+    double *StateVariableStore::trial_block(const unsigned int block) {
+        /*!
+         * Get the trial state variables of a block. The values are in structure of arrays form with a
+         * stride of block_points( block ) between state variables.
+         *
+         * Every point of the block is marked as written so the caller must overwrite all of the values e.g.
+         * with the pointer form of IMaterial::evaluate_model_batch.
+         *
+         * :param const unsigned int block: The block number
+         */
+
+        std::fill(written_.begin() + block * block_size_, written_.begin() + block * block_size_ + block_points(block),
+                  1);
+
+        return buffer(1 - committed_buffer_) + block * block_stride_;
+    }
+
+    const double *StateVariableStore::committed_block(const unsigned int block) const {
+        /*!
+         * Get the committed state variables of a block. The values are in structure of arrays form with a
+         * stride of block_points( block ) between state variables.
+         *
+         * :param const unsigned int block: The block number
+         */
+
+        return buffer(committed_buffer_) + block * block_stride_;
+    }
+
+    void StateVariableStore::get_committed(const unsigned int element, const unsigned int gauss_point,
+                                           std::vector<double> &SDVS) const {
+        /*!
+         * Copy the committed state variables of a point into a vector for use with evaluate_model
+         *
+         * :param const unsigned int element: The element number
+         * :param const unsigned int gauss_point: The Gauss point number
+         * :param std::vector< double > &SDVS: The state variables of the point
+         */
+
+        SDVS.resize(num_sdvs_);
+
+        for (unsigned int i = 0; i < num_sdvs_; i++) {
+            SDVS[i] = committed(element, gauss_point, i);
+        }
+    }
+
+    void StateVariableStore::set_trial(const unsigned int element, const unsigned int gauss_point,
+                                       const std::vector<double> &SDVS) {
+        /*!
+         * Set the trial state variables of a point from the vector updated by evaluate_model
+         *
+         * :param const unsigned int element: The element number
+         * :param const unsigned int gauss_point: The Gauss point number
+         * :param const std::vector< double > &SDVS: The state variables of the point
+         */
+
+        for (unsigned int i = 0; i < std::min((std::size_t)num_sdvs_, SDVS.size()); i++) {
+            trial(element, gauss_point, i) = SDVS[i];
+        }
+    }
+
+    void StateVariableStore::set_committed(const unsigned int element, const unsigned int gauss_point,
+                                           const std::vector<double> &SDVS) {
+        /*!
+         * Set the committed state variables of a point e.g. to their initial values
+         *
+         * :param const unsigned int element: The element number
+         * :param const unsigned int gauss_point: The Gauss point number
+         * :param const std::vector< double > &SDVS: The state variables of the point
+         */
+
+        double *committed_values = buffer(committed_buffer_);
+
+        for (unsigned int i = 0; i < std::min((std::size_t)num_sdvs_, SDVS.size()); i++) {
+            committed_values[index(element, gauss_point, i)] = SDVS[i];
+        }
+    }
+
+    void StateVariableStore::commit() {
+        /*!
+         * Accept the trial state variables as the converged values. The buffers are swapped so the values of the
+         * points written since the last commit are not copied. The points which were not written keep their
+         * committed values, which are copied into the trial buffer before the swap. The old committed values
+         * become the trial buffer and are overwritten by the next evaluation.
+         */
+
+        for (std::size_t point = 0; point < written_.size(); point++) {
+            write_point(point);
+        }
+
+        committed_buffer_ = 1 - committed_buffer_;
+
+        std::fill(written_.begin(), written_.end(), 0);
+    }
+
+    void StateVariableStore::discard() {
+        /*!
+         * Drop the trial state variables of a rejected increment. The next commit keeps the committed values of
+         * every point which is not written again.
+         */
+
+        std::fill(written_.begin(), written_.end(), 0);
+    }
+
+    void StateVariableStore::write_point(const std::size_t point) {
+        /*!
+         * Mark a point as written. The committed values of the point are copied into the trial buffer if it
+         * has not been written since the last commit.
+         *
+         * :param const std::size_t point: The point ( element * num_gauss_points + gauss_point )
+         */
+
+        if (written_[point]) {
+            return;
+        }
+
+        const unsigned int  block     = point / block_size_;
+        const std::size_t   start     = block * block_stride_ + point % block_size_;
+        const unsigned int  stride    = block_points(block);
+        const double       *committed = buffer(committed_buffer_) + start;
+        double             *trial     = buffer(1 - committed_buffer_) + start;
+
+        for (unsigned int i = 0; i < num_sdvs_; i++) {
+            trial[i * stride] = committed[i * stride];
+        }
+
+        written_[point] = 1;
+    }
+
+    double *StateVariableStore::buffer(const unsigned int index) {
+        /*!
+         * Get the cache line aligned start of a buffer
+         *
+         * :param const unsigned int index: The buffer index
+         */
+
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffers_[index].data());
+        std::uintptr_t bytes   = alignment_ * sizeof(double);
+        return buffers_[index].data() + ((bytes - address % bytes) % bytes) / sizeof(double);
+    }
+
+    const double *StateVariableStore::buffer(const unsigned int index) const {
+        /*!
+         * Get the cache line aligned start of a buffer
+         *
+         * :param const unsigned int index: The buffer index
+         */
+
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffers_[index].data());
+        std::uintptr_t bytes   = alignment_ * sizeof(double);
+        return buffers_[index].data() + ((bytes - address % bytes) % bytes) / sizeof(double);
+    }
+
+    std::size_t StateVariableStore::index(const unsigned int element, const unsigned int gauss_point,
+                                          const unsigned int sdv) const {
+        /*!
+         * Get the location of a state variable in a buffer
+         *
+         * :param const unsigned int element: The element number
+         * :param const unsigned int gauss_point: The Gauss point number
+         * :param const unsigned int sdv: The state variable number
+         */
+
+        std::size_t  point = (std::size_t)element * num_gauss_points_ + gauss_point;
+        unsigned int block = point / block_size_;
+        return block * block_stride_ + sdv * block_points(block) + point % block_size_;
+    }
+
+}  // namespace micromorphic_material_library
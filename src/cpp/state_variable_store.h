@@ -0,0 +1,108 @@
+/*!
+=====================================================================
+|                      state_variable_store.h                       |
+=====================================================================
+| A header file which defines the storage of the state variables of |
+| the Gauss points of a mesh. The store is shared by the material   |
+| library and the finite element driver so it does not depend on    |
+| the material models.                                              |
+=====================================================================
+*/
+
+#ifndef STATE_VARIABLE_STORE_H
+#define STATE_VARIABLE_STORE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace micromorphic_material_library {
+
+    /*
+     * Storage for the state variables of every Gauss point of a mesh.
+     *
+     * The values are held in a single contiguous buffer for the committed ( last converged ) state and one for
+     * the trial ( current iteration ) state. The points ( element * num_gauss_points + gauss_point ) are grouped
+     * into blocks of block_size points and each block is stored in structure of arrays form i.e. state variable i
+     * of local point p is at [ i * block_points( block ) + p ] of the block ( only the last block may hold fewer
+     * than block_size points ). Blocks start on cache line boundaries so a block can be handed directly to the
+     * pointer form of IMaterial::evaluate_model_batch.
+     *
+     * Trial values are always computed from the committed values so committing a converged increment only swaps
+     * the two buffers. The points whose trial values were not written since the last commit, e.g. the elements which
+     * an incremental assembly did not re-integrate, are copied into the trial buffer first so they keep their
+     * committed values. A rejected increment is dropped with discard.
+     */
+    class StateVariableStore {
+       public:
+        StateVariableStore();
+
+        StateVariableStore(const unsigned int num_elements, const unsigned int num_gauss_points,
+                           const unsigned int num_sdvs, const unsigned int block_size = 8);
+
+        void resize(const unsigned int num_elements, const unsigned int num_gauss_points, const unsigned int num_sdvs,
+                    const unsigned int block_size = 8);
+
+        unsigned int num_elements() const { return num_elements_; }
+
+        unsigned int num_gauss_points() const { return num_gauss_points_; }
+
+        unsigned int num_sdvs() const { return num_sdvs_; }
+
+        unsigned int num_points() const { return num_elements_ * num_gauss_points_; }
+
+        unsigned int block_size() const { return block_size_; }
+
+        unsigned int num_blocks() const { return num_blocks_; }
+
+        unsigned int block_points(const unsigned int block) const;
+
+        double &trial(const unsigned int element, const unsigned int gauss_point, const unsigned int sdv);
+
+        double committed(const unsigned int element, const unsigned int gauss_point, const unsigned int sdv) const;
+
+        double *trial_block(const unsigned int block);
+
+        const double *committed_block(const unsigned int block) const;
+
+        void get_committed(const unsigned int element, const unsigned int gauss_point,
+                           std::vector<double> &SDVS) const;
+
+        void set_trial(const unsigned int element, const unsigned int gauss_point, const std::vector<double> &SDVS);
+
+        void set_committed(const unsigned int element, const unsigned int gauss_point,
+                           const std::vector<double> &SDVS);
+
+        void commit();
+
+        void discard();
+
+       private:
+        /* The size of a cache line in doubles */
+        static const unsigned int alignment_ = 8;
+
+        unsigned int num_elements_;
+        unsigned int num_gauss_points_;
+        unsigned int num_sdvs_;
+        unsigned int block_size_;
+        unsigned int num_blocks_;
+        /* The number of doubles between the starts of consecutive blocks */
+        std::size_t block_stride_;
+        /* The index of the buffer which holds the committed values */
+        unsigned int committed_buffer_;
+        /* The committed and trial buffers ( padded so that they can be aligned ) */
+        std::vector<double> buffers_[2];
+        /* Flags of the points whose trial values were written since the last commit */
+        std::vector<unsigned char> written_;
+
+        double *buffer(const unsigned int index);
+
+        const double *buffer(const unsigned int index) const;
+
+        std::size_t index(const unsigned int element, const unsigned int gauss_point, const unsigned int sdv) const;
+
+        void write_point(const std::size_t point);
+    };
+
+}  // namespace micromorphic_material_library
+
+#endif
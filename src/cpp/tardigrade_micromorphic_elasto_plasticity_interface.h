@@ -1,10 +1,165 @@
 #ifndef TARDIGRADE_MICROMORPHIC_ELASTO_PLASTICITY_INTERFACE_H
 #define TARDIGRADE_MICROMORPHIC_ELASTO_PLASTICITY_INTERFACE_H
 
+#include <algorithm>
 #include <micromorphic_material_library.h>
 #include <tardigrade_micromorphic_elasto_plasticity.h>
 namespace tardigradeMicromorphicElastoPlasticity {
-    class LinearElasticityDruckerPragerPlasticity : public micromorphic_material_library::IMaterial {
+
+    /* The number of state variables of the model */
+    const unsigned int num_model_state_variables = 55;
+
+    /*
+     * The optional solver hints which may be appended to the state variables. They are carried from one converged
+     * increment to the next and begin at SDVS[ num_model_state_variables ]
+     *
+     * PLASTIC_HINT:   1 if the last converged increment was plastic, 0 otherwise
+     * SUBSTEP_HINT:   The number of sub-increments to start the next local solve with
+     * SOLVE_HINT:     The number of local solves used by the last converged increment
+     */
+    enum SolverHint { PLASTIC_HINT, SUBSTEP_HINT, SOLVE_HINT, NUM_SOLVER_HINTS };
+
+    /* The largest number of sub-increments used when warm starting the local solve */
+    const unsigned int max_substeps = 16;
+
+    template <class Solve>
+    int solve_with_hints(const std::vector<double> &time, const double (&current_grad_u)[3][3],
+                         const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+                         const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+                         const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, Solve &solve,
+                         const bool allow_substeps = true) {
+        /*!
+         * Solve the return mapping for an increment using the solver hints stored after the state variables.
+         *
+         * If SDVS does not hold the hint block the increment is solved directly. Otherwise the increment is
+         * split into the number of sub-increments recorded by the last converged increment at this point if it
+         * was plastic ( one otherwise ) so that the local solves start from a nearby converged plastic state. A
+         * sub-incremented solve which fails to converge is repeated with twice as many sub-increments up to
+         * max_substeps. The hints of the converged increment are written back to the hint block and a
+         * recommendation of half the sub-increments is stored when the first attempt converged so points leave
+         * sub-incrementation once the plastic flow becomes easier to resolve.
+         *
+         * The jacobians of a sub-incremented solve would only be those of the final sub-increment because the
+         * local solves do not provide the jacobians of the state variables w.r.t. the deformation which are needed
+         * to chain the sub-increment tangents. Callers which need the jacobians must set allow_substeps to false.
+         * The increment is then always solved in a single step, which makes the jacobians consistent with the
+         * returned stresses, and a failed solve is returned to the caller so that the global increment is cut back.
+         * The hints are still written back.
+         *
+         * :param const std::vector< double > &time: The current time and the timestep
+         *     [ current_t, dt ]
+         * :param const double ( &current_grad_u )[ 3 ][ 3 ]: The current displacement gradient
+         * :param const double ( &current_phi )[ 9 ]: The current micro displacement
+         * :param const double ( &current_grad_phi )[ 9 ][ 3 ]: The current micro displacement gradient
+         * :param const double ( &previous_grad_u )[ 3 ][ 3 ]: The previous displacement gradient
+         * :param const double ( &previous_phi )[ 9 ]: The previous micro displacement
+         * :param const double ( &previous_grad_phi )[ 9 ][ 3 ]: The previous micro displacement gradient
+         * :param std::vector< double > &SDVS: The state variables optionally followed by the solver hints
+         * :param Solve &solve: The local solve which is called as
+         *     solve( time, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+         *            previous_grad_phi, SDVS ) and returns the error code of evaluate_hydra_model
+         * :param const bool allow_substeps: Whether the increment may be split into sub-increments
+         *
+         * Returns the error code of the last local solve
+         */
+
+        if (SDVS.size() != num_model_state_variables + NUM_SOLVER_HINTS) {
+            return solve(time, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+                         previous_grad_phi, SDVS);
+        }
+
+        const std::vector<double> previous_SDVS(SDVS.begin(), SDVS.begin() + num_model_state_variables);
+
+        const double *hints = SDVS.data() + num_model_state_variables;
+
+        unsigned int num_substeps = 1;
+        if (allow_substeps && (hints[PLASTIC_HINT] > 0.5)) {
+            num_substeps = std::min(max_substeps, std::max(1u, (unsigned int)(hints[SUBSTEP_HINT] + 0.5)));
+        }
+
+        const unsigned int initial_substeps = num_substeps;
+        unsigned int       num_solves       = 0;
+
+        std::vector<double> sub_SDVS, sub_time(2);
+
+        double sub_current_grad_u[3][3], sub_current_phi[9], sub_current_grad_phi[9][3];
+        double sub_previous_grad_u[3][3], sub_previous_phi[9], sub_previous_grad_phi[9][3];
+
+        const double previous_t = time[0] - time[1];
+
+        while (true) {
+            sub_SDVS = previous_SDVS;
+
+            int errorCode = 0;
+
+            for (unsigned int k = 1; k <= num_substeps; k++) {
+                const double f0 = (double)(k - 1) / num_substeps;
+                const double f1 = (double)k / num_substeps;
+
+                sub_time[0] = previous_t + f1 * time[1];
+                sub_time[1] = time[1] / num_substeps;
+
+                for (unsigned int i = 0; i < 9; i++) {
+                    const double dgrad_u = current_grad_u[i / 3][i % 3] - previous_grad_u[i / 3][i % 3];
+                    const double dphi    = current_phi[i] - previous_phi[i];
+
+                    sub_previous_grad_u[i / 3][i % 3] = previous_grad_u[i / 3][i % 3] + f0 * dgrad_u;
+                    sub_current_grad_u[i / 3][i % 3]  = previous_grad_u[i / 3][i % 3] + f1 * dgrad_u;
+                    sub_previous_phi[i]               = previous_phi[i] + f0 * dphi;
+                    sub_current_phi[i]                = previous_phi[i] + f1 * dphi;
+
+                    for (unsigned int j = 0; j < 3; j++) {
+                        const double dgrad_phi = current_grad_phi[i][j] - previous_grad_phi[i][j];
+
+                        sub_previous_grad_phi[i][j] = previous_grad_phi[i][j] + f0 * dgrad_phi;
+                        sub_current_grad_phi[i][j]  = previous_grad_phi[i][j] + f1 * dgrad_phi;
+                    }
+                }
+
+                // The final sub-increment ends exactly at the current state
+                if (k == num_substeps) {
+                    sub_time[0] = time[0];
+                    std::copy(&current_grad_u[0][0], &current_grad_u[0][0] + 9, &sub_current_grad_u[0][0]);
+                    std::copy(current_phi, current_phi + 9, sub_current_phi);
+                    std::copy(&current_grad_phi[0][0], &current_grad_phi[0][0] + 27, &sub_current_grad_phi[0][0]);
+                }
+
+                errorCode = solve(sub_time, sub_current_grad_u, sub_current_phi, sub_current_grad_phi,
+                                  sub_previous_grad_u, sub_previous_phi, sub_previous_grad_phi, sub_SDVS);
+
+                num_solves++;
+
+                if (errorCode > 0) {
+                    break;
+                }
+            }
+
+            if (errorCode == 0) {
+                const bool plastic = !std::equal(previous_SDVS.begin(), previous_SDVS.end(), sub_SDVS.begin());
+
+                unsigned int next_substeps = num_substeps;
+                if (num_substeps == initial_substeps) {
+                    next_substeps = std::max(1u, num_substeps / 2);
+                }
+
+                SDVS = sub_SDVS;
+                SDVS.resize(num_model_state_variables + NUM_SOLVER_HINTS);
+                SDVS[num_model_state_variables + PLASTIC_HINT] = plastic ? 1 : 0;
+                SDVS[num_model_state_variables + SUBSTEP_HINT] = plastic ? next_substeps : 1;
+                SDVS[num_model_state_variables + SOLVE_HINT]   = num_solves;
+
+                return 0;
+            }
+
+            if ((errorCode > 1) || !allow_substeps || (num_substeps >= max_substeps)) {
+                return errorCode;
+            }
+
+            num_substeps *= 2;
+        }
+    }
+
+    class LinearElasticityDruckerPragerPlasticity final : public micromorphic_material_library::IMaterial {
         /*!
          * The class which is called when evaluating a
          * linear elastic Drucker-Prager plastic micromorphic
@@ -12,6 +167,10 @@ namespace tardigradeMicromorphicElastoPlasticity {
          *
          * This class registers the model into a library of models which can then
          * be called by name.
+         *
+         * The state variables may be followed by NUM_SOLVER_HINTS solver hints ( see SolverHint ) which are
+         * used to warm start the local solve from the last converged increment. Only the evaluations without the
+         * jacobians are sub-incremented.
          */
 
        public:
@@ -30,15 +189,23 @@ namespace tardigradeMicromorphicElastoPlasticity {
                            tardigradeSolverTools::homotopyMap &DEBUG
 #endif
         ) {
-            return tardigradeMicromorphicElastoPlasticity::evaluate_hydra_model(
-                time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
-                previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
-                PK2, SIGMA, M, ADD_TERMS, output_message
+            auto solve = [&](const std::vector<double> &_time, const double (&_current_grad_u)[3][3],
+                             const double (&_current_phi)[9], const double (&_current_grad_phi)[9][3],
+                             const double (&_previous_grad_u)[3][3], const double (&_previous_phi)[9],
+                             const double (&_previous_grad_phi)[9][3], std::vector<double> &_SDVS) {
+                return tardigradeMicromorphicElastoPlasticity::evaluate_hydra_model(
+                    _time, fparams, _current_grad_u, _current_phi, _current_grad_phi, _previous_grad_u, _previous_phi,
+                    _previous_grad_phi, _SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF,
+                    previous_ADD_grad_DOF, PK2, SIGMA, M, ADD_TERMS, output_message
 #ifdef DEBUG_MODE
-                ,
-                DEBUG
+                    ,
+                    DEBUG
 #endif
-            );
+                );
+            };
+
+            return solve_with_hints(time, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+                                    previous_grad_phi, SDVS, solve);
         }
 
         int evaluate_model(
@@ -60,17 +227,26 @@ namespace tardigradeMicromorphicElastoPlasticity {
             tardigradeSolverTools::homotopyMap &DEBUG
 #endif
         ) {
-
-            return tardigradeMicromorphicElastoPlasticity::evaluate_hydra_model(
-                time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
-                previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
-                PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi,
-                DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+            auto solve = [&](const std::vector<double> &_time, const double (&_current_grad_u)[3][3],
+                             const double (&_current_phi)[9], const double (&_current_grad_phi)[9][3],
+                             const double (&_previous_grad_u)[3][3], const double (&_previous_phi)[9],
+                             const double (&_previous_grad_phi)[9][3], std::vector<double> &_SDVS) {
+                return tardigradeMicromorphicElastoPlasticity::evaluate_hydra_model(
+                    _time, fparams, _current_grad_u, _current_phi, _current_grad_phi, _previous_grad_u, _previous_phi,
+                    _previous_grad_phi, _SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF,
+                    previous_ADD_grad_DOF, PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u,
+                    DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS,
+                    output_message
 #ifdef DEBUG_MODE
-                ,
-                DEBUG
+                    ,
+                    DEBUG
 #endif
-            );
+                );
+            };
+
+            // The sub-increment tangents cannot be chained so the jacobians are always formed in a single step
+            return solve_with_hints(time, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+                                    previous_grad_phi, SDVS, solve, false);
         }
     };
 
@@ -1 +1,119 @@
 #include <tardigrade_micromorphic_linear_elasticity_interface.h>
+
+#include <algorithm>
+
+namespace tardigradeMicromorphicLinearElasticity {
+
+    int LinearElasticity::evaluate_model_batch(const unsigned int npoints, const std::vector<double> &time,
+                                               const std::vector<double>(&fparams), const double *current_grad_u,
+                                               const double *current_phi, const double *current_grad_phi,
+                                               const double *previous_grad_u, const double *previous_phi,
+                                               const double *previous_grad_phi, const unsigned int nsdvs,
+                                               const double *previous_SDVS, double *SDVS, double *PK2, double *SIGMA,
+                                               double *M, std::string &output_message
+#ifdef DEBUG_MODE
+                                               ,
+                                               std::map<std::string,
+                                                        std::map<std::string, std::map<std::string, std::vector<double> > > >
+                                                   &DEBUG
+#endif
+    ) {
+        /*!
+         * Evaluate the linear elastic model at npoints points. The arguments are the same as for
+         * IMaterial::evaluate_model_batch.
+         *
+         * The points are streamed through the upstream evaluate_hydra_model without going through the virtual
+         * evaluate_model. The inputs are transposed from the structure of arrays form a block of points at a time
+         * so the strided loads and stores of each component run over consecutive points, and the per-thread point
+         * outputs keep their capacity between calls.
+         */
+
+        if (npoints == 0) {
+            return 0;
+        }
+
+        // The number of points transposed at a time
+        const unsigned int block_size = 8;
+
+        double current_grad_u_b[block_size][3][3], current_phi_b[block_size][9], current_grad_phi_b[block_size][9][3];
+        double previous_grad_u_b[block_size][3][3], previous_phi_b[block_size][9],
+            previous_grad_phi_b[block_size][9][3];
+
+        const std::vector<double>               ADD_DOF;
+        const std::vector<std::vector<double> > ADD_grad_DOF;
+
+        thread_local std::vector<double>                SDVS_p, PK2_p, SIGMA_p, M_p;
+        thread_local std::vector<std::vector<double> > ADD_TERMS;
+        thread_local micromorphic_material_library::MaterialDiagnostic diagnostic;
+
+        for (unsigned int start = 0; start < npoints; start += block_size) {
+            const unsigned int nblock = std::min(block_size, npoints - start);
+
+            // Gather the block
+            for (unsigned int i = 0; i < 9; i++) {
+                const unsigned int offset = i * npoints + start;
+                for (unsigned int b = 0; b < nblock; b++) {
+                    current_grad_u_b[b][i / 3][i % 3]  = current_grad_u[offset + b];
+                    current_phi_b[b][i]                = current_phi[offset + b];
+                    previous_grad_u_b[b][i / 3][i % 3] = previous_grad_u[offset + b];
+                    previous_phi_b[b][i]               = previous_phi[offset + b];
+                }
+            }
+
+            for (unsigned int i = 0; i < 27; i++) {
+                const unsigned int offset = i * npoints + start;
+                for (unsigned int b = 0; b < nblock; b++) {
+                    current_grad_phi_b[b][i / 3][i % 3]  = current_grad_phi[offset + b];
+                    previous_grad_phi_b[b][i / 3][i % 3] = previous_grad_phi[offset + b];
+                }
+            }
+
+            for (unsigned int b = 0; b < nblock; b++) {
+                const unsigned int p = start + b;
+
+                SDVS_p.resize(nsdvs);
+                for (unsigned int i = 0; i < nsdvs; i++) {
+                    SDVS_p[i] = previous_SDVS[i * npoints + p];
+                }
+
+                diagnostic.clear();
+
+                int errorCode = tardigradeMicromorphicLinearElasticity::evaluate_hydra_model(
+                    time, fparams, current_grad_u_b[b], current_phi_b[b], current_grad_phi_b[b], previous_grad_u_b[b],
+                    previous_phi_b[b], previous_grad_phi_b[b], SDVS_p, ADD_DOF, ADD_grad_DOF, ADD_DOF, ADD_grad_DOF,
+                    PK2_p, SIGMA_p, M_p, ADD_TERMS, diagnostic.detail);
+
+                if (errorCode > 0) {
+                    diagnostic.fail(errorCode, "Error in evaluate_model_batch", p);
+                    output_message = diagnostic.message();
+                    return errorCode;
+                }
+
+                if ((PK2_p.size() != 9) || (SIGMA_p.size() != 9) || (M_p.size() != 27) ||
+                    (SDVS_p.size() != nsdvs)) {
+                    diagnostic.detail.clear();
+                    diagnostic.fail(2, "Error: evaluate_model returned outputs of unexpected size", p);
+                    output_message = diagnostic.message();
+                    return 2;
+                }
+
+                // Scatter the point values
+                for (unsigned int i = 0; i < 9; i++) {
+                    PK2[i * npoints + p]   = PK2_p[i];
+                    SIGMA[i * npoints + p] = SIGMA_p[i];
+                }
+
+                for (unsigned int i = 0; i < 27; i++) {
+                    M[i * npoints + p] = M_p[i];
+                }
+
+                for (unsigned int i = 0; i < nsdvs; i++) {
+                    SDVS[i * npoints + p] = SDVS_p[i];
+                }
+            }
+        }
+
+        return 0;
+    }
+
+}  // namespace tardigradeMicromorphicLinearElasticity
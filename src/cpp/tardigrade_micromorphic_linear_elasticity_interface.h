@@ -4,7 +4,7 @@
 #include <micromorphic_material_library.h>
 #include <tardigrade_micromorphic_linear_elasticity.h>
 namespace tardigradeMicromorphicLinearElasticity {
-    class LinearElasticity : public micromorphic_material_library::IMaterial {
+    class LinearElasticity final : public micromorphic_material_library::IMaterial {
         /*!
          * The class which is called when evaluating a
          * linear elastic micromorphic constitutive model.
@@ -14,6 +14,8 @@ namespace tardigradeMicromorphicLinearElasticity {
          */
 
        public:
+        using micromorphic_material_library::IMaterial::evaluate_model_batch;
+
         int evaluate_model(
             const std::vector<double> &time, const std::vector<double>(&fparams), const double (&current_grad_u)[3][3],
             const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
@@ -59,6 +61,55 @@ namespace tardigradeMicromorphicLinearElasticity {
                 PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi,
                 DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message);
         }
+
+        int evaluate_model_flat(
+            const std::vector<double> &time, const std::vector<double>(&fparams), const double (&current_grad_u)[3][3],
+            const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+            const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+            const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS,
+            const std::vector<double> &current_ADD_DOF, const std::vector<std::vector<double> > &current_ADD_grad_DOF,
+            const std::vector<double> &previous_ADD_DOF, const std::vector<std::vector<double> > &previous_ADD_grad_DOF,
+            double (&PK2)[9], double (&SIGMA)[9], double (&M)[27], double (&DPK2Dgrad_u)[9][9],
+            double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27], double (&DSIGMADgrad_u)[9][9],
+            double (&DSIGMADphi)[9][9], double (&DSIGMADgrad_phi)[9][27], double (&DMDgrad_u)[27][9],
+            double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27], std::vector<std::vector<double> > &ADD_TERMS,
+            std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS, std::string &output_message
+#ifdef DEBUG_MODE
+            ,
+            std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+            ) override {
+            /*!
+             * Evaluate the upstream model into the fixed size buffers. The results of evaluate_hydra_model are copied
+             * through the per-thread scratch storage of evaluate_material_flat_nested, the call to evaluate_model is
+             * resolved at compile time.
+             */
+
+            return micromorphic_material_library::evaluate_material_flat_nested(
+                *this, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+                previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+                PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi,
+                DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+                ,
+                DEBUG
+#endif
+            );
+        }
+
+        int evaluate_model_batch(const unsigned int npoints, const std::vector<double> &time,
+                                 const std::vector<double>(&fparams), const double *current_grad_u,
+                                 const double *current_phi, const double *current_grad_phi,
+                                 const double *previous_grad_u, const double *previous_phi,
+                                 const double *previous_grad_phi, const unsigned int nsdvs,
+                                 const double *previous_SDVS, double *SDVS, double *PK2, double *SIGMA, double *M,
+                                 std::string &output_message
+#ifdef DEBUG_MODE
+                                 ,
+                                 std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > >
+                                     &DEBUG
+#endif
+                                 ) override;
     };
 
     REGISTER_MATERIAL(LinearElasticity)
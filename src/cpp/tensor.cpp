@@ -68,4 +68,35 @@ namespace tensor{
         
         return FOTI;
     }
+    
+    double det(const FixedTensor23& T){
+        /*!Return the determinant of a fixed size second order tensor
+        
+        The determinant is expanded along the first row.*/
+        
+        return T(0,0)*(T(1,1)*T(2,2) - T(1,2)*T(2,1))
+              -T(0,1)*(T(1,0)*T(2,2) - T(1,2)*T(2,0))
+              +T(0,2)*(T(1,0)*T(2,1) - T(1,1)*T(2,0));
+    }
+    
+    FixedTensor23 inverse(const FixedTensor23& T){
+        /*!Return the inverse of a fixed size second order tensor
+        
+        The inverse is computed from the adjugate. The tensor 
+        is not checked for singularity.*/
+        
+        FixedTensor23 Tinv;
+        
+        Tinv(0,0) = T(1,1)*T(2,2) - T(1,2)*T(2,1);
+        Tinv(0,1) = T(0,2)*T(2,1) - T(0,1)*T(2,2);
+        Tinv(0,2) = T(0,1)*T(1,2) - T(0,2)*T(1,1);
+        Tinv(1,0) = T(1,2)*T(2,0) - T(1,0)*T(2,2);
+        Tinv(1,1) = T(0,0)*T(2,2) - T(0,2)*T(2,0);
+        Tinv(1,2) = T(0,2)*T(1,0) - T(0,0)*T(1,2);
+        Tinv(2,0) = T(1,0)*T(2,1) - T(1,1)*T(2,0);
+        Tinv(2,1) = T(0,1)*T(2,0) - T(0,0)*T(2,1);
+        Tinv(2,2) = T(0,0)*T(1,1) - T(0,1)*T(1,0);
+        
+        return Tinv/det(T);
+    }
 }
\ No newline at end of file
@@ -179,6 +179,8 @@ namespace tensor
                 index_split     = T.index_split;
                 iterator_split  = T.iterator_split;
                 index_factors   = T.index_factors;
+                
+                return *this;
             }
     
             BaseTensor<m_b,n_b> operator+(const BaseTensor<m_b,n_b>& T1){
@@ -698,6 +700,274 @@ namespace tensor
     }
     
         
+    //!==
+    //!|
+    //!| Fixed size tensors
+    //!|
+    //!==
+    
+    namespace fixed_shape{
+        /*!Compile time utilities for the shape of a FixedTensor*/
+        
+        template<int... dims> struct product;
+        
+        template<> struct product<>{
+            /*!The product of an empty set of dimensions*/
+            static constexpr int value = 1;
+        };
+        
+        template<int d, int... dims> struct product<d,dims...>{
+            /*!The product of the dimensions*/
+            static constexpr int value = d*product<dims...>::value;
+        };
+        
+        template<int... dims> struct index_map;
+        
+        template<> struct index_map<>{
+            static constexpr int map(){
+                /*!The terminal case of the index map*/
+                return 0;
+            }
+        };
+        
+        template<int d, int... dims> struct index_map<d,dims...>{
+            template<typename... ArgsT>
+            static constexpr int map(int i, ArgsT... indices){
+                /*!Map the indices to the row-major location in the data array*/
+                return i*product<dims...>::value + index_map<dims...>::map(indices...);
+            }
+        };
+        
+        template<int... dims> struct dimension;
+        
+        template<> struct dimension<>{
+            static constexpr int get(int n){
+                /*!The terminal case of the dimension lookup*/
+                return 0;
+            }
+        };
+        
+        template<int d, int... dims> struct dimension<d,dims...>{
+            static constexpr int get(int n){
+                /*!Get the length of index n*/
+                return (n==0) ? d : dimension<dims...>::get(n-1);
+            }
+        };
+    }
+    
+    template<int... dims> class FixedTensor{
+        /*!===
+           |
+           | F i x e d T e n s o r
+           |
+          ===
+        
+        A tensor whose shape is a template parameter.
+        
+        The shape, the number of terms, and the mapping 
+        from the indices to the data array are all known 
+        at compile time so the tensor has no dynamic 
+        members and lives entirely on the stack. The 
+        data is stored in row-major order such that the 
+        terms have the same ordering as the default format 
+        of BaseTensor.
+        
+        Arithmetic is performed in place or on the stack 
+        without any of the run time shape and format checks 
+        of BaseTensor. Indices are not bounds checked.
+        
+        */
+        
+        public:
+        
+            //!==
+            //!|
+            //!| Attribute Definitions
+            //!|
+            //!==
+            
+            static constexpr int order = sizeof...(dims);               //!The order of the tensor
+            static constexpr int size  = fixed_shape::product<dims...>::value; //!The number of terms in the tensor
+            
+            double data[size];                                          //!The data array of the tensor
+            
+            //!==
+            //!|
+            //!| Constructors
+            //!|
+            //!==
+            
+            FixedTensor(){
+                /*!The default constructor for the tensor. The tensor will be initialized to 0.*/
+                zero();
+            }
+            
+            FixedTensor(const double (&_data)[size]){
+                /*!A constructor for a tensor where the data is read in*/
+                for(int i=0; i<size; i++){data[i] = _data[i];}
+            }
+            
+            //!==
+            //!|
+            //!| Operators
+            //!|
+            //!==
+            
+            template <typename ...ArgsT>
+            double& operator()(ArgsT ...indices){
+                /*!================================================
+                |            FixedTensor::operator()            |
+                =================================================
+                
+                Operator which returns the *address* of the term 
+                of the data array using index notation.
+                
+                Input:
+                    indices: The indices provided by the user. Should be of type int
+                */
+                
+                static_assert(sizeof...(ArgsT)==order, "The number of indices must equal the order of the tensor");
+                return data[fixed_shape::index_map<dims...>::map(indices...)];
+            }
+            
+            template <typename ...ArgsT>
+            double operator()(ArgsT ...indices) const{
+                /*!================================================
+                |            FixedTensor::operator()            |
+                =================================================
+                
+                Operator which returns the *value* of the term 
+                of the data array using index notation.
+                
+                Input:
+                    indices: The indices provided by the user. Should be of type int
+                */
+                
+                static_assert(sizeof...(ArgsT)==order, "The number of indices must equal the order of the tensor");
+                return data[fixed_shape::index_map<dims...>::map(indices...)];
+            }
+            
+            FixedTensor<dims...>& operator+=(const FixedTensor<dims...>& T1){
+                /*!Redefine the addition equals operator*/
+                for(int i=0; i<size; i++){data[i] += T1.data[i];}
+                return *this;
+            }
+            
+            FixedTensor<dims...>& operator-=(const FixedTensor<dims...>& T1){
+                /*!Redefine the subtraction equals operator*/
+                for(int i=0; i<size; i++){data[i] -= T1.data[i];}
+                return *this;
+            }
+            
+            FixedTensor<dims...>& operator*=(const double& a){
+                /*!Redefine the multiplication equals operator for a scalar double*/
+                for(int i=0; i<size; i++){data[i] *= a;}
+                return *this;
+            }
+            
+            FixedTensor<dims...>& operator/=(const double& a){
+                /*!Redefine the division equals operator for a scalar double*/
+                for(int i=0; i<size; i++){data[i] /= a;}
+                return *this;
+            }
+            
+            FixedTensor<dims...> operator+(const FixedTensor<dims...>& T1) const{
+                /*!Redefine the addition operator*/
+                FixedTensor<dims...> T = *this;
+                return T += T1;
+            }
+            
+            FixedTensor<dims...> operator-(const FixedTensor<dims...>& T1) const{
+                /*!Redefine the subtraction operator*/
+                FixedTensor<dims...> T = *this;
+                return T -= T1;
+            }
+            
+            FixedTensor<dims...> operator-() const{
+                /*!Redefine the negative operator*/
+                FixedTensor<dims...> T = *this;
+                return T *= -1.;
+            }
+            
+            //!==
+            //!|
+            //!| Methods
+            //!|
+            //!==
+            
+            static constexpr int dimension(int n){
+                /*!Get the length of index n of the tensor*/
+                return fixed_shape::dimension<dims...>::get(n);
+            }
+            
+            void zero(){
+                /*! Set all values of the tensor to zero */
+                for(int i=0; i<size; i++){data[i] = 0.;}
+            }
+            
+            void add_scaled(const double& a, const FixedTensor<dims...>& T1){
+                /*!Add a scaled tensor in place i.e. this += a*T1*/
+                for(int i=0; i<size; i++){data[i] += a*T1.data[i];}
+            }
+            
+            template<int m, int n>
+            void from_base_tensor(const BaseTensor<m,n>& T){
+                /*!=========================
+                |    from_base_tensor    |
+                ==========================
+                
+                Copy the values of a BaseTensor with the 
+                default storage format and the same number 
+                of terms into the tensor.
+                
+                */
+                
+                static_assert((m>0) && (n>0) && (m*n==size), "The BaseTensor must have a fixed size with the same number of terms");
+                for(int i=0; i<m; i++){
+                    for(int j=0; j<n; j++){
+                        data[i*n+j] = T.data(i,j);
+                    }
+                }
+            }
+            
+            template<int m, int n>
+            void to_base_tensor(BaseTensor<m,n>& T) const{
+                /*!=======================
+                |    to_base_tensor    |
+                ========================
+                
+                Copy the values of the tensor into a 
+                BaseTensor with the default storage format 
+                and the same number of terms.
+                
+                */
+                
+                static_assert((m>0) && (n>0) && (m*n==size), "The BaseTensor must have a fixed size with the same number of terms");
+                for(int i=0; i<m; i++){
+                    for(int j=0; j<n; j++){
+                        T.data(i,j) = data[i*n+j];
+                    }
+                }
+            }
+    };
+    
+    template<int... dims> FixedTensor<dims...> operator*(const double& a, const FixedTensor<dims...>& T){
+        /*!Redefine the multiplication operator for a scalar double*/
+        FixedTensor<dims...> Tout = T;
+        return Tout *= a;
+    }
+    
+    template<int... dims> FixedTensor<dims...> operator*(const FixedTensor<dims...>& T, const double& a){
+        /*!Redefine the multiplication operator for a scalar double*/
+        return a*T;
+    }
+    
+    template<int... dims> FixedTensor<dims...> operator/(const FixedTensor<dims...>& T, const double& a){
+        /*!Redefine the division operator for a scalar double*/
+        FixedTensor<dims...> Tout = T;
+        return Tout /= a;
+    }
+    
     //!==
     //!|
     //!| Type definitions
@@ -711,6 +981,12 @@ namespace tensor
     typedef BaseTensor<27,27> Tensor63;
     typedef BaseTensor<Eigen::Dynamic, Eigen::Dynamic> Tensor;
     
+    typedef FixedTensor<3,3>         FixedTensor23;
+    typedef FixedTensor<3,3,3>       FixedTensor33;
+    typedef FixedTensor<3,3,3,3>     FixedTensor43;
+    typedef FixedTensor<3,3,3,3,3>   FixedTensor53;
+    typedef FixedTensor<3,3,3,3,3,3> FixedTensor63;
+    
     //!==
     //!|
     //!| Functions
@@ -719,4 +995,7 @@ namespace tensor
         
     Tensor23 eye();
     Tensor43 FOT_eye();
+    
+    double        det(const FixedTensor23& T);
+    FixedTensor23 inverse(const FixedTensor23& T);
 }
\ No newline at end of file
@@ -2179,6 +2179,94 @@ int test_compute_dgrad_chidF(std::ofstream &results){
     return 1;
 }
 
+int test_apply_derivative_operators(std::ofstream &results){
+    /*!=========================================
+    |    test_apply_derivative_operators    |
+    =========================================
+    
+    Test the application of the gradients of the 
+    deformation measures to the gradient of a quantity 
+    w.r.t. the deformation measures against the 
+    products with the dense gradients.
+    */
+    
+    //Define the required fundamental measures
+    Matrix_3x3 F;
+    define_deformation_gradient(F);
+    Matrix_3x3 chi;
+    define_chi(chi);
+    Vector_27 grad_chi = Vector_27::Random();
+    
+    //Define the gradients of the quantities w.r.t. the deformation measures
+    Matrix_9x9   dAdsot_9   = Matrix_9x9::Random();
+    Matrix_27x9  dAdsot_27  = Matrix_27x9::Random();
+    Matrix_9x27  dAdtot_9   = Matrix_9x27::Random();
+    Matrix_27x27 dAdtot_27  = Matrix_27x27::Random();
+    
+    //Define the dense gradients of the deformation measures
+    Matrix_9x9   dRCGdF, dPsidF, dPsidchi;
+    Matrix_27x9  dGammadF, dgrad_chidF;
+    Matrix_27x27 dGammadgrad_chi, dgrad_chidgrad_phi;
+    deformation_measures::compute_dRCGdF(F, dRCGdF);
+    deformation_measures::compute_dPsidF(chi, dPsidF);
+    deformation_measures::compute_dPsidchi(F, dPsidchi);
+    deformation_measures::compute_dGammadF(grad_chi, dGammadF);
+    deformation_measures::compute_dgrad_chidF(grad_chi, dgrad_chidF);
+    deformation_measures::compute_dGammadgrad_chi(F, dGammadgrad_chi);
+    deformation_measures::compute_dgrad_chidgrad_phi(F, dgrad_chidgrad_phi);
+    
+    Matrix_9x9   result_9x9;
+    Matrix_27x9  result_27x9;
+    Matrix_9x27  result_9x27;
+    Matrix_27x27 result_27x27;
+    
+    bool tot_result = true;
+    
+    deformation_measures::apply_dRCGdF(dAdsot_9, F, result_9x9);
+    tot_result *= result_9x9.isApprox(dAdsot_9*dRCGdF,1e-12);
+    deformation_measures::apply_dRCGdF(dAdsot_27, F, result_27x9);
+    tot_result *= result_27x9.isApprox(dAdsot_27*dRCGdF,1e-12);
+    
+    deformation_measures::apply_dPsidF(dAdsot_9, chi, result_9x9);
+    tot_result *= result_9x9.isApprox(dAdsot_9*dPsidF,1e-12);
+    deformation_measures::apply_dPsidF(dAdsot_27, chi, result_27x9);
+    tot_result *= result_27x9.isApprox(dAdsot_27*dPsidF,1e-12);
+    
+    deformation_measures::apply_dPsidchi(dAdsot_9, F, result_9x9);
+    tot_result *= result_9x9.isApprox(dAdsot_9*dPsidchi,1e-12);
+    deformation_measures::apply_dPsidchi(dAdsot_27, F, result_27x9);
+    tot_result *= result_27x9.isApprox(dAdsot_27*dPsidchi,1e-12);
+    
+    deformation_measures::apply_dGammadF(dAdtot_9, grad_chi, result_9x9);
+    tot_result *= result_9x9.isApprox(dAdtot_9*dGammadF,1e-12);
+    deformation_measures::apply_dGammadF(dAdtot_27, grad_chi, result_27x9);
+    tot_result *= result_27x9.isApprox(dAdtot_27*dGammadF,1e-12);
+    
+    deformation_measures::apply_dGammadgrad_chi(dAdtot_9, F, result_9x27);
+    tot_result *= result_9x27.isApprox(dAdtot_9*dGammadgrad_chi,1e-12);
+    deformation_measures::apply_dGammadgrad_chi(dAdtot_27, F, result_27x27);
+    tot_result *= result_27x27.isApprox(dAdtot_27*dGammadgrad_chi,1e-12);
+    
+    deformation_measures::apply_dgrad_chidgrad_phi(dAdtot_9, F, result_9x27);
+    tot_result *= result_9x27.isApprox(dAdtot_9*dgrad_chidgrad_phi,1e-12);
+    deformation_measures::apply_dgrad_chidgrad_phi(dAdtot_27, F, result_27x27);
+    tot_result *= result_27x27.isApprox(dAdtot_27*dgrad_chidgrad_phi,1e-12);
+    
+    deformation_measures::apply_dgrad_chidF(dAdtot_9, grad_chi, result_9x9);
+    tot_result *= result_9x9.isApprox(dAdtot_9*dgrad_chidF,1e-12);
+    deformation_measures::apply_dgrad_chidF(dAdtot_27, grad_chi, result_27x9);
+    tot_result *= result_27x9.isApprox(dAdtot_27*dgrad_chidF,1e-12);
+    
+    if (tot_result){
+        results << "test_apply_derivative_operators & True\\\\\n\\hline\n";
+    }
+    else {
+        results << "test_apply_derivative_operators & False\\\\\n\\hline\n";
+    }
+
+    return 1;
+}
+
 int test_compute_ddetAdA(std::ofstream &results){
     /*!==============================
     |    test_compute_ddetAdA    |
@@ -2493,6 +2581,7 @@ int main(){
     test_compute_dGammadgrad_chi(results);
     test_compute_dgrad_chidgrad_phi(results);
     test_compute_dgrad_chidF(results);
+    test_apply_derivative_operators(results);
     test_compute_ddetAdA(results);
     test_map_stresses_to_current_configuration(results);
     test_compute_dFdgrad_u(results);
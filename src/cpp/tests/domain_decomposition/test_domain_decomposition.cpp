@@ -0,0 +1,269 @@
+/*!=======================================================
+  |                                                     |
+  |           test_domain_decomposition.cpp             |
+  |                                                     |
+  -------------------------------------------------------
+  | The unit test file for domain_decomposition.h/cpp.  |
+  | The partition and the exchange lists of every rank  |
+  | are built without communication so they are tested |
+  | here for several ranks within a single process.     |
+  | The node orderings used to renumber the mesh are    |
+  | also tested.                                        |
+  =======================================================*/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <domain_decomposition.h>
+
+void cube_mesh(const unsigned int &n, std::vector< std::array< double, 3 > > &centroids,
+               std::vector< std::vector< unsigned int > > &element_nodes, unsigned int &num_nodes){
+    /*!===================
+    |    cube_mesh    |
+    ===================
+    
+    Form the element centroids and connectivity 
+    of a unit cube meshed with n x n x n elements.
+    
+    */
+    
+    num_nodes = (n+1)*(n+1)*(n+1);
+    centroids.clear();
+    element_nodes.clear();
+    
+    for(unsigned int k=0; k<n; k++){
+        for(unsigned int j=0; j<n; j++){
+            for(unsigned int i=0; i<n; i++){
+                unsigned int base = i + (n+1)*(j + (n+1)*k);
+                unsigned int up   = (n+1)*(n+1);
+                std::array< double, 3 > centroid = { {(i+0.5)/n, (j+0.5)/n, (k+0.5)/n} };
+                std::vector< unsigned int > nodes = {base, base+1, base+n+2, base+n+1, base+up, base+up+1, base+up+n+2, base+up+n+1};
+                centroids.push_back(centroid);
+                element_nodes.push_back(nodes);
+            }
+        }
+    }
+}
+
+int test_recursive_coordinate_bisection(std::ofstream &results){
+    /*!=============================================
+    |    test_recursive_coordinate_bisection    |
+    =============================================
+    
+    Test that the parts are balanced and that a 
+    bisection splits the mesh normal to its 
+    longest side.
+    
+    */
+    
+    std::vector< std::array< double, 3 > > centroids;
+    std::vector< std::vector< unsigned int > > element_nodes;
+    unsigned int num_nodes;
+    cube_mesh(4, centroids, element_nodes, num_nodes);
+    
+    bool result = true;
+    
+    //Balance for part counts which are and are not powers of two
+    unsigned int nparts[4] = {1, 2, 3, 5};
+    for(int p=0; p<4; p++){
+        std::vector< unsigned int > parts = domain_decomposition::recursive_coordinate_bisection(centroids, nparts[p]);
+        std::vector< unsigned int > counts(nparts[p],0);
+        for(unsigned int e=0; e<parts.size(); e++){
+            if(parts[e]>=nparts[p]){result = false; continue;}
+            counts[parts[e]]++;
+        }
+        unsigned int min_count = *std::min_element(counts.begin(), counts.end());
+        unsigned int max_count = *std::max_element(counts.begin(), counts.end());
+        result = result && (max_count-min_count<=1);
+    }
+    
+    //Stretch the mesh in z so that the first cut is normal to z
+    std::vector< std::array< double, 3 > > stretched = centroids;
+    for(unsigned int e=0; e<stretched.size(); e++){stretched[e][2] *= 10.;}
+    std::vector< unsigned int > parts = domain_decomposition::recursive_coordinate_bisection(stretched, 2);
+    for(unsigned int e=0; e<parts.size(); e++){
+        result = result && (parts[e]==((stretched[e][2]>5.) ? 1u : 0u));
+    }
+    
+    if(result){results << "test_recursive_coordinate_bisection & True\\\\\n\\hline\n";}
+    else{results << "test_recursive_coordinate_bisection & False\\\\\n\\hline\n";}
+    
+    return 1;
+}
+
+bool is_ordering(const std::vector< unsigned int > &order, const unsigned int &n){
+    /*!Check that order contains each of 0 to n-1 exactly once*/
+    std::vector< unsigned int > sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    bool result = (sorted.size()==n);
+    for(unsigned int i=0; result && (i<n); i++){result = (sorted[i]==i);}
+    return result;
+}
+
+int test_node_orderings(std::ofstream &results){
+    /*!=============================
+    |    test_node_orderings    |
+    =============================
+    
+    Test that reverse Cuthill-McKee reduces the 
+    bandwidth of a scrambled numbering of the 
+    nodes of a cube mesh and recovers the band 
+    of a path and that the Morton ordering of 
+    the corners of a cube is the z-order.
+    
+    */
+    
+    bool result = true;
+    
+    std::vector< std::array< double, 3 > > centroids;
+    std::vector< std::vector< unsigned int > > element_nodes;
+    unsigned int num_nodes;
+    cube_mesh(4, centroids, element_nodes, num_nodes);
+    
+    //Scramble the node numbers (37 and the 125 nodes are coprime)
+    std::vector< std::vector< unsigned int > > adjacency(num_nodes);
+    for(unsigned int e=0; e<element_nodes.size(); e++){
+        for(unsigned int a=0; a<element_nodes[e].size(); a++){
+            for(unsigned int b=0; b<element_nodes[e].size(); b++){
+                unsigned int na = (37*element_nodes[e][a])%num_nodes;
+                unsigned int nb = (37*element_nodes[e][b])%num_nodes;
+                if((a!=b) && (std::find(adjacency[na].begin(), adjacency[na].end(), nb)==adjacency[na].end())){adjacency[na].push_back(nb);}
+            }
+        }
+    }
+    
+    std::vector< unsigned int > identity(num_nodes);
+    for(unsigned int n=0; n<num_nodes; n++){identity[n] = n;}
+    
+    std::vector< unsigned int > order = domain_decomposition::reverse_cuthill_mckee(adjacency);
+    result = result && is_ordering(order, num_nodes);
+    result = result && (domain_decomposition::bandwidth(adjacency, order) < domain_decomposition::bandwidth(adjacency, identity));
+    
+    //A path numbered from the middle out has a bandwidth of one after reordering
+    std::vector< std::vector< unsigned int > > path(7);
+    unsigned int path_nodes[7] = {6, 4, 2, 0, 1, 3, 5};
+    for(int i=0; i<6; i++){
+        path[path_nodes[i]].push_back(path_nodes[i+1]);
+        path[path_nodes[i+1]].push_back(path_nodes[i]);
+    }
+    order = domain_decomposition::reverse_cuthill_mckee(path);
+    result = result && is_ordering(order, 7) && (domain_decomposition::bandwidth(path, order)==1);
+    
+    //The corners of a cube given in reverse z-order
+    std::vector< std::array< double, 3 > > corners(8);
+    for(unsigned int c=0; c<8; c++){
+        unsigned int z = 7-c;
+        corners[c] = { {double(z%2), double((z/2)%2), double(z/4)} };
+    }
+    order = domain_decomposition::morton_order(corners);
+    for(unsigned int c=0; c<8; c++){result = result && (order[c]==7-c);}
+    
+    if(result){results << "test_node_orderings & True\\\\\n\\hline\n";}
+    else{results << "test_node_orderings & False\\\\\n\\hline\n";}
+    
+    return 1;
+}
+
+int test_build(std::ofstream &results){
+    /*!====================
+    |    test_build    |
+    ====================
+    
+    Test the ownership of the nodes and that the 
+    exchange lists of the ranks are consistent i.e. 
+    the nodes a rank sends to a neighbor are the 
+    nodes the neighbor receives from it.
+    
+    */
+    
+    std::vector< std::array< double, 3 > > centroids;
+    std::vector< std::vector< unsigned int > > element_nodes;
+    unsigned int num_nodes;
+    cube_mesh(4, centroids, element_nodes, num_nodes);
+    
+    const unsigned int size = 4;
+    std::vector< domain_decomposition::Decomposition > ranks;
+    for(unsigned int r=0; r<size; r++){
+        ranks.push_back(domain_decomposition::Decomposition(r,size));
+        ranks[r].build(centroids, element_nodes, num_nodes);
+    }
+    
+    bool result = true;
+    
+    //Every rank forms the same partition
+    for(unsigned int r=1; r<size; r++){
+        result = result && (ranks[r].element_rank==ranks[0].element_rank) && (ranks[r].node_owner==ranks[0].node_owner);
+    }
+    
+    //The owner of each node is the lowest rank with one of its elements
+    std::vector< unsigned int > expected_owner(num_nodes,size);
+    for(unsigned int e=0; e<element_nodes.size(); e++){
+        for(unsigned int n=0; n<8; n++){
+            expected_owner[element_nodes[e][n]] = std::min(expected_owner[element_nodes[e][n]], ranks[0].element_rank[e]);
+        }
+    }
+    result = result && (expected_owner==ranks[0].node_owner);
+    
+    //The exchange lists are consistent
+    unsigned int nexchanged = 0;
+    for(unsigned int r=0; r<size; r++){
+        for(unsigned int i=0; i<ranks[r].neighbors.size(); i++){
+            const domain_decomposition::Decomposition &neighbor = ranks[ranks[r].neighbors[i]];
+            std::vector< unsigned int >::const_iterator it = std::find(neighbor.neighbors.begin(), neighbor.neighbors.end(), r);
+            if(it==neighbor.neighbors.end()){result = false; continue;}
+            unsigned int j = it - neighbor.neighbors.begin();
+            result = result && (ranks[r].send_nodes[i]==neighbor.recv_nodes[j]) && (ranks[r].recv_nodes[i]==neighbor.send_nodes[j]);
+            for(unsigned int k=0; k<ranks[r].send_nodes[i].size(); k++){
+                result = result && ranks[r].owns_node(ranks[r].send_nodes[i][k]);
+            }
+            nexchanged += ranks[r].send_nodes[i].size();
+        }
+    }
+    
+    //The ranks share the nodes on the interfaces of the parts
+    result = result && (nexchanged>0);
+    
+    //Without neighbors the exchanges do nothing
+    domain_decomposition::Decomposition single;
+    single.build(centroids, element_nodes, num_nodes);
+    std::vector< double > values(num_nodes,1.);
+    single.update_ghosts(values,1);
+    single.accumulate_ghosts(values,1);
+    single.gather(values,1);
+    double total = 2.;
+    single.sum(&total,1);
+    double largest = 3.;
+    single.maximum(&largest,1);
+    result = result && (single.neighbors.size()==0) && (values==std::vector< double >(num_nodes,1.)) && (total==2.) && (largest==3.);
+    
+    if(result){results << "test_build & True\\\\\n\\hline\n";}
+    else{results << "test_build & False\\\\\n\\hline\n";}
+    
+    return 1;
+}
+
+int main(){
+    /*!==============================
+    |         main              |
+    ==============================
+    
+    The main loop which runs the tests defined in the 
+    accompanying functions. Each function should output 
+    the function name followed by & followed by True or
+    False if the test passes or fails respectively.
+    
+    */
+    
+    std::ofstream results;
+    //Open the results file
+    results.open ("results.tex");
+    
+    test_recursive_coordinate_bisection(results);
+    test_node_orderings(results);
+    test_build(results);
+    
+    //Close the results file
+    results.close();
+}
@@ -0,0 +1,223 @@
+/*!=======================================================
+  |                                                     |
+  |                  test_driver.cpp                    |
+  |                                                     |
+  -------------------------------------------------------
+  | The unit test file for driver.h/cpp.                |
+  | This file tests the solver methods of the           |
+  | FEAModel defined in driver.h/cpp.                   |
+  |                                                     |
+  | Generated files:                                    |
+  |    Results.tex:  A LaTeX file which contains the    |
+  |                  results as they will be included   |
+  |                  in the generated report.           |
+  =======================================================
+  | Dependencies:                                       |
+  | Eigen:  An implementation of various matrix         |
+  |         commands. The sparse jacobian of the model  |
+  |         uses such a matrix.                         |
+  =======================================================*/
+  
+#include <iostream>
+#include <fstream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+#include <tensor.h>
+#include <micro_element.h>
+#include <newton_krylov.h>
+#include <driver.h>
+
+//!The deck of the linear displacement manufactured solution
+const std::string linear_u_deck = "../regression_tests/linear_u/linear_u.inp";
+
+bool vectors_equal(const std::vector< double > &a, const std::vector< double > &b){
+    /*!Check if two vectors are identical*/
+
+    if(a.size()!=b.size()){return false;}
+    for(int i=0; i<a.size(); i++){
+        if(a[i]!=b[i]){return false;}
+    }
+    return true;
+}
+
+bool state_variables_equal(const FEAModel &FM, const double offset){
+    /*!Check if the committed state variables of every gauss point are the element number plus the offset*/
+
+    for(unsigned int e=0; e<FM.state_variables.num_elements(); e++){
+        for(unsigned int g=0; g<FM.state_variables.num_gauss_points(); g++){
+            for(unsigned int i=0; i<FM.state_variables.num_sdvs(); i++){
+                if(FM.state_variables.committed(e, g, i)!=e+offset){return false;}
+            }
+        }
+    }
+    return true;
+}
+
+int test_adaptive_timestep(std::ofstream &results){
+    /*!==================================
+    |    test_adaptive_timestep    |
+    ==================================
+
+    Test the adaptive timestep control of the
+    solver. An increment which is limited to a
+    single Newton iteration fails, it should be
+    rolled back to the last converged state and
+    the timestep should be cut back. The retried
+    increment converges quickly so the timestep
+    should grow. The state variables of the failed
+    increment are discarded and those of the
+    converged increment are committed.*/
+
+    int  test_num        = 10;
+    std::vector<bool> test_results(test_num,false);
+
+    InputParser IP(linear_u_deck);
+    IP.read_input();
+    IP.num_sdvs = 2;
+    FEAModel FM = FEAModel(IP);
+    FM.adaptive_timestep = true;
+
+    //!Set the initial state variables of each element to the element number
+    for(unsigned int e=0; e<FM.state_variables.num_elements(); e++){
+        for(unsigned int g=0; g<FM.state_variables.num_gauss_points(); g++){
+            FM.state_variables.set_committed(e, g, std::vector< double >(2, e+0.5));
+        }
+    }
+
+    const double dt0 = FM.input.dt;
+    const std::vector< double > u0 = FM.u;
+
+    //!Force a failed increment by only allowing a single Newton iteration
+    FM.krylov_maxiter = 1;
+    FM.input.t        = FM.input.tp+FM.input.dt;
+    FM.apply_manufactured_solution();
+
+    bool converged = FM.increment_solution();
+
+    test_results[0] = !converged && !vectors_equal(FM.u, u0);
+
+    //!Change a trial state variable of the failed increment
+    FM.state_variables.trial(0, 0, 0) = -1.;
+
+    //!The failed increment should be rolled back and the timestep cut back
+    bool proceed = FM.advance_timestep(converged);
+
+    test_results[1] = proceed && vectors_equal(FM.u, u0) && vectors_equal(FM.up, u0);
+    test_results[2] = (FM.input.dt == FM.cutback_factor*dt0) && (FM.input.t == FM.input.tp+FM.input.dt)
+                      && (FM.input.tp == 0.);
+    test_results[3] = FM.increment_number == 0;
+
+    //!The retried increment should converge quickly and the timestep grow
+    FM.krylov_maxiter = 10;
+    FM.apply_manufactured_solution();
+
+    const double t1 = FM.input.t;
+    converged = FM.increment_solution();
+
+    test_results[4] = converged && (FM.newton_iterations<=FM.fast_iterations);
+    test_results[5] = FM.increment_number == 1;
+
+    proceed = FM.advance_timestep(converged);
+
+    test_results[6] = proceed && vectors_equal(FM.up, FM.u) && !vectors_equal(FM.u, u0);
+    test_results[7] = (FM.input.tp == t1) && (FM.input.dt == FM.growth_factor*FM.cutback_factor*dt0)
+                      && (FM.input.t == FM.input.tp+FM.input.dt);
+
+    //!The elements carry their state variables over so the committed values are unchanged
+    test_results[8] = (FM.state_variables.num_elements()==FM.mapped_elements.size())
+                      && (FM.state_variables.num_gauss_points()==8) && (FM.state_variables.num_sdvs()==2);
+    test_results[9] = state_variables_equal(FM, 0.5);
+
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        //std::cout << "\nSub-test " << i+1 << " result: " << test_results[i] << "\n";
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+
+    if(tot_result){
+        results << "test_adaptive_timestep & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_adaptive_timestep & False\\\\\n\\hline\n";
+    }
+    return 1;
+}
+
+int test_fixed_timestep(std::ofstream &results){
+    /*!===============================
+    |    test_fixed_timestep    |
+    ===============================
+
+    Test that the timestep is fixed by default.
+    A converged increment should not change the
+    timestep and a failed increment should end
+    the solve.*/
+
+    int  test_num        = 3;
+    std::vector<bool> test_results(test_num,false);
+
+    InputParser IP(linear_u_deck);
+    IP.read_input();
+    FEAModel FM = FEAModel(IP);
+
+    const double dt0 = FM.input.dt;
+
+    test_results[0] = !FM.adaptive_timestep;
+
+    FM.input.t = FM.input.tp+FM.input.dt;
+    FM.apply_manufactured_solution();
+
+    bool converged = FM.increment_solution();
+    test_results[1] = converged && FM.advance_timestep(converged) && (FM.input.dt == dt0);
+
+    //!Force a failed increment by only allowing a single Newton iteration
+    FM.krylov_maxiter = 1;
+    FM.apply_manufactured_solution();
+
+    converged = FM.increment_solution();
+    test_results[2] = !converged && !FM.advance_timestep(converged) && (FM.input.dt == dt0);
+
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        //std::cout << "\nSub-test " << i+1 << " result: " << test_results[i] << "\n";
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+
+    if(tot_result){
+        results << "test_fixed_timestep & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_fixed_timestep & False\\\\\n\\hline\n";
+    }
+    return 1;
+}
+
+int main(){
+    /*!==========================
+    |         main            |
+    ===========================
+
+    The main loop which runs the tests defined in the
+    accompanying functions. Each function should output
+    the function name followed by & followed by True or
+    False if the test passes or fails respectively.*/
+
+    std::ofstream results;
+    //Open the results file
+    results.open ("results.tex");
+
+    //!Run the test functions
+    test_adaptive_timestep(results);
+    test_fixed_timestep(results);
+
+    //Close the results file
+    results.close();
+}
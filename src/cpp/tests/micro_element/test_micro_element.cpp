@@ -24,14 +24,18 @@
 #include <functional>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <numeric>
 #include <vector>
 #include <Eigen/Dense>
 #include <tensor.h>
 #include <micro_element.h>
 #include <finite_difference.h>
+#include <instrumentation.h>
 #include <ctime>
 #include <stdlib.h>
+#include <cstdio>
+#include <algorithm>
 
 void print_vector(std::string name, std::vector< double > V){
     /*!======================
@@ -263,6 +267,149 @@ int test_constructors(std::ofstream &results){
     return 1;
 }
 
+int test_reset(std::ofstream &results){
+    /*!====================
+    |    test_reset    |
+    ====================
+    
+    Run tests on the reset of an element to 
+    ensure that it results in the same element 
+    as the constructor.
+    
+    */
+    
+    //Seed the random number generator
+    srand (1);
+    
+    //!Initialize test results
+    int  test_num        = 4;
+    std::vector<bool> test_results(test_num,false);
+    
+    //!Form the required vectors
+    std::vector< double > reference_coords = {0,0,0,1,0,0,1,1,0,0,1,0,0,0,1,1,0,1,1,1,1,0,1,1};
+    std::vector< double > U;
+    std::vector< double > dU;
+    U.resize(96);
+    dU.resize(96);
+    
+    //!Reset a default element multiple times
+    micro_element::Hex8 A = micro_element::Hex8();
+    
+    for(int k=0; k<2; k++){
+        for(int i=0; i<96; i++){
+            U[i]  = (rand()%100-50)/1000.;
+            dU[i] = (rand()%100-50)/10000.;
+        }
+        A.reset(reference_coords,U,dU);
+    }
+    
+    //!Construct the element with the final values
+    micro_element::Hex8 B = micro_element::Hex8(reference_coords,U,dU);
+    
+    test_results[0] = (A.reference_coords == B.reference_coords) && (A.current_coords == B.current_coords);
+    test_results[1] = (A.dof_at_nodes == B.dof_at_nodes) && (A.Delta_dof_at_nodes == B.Delta_dof_at_nodes);
+    
+    test_results[2] = true;
+    for(int n=0; n<8; n++){
+        test_results[2] = test_results[2] * (A.node_phis[n].data == B.node_phis[n].data);
+    }
+    
+    test_results[3] = (A.RHS == B.RHS) && (A.AMATRX == B.AMATRX);
+    
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+    
+    if(tot_result){
+        results << "test_reset & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_reset & False\\\\\n\\hline\n";
+    }
+    
+    return 1;
+}
+
+int test_shape_function_cache(std::ofstream &results){
+    /*!===================================
+    |    test_shape_function_cache    |
+    ===================================
+    
+    Run tests on the shape function cache to 
+    ensure that an element using the cache 
+    produces the same shape function values 
+    as one computing them directly.
+    
+    */
+    
+    //Seed the random number generator
+    srand (1);
+    
+    //!Initialize test results
+    int  test_num        = 5;
+    std::vector<bool> test_results(test_num,true);
+    
+    //!Form the required vectors
+    std::vector< double > reference_coords = {0,0,0,1,0,0,1,1,0,0,1,0,0,0,1,1,0,1,1,1,1,0,1,1};
+    std::vector< double > U;
+    std::vector< double > dU;
+    U.resize(96);
+    dU.resize(96);
+    
+    for(int i=0; i<24; i++){
+        reference_coords[i] += (rand()%100-50)/1000.;
+    }
+    
+    for(int i=0; i<96; i++){
+        U[i]  = (rand()%100-50)/1000.;
+        dU[i] = (rand()%100-50)/10000.;
+    }
+    
+    micro_element::Hex8 A = micro_element::Hex8(reference_coords,U,dU);
+    micro_element::Hex8 B = micro_element::Hex8(reference_coords,U,dU);
+    
+    micro_element::ShapeFunctionCache cache;
+    B.build_shape_function_cache(cache);
+    B.set_shape_function_cache(&cache);
+    
+    test_results[0] = cache.is_set && (cache.Ns.size() == 8);
+    
+    for(int i=0; i<8; i++){
+        A.set_gpt_num(i);
+        B.set_gpt_num(i);
+        A.update_shape_function_values();
+        B.update_shape_function_values();
+        
+        for(int n=0; n<8; n++){
+            test_results[1] = test_results[1] * (A.get_N(n)       == B.get_N(n));
+            test_results[2] = test_results[2] * (A.get_dNdxi(n)   == B.get_dNdxi(n));
+            test_results[3] = test_results[3] * (A.get_dNdx(0,n)  == B.get_dNdx(0,n));
+            test_results[4] = test_results[4] * (A.get_dNdx(1,n)  == B.get_dNdx(1,n));
+        }
+    }
+    
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+    
+    if(tot_result){
+        results << "test_shape_function_cache & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_shape_function_cache & False\\\\\n\\hline\n";
+    }
+    
+    return 1;
+}
+
 int test_shape_functions(std::ofstream &results){
     /*!==============================
     |    test_shape_functions    |
@@ -2478,6 +2625,500 @@ int test_integrate_element(std::ofstream &results){
     return 1;
 }
 
+int test_integrate_element_parallel(std::ofstream &results){
+    /*!=========================================
+    |    test_integrate_element_parallel    |
+    =========================================
+    
+    Run tests on the integration of the 
+    finite element with the gauss points 
+    evaluated on a thread pool. The result 
+    should match the serial integration and 
+    be identical between repeated evaluations.
+    
+    */
+    
+    //Seed the random number generator
+    srand (1);
+    
+    //!Initialize test results
+    int  test_num        = 6;
+    std::vector<bool> test_results(test_num,true);
+    
+    //!Initialize the floating point parameters
+    std::vector< double > fparams(19,0.);
+    
+    fparams[0] = 1000.;
+    
+    for(int i=1; i<19; i++){
+        fparams[i] = 0.1*(i+1);
+    }
+    
+    //!Form the required vectors for element formation
+    std::vector< double > reference_coords = {0,0,0,1,0,0,1,1,0,0,1,0,0.1,-0.2,1,1.1,-0.2,1.1,1.1,0.8,1.1,0.1,0.8,1};
+    std::vector< double > U(96,0.);
+    std::vector< double > dU(96,0.);
+    
+    for(int i=0; i<96; i++){
+        U[i]  = (rand()%100-50)/1000.;
+        dU[i] = 0.1*U[i];
+    }
+    
+    micro_element::Hex8 serial   = micro_element::Hex8(reference_coords,U,dU,fparams);
+    micro_element::Hex8 parallel = micro_element::Hex8(reference_coords,U,dU,fparams);
+    micro_element::Hex8 repeated = micro_element::Hex8(reference_coords,U,dU,fparams);
+    
+    micro_element::GaussPointPool pool(3);
+    micro_element::GaussPointPool empty_pool;
+    
+    serial.integrate_element(true);
+    parallel.integrate_element(pool, true);
+    repeated.integrate_element(pool, true);
+    
+    double tol = 1e-9;
+    
+    test_results[0] = (pool.size()==3) && (empty_pool.size()==0);
+    test_results[1] = (serial.RHS - parallel.RHS).norm() < tol*(1+serial.RHS.norm());
+    test_results[2] = (serial.AMATRX - parallel.AMATRX).norm() < tol*(1+serial.AMATRX.norm());
+    test_results[3] = (parallel.RHS == repeated.RHS) && (parallel.AMATRX == repeated.AMATRX);
+    
+    for(int i=0; i<8; i++){
+        test_results[4] = test_results[4] * (serial.PK2[i].data   == parallel.PK2[i].data);
+        test_results[4] = test_results[4] * (serial.SIGMA[i].data == parallel.SIGMA[i].data);
+        test_results[4] = test_results[4] * (serial.M[i].data     == parallel.M[i].data);
+    }
+    
+    //!A pool without workers falls back to the serial integration
+    micro_element::Hex8 fallback = micro_element::Hex8(reference_coords,U,dU,fparams);
+    fallback.integrate_element(empty_pool, true);
+    test_results[5] = (fallback.RHS == serial.RHS) && (fallback.AMATRX == serial.AMATRX);
+    
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+    
+    if(tot_result){
+        results << "test_integrate_element_parallel & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_integrate_element_parallel & False\\\\\n\\hline\n";
+    }
+    
+    return 1;
+}
+
+int test_quadrature_rules(std::ofstream &results){
+    /*!===============================
+    |    test_quadrature_rules    |
+    ===============================
+    
+    Run tests on the selectable quadrature rules 
+    and the hourglass control of the single point 
+    rule.
+    
+    */
+    
+    //!Initialize test results
+    int  test_num        = 6;
+    std::vector<bool> test_results(test_num,true);
+    
+    //!Initialize the floating point parameters
+    std::vector< double > fparams(19,0.);
+    
+    fparams[0] = 1000.;
+    
+    for(int i=1; i<19; i++){
+        fparams[i] = 0.1*(i+1);
+    }
+    
+    double tol = 1e-9;
+    
+    //!The full rule reproduces the default quadrature
+    micro_element::Hex8 element;
+    std::vector< std::vector< double > > default_points  = element.points;
+    std::vector< double >                default_weights = element.weights;
+    
+    element.set_quadrature_rule(2);
+    test_results[0] = (element.number_gauss_points==8) && (element.points==default_points) && (element.weights==default_weights);
+    
+    //!The weights of every rule sum to the volume of the parent element
+    for(int order=1; order<4; order++){
+        element.set_quadrature_rule(order);
+        double total_weight = 0;
+        for(int i=0; i<element.number_gauss_points; i++){total_weight += element.weights[i];}
+        test_results[1] = test_results[1] * (element.number_gauss_points==order*order*order) && (element.PK2.size()==order*order*order) && (fabs(total_weight-8)<tol);
+    }
+    
+    //!A homogeneous deformation of a parallelepiped is integrated exactly by all of the rules
+    std::vector< double > reference_coords = {0,0,0,1,0,0,1.2,1,0,0.2,1,0,0.1,0.3,1,1.1,0.3,1,1.3,1.3,1,0.3,1.3,1};
+    std::vector< double > U(96,0.);
+    std::vector< double > dU(96,0.);
+    
+    for(int n=0; n<8; n++){
+        const double *X = &reference_coords[3*n];
+        for(int i=0; i<3; i++){
+            U[i+12*n] = 0.01*(i+1)*X[0] - 0.02*X[1] + 0.005*(i+2)*X[2];
+        }
+        for(int i=3; i<12; i++){
+            U[i+12*n] = 0.001*i;
+        }
+    }
+    
+    std::vector< micro_element::Hex8 > elements(3);
+    for(int order=1; order<4; order++){
+        elements[order-1] = micro_element::Hex8(reference_coords,U,dU,fparams);
+        elements[order-1].set_quadrature_rule(order);
+        elements[order-1].integrate_element();
+    }
+    
+    test_results[2] = ((elements[0].RHS - elements[1].RHS).norm() < 1e-6*(1+elements[1].RHS.norm())) &&
+                      ((elements[2].RHS - elements[1].RHS).norm() < 1e-6*(1+elements[1].RHS.norm()));
+    
+    //!The hourglass control does not resist the homogeneous deformation
+    micro_element::Hex8 homogeneous = micro_element::Hex8(reference_coords,U,dU,fparams);
+    homogeneous.set_quadrature_rule(1);
+    homogeneous.hourglass_coefficient = 0;
+    homogeneous.integrate_element();
+    
+    bool homogeneous_result = (elements[0].RHS - homogeneous.RHS).norm() < tol*(1+homogeneous.RHS.norm());
+    
+    //!An hourglass pattern is resisted by the stabilization and the stiffness is consistent with the forces
+    for(int n=0; n<8; n++){
+        const std::vector< double > &xi = element.local_coords[n];
+        for(int i=0; i<12; i++){
+            U[i+12*n] = 0.01*xi[0]*xi[1] + 0.002*i*xi[0]*xi[1]*xi[2];
+        }
+    }
+    
+    micro_element::Hex8 stabilized   = micro_element::Hex8(reference_coords,U,dU,fparams);
+    micro_element::Hex8 unstabilized = micro_element::Hex8(reference_coords,U,dU,fparams);
+    
+    stabilized.set_quadrature_rule(1);
+    unstabilized.set_quadrature_rule(1);
+    unstabilized.hourglass_coefficient = 0;
+    
+    stabilized.integrate_element(true);
+    unstabilized.integrate_element(true);
+    
+    Eigen::VectorXd U_vector = Eigen::Map< Eigen::VectorXd >(U.data(),96);
+    Eigen::VectorXd hourglass_RHS    = stabilized.RHS - unstabilized.RHS;
+    Eigen::MatrixXd hourglass_AMATRX = stabilized.AMATRX - unstabilized.AMATRX;
+    
+    test_results[3] = (hourglass_RHS.norm() > 1e-6) && ((hourglass_RHS - hourglass_AMATRX*U_vector).norm() < tol*(1+hourglass_RHS.norm()));
+    
+    //!The hourglass stiffness is symmetric
+    test_results[4] = homogeneous_result && ((hourglass_AMATRX - hourglass_AMATRX.transpose()).norm() < tol*(1+hourglass_AMATRX.norm()));
+    
+    //!The rule can be selected through the integer properties (JPROPS)
+    micro_element::Hex8 from_iparams = micro_element::Hex8(reference_coords,U,dU,fparams,{1,100});
+    from_iparams.set_quadrature_from_iparams();
+    test_results[5] = (from_iparams.quadrature_order==1) && (from_iparams.number_gauss_points==1) && (fabs(from_iparams.hourglass_coefficient-0.1)<tol);
+    
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+    
+    if(tot_result){
+        results << "test_quadrature_rules & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_quadrature_rules & False\\\\\n\\hline\n";
+    }
+    
+    return 1;
+}
+
+int test_lumped_mass(std::ofstream &results){
+    /*!==========================
+    |    test_lumped_mass    |
+    ==========================
+    
+    Run tests on the lumped mass of the
+    element used in explicit dynamics.
+    
+    */
+    
+    //!Initialize test results
+    int  test_num        = 4;
+    std::vector<bool> test_results(test_num,true);
+    
+    //!Initialize the floating point parameters
+    std::vector< double > fparams(19,0.);
+    
+    fparams[0] = 1000.;
+    
+    for(int i=1; i<19; i++){
+        fparams[i] = 0.1*(i+1);
+    }
+    
+    double tol = 1e-9;
+    
+    //!Form the required vectors for element formation
+    std::vector< double > reference_coords = {0,0,0,1,0,0,1,1,0,0,1,0,0.1,-0.2,1,1.1,-0.2,1.1,1.1,0.8,1.1,0.1,0.8,1};
+    std::vector< double > Unode;
+    std::vector< double > Xnode(3,0.);
+    std::vector< double > U(96,0.);
+    std::vector< double > dU(96,0.);
+    for(int n=0; n<8; n++){
+        for(int i=0; i<3; i++){Xnode[i] = reference_coords[i+n*3];}
+        Unode = test_deformation(Xnode);
+        for(int i=0; i<12; i++){
+            U[i+n*12]  = Unode[i];
+            dU[i+n*12] = 0.1*Unode[i];
+        }
+    }
+    
+    //!The row-sum lumping is the sum of the rows of the consistent mass matrix
+    micro_element::Hex8 consistent = micro_element::Hex8(reference_coords,U,dU,fparams);
+    consistent.integrate_element(false,true,true);
+    
+    micro_element::Hex8 element = micro_element::Hex8(reference_coords,U,dU,fparams);
+    element.set_lumped_mass();
+    Vector row_sum = element.lumped_mass;
+    
+    test_results[0] = (row_sum.size()==96) && ((row_sum - consistent.AMATRX.rowwise().sum()).norm() < tol*row_sum.norm());
+    
+    //!The HRZ lumping conserves the mass of the element and is positive
+    double total_mass = 0;
+    for(int i=0; i<8; i++){total_mass += consistent.mini_mass.row(i).sum();}
+    
+    element.set_lumped_mass(true);
+    double hrz_mass = 0;
+    for(int n=0; n<8; n++){
+        hrz_mass += element.lumped_mass(12*n);
+        test_results[1] = test_results[1] && (element.lumped_mass(12*n)>0);
+    }
+    test_results[1] = test_results[1] && (fabs(hrz_mass - total_mass) < tol*total_mass) && ((element.lumped_mass - row_sum).norm() > tol*row_sum.norm());
+    
+    //!The micro displacement degrees of freedom are scaled by the diagonal of the micro-inertia
+    //!(11,22,33,23,13,12,32,31,21)
+    micro_element::Hex8 inertia = micro_element::Hex8(reference_coords,U,dU,fparams);
+    inertia.reference_micro_inertia = {2,0.1,0.2,0.1,3,0.3,0.2,0.3,4};
+    inertia.set_lumped_mass();
+    double scales[9] = {2,3,4,4,4,3,3,2,2};
+    for(int n=0; n<8; n++){
+        for(int k=0; k<3; k++){
+            test_results[2] = test_results[2] && (fabs(inertia.lumped_mass(k+12*n) - row_sum(k+12*n)) < tol*row_sum(12*n));
+        }
+        for(int k=0; k<9; k++){
+            test_results[2] = test_results[2] && (fabs(inertia.lumped_mass(k+3+12*n) - scales[k]*row_sum(12*n)) < tol*row_sum(12*n));
+        }
+    }
+    
+    //!The shape function cache and the quadrature rule do not change the mass of the element
+    micro_element::ShapeFunctionCache cache;
+    micro_element::Hex8 cached = micro_element::Hex8(reference_coords,U,dU,fparams);
+    cached.build_shape_function_cache(cache);
+    cached.set_shape_function_cache(&cache);
+    cached.set_lumped_mass();
+    test_results[3] = ((cached.lumped_mass - row_sum).norm() < tol*row_sum.norm());
+    
+    for(int order=1; order<4; order++){
+        micro_element::Hex8 rule = micro_element::Hex8(reference_coords,U,dU,fparams);
+        rule.set_quadrature_rule(order);
+        rule.set_lumped_mass(true);
+        double rule_mass = 0;
+        for(int n=0; n<8; n++){rule_mass += rule.lumped_mass(12*n);}
+        test_results[3] = test_results[3] && (fabs(rule_mass - total_mass) < tol*total_mass);
+    }
+    
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+    
+    if(tot_result){
+        results << "test_lumped_mass & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_lumped_mass & False\\\\\n\\hline\n";
+    }
+    
+    return 1;
+}
+
+int test_stress_writer(std::ofstream &results){
+    /*!============================
+    |    test_stress_writer    |
+    ============================
+    
+    Run tests on the binary stress writer to 
+    ensure that the records written by several 
+    threads are all in the output file.
+    
+    */
+    
+    //!Initialize test results
+    int  test_num        = 4;
+    std::vector<bool> test_results(test_num,true);
+    
+    std::string filename = "test_stress_writer.stress";
+    std::remove(filename.c_str());
+    
+    int num_threads = 3;
+    int num_calls   = 50;
+    
+    {
+        micro_element::StressWriter writer(filename, 7);
+        
+        std::vector< std::thread > threads;
+        for(int t=0; t<num_threads; t++){
+            threads.push_back(std::thread([&writer, t, num_calls]{
+                micro_element::StressRecord records[8];
+                for(int k=0; k<num_calls; k++){
+                    for(int g=0; g<8; g++){
+                        records[g].element     = t;
+                        records[g].step        = 1;
+                        records[g].increment   = k;
+                        records[g].gauss_point = g;
+                        for(int j=0; j<9;  j++){records[g].PK2[j]   = t + 0.01*k + 0.0001*g;}
+                        for(int j=0; j<6;  j++){records[g].SIGMA[j] = j;}
+                        for(int j=0; j<27; j++){records[g].M[j]     = j;}
+                    }
+                    writer.write(records, 8);
+                }
+            }));
+        }
+        for(int t=0; t<num_threads; t++){threads[t].join();}
+    }
+    
+    //!Read the file back
+    std::ifstream f(filename, std::ios::binary);
+    
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    f.read(magic, 8);
+    f.read((char*)&version,     sizeof(version));
+    f.read((char*)&record_size, sizeof(record_size));
+    
+    test_results[0] = (std::string(magic,8) == "MICROSTR") && (version == 1) && (record_size == sizeof(micro_element::StressRecord));
+    
+    std::vector< int > counts(num_threads*num_calls*8, 0);
+    uint64_t num_records;
+    int      total = 0;
+    
+    while(f.read((char*)&num_records, sizeof(num_records))){
+        test_results[1] = test_results[1] && (num_records>0);
+        
+        for(uint64_t i=0; i<num_records; i++){
+            micro_element::StressRecord record;
+            f.read((char*)&record, sizeof(record));
+            
+            counts[record.gauss_point + 8*(record.increment + num_calls*record.element)]++;
+            test_results[2] = test_results[2] && (record.PK2[4] == record.element + 0.01*record.increment + 0.0001*record.gauss_point);
+            total++;
+        }
+    }
+    f.close();
+    std::remove(filename.c_str());
+    
+    test_results[3] = (total == num_threads*num_calls*8) && (*std::min_element(counts.begin(), counts.end()) == 1);
+    
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+    
+    if(tot_result){
+        results << "test_stress_writer & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_stress_writer & False\\\\\n\\hline\n";
+    }
+    
+    return 1;
+}
+
+int test_instrumentation(std::ofstream &results){
+    /*!==============================
+    |    test_instrumentation    |
+    ==============================
+    
+    Run tests on the hot path counters to ensure 
+    that the counts recorded by several threads, 
+    including threads which have exited, are 
+    merged into the summary.
+    
+    */
+    
+    //!Initialize test results
+    int  test_num        = 4;
+    std::vector<bool> test_results(test_num,true);
+    
+    #ifdef MICROMORPHIC_INSTRUMENTATION
+    int num_threads = 3;
+    int num_calls   = 100;
+    
+    std::vector< std::thread > threads;
+    for(int t=0; t<num_threads; t++){
+        threads.push_back(std::thread([num_calls]{
+            for(int i=0; i<num_calls; i++){
+                MICROMORPHIC_TIME_SCOPE("test timer");
+                MICROMORPHIC_COUNT("test counter",2);
+            }
+        }));
+    }
+    for(int t=0; t<num_threads; t++){threads[t].join();}
+    
+    //!A thread which is still running
+    for(int i=0; i<num_calls; i++){
+        MICROMORPHIC_TIME_SCOPE_DYNAMIC(std::string("test ") + "timer");
+    }
+    
+    std::vector< instrumentation::Totals > totals = instrumentation::Registry::get().totals();
+    
+    int timer   = -1;
+    int counter = -1;
+    for(unsigned int i=0; i<totals.size(); i++){
+        if(totals[i].name == "test timer"){timer = i;}
+        if(totals[i].name == "test counter"){counter = i;}
+    }
+    
+    test_results[0] = (timer>=0) && (counter>=0);
+    
+    if(test_results[0]){
+        test_results[1] = totals[timer].count == (unsigned long long)((num_threads+1)*num_calls);
+        test_results[2] = (totals[counter].count == (unsigned long long)(2*num_threads*num_calls)) && (totals[counter].nanoseconds == 0);
+    }
+    
+    std::stringstream json;
+    instrumentation::Registry::get().write_json(json);
+    test_results[3] = json.str().find("\"test timer\": {\"count\": " + std::to_string((num_threads+1)*num_calls)) != std::string::npos;
+    #endif
+    
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+    
+    if(tot_result){
+        results << "test_instrumentation & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_instrumentation & False\\\\\n\\hline\n";
+    }
+    
+    return 1;
+}
+
 int main(){
     /*!==========================
     |         main            |
@@ -2494,7 +3135,9 @@ int main(){
     
     //!Run the test functions
     test_constructors(results);
+    test_reset(results);
     test_shape_functions(results);
+    test_shape_function_cache(results);
     test_mass_matrix(results);
     test_fundamental_measures(results);
     test_deformation_measures(results);
@@ -2502,6 +3145,11 @@ int main(){
     test_balance_of_linear_momentum(results);
     test_balance_of_first_moment_of_momentum(results);
     test_integrate_element(results);
+    test_integrate_element_parallel(results);
+    test_quadrature_rules(results);
+    test_lumped_mass(results);
+    test_stress_writer(results);
+    test_instrumentation(results);
     
     //Close the results file
     results.close();
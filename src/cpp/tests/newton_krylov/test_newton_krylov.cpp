@@ -55,6 +55,37 @@ std::vector<double> residual_function3(const std::vector<double> &x){
     return r;
 }
 
+std::vector<double> residual_function4(const std::vector<double> &x){
+    /*Residual function for a test linear problem with a 
+      badly scaled diagonal and a tridiagonal coupling*/
+    std::vector<double> r;
+    r.resize(x.size());
+    
+    for(int i=0; i<x.size(); i++){
+        r[i] = (i+1.)*x[i] - 1.;
+        if(i>0){r[i] -= 0.5*x[i-1];}
+        if(i<(x.size()-1)){r[i] -= 0.5*x[i+1];}
+    }
+    return r;
+}
+
+std::vector<double> residual_function5(const std::vector<double> &x){
+    /*Residual function for a test problem which cannot be 
+      evaluated at the root (the residual is not finite)*/
+    std::vector<double> r(1);
+    
+    r[0] = (x[0]<1.) ? x[0]-4. : NAN;
+    return r;
+}
+
+void jacobi_preconditioner4(const std::vector<double> &v, std::vector<double> &z){
+    /*The inverse of the diagonal of the jacobian of residual_function4*/
+    z.resize(v.size());
+    for(int i=0; i<v.size(); i++){
+        z[i] = v[i]/(i+1.);
+    }
+}
+
 void run_solver1(std::ofstream &results){
     /*Set initial vector*/
     std::vector< double> u;
@@ -136,6 +167,49 @@ void run_solver3(std::ofstream &results){
     else{results << "\ntest_newton_krylov_3 & False\\\\\n\\hline\n";}
 }
 
+void run_solver4(std::ofstream &results, bool precondition=false){
+    /*Run the linear problem which requires GMRES to be restarted
+      optionally with a right preconditioner*/
+    std::vector< double > u(30,0.);
+    bool test_result = true;
+    
+    krylov::Solver solver1 = krylov::Solver(residual_function4, u, 10, 5, false);
+    solver1.NKtol = 1e-9;
+    solver1.tol   = 1e-10;
+    solver1.rmax  = 50;
+    if(precondition){solver1.P_fxn = jacobi_preconditioner4;}
+    solver1.solve();
+    
+    //The workspace is sized once and reused by all of the iterations
+    test_result *= solver1.Q.size()==u.size()*(solver1.kmax+1);
+    test_result *= !solver1.inconv_flg;
+    
+    std::vector< double > r = residual_function4(solver1.u);
+    test_result *= 1e-6>solver1.vector_norm(r);
+    
+    if(precondition){
+        if(test_result){results << "test_newton_krylov_4_preconditioned & True\\\\\n\\hline\n";}
+        else{results << "\ntest_newton_krylov_4_preconditioned & False\\\\\n\\hline\n";}
+    }
+    else{
+        if(test_result){results << "test_newton_krylov_4 & True\\\\\n\\hline\n";}
+        else{results << "\ntest_newton_krylov_4 & False\\\\\n\\hline\n";}
+    }
+}
+
+void run_solver5(std::ofstream &results){
+    /*Run the problem with a residual which is not finite 
+      after the first iteration. The solver must report 
+      that it did not converge.*/
+    std::vector< double > u(1,0.);
+    
+    krylov::Solver solver1 = krylov::Solver(residual_function5, u, 10, 5, false);
+    solver1.solve();
+    
+    if(solver1.inconv_flg){results << "test_newton_krylov_5 & True\\\\\n\\hline\n";}
+    else{results << "\ntest_newton_krylov_5 & False\\\\\n\\hline\n";}
+}
+
 int main(){
     /*Main function for Newton-Krylov test*/
     
@@ -147,6 +221,9 @@ int main(){
     run_solver2(results,1);
     run_solver2(results,2);
     run_solver3(results);
+    run_solver4(results);
+    run_solver4(results,true);
+    run_solver5(results);
     
     //Close the results file
     results.close();
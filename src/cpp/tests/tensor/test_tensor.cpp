@@ -539,6 +539,103 @@ int test_operators(std::ofstream &results){
     return 1;
 }
 
+int test_fixed_tensor(std::ofstream &results){
+    /*!=================================
+    |       test_fixed_tensor       |
+    =================================
+    
+    A test of the fixed size tensor. The storage 
+    pattern and the operators should be consistent 
+    with those of BaseTensor.*/
+    
+    int  test_num        = 8;
+    std::vector<bool> test_results(test_num,false);
+    
+    //!Compare the storage pattern to BaseTensor for a 3rd order tensor
+    tensor::Tensor33      T({3,3,3});
+    tensor::FixedTensor33 FT;
+    
+    double inc = 1; //Set an initial increment vector
+    
+    for(int i=0; i<3; i++){
+        for(int j=0; j<3; j++){
+            for(int k=0; k<3; k++){
+                T(i,j,k)  = inc;
+                FT(i,j,k) = inc;
+                inc++;
+            }
+        }
+    }
+    
+    tensor::Tensor33 T_compare({3,3,3});
+    FT.to_base_tensor(T_compare);
+    
+    test_results[0] = T_compare.data.isApprox(T.data);
+    
+    tensor::FixedTensor33 FT_compare;
+    FT_compare.from_base_tensor(T);
+    
+    test_results[1] = true;
+    for(int i=0; i<FT.size; i++){
+        test_results[1] = test_results[1] * (FT.data[i] == FT_compare.data[i]);
+    }
+    
+    //!Test the shape information
+    test_results[2] = (tensor::FixedTensor53::order==5) && (tensor::FixedTensor53::size==243)
+                      && (tensor::FixedTensor<4,3,7>::dimension(2)==7);
+    
+    //!Test the operators
+    double a1[9] = {1,2,3,4,5,6,7,8,9};
+    double a2[9] = {6,2,2,7,2,1,3,9,0};
+    tensor::FixedTensor23 M1(a1);
+    tensor::FixedTensor23 M2(a2);
+    
+    tensor::FixedTensor23 Tsum =  M1+M2;
+    tensor::FixedTensor23 Tsub =  M1-M2;
+    tensor::FixedTensor23 Tneg = -M1;
+    tensor::FixedTensor23 Tscl = 2.*M1;
+    M1 += M2;
+    M2 -= M2;
+    
+    test_results[3] = true;
+    test_results[4] = true;
+    test_results[5] = true;
+    for(int i=0; i<9; i++){
+        test_results[3] = test_results[3] * (Tsum.data[i] == a1[i]+a2[i]) * (Tsub.data[i] == a1[i]-a2[i]);
+        test_results[4] = test_results[4] * (Tneg.data[i] == -a1[i]) * (Tscl.data[i] == 2*a1[i]);
+        test_results[5] = test_results[5] * (M1.data[i] == a1[i]+a2[i]) * (M2.data[i] == 0);
+    }
+    
+    //!Compare the determinant and the inverse to BaseTensor
+    double a3[9] = {4,2,1,0,3,5,2,1,6};
+    tensor::FixedTensor23 M3(a3);
+    tensor::Tensor23      B3({3,3});
+    M3.to_base_tensor(B3);
+    
+    test_results[6] = fabs(tensor::det(M3) - B3.det())<1e-9;
+    
+    tensor::Tensor23 B3inv({3,3});
+    tensor::inverse(M3).to_base_tensor(B3inv);
+    test_results[7] = B3inv.data.isApprox(B3.inverse().data);
+    
+    //Compare all test results
+    bool tot_result = true;
+    for(int i = 0; i<test_num; i++){
+        //std::cout << "\nSub-test " << i+1 << " result: " << test_results[i] << "\n";
+        if(!test_results[i]){
+            tot_result = false;
+        }
+    }
+    
+    if(tot_result){
+        results << "test_fixed_tensor & True\\\\\n\\hline\n";
+    }
+    else{
+        results << "test_fixed_tensor & False\\\\\n\\hline\n";
+    }
+    return 1;
+}
+
 int main(){
     /*!==========================
     |         main            |
@@ -560,6 +657,7 @@ int main(){
     test_FOT_eye(results);
     test_det(results);
     test_operators(results);
+    test_fixed_tensor(results);
     
     //Close the results file
     results.close();
@@ -20,6 +20,136 @@
 #define BOOST_TEST_MODULE test_tardigrade_micromorphic_linear_elasticity
 #include <boost/test/included/unit_test.hpp>
 
+namespace mockMaterial {
+
+    struct LinearStress {
+        /*!
+         * A material whose stresses are a fixed linear function of the deformation used to test the templated Gauss
+         * point kernel. The flat evaluation is provided through argument dependent lookup in the same way as for the
+         * micromorphic material library.
+         */
+
+        double scale = 1;
+    };
+
+    int evaluate_material_flat(
+        LinearStress &material, const std::vector<double> &time, const std::vector<double> &fparams,
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[9],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[9][9], double (&DSIGMADphi)[9][9], double (&DSIGMADgrad_phi)[9][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * The stresses are PK2_I = scale ( grad_u_I + 0.1 I phi_I ), SIGMA_I = scale ( 0.5 grad_u_I + phi_I ) and
+         * M_I = scale grad_phi_I. Returns 1 if the time is negative.
+         */
+
+        if (time[0] < 0) {
+            output_message = "negative time";
+            return 1;
+        }
+
+        for (unsigned int I = 0; I < 9; I++) {
+            for (unsigned int J = 0; J < 9; J++) {
+                DPK2Dgrad_u[I][J]   = (I == J) * material.scale;
+                DPK2Dphi[I][J]      = (I == J) * 0.1 * I * material.scale;
+                DSIGMADgrad_u[I][J] = (I == J) * 0.5 * material.scale;
+                DSIGMADphi[I][J]    = (I == J) * material.scale;
+            }
+
+            for (unsigned int J = 0; J < 27; J++) {
+                DPK2Dgrad_phi[I][J]   = 0;
+                DSIGMADgrad_phi[I][J] = 0;
+            }
+
+            PK2[I]   = material.scale * (current_grad_u[I / 3][I % 3] + 0.1 * I * current_phi[I]);
+            SIGMA[I] = material.scale * (0.5 * current_grad_u[I / 3][I % 3] + current_phi[I]);
+        }
+
+        for (unsigned int I = 0; I < 27; I++) {
+            for (unsigned int J = 0; J < 9; J++) {
+                DMDgrad_u[I][J] = 0;
+                DMDphi[I][J]    = 0;
+            }
+
+            for (unsigned int J = 0; J < 27; J++) {
+                DMDgrad_phi[I][J] = (I == J) * material.scale;
+            }
+
+            M[I] = material.scale * current_grad_phi[I / 3][I % 3];
+        }
+
+        SDVS = {time[0]};
+
+        return 0;
+    }
+
+    int evaluate_material_flat_symmetric(
+        LinearStress &material, const std::vector<double> &time, const std::vector<double> &fparams,
+        const double (&current_grad_u)[3][3], const double (&current_phi)[9], const double (&current_grad_phi)[9][3],
+        const double (&previous_grad_u)[3][3], const double (&previous_phi)[9],
+        const double (&previous_grad_phi)[9][3], std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+        const std::vector<std::vector<double> > &current_ADD_grad_DOF, const std::vector<double> &previous_ADD_DOF,
+        const std::vector<std::vector<double> > &previous_ADD_grad_DOF, double (&PK2)[9], double (&SIGMA)[6],
+        double (&M)[27], double (&DPK2Dgrad_u)[9][9], double (&DPK2Dphi)[9][9], double (&DPK2Dgrad_phi)[9][27],
+        double (&DSIGMADgrad_u)[6][9], double (&DSIGMADphi)[6][9], double (&DSIGMADgrad_phi)[6][27],
+        double (&DMDgrad_u)[27][9], double (&DMDphi)[27][9], double (&DMDgrad_phi)[27][27],
+        std::vector<std::vector<double> > &ADD_TERMS, std::vector<std::vector<std::vector<double> > > &ADD_JACOBIANS,
+        std::string &output_message
+#ifdef DEBUG_MODE
+        ,
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > &DEBUG
+#endif
+    ) {
+        /*!
+         * The stresses of evaluate_material_flat with the symmetric part of SIGMA in the Voigt form
+         * [ 11, 22, 33, 23, 13, 12 ]
+         */
+
+        double SIGMA_full[9], DSIGMADgrad_u_full[9][9], DSIGMADphi_full[9][9], DSIGMADgrad_phi_full[9][27];
+
+        int errorCode = evaluate_material_flat(
+            material, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+            previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+            PK2, SIGMA_full, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u_full, DSIGMADphi_full,
+            DSIGMADgrad_phi_full, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+            ,
+            DEBUG
+#endif
+        );
+
+        const unsigned int IJ[6] = {0, 4, 8, 5, 2, 1};
+        const unsigned int JI[6] = {0, 4, 8, 7, 6, 3};
+
+        for (unsigned int v = 0; v < 6; v++) {
+            SIGMA[v] = 0.5 * (SIGMA_full[IJ[v]] + SIGMA_full[JI[v]]);
+
+            for (unsigned int k = 0; k < 9; k++) {
+                DSIGMADgrad_u[v][k] = 0.5 * (DSIGMADgrad_u_full[IJ[v]][k] + DSIGMADgrad_u_full[JI[v]][k]);
+                DSIGMADphi[v][k]    = 0.5 * (DSIGMADphi_full[IJ[v]][k] + DSIGMADphi_full[JI[v]][k]);
+            }
+
+            for (unsigned int k = 0; k < 27; k++) {
+                DSIGMADgrad_phi[v][k] = 0.5 * (DSIGMADgrad_phi_full[IJ[v]][k] + DSIGMADgrad_phi_full[JI[v]][k]);
+            }
+        }
+
+        return errorCode;
+    }
+
+}  // namespace mockMaterial
+
 typedef balance_equations::variableType   variableType;
 typedef balance_equations::variableVector variableVector;
 typedef balance_equations::variableMatrix variableMatrix;
@@ -942,6 +1072,29 @@ BOOST_AUTO_TEST_CASE(testCompute_internal_force_jacobian) {
             BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DfintDU_ij, DfintDU_numeric[i][j]));
         }
     }
+
+    // Evaluate the block kernel
+    double F_b[9], PK2_b[9], DPK2Dgrad_u_b[9][9], DPK2Dphi_b[9][9], DPK2Dgrad_phi_b[9][27];
+    std::copy(F.begin(), F.end(), F_b);
+    std::copy(PK2.begin(), PK2.end(), PK2_b);
+    for (unsigned int i = 0; i < 9; i++) {
+        std::copy(DPK2Dgrad_u[i].begin(), DPK2Dgrad_u[i].end(), DPK2Dgrad_u_b[i]);
+        std::copy(DPK2Dphi[i].begin(), DPK2Dphi[i].end(), DPK2Dphi_b[i]);
+        std::copy(DPK2Dgrad_phi[i].begin(), DPK2Dgrad_phi[i].end(), DPK2Dgrad_phi_b[i]);
+    }
+
+    double fint[3], fint_b[3], DfintDU_b[3][12];
+    balance_equations::compute_internal_force(dNdX, F, PK2, fint);
+    balance_equations::compute_internal_force_and_jacobian(N, dNdX, etas[n], detadX_n, F_b, PK2_b, DPK2Dgrad_u_b,
+                                                           DPK2Dphi_b, DPK2Dgrad_phi_b, fint_b, DfintDU_b);
+
+    for (unsigned int i = 0; i < 3; i++) {
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(fint_b[i], fint[i]));
+
+        for (unsigned int j = 0; j < 12; j++) {
+            BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DfintDU_b[i][j], DfintDU_numeric[i][j]));
+        }
+    }
 }
 
 BOOST_AUTO_TEST_CASE(testCompute_internal_couple_jacobian) {
@@ -1081,6 +1234,47 @@ BOOST_AUTO_TEST_CASE(testCompute_internal_couple_jacobian) {
             BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DcintDU_ij, DcintDU_numeric[i][j]));
         }
     }
+
+    // Evaluate the block kernel
+    double F_b[9], chi_b[9], PK2_b[9], SIGMA_b[9], M_b[27];
+    double DPK2Dgrad_u_b[9][9], DPK2Dphi_b[9][9], DPK2Dgrad_phi_b[9][27];
+    double DSIGMADgrad_u_b[9][9], DSIGMADphi_b[9][9], DSIGMADgrad_phi_b[9][27];
+    double DMDgrad_u_b[27][9], DMDphi_b[27][9], DMDgrad_phi_b[27][27];
+    std::copy(F.begin(), F.end(), F_b);
+    std::copy(chi.begin(), chi.end(), chi_b);
+    std::copy(PK2.begin(), PK2.end(), PK2_b);
+    std::copy(SIGMA.begin(), SIGMA.end(), SIGMA_b);
+    std::copy(M.begin(), M.end(), M_b);
+    for (unsigned int i = 0; i < 9; i++) {
+        std::copy(DPK2Dgrad_u[i].begin(), DPK2Dgrad_u[i].end(), DPK2Dgrad_u_b[i]);
+        std::copy(DPK2Dphi[i].begin(), DPK2Dphi[i].end(), DPK2Dphi_b[i]);
+        std::copy(DPK2Dgrad_phi[i].begin(), DPK2Dgrad_phi[i].end(), DPK2Dgrad_phi_b[i]);
+        std::copy(DSIGMADgrad_u[i].begin(), DSIGMADgrad_u[i].end(), DSIGMADgrad_u_b[i]);
+        std::copy(DSIGMADphi[i].begin(), DSIGMADphi[i].end(), DSIGMADphi_b[i]);
+        std::copy(DSIGMADgrad_phi[i].begin(), DSIGMADgrad_phi[i].end(), DSIGMADgrad_phi_b[i]);
+    }
+    for (unsigned int i = 0; i < 27; i++) {
+        std::copy(DMDgrad_u[i].begin(), DMDgrad_u[i].end(), DMDgrad_u_b[i]);
+        std::copy(DMDphi[i].begin(), DMDphi[i].end(), DMDphi_b[i]);
+        std::copy(DMDgrad_phi[i].begin(), DMDgrad_phi[i].end(), DMDgrad_phi_b[i]);
+    }
+
+    double cint[9], cint_b[9], DcintDU_b[9][12];
+    errorCode = balance_equations::compute_internal_couple(N, dNdX, F, chi, PK2, SIGMA, M, cint);
+
+    BOOST_CHECK(errorCode == 0);
+
+    balance_equations::compute_internal_couple_and_jacobian(
+        N, dNdX, etas[n], detadX_n, F_b, chi_b, PK2_b, SIGMA_b, M_b, DPK2Dgrad_u_b, DPK2Dphi_b, DPK2Dgrad_phi_b,
+        DSIGMADgrad_u_b, DSIGMADphi_b, DSIGMADgrad_phi_b, DMDgrad_u_b, DMDphi_b, DMDgrad_phi_b, cint_b, DcintDU_b);
+
+    for (unsigned int i = 0; i < 9; i++) {
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(cint_b[i], cint[i]));
+
+        for (unsigned int j = 0; j < 12; j++) {
+            BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DcintDU_b[i][j], DcintDU_numeric[i][j]));
+        }
+    }
 }
 
 BOOST_AUTO_TEST_CASE(testCompute_inertia_couple2) {
@@ -1280,3 +1474,426 @@ BOOST_AUTO_TEST_CASE(testCompute_inertia_force_jacobian) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(testCompute_gauss_point_residual_and_jacobian) {
+    /*!
+     * Test the Gauss point kernel templated on the material model against the block kernels
+     */
+
+    const unsigned int num_nodes = 2;
+
+    const double N[num_nodes]       = {0.3, 0.7};
+    const double dNdX[num_nodes][3] = {{-0.5, 0.2, 0.1}, {0.4, -0.3, 0.6}};
+    const double weight             = 0.25;
+
+    const double grad_u[3][3]   = {{0.1, -0.2, 0.05}, {0.03, 0.2, -0.1}, {0.07, 0.01, -0.04}};
+    const double phi[9]         = {0.02, -0.01, 0.03, 0.05, -0.04, 0.01, 0.02, 0.06, -0.03};
+    double       grad_phi[9][3] = {};
+    for (unsigned int i = 0; i < 9; i++) {
+        for (unsigned int j = 0; j < 3; j++) {
+            grad_phi[i][j] = 0.01 * (i + 1) - 0.02 * j;
+        }
+    }
+
+    const double zero_grad_u[3][3] = {}, zero_phi[9] = {}, zero_grad_phi[9][3] = {};
+
+    const std::vector<double> time = {1.0, 0.1}, fparams = {};
+
+    std::vector<double> SDVS;
+    std::string         output_message;
+
+    mockMaterial::LinearStress material;
+    material.scale = 2.0;
+
+    const unsigned int  ndof = 12 * num_nodes;
+    std::vector<double> RHS(ndof, 0), AMATRX(ndof * ndof, 0);
+
+    int errorCode = balance_equations::compute_gauss_point_residual_and_jacobian(
+        material, time, fparams, grad_u, phi, grad_phi, zero_grad_u, zero_phi, zero_grad_phi, SDVS, num_nodes, N,
+        dNdX, weight, RHS.data(), AMATRX.data(), output_message);
+
+    BOOST_REQUIRE(errorCode == 0);
+
+    BOOST_CHECK(SDVS.size() == 1);
+
+    // Evaluate the material and the block kernels directly
+    double F[9], chi[9];
+    for (unsigned int i = 0; i < 9; i++) {
+        F[i]   = grad_u[i / 3][i % 3] + (i % 4 == 0);
+        chi[i] = phi[i] + (i % 4 == 0);
+    }
+
+    double PK2[9], SIGMA[9], M[27];
+    double DPK2Dgrad_u[9][9], DPK2Dphi[9][9], DPK2Dgrad_phi[9][27];
+    double DSIGMADgrad_u[9][9], DSIGMADphi[9][9], DSIGMADgrad_phi[9][27];
+    double DMDgrad_u[27][9], DMDphi[27][9], DMDgrad_phi[27][27];
+
+    std::vector<std::vector<double> >               ADD_TERMS;
+    std::vector<std::vector<std::vector<double> > > ADD_JACOBIANS;
+
+#ifdef DEBUG_MODE
+    std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG;
+#endif
+
+    errorCode = mockMaterial::evaluate_material_flat(
+        material, time, fparams, grad_u, phi, grad_phi, zero_grad_u, zero_phi, zero_grad_phi, SDVS, {}, {}, {}, {},
+        PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+        DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+        ,
+        DEBUG
+#endif
+    );
+
+    BOOST_REQUIRE(errorCode == 0);
+
+    for (unsigned int a = 0; a < num_nodes; a++) {
+        for (unsigned int b = 0; b < num_nodes; b++) {
+            double fint[3], cint[9], DfintDU[3][12], DcintDU[9][12];
+
+            balance_equations::compute_internal_force_and_jacobian(N[a], dNdX[a], N[b], dNdX[b], F, PK2, DPK2Dgrad_u,
+                                                                   DPK2Dphi, DPK2Dgrad_phi, fint, DfintDU);
+
+            balance_equations::compute_internal_couple_and_jacobian(
+                N[a], dNdX[a], N[b], dNdX[b], F, chi, PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi,
+                DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, cint, DcintDU);
+
+            for (unsigned int i = 0; i < 3; i++) {
+                BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(RHS[12 * a + i], weight * fint[i]));
+
+                for (unsigned int k = 0; k < 12; k++) {
+                    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(AMATRX[(12 * a + i) * ndof + 12 * b + k],
+                                                                   weight * DfintDU[i][k]));
+                }
+            }
+
+            for (unsigned int i = 0; i < 9; i++) {
+                BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(RHS[12 * a + 3 + i], weight * cint[i]));
+
+                for (unsigned int k = 0; k < 12; k++) {
+                    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(AMATRX[(12 * a + 3 + i) * ndof + 12 * b + k],
+                                                                   weight * DcintDU[i][k]));
+                }
+            }
+        }
+    }
+
+    // A failed material evaluation must leave the element arrays untouched
+    const std::vector<double> RHS_answer = RHS, AMATRX_answer = AMATRX;
+
+    errorCode = balance_equations::compute_gauss_point_residual_and_jacobian(
+        material, {-1.0, 0.1}, fparams, grad_u, phi, grad_phi, zero_grad_u, zero_phi, zero_grad_phi, SDVS, num_nodes,
+        N, dNdX, weight, RHS.data(), AMATRX.data(), output_message);
+
+    BOOST_CHECK(errorCode == 1);
+
+    BOOST_CHECK(RHS == RHS_answer);
+
+    BOOST_CHECK(AMATRX == AMATRX_answer);
+}
+
+BOOST_AUTO_TEST_CASE(testCompute_gauss_point_residual_and_jacobian_symmetric) {
+    /*!
+     * Test the Gauss point kernel with SIGMA in Voigt form against the block kernels with the full, symmetrized
+     * SIGMA
+     */
+
+    const unsigned int num_nodes = 2;
+
+    const double N[num_nodes]       = {0.3, 0.7};
+    const double dNdX[num_nodes][3] = {{-0.5, 0.2, 0.1}, {0.4, -0.3, 0.6}};
+    const double weight             = 0.25;
+
+    const double grad_u[3][3]   = {{0.1, -0.2, 0.05}, {0.03, 0.2, -0.1}, {0.07, 0.01, -0.04}};
+    const double phi[9]         = {0.02, -0.01, 0.03, 0.05, -0.04, 0.01, 0.02, 0.06, -0.03};
+    double       grad_phi[9][3] = {};
+    for (unsigned int i = 0; i < 9; i++) {
+        for (unsigned int j = 0; j < 3; j++) {
+            grad_phi[i][j] = 0.01 * (i + 1) - 0.02 * j;
+        }
+    }
+
+    const double zero_grad_u[3][3] = {}, zero_phi[9] = {}, zero_grad_phi[9][3] = {};
+
+    const std::vector<double> time = {1.0, 0.1}, fparams = {};
+
+    std::vector<double> SDVS;
+    std::string         output_message;
+
+    mockMaterial::LinearStress material;
+    material.scale = 2.0;
+
+    const unsigned int  ndof = 12 * num_nodes;
+    std::vector<double> RHS(ndof, 0), AMATRX(ndof * ndof, 0);
+
+    int errorCode = balance_equations::compute_gauss_point_residual_and_jacobian_symmetric(
+        material, time, fparams, grad_u, phi, grad_phi, zero_grad_u, zero_phi, zero_grad_phi, SDVS, num_nodes, N,
+        dNdX, weight, RHS.data(), AMATRX.data(), output_message);
+
+    BOOST_REQUIRE(errorCode == 0);
+
+    // Evaluate the material, symmetrize SIGMA and evaluate the full block kernels
+    double F[9], chi[9];
+    for (unsigned int i = 0; i < 9; i++) {
+        F[i]   = grad_u[i / 3][i % 3] + (i % 4 == 0);
+        chi[i] = phi[i] + (i % 4 == 0);
+    }
+
+    double PK2[9], SIGMA[9], M[27];
+    double DPK2Dgrad_u[9][9], DPK2Dphi[9][9], DPK2Dgrad_phi[9][27];
+    double DSIGMADgrad_u[9][9], DSIGMADphi[9][9], DSIGMADgrad_phi[9][27];
+    double DMDgrad_u[27][9], DMDphi[27][9], DMDgrad_phi[27][27];
+
+    std::vector<std::vector<double> >               ADD_TERMS;
+    std::vector<std::vector<std::vector<double> > > ADD_JACOBIANS;
+
+#ifdef DEBUG_MODE
+    std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG;
+#endif
+
+    errorCode = mockMaterial::evaluate_material_flat(
+        material, time, fparams, grad_u, phi, grad_phi, zero_grad_u, zero_phi, zero_grad_phi, SDVS, {}, {}, {}, {},
+        PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u,
+        DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS, output_message
+#ifdef DEBUG_MODE
+        ,
+        DEBUG
+#endif
+    );
+
+    BOOST_REQUIRE(errorCode == 0);
+
+    for (unsigned int I = 0; I < 3; I++) {
+        for (unsigned int J = 0; J < I; J++) {
+            const unsigned int IJ = 3 * I + J, JI = 3 * J + I;
+
+            SIGMA[IJ] = SIGMA[JI] = 0.5 * (SIGMA[IJ] + SIGMA[JI]);
+
+            for (unsigned int k = 0; k < 9; k++) {
+                DSIGMADgrad_u[IJ][k] = DSIGMADgrad_u[JI][k] = 0.5 * (DSIGMADgrad_u[IJ][k] + DSIGMADgrad_u[JI][k]);
+                DSIGMADphi[IJ][k] = DSIGMADphi[JI][k] = 0.5 * (DSIGMADphi[IJ][k] + DSIGMADphi[JI][k]);
+            }
+
+            for (unsigned int k = 0; k < 27; k++) {
+                DSIGMADgrad_phi[IJ][k] = DSIGMADgrad_phi[JI][k] =
+                    0.5 * (DSIGMADgrad_phi[IJ][k] + DSIGMADgrad_phi[JI][k]);
+            }
+        }
+    }
+
+    for (unsigned int a = 0; a < num_nodes; a++) {
+        for (unsigned int b = 0; b < num_nodes; b++) {
+            double cint[9], DcintDU[9][12];
+
+            balance_equations::compute_internal_couple_and_jacobian(
+                N[a], dNdX[a], N[b], dNdX[b], F, chi, PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi,
+                DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, cint, DcintDU);
+
+            for (unsigned int i = 0; i < 9; i++) {
+                BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(RHS[12 * a + 3 + i], weight * cint[i]));
+
+                for (unsigned int k = 0; k < 12; k++) {
+                    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(AMATRX[(12 * a + 3 + i) * ndof + 12 * b + k],
+                                                                   weight * DcintDU[i][k]));
+                }
+            }
+        }
+    }
+
+    // A failed material evaluation must leave the element arrays untouched
+    const std::vector<double> RHS_answer = RHS, AMATRX_answer = AMATRX;
+
+    errorCode = balance_equations::compute_gauss_point_residual_and_jacobian_symmetric(
+        material, {-1.0, 0.1}, fparams, grad_u, phi, grad_phi, zero_grad_u, zero_phi, zero_grad_phi, SDVS, num_nodes,
+        N, dNdX, weight, RHS.data(), AMATRX.data(), output_message);
+
+    BOOST_CHECK(errorCode == 1);
+
+    BOOST_CHECK(RHS == RHS_answer);
+
+    BOOST_CHECK(AMATRX == AMATRX_answer);
+}
+
+BOOST_AUTO_TEST_CASE(testBatched_residual) {
+    /*!
+     * Test the batched interpolation, element integration and assembly against the Gauss point kernel applied
+     * element by element
+     */
+
+    const unsigned int num_elements = 2, num_gauss_points = 2, num_nodes = 2, num_global_nodes = 3;
+    const unsigned int npoints = num_elements * num_gauss_points, ndof = 12 * num_global_nodes;
+
+    const unsigned int connectivity[num_elements][num_nodes] = {{0, 1}, {1, 2}};
+
+    std::vector<double> u(ndof);
+    for (unsigned int d = 0; d < ndof; d++) {
+        u[d] = 0.01 * ((7 * d) % 11) - 0.03;
+    }
+
+    double N[npoints][num_nodes], dNdX[npoints][num_nodes][3], weight[npoints];
+    for (unsigned int p = 0; p < npoints; p++) {
+        for (unsigned int a = 0; a < num_nodes; a++) {
+            N[p][a] = 0.2 + 0.3 * a + 0.05 * p;
+            for (unsigned int I = 0; I < 3; I++) {
+                dNdX[p][a][I] = (a == 0 ? -1.0 : 1.0) * (0.4 + 0.1 * I) + 0.02 * p;
+            }
+        }
+        weight[p] = 0.25 + 0.1 * p;
+    }
+
+    const double zero_grad_u[3][3] = {}, zero_phi[9] = {}, zero_grad_phi[9][3] = {};
+
+    const std::vector<double> time = {1.0, 0.1}, fparams = {};
+
+    std::vector<double> SDVS;
+    std::string         output_message;
+
+    mockMaterial::LinearStress material;
+    material.scale = 2.0;
+
+    // Integrate each element with the Gauss point kernel and scatter into the global residual
+    std::vector<double> RHS_answer(ndof, 0);
+    for (unsigned int e = 0; e < num_elements; e++) {
+        std::vector<double> RHS(12 * num_nodes, 0), AMATRX(12 * num_nodes * 12 * num_nodes, 0);
+
+        for (unsigned int g = 0; g < num_gauss_points; g++) {
+            const unsigned int p = num_gauss_points * e + g;
+
+            double grad_u[3][3] = {}, phi[9] = {}, grad_phi[9][3] = {};
+            for (unsigned int a = 0; a < num_nodes; a++) {
+                const double *node_u = u.data() + 12 * connectivity[e][a];
+                for (unsigned int i = 0; i < 3; i++) {
+                    for (unsigned int I = 0; I < 3; I++) {
+                        grad_u[i][I] += node_u[i] * dNdX[p][a][I];
+                    }
+                }
+                for (unsigned int ij = 0; ij < 9; ij++) {
+                    phi[ij] += N[p][a] * node_u[3 + ij];
+                    for (unsigned int K = 0; K < 3; K++) {
+                        grad_phi[ij][K] += node_u[3 + ij] * dNdX[p][a][K];
+                    }
+                }
+            }
+
+            int errorCode = balance_equations::compute_gauss_point_residual_and_jacobian(
+                material, time, fparams, grad_u, phi, grad_phi, zero_grad_u, zero_phi, zero_grad_phi, SDVS,
+                num_nodes, N[p], dNdX[p], weight[p], RHS.data(), AMATRX.data(), output_message);
+
+            BOOST_REQUIRE(errorCode == 0);
+        }
+
+        for (unsigned int a = 0; a < num_nodes; a++) {
+            for (unsigned int k = 0; k < 12; k++) {
+                RHS_answer[12 * connectivity[e][a] + k] += RHS[12 * a + k];
+            }
+        }
+    }
+
+    // Form the batch in structure of arrays form
+    std::vector<unsigned int> batch_dof(12 * num_nodes * num_elements);
+    std::vector<double>       batch_N(num_nodes * npoints), batch_dNdX(3 * num_nodes * npoints),
+        batch_weight(weight, weight + npoints);
+
+    for (unsigned int e = 0; e < num_elements; e++) {
+        for (unsigned int k = 0; k < 12 * num_nodes; k++) {
+            batch_dof[k * num_elements + e] = 12 * connectivity[e][k / 12] + k % 12;
+        }
+    }
+
+    for (unsigned int p = 0; p < npoints; p++) {
+        for (unsigned int a = 0; a < num_nodes; a++) {
+            batch_N[a * npoints + p] = N[p][a];
+            for (unsigned int I = 0; I < 3; I++) {
+                batch_dNdX[(3 * a + I) * npoints + p] = dNdX[p][a][I];
+            }
+        }
+    }
+
+    balance_equations::ElementBatch batch;
+    batch.num_elements     = num_elements;
+    batch.num_gauss_points = num_gauss_points;
+    batch.num_nodes        = num_nodes;
+    batch.dof              = batch_dof.data();
+    batch.N                = batch_N.data();
+    batch.dNdX             = batch_dNdX.data();
+    batch.weight           = batch_weight.data();
+
+    BOOST_CHECK(batch.num_points() == npoints);
+
+    std::vector<double> grad_u(9 * npoints), phi(9 * npoints), grad_phi(27 * npoints);
+    balance_equations::interpolate_dof_batch(batch, u.data(), grad_u.data(), phi.data(), grad_phi.data());
+
+    // Evaluate the material at each point
+    std::vector<double> PK2(9 * npoints), SIGMA(9 * npoints), M(27 * npoints);
+    for (unsigned int p = 0; p < npoints; p++) {
+        double point_grad_u[3][3], point_phi[9], point_grad_phi[9][3];
+        for (unsigned int c = 0; c < 9; c++) {
+            point_grad_u[c / 3][c % 3] = grad_u[c * npoints + p];
+            point_phi[c]               = phi[c * npoints + p];
+        }
+        for (unsigned int c = 0; c < 27; c++) {
+            point_grad_phi[c / 3][c % 3] = grad_phi[c * npoints + p];
+        }
+
+        double point_PK2[9], point_SIGMA[9], point_M[27];
+        double DPK2Dgrad_u[9][9], DPK2Dphi[9][9], DPK2Dgrad_phi[9][27];
+        double DSIGMADgrad_u[9][9], DSIGMADphi[9][9], DSIGMADgrad_phi[9][27];
+        double DMDgrad_u[27][9], DMDphi[27][9], DMDgrad_phi[27][27];
+
+        std::vector<std::vector<double> >               ADD_TERMS;
+        std::vector<std::vector<std::vector<double> > > ADD_JACOBIANS;
+
+#ifdef DEBUG_MODE
+        std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > > DEBUG;
+#endif
+
+        int errorCode = mockMaterial::evaluate_material_flat(
+            material, time, fparams, point_grad_u, point_phi, point_grad_phi, zero_grad_u, zero_phi, zero_grad_phi,
+            SDVS, {}, {}, {}, {}, point_PK2, point_SIGMA, point_M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi,
+            DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS,
+            output_message
+#ifdef DEBUG_MODE
+            ,
+            DEBUG
+#endif
+        );
+
+        BOOST_REQUIRE(errorCode == 0);
+
+        for (unsigned int c = 0; c < 9; c++) {
+            PK2[c * npoints + p]   = point_PK2[c];
+            SIGMA[c * npoints + p] = point_SIGMA[c];
+        }
+        for (unsigned int c = 0; c < 27; c++) {
+            M[c * npoints + p] = point_M[c];
+        }
+    }
+
+    std::vector<double> element_RHS(12 * num_nodes * num_elements, 1);
+    balance_equations::integrate_element_residual_batch(batch, grad_u.data(), phi.data(), PK2.data(), SIGMA.data(),
+                                                        M.data(), element_RHS.data());
+
+    std::vector<unsigned int> dof_offsets, dof_entries;
+    balance_equations::map_dof_to_element_residuals(batch, ndof, dof_offsets, dof_entries);
+
+    BOOST_CHECK(dof_offsets.size() == ndof + 1);
+
+    BOOST_CHECK(dof_offsets[ndof] == 12 * num_nodes * num_elements);
+
+    // The shared node gathers from both elements
+    BOOST_CHECK(dof_offsets[13] - dof_offsets[12] == 2);
+
+    std::vector<double> RHS(ndof, 1);
+    balance_equations::assemble_residual_batch(ndof, dof_offsets.data(), dof_entries.data(), element_RHS.data(),
+                                               RHS.data());
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(RHS, RHS_answer));
+
+    double norm_answer = 0;
+    for (unsigned int d = 0; d < ndof; d++) {
+        norm_answer += RHS[d] * RHS[d];
+    }
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(balance_equations::residual_norm_squared_batch(ndof, RHS.data()),
+                                                   norm_answer));
+}
@@ -2,7 +2,9 @@
 
 #include <micromorphic_material_library.h>
 #include <tardigrade_micromorphic_elasto_plasticity.h>
+#include <tardigrade_micromorphic_elasto_plasticity_interface.h>
 
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -682,3 +684,509 @@ BOOST_AUTO_TEST_CASE(testEvaluate_model_history) {
 
     BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(MAnswer, M_result));
 }
+
+BOOST_AUTO_TEST_CASE(testEvaluate_model_history_solver_hints) {
+    /*!
+     * Test the material model undergoing a time history with the solver hints appended to the state variables.
+     * The local solves converge without sub-incrementation so the results must match the history without hints.
+     */
+
+    // Initialize the model
+    std::string _model_name = "LinearElasticityDruckerPragerPlasticity";
+    auto       &factory     = micromorphic_material_library::MaterialFactory::Instance();
+    auto        material    = factory.GetMaterial(_model_name);
+
+    std::vector<std::vector<double> > grad_u_0 = {
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0}
+    };
+
+    std::vector<std::vector<double> > grad_u_f = {
+        {0.5, 0, 0},
+        {0.0, 0, 0},
+        {0.0, 0, 0}
+    };
+
+    std::vector<double> phi_0 = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    std::vector<double> phi_f = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    std::vector<std::vector<double> > grad_phi_0 = {
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0}
+    };
+
+    std::vector<std::vector<double> > grad_phi_f = {
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0}
+    };
+
+    double dt = 0.05;
+    double t0 = 0.;
+    double tf = 0.25;
+
+    double t = t0;
+
+    // Set up the model parameters
+    std::vector<double> fparams = {2, 1e3,  1e2, 2,     7e2,   1e4,   2,   1e3, 1e4, 2,     0.,   0.0, 2, 0.,    0.0,
+                                   2, 0.,   0.0, 2,     0.,    0.0,   2,   0.,  0.0, 2,     0.,   0.0, 2, 29480, 25480,
+                                   5, 1000, 400, -1500, -1400, -3000, 11,  0,   0,   0,     0,    0,   0, 1e+06, 0,
+                                   0, 0,    0,   2,     400,   -3000, 0.5, 0.5, 0.5, 1e-09, 1e-09};
+    //                                      0.0, 0.0, 0.0, 1e-09, 1e-09 };
+
+    // Initialize the state variable vector
+    std::vector<double> SDVSDefault(tardigradeMicromorphicElastoPlasticity::num_model_state_variables +
+                                        tardigradeMicromorphicElastoPlasticity::NUM_SOLVER_HINTS,
+                                    0);
+
+    // Initialize the additional degree of freedom vectors
+    std::vector<double>               current_ADD_DOF;
+    std::vector<std::vector<double> > current_ADD_grad_DOF;
+
+    std::vector<double>               previous_ADD_DOF;
+    std::vector<std::vector<double> > previous_ADD_grad_DOF;
+
+    // Initialize the stress measures
+    std::vector<double> current_PK2(9, 0);
+
+    std::vector<double> current_SIGMA(9, 0);
+
+    std::vector<double> current_M(27, 0);
+
+    // Initialize the additional terms vector
+    std::vector<std::vector<double> > ADD_TERMS;
+
+    // Initialize the output message string
+    std::string output_message;
+
+    std::vector<double> SDVS = SDVSDefault;
+
+    std::vector<double> PK2_result, SIGMA_result, M_result;
+
+    std::vector<double> PK2Answer = {5.14732214e+03, -6.86370000e-18, -4.92990000e-20, -6.83590000e-18, 4.03393807e+03,
+                                     2.51010000e-20, -4.63140000e-20, 2.38770000e-20,  4.03393807e+03};
+
+    std::vector<double> SIGMAAnswer = {5.04960294e+03,  -6.41210000e-18, -6.97664000e-20,
+                                       -6.42500000e-18, 4.09095475e+03,  1.91100000e-21,
+                                       -7.90527000e-20, 9.03380000e-20,  4.09095475e+03};
+
+    std::vector<double> MAnswer(27, 0);
+
+    std::vector<double> SDVSAnswer = {
+        4.0482366e-02,  3.2221000e-22,  -2.0521100e-24, -7.7550000e-23, -1.9437542e-02, 4.4690000e-24,  5.2236600e-24,
+        -5.0330000e-24, -1.9437542e-02, 1.0711910e-02,  4.4361000e-24,  1.2041200e-23,  -5.3431000e-24, -5.2891700e-03,
+        3.2546900e-24,  8.3249000e-24,  3.7619000e-24,  -5.2891700e-03, -1.2559400e-25, -1.4241000e-24, -2.0160600e-23,
+        1.1850000e-24,  3.5798180e-24,  -4.0320720e-26, -1.6025300e-25, 6.6401000e-26,  -1.5570200e-25, -9.4920500e-26,
+        3.1523200e-26,  1.3390000e-27,  1.3480700e-26,  4.3452570e-26,  9.7130000e-28,  1.3483280e-26,  4.3529000e-27,
+        -6.8650000e-28, 1.3851000e-26,  3.2998700e-26,  -2.6483000e-27, -1.3484100e-26, 1.7344100e-26,  -1.4103000e-27,
+        -1.3483100e-26, -1.5251000e-27, 1.8054900e-27,  4.3440166e-01,  6.2053500e-03,  -2.0501400e-29, -1.1141400e-28,
+        9.4642000e-32,  6.2345250e-02,  2.2586820e-02,  4.9913000e-26,  -4.2241000e-26, -2.5100000e-29};
+
+    std::vector<std::vector<double> > grad_u_prev   = grad_u_0;
+    std::vector<double>               phi_prev      = phi_0;
+    std::vector<std::vector<double> > grad_phi_prev = grad_phi_0;
+
+    std::vector<std::vector<double> > grad_u_curr;
+    std::vector<double>               phi_curr;
+    std::vector<std::vector<double> > grad_phi_curr;
+
+    std::vector<double> time;
+
+    double current_grad_u[3][3], current_phi[9], current_grad_phi[9][3];
+    double previous_grad_u[3][3], previous_phi[9], previous_grad_phi[9][3];
+
+    // Initial state
+    // Update the arrays
+    for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 3; j++) {
+            previous_grad_u[i][j] = grad_u_prev[i][j];
+        }
+    }
+
+    for (unsigned int i = 0; i < 9; i++) {
+        previous_phi[i] = phi_prev[i];
+
+        for (unsigned int j = 0; j < 3; j++) {
+            previous_grad_phi[i][j] = grad_phi_prev[i][j];
+        }
+    }
+    // Evaluate the model
+    time          = {0., 0.};
+    int errorCode = material->evaluate_model(time, fparams, previous_grad_u, previous_phi, previous_grad_phi,
+                                             previous_grad_u, previous_phi, previous_grad_phi, SDVS, current_ADD_DOF,
+                                             current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF, PK2_result,
+                                             SIGMA_result, M_result, ADD_TERMS, output_message);
+
+    BOOST_CHECK(errorCode <= 0);
+
+    // Begin iteration
+    while (t + dt < tf) {
+        time = {t + dt, dt};
+
+        // Increment the displacements
+        grad_u_curr   = grad_u_prev + dt * (grad_u_f - grad_u_0);
+        phi_curr      = phi_prev + dt * (phi_f - phi_0);
+        grad_phi_curr = grad_phi_prev + dt * (grad_phi_f - grad_phi_0);
+
+        // Update the arrays
+        for (unsigned int i = 0; i < 3; i++) {
+            for (unsigned int j = 0; j < 3; j++) {
+                current_grad_u[i][j]  = grad_u_curr[i][j];
+                previous_grad_u[i][j] = grad_u_prev[i][j];
+            }
+        }
+
+        for (unsigned int i = 0; i < 9; i++) {
+            current_phi[i]  = phi_curr[i];
+            previous_phi[i] = phi_prev[i];
+
+            for (unsigned int j = 0; j < 3; j++) {
+                current_grad_phi[i][j]  = grad_phi_curr[i][j];
+                previous_grad_phi[i][j] = grad_phi_prev[i][j];
+            }
+        }
+
+        // Evaluate the model
+        int errorCode =
+            material->evaluate_model(time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u,
+                                     previous_phi, previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF,
+                                     previous_ADD_DOF, previous_ADD_grad_DOF, PK2_result, SIGMA_result, M_result,
+                                     ADD_TERMS, output_message);
+
+        BOOST_CHECK(errorCode <= 0);
+
+        t += dt;
+
+        grad_u_prev   = grad_u_curr;
+        phi_prev      = phi_curr;
+        grad_phi_prev = grad_phi_curr;
+    }
+
+    BOOST_REQUIRE(SDVS.size() == SDVSDefault.size());
+
+    std::vector<double> SDVS_model(SDVS.begin(), SDVS.begin() + SDVSAnswer.size());
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(SDVSAnswer, SDVS_model));
+
+    const double *hints = SDVS.data() + tardigradeMicromorphicElastoPlasticity::num_model_state_variables;
+
+    BOOST_CHECK(hints[tardigradeMicromorphicElastoPlasticity::PLASTIC_HINT] == 1);
+
+    BOOST_CHECK(hints[tardigradeMicromorphicElastoPlasticity::SUBSTEP_HINT] == 1);
+
+    BOOST_CHECK(hints[tardigradeMicromorphicElastoPlasticity::SOLVE_HINT] == 1);
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(PK2Answer, PK2_result));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(SIGMAAnswer, SIGMA_result));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(MAnswer, M_result));
+}
+
+BOOST_AUTO_TEST_CASE(testEvaluate_model_jacobian_solver_hints) {
+    /*!
+     * Test that the jacobians are consistent with the stresses when the solver hints request sub-incrementation.
+     * The jacobians are compared to finite differences of the stresses returned by the same evaluation.
+     */
+
+    // Initialize the model
+    std::string _model_name = "LinearElasticityDruckerPragerPlasticity";
+    auto       &factory     = micromorphic_material_library::MaterialFactory::Instance();
+    auto        material    = factory.GetMaterial(_model_name);
+
+    // Set up the inputs
+    std::vector<double> time = {10., 2.5};
+
+    std::vector<double> fparams = {
+        2,     2.4e2,  1.5e1,                        // Macro hardening parameters
+        2,     1.4e2,  2.0e1,                        // Micro hardening parameters
+        2,     2.0e0,  2.7e1,                        // Micro gradient hardening parameters
+        2,     0.56,   0.2,                          // Macro flow parameters
+        2,     0.15,   -0.2,                         // Micro flow parameters
+        2,     0.82,   0.1,                          // Micro gradient flow parameters
+        2,     0.70,   0.3,                          // Macro yield parameters
+        2,     0.40,   -0.3,                         // Micro yield parameters
+        2,     0.52,   0.4,                          // Micro gradient yield parameters
+        2,     696.47, 65.84,                        // A stiffness tensor parameters
+        5,     -7.69,  -51.92, 38.61, -27.31, 5.13,  // B stiffness tensor parameters
+        11,    1.85,   -0.19,  -1.08, -1.57,  2.29,
+        -0.61, 5.97,   -2.02,  2.38,  -0.32,  -3.25,  // C stiffness tensor parameters
+        2,     -51.92, 5.13,                          // D stiffness tensor parameters
+        0.4,   0.3,    0.35,   1e-8,  1e-8            // Integration parameters
+    };
+
+    double current_grad_u[3][3] = {
+        {0.200, 0.100, 0.000},
+        {0.100, 0.001, 0.000},
+        {0.000, 0.000, 0.000}
+    };
+
+    double previous_grad_u[3][3] = {
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0}
+    };
+
+    double current_phi[9] = {0.100, 0.000, 0.000, 0.000, 0.000, 0.000, 0.000, 0.000, 0.000};
+
+    double previous_phi[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    double current_grad_phi[9][3] = {
+        {0.13890017,  -0.3598602,  -0.08048856},
+        {-0.18572739, 0.06847269,  0.22931628 },
+        {-0.01829735, -0.48731265, -0.25277529},
+        {0.26626212,  0.4844646,   -0.31965177},
+        {0.49197846,  0.19051656,  -0.0365349 },
+        {-0.06607774, -0.33526875, -0.15803078},
+        {0.09738707,  -0.49482218, -0.39584868},
+        {-0.45599864, 0.08585038,  -0.09432794},
+        {0.23055539,  0.07564162,  0.24051469 }
+    };
+
+    double previous_grad_phi[9][3] = {
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0}
+    };
+
+    // A plastic last increment which recommends four sub-increments
+    std::vector<double> SDVSDefault(tardigradeMicromorphicElastoPlasticity::num_model_state_variables +
+                                        tardigradeMicromorphicElastoPlasticity::NUM_SOLVER_HINTS,
+                                    0);
+
+    SDVSDefault[tardigradeMicromorphicElastoPlasticity::num_model_state_variables +
+                tardigradeMicromorphicElastoPlasticity::PLASTIC_HINT] = 1;
+    SDVSDefault[tardigradeMicromorphicElastoPlasticity::num_model_state_variables +
+                tardigradeMicromorphicElastoPlasticity::SUBSTEP_HINT] = 4;
+
+    std::vector<double>               current_ADD_DOF;
+    std::vector<std::vector<double> > current_ADD_grad_DOF;
+
+    std::vector<double>               previous_ADD_DOF;
+    std::vector<std::vector<double> > previous_ADD_grad_DOF;
+
+    std::vector<std::vector<double> >                ADD_TERMS;
+    std::vector<std::vector<std::vector<double> > > ADD_JACOBIANS;
+
+    std::string output_message;
+
+    std::vector<double> PK2_result, SIGMA_result, M_result;
+
+    std::vector<std::vector<double> > DPK2Dgrad_u_result, DPK2Dphi_result, DPK2Dgrad_phi_result, DSIGMADgrad_u_result,
+        DSIGMADphi_result, DSIGMADgrad_phi_result, DMDgrad_u_result, DMDphi_result, DMDgrad_phi_result;
+
+    auto evaluate = [&](std::vector<double> &SDVS, std::vector<double> &PK2, std::vector<double> &SIGMA,
+                        std::vector<double> &M) {
+        std::vector<std::vector<double> > DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi,
+            DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi;
+
+        return material->evaluate_model(time, fparams, current_grad_u, current_phi, current_grad_phi,
+                                        previous_grad_u, previous_phi, previous_grad_phi, SDVS, current_ADD_DOF,
+                                        current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF, PK2, SIGMA, M,
+                                        DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi,
+                                        DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS,
+                                        output_message);
+    };
+
+    std::vector<double> SDVS = SDVSDefault;
+
+    int errorCode = material->evaluate_model(
+        time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi, previous_grad_phi,
+        SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF, PK2_result, SIGMA_result,
+        M_result, DPK2Dgrad_u_result, DPK2Dphi_result, DPK2Dgrad_phi_result, DSIGMADgrad_u_result, DSIGMADphi_result,
+        DSIGMADgrad_phi_result, DMDgrad_u_result, DMDphi_result, DMDgrad_phi_result, ADD_TERMS, ADD_JACOBIANS,
+        output_message);
+
+    BOOST_CHECK(errorCode == 0);
+
+    BOOST_REQUIRE(SDVS.size() == SDVSDefault.size());
+
+    const double *hints = SDVS.data() + tardigradeMicromorphicElastoPlasticity::num_model_state_variables;
+
+    BOOST_CHECK(hints[tardigradeMicromorphicElastoPlasticity::SOLVE_HINT] == 1);
+
+    // The stresses must be those of the single step solve
+    std::vector<double> SDVS_single(tardigradeMicromorphicElastoPlasticity::num_model_state_variables, 0);
+
+    std::vector<double> PK2_single, SIGMA_single, M_single;
+
+    errorCode = evaluate(SDVS_single, PK2_single, SIGMA_single, M_single);
+
+    BOOST_CHECK(errorCode == 0);
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(PK2_result, PK2_single));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(SIGMA_result, SIGMA_single));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(M_result, M_single));
+
+    // Compare the jacobians to central differences of the evaluation with the hints
+    const double eps = 1e-6;
+
+    std::vector<double *> degrees_of_freedom;
+    for (unsigned int i = 0; i < 9; i++) {
+        degrees_of_freedom.push_back(&current_grad_u[i / 3][i % 3]);
+    }
+    for (unsigned int i = 0; i < 9; i++) {
+        degrees_of_freedom.push_back(current_phi + i);
+    }
+    for (unsigned int i = 0; i < 27; i++) {
+        degrees_of_freedom.push_back(&current_grad_phi[i / 3][i % 3]);
+    }
+
+    std::vector<std::vector<double> > DPK2DDOF(9, std::vector<double>(45, 0));
+    std::vector<std::vector<double> > DSIGMADDOF(9, std::vector<double>(45, 0));
+    std::vector<std::vector<double> > DMDDOF(27, std::vector<double>(45, 0));
+
+    for (unsigned int j = 0; j < degrees_of_freedom.size(); j++) {
+        const double value = *degrees_of_freedom[j];
+        const double delta = eps * std::fabs(value) + eps;
+
+        std::vector<double> SDVS_P = SDVSDefault, PK2_P, SIGMA_P, M_P;
+        std::vector<double> SDVS_M = SDVSDefault, PK2_M, SIGMA_M, M_M;
+
+        *degrees_of_freedom[j] = value + delta;
+        BOOST_CHECK(evaluate(SDVS_P, PK2_P, SIGMA_P, M_P) == 0);
+
+        *degrees_of_freedom[j] = value - delta;
+        BOOST_CHECK(evaluate(SDVS_M, PK2_M, SIGMA_M, M_M) == 0);
+
+        *degrees_of_freedom[j] = value;
+
+        for (unsigned int i = 0; i < 9; i++) {
+            DPK2DDOF[i][j]   = (PK2_P[i] - PK2_M[i]) / (2 * delta);
+            DSIGMADDOF[i][j] = (SIGMA_P[i] - SIGMA_M[i]) / (2 * delta);
+        }
+
+        for (unsigned int i = 0; i < 27; i++) {
+            DMDDOF[i][j] = (M_P[i] - M_M[i]) / (2 * delta);
+        }
+    }
+
+    for (unsigned int i = 0; i < 9; i++) {
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            DPK2Dgrad_u_result[i], std::vector<double>(DPK2DDOF[i].begin(), DPK2DDOF[i].begin() + 9), 1e-4, 1e-5));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            DPK2Dphi_result[i], std::vector<double>(DPK2DDOF[i].begin() + 9, DPK2DDOF[i].begin() + 18), 1e-4, 1e-5));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            DPK2Dgrad_phi_result[i], std::vector<double>(DPK2DDOF[i].begin() + 18, DPK2DDOF[i].end()), 1e-4, 1e-5));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            DSIGMADgrad_u_result[i], std::vector<double>(DSIGMADDOF[i].begin(), DSIGMADDOF[i].begin() + 9), 1e-4,
+            1e-5));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            DSIGMADphi_result[i], std::vector<double>(DSIGMADDOF[i].begin() + 9, DSIGMADDOF[i].begin() + 18), 1e-4,
+            1e-5));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            DSIGMADgrad_phi_result[i], std::vector<double>(DSIGMADDOF[i].begin() + 18, DSIGMADDOF[i].end()), 1e-4,
+            1e-5));
+    }
+
+    for (unsigned int i = 0; i < 27; i++) {
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            DMDgrad_u_result[i], std::vector<double>(DMDDOF[i].begin(), DMDDOF[i].begin() + 9), 1e-4, 1e-5));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            DMDphi_result[i], std::vector<double>(DMDDOF[i].begin() + 9, DMDDOF[i].begin() + 18), 1e-4, 1e-5));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            DMDgrad_phi_result[i], std::vector<double>(DMDDOF[i].begin() + 18, DMDDOF[i].end()), 1e-4, 1e-5));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSolve_with_hints) {
+    /*!
+     * Test the sub-incrementation of solve_with_hints with a local solve which records the sub-increments
+     */
+
+    const std::vector<double> time = {1.0, 0.5};
+
+    const double current_grad_u[3][3]  = {{0.4, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+    const double previous_grad_u[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+
+    const double current_phi[9]  = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    const double previous_phi[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    const double current_grad_phi[9][3]  = {};
+    const double previous_grad_phi[9][3] = {};
+
+    std::vector<double> increments;
+
+    // A plastic solve which counts its calls in the first state variable
+    auto solve = [&](const std::vector<double> &_time, const double (&_current_grad_u)[3][3],
+                     const double (&_current_phi)[9], const double (&_current_grad_phi)[9][3],
+                     const double (&_previous_grad_u)[3][3], const double (&_previous_phi)[9],
+                     const double (&_previous_grad_phi)[9][3], std::vector<double> &_SDVS) {
+        increments.push_back(_current_grad_u[0][0] - _previous_grad_u[0][0]);
+        _SDVS[0] += 1;
+        return 0;
+    };
+
+    std::vector<double> SDVSDefault(tardigradeMicromorphicElastoPlasticity::num_model_state_variables +
+                                        tardigradeMicromorphicElastoPlasticity::NUM_SOLVER_HINTS,
+                                    0);
+
+    SDVSDefault[tardigradeMicromorphicElastoPlasticity::num_model_state_variables +
+                tardigradeMicromorphicElastoPlasticity::PLASTIC_HINT] = 1;
+    SDVSDefault[tardigradeMicromorphicElastoPlasticity::num_model_state_variables +
+                tardigradeMicromorphicElastoPlasticity::SUBSTEP_HINT] = 4;
+
+    // The evaluations without the jacobians are sub-incremented
+    std::vector<double> SDVS = SDVSDefault;
+
+    int errorCode = tardigradeMicromorphicElastoPlasticity::solve_with_hints(
+        time, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi, previous_grad_phi, SDVS,
+        solve);
+
+    BOOST_CHECK(errorCode == 0);
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(increments, std::vector<double>({0.1, 0.1, 0.1, 0.1})));
+
+    BOOST_CHECK(SDVS[0] == 4);
+
+    BOOST_CHECK(SDVS[tardigradeMicromorphicElastoPlasticity::num_model_state_variables +
+                     tardigradeMicromorphicElastoPlasticity::SUBSTEP_HINT] == 2);
+
+    // The evaluations with the jacobians are always solved in a single step
+    increments.clear();
+
+    SDVS = SDVSDefault;
+
+    errorCode = tardigradeMicromorphicElastoPlasticity::solve_with_hints(time, current_grad_u, current_phi,
+                                                                         current_grad_phi, previous_grad_u,
+                                                                         previous_phi, previous_grad_phi, SDVS, solve,
+                                                                         false);
+
+    BOOST_CHECK(errorCode == 0);
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(increments, std::vector<double>({0.4})));
+
+    BOOST_CHECK(SDVS[0] == 1);
+
+    BOOST_CHECK(SDVS[tardigradeMicromorphicElastoPlasticity::num_model_state_variables +
+                     tardigradeMicromorphicElastoPlasticity::SOLVE_HINT] == 1);
+}
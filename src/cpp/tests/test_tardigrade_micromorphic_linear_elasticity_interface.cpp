@@ -3,6 +3,8 @@
 #include <tardigrade_micromorphic_linear_elasticity.h>
 #include <tardigrade_micromorphic_linear_elasticity_interface.h>
 
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -205,4 +207,646 @@ BOOST_AUTO_TEST_CASE(testMaterialLibraryInterface) {
     BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DMDphi_result, DMDphi_answer));
 
     BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DMDgrad_phi_result, DMDgrad_phi_answer));
+
+    // Test the threaded numeric Jacobian values
+    errorCode = material->evaluate_model_numeric_gradients(
+        time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi, previous_grad_phi,
+        SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF, PK2_result, SIGMA_result,
+        M_result, DPK2Dgrad_u_result, DPK2Dphi_result, DPK2Dgrad_phi_result, DSIGMADgrad_u_result, DSIGMADphi_result,
+        DSIGMADgrad_phi_result, DMDgrad_u_result, DMDphi_result, DMDgrad_phi_result, ADD_TERMS, ADD_JACOBIANS,
+        output_message, 1e-6, micromorphic_material_library::CENTRAL_DIFFERENCE, 4);
+
+    BOOST_CHECK(errorCode <= 0);
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DPK2Dgrad_u_result, DPK2Dgrad_u_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DPK2Dphi_result, DPK2Dphi_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DPK2Dgrad_phi_result, DPK2Dgrad_phi_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DSIGMADgrad_u_result, DSIGMADgrad_u_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DSIGMADphi_result, DSIGMADphi_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DSIGMADgrad_phi_result, DSIGMADgrad_phi_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DMDgrad_u_result, DMDgrad_u_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DMDphi_result, DMDphi_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DMDgrad_phi_result, DMDgrad_phi_answer));
+
+    // Test the forward difference numeric Jacobian values
+    errorCode = material->evaluate_model_numeric_gradients(
+        time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi, previous_grad_phi,
+        SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF, PK2_result, SIGMA_result,
+        M_result, DPK2Dgrad_u_result, DPK2Dphi_result, DPK2Dgrad_phi_result, DSIGMADgrad_u_result, DSIGMADphi_result,
+        DSIGMADgrad_phi_result, DMDgrad_u_result, DMDphi_result, DMDgrad_phi_result, ADD_TERMS, ADD_JACOBIANS,
+        output_message, 1e-6, micromorphic_material_library::FORWARD_DIFFERENCE, 2);
+
+    BOOST_CHECK(errorCode <= 0);
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(PK2_result, PK2_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DPK2Dgrad_u_result, DPK2Dgrad_u_answer, 1e-4, 1e-4));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DPK2Dphi_result, DPK2Dphi_answer, 1e-4, 1e-4));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DPK2Dgrad_phi_result, DPK2Dgrad_phi_answer, 1e-4, 1e-4));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DSIGMADgrad_u_result, DSIGMADgrad_u_answer, 1e-4, 1e-4));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DSIGMADphi_result, DSIGMADphi_answer, 1e-4, 1e-4));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DSIGMADgrad_phi_result, DSIGMADgrad_phi_answer, 1e-4, 1e-4));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DMDgrad_u_result, DMDgrad_u_answer, 1e-4, 1e-4));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DMDphi_result, DMDphi_answer, 1e-4, 1e-4));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(DMDgrad_phi_result, DMDgrad_phi_answer, 1e-4, 1e-4));
+
+    // Test the flat buffer interface
+    double PK2_flat[9], SIGMA_flat[9], M_flat[27];
+    double DPK2Dgrad_u_flat[9][9], DPK2Dphi_flat[9][9], DPK2Dgrad_phi_flat[9][27];
+    double DSIGMADgrad_u_flat[9][9], DSIGMADphi_flat[9][9], DSIGMADgrad_phi_flat[9][27];
+    double DMDgrad_u_flat[27][9], DMDphi_flat[27][9], DMDgrad_phi_flat[27][27];
+
+    errorCode = material->evaluate_model_flat(
+        time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi, previous_grad_phi,
+        SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF, PK2_flat, SIGMA_flat,
+        M_flat, DPK2Dgrad_u_flat, DPK2Dphi_flat, DPK2Dgrad_phi_flat, DSIGMADgrad_u_flat, DSIGMADphi_flat,
+        DSIGMADgrad_phi_flat, DMDgrad_u_flat, DMDphi_flat, DMDgrad_phi_flat, ADD_TERMS, ADD_JACOBIANS, output_message);
+
+    BOOST_CHECK(errorCode == 0);
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(PK2_flat, PK2_flat + 9), PK2_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(SIGMA_flat, SIGMA_flat + 9), SIGMA_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(M_flat, M_flat + 27), M_answer));
+
+    for (unsigned int i = 0; i < 9; i++) {
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(DPK2Dgrad_u_flat[i], DPK2Dgrad_u_flat[i] + 9),
+                                                       DPK2Dgrad_u_answer[i]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(DPK2Dphi_flat[i], DPK2Dphi_flat[i] + 9),
+                                                       DPK2Dphi_answer[i]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            std::vector<double>(DPK2Dgrad_phi_flat[i], DPK2Dgrad_phi_flat[i] + 27), DPK2Dgrad_phi_answer[i]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            std::vector<double>(DSIGMADgrad_u_flat[i], DSIGMADgrad_u_flat[i] + 9), DSIGMADgrad_u_answer[i]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(DSIGMADphi_flat[i], DSIGMADphi_flat[i] + 9),
+                                                       DSIGMADphi_answer[i]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            std::vector<double>(DSIGMADgrad_phi_flat[i], DSIGMADgrad_phi_flat[i] + 27), DSIGMADgrad_phi_answer[i]));
+    }
+
+    for (unsigned int i = 0; i < 27; i++) {
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(DMDgrad_u_flat[i], DMDgrad_u_flat[i] + 9),
+                                                       DMDgrad_u_answer[i]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(DMDphi_flat[i], DMDphi_flat[i] + 9),
+                                                       DMDphi_answer[i]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            std::vector<double>(DMDgrad_phi_flat[i], DMDgrad_phi_flat[i] + 27), DMDgrad_phi_answer[i]));
+    }
+
+    // Test the symmetric flat buffer interface of the concrete model
+    tardigradeMicromorphicLinearElasticity::LinearElasticity linear_elasticity;
+
+    double SIGMA_voigt[6], DSIGMADgrad_u_voigt[6][9], DSIGMADphi_voigt[6][9], DSIGMADgrad_phi_voigt[6][27];
+
+    errorCode = micromorphic_material_library::evaluate_material_flat_symmetric(
+        linear_elasticity, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi,
+        previous_grad_phi, SDVS, current_ADD_DOF, current_ADD_grad_DOF, previous_ADD_DOF, previous_ADD_grad_DOF,
+        PK2_flat, SIGMA_voigt, M_flat, DPK2Dgrad_u_flat, DPK2Dphi_flat, DPK2Dgrad_phi_flat, DSIGMADgrad_u_voigt,
+        DSIGMADphi_voigt, DSIGMADgrad_phi_voigt, DMDgrad_u_flat, DMDphi_flat, DMDgrad_phi_flat, ADD_TERMS,
+        ADD_JACOBIANS, output_message);
+
+    BOOST_CHECK(errorCode == 0);
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(PK2_flat, PK2_flat + 9), PK2_answer));
+
+    BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(std::vector<double>(M_flat, M_flat + 27), M_answer));
+
+    for (unsigned int v = 0; v < 6; v++) {
+        const unsigned int IJ = 3 * micromorphic_material_library::symmetric_voigt_rows[v] +
+                                micromorphic_material_library::symmetric_voigt_columns[v];
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(SIGMA_voigt[v], SIGMA_answer[IJ]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            std::vector<double>(DSIGMADgrad_u_voigt[v], DSIGMADgrad_u_voigt[v] + 9), DSIGMADgrad_u_answer[IJ]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            std::vector<double>(DSIGMADphi_voigt[v], DSIGMADphi_voigt[v] + 9), DSIGMADphi_answer[IJ]));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(
+            std::vector<double>(DSIGMADgrad_phi_voigt[v], DSIGMADgrad_phi_voigt[v] + 27), DSIGMADgrad_phi_answer[IJ]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testGetSharedMaterial) {
+    /*!
+     * Test that the shared material instances are persistent and that unknown
+     * names are reported.
+     */
+
+    std::string _model_name = "LinearElasticity";
+    auto       &factory     = micromorphic_material_library::MaterialFactory::Instance();
+
+    auto material1 = factory.GetSharedMaterial(_model_name);
+    auto material2 = factory.GetSharedMaterial(_model_name);
+
+    BOOST_CHECK(material1);
+
+    BOOST_CHECK(material1.get() == material2.get());
+
+    BOOST_CHECK_THROW(factory.GetSharedMaterial("NotAMaterialModel"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(testEvaluate_model_batch) {
+    /*!
+     * Test the batched evaluation of the linear elastic model
+     * via the material library.
+     */
+
+    // Initialize the model
+    std::string _model_name = "LinearElasticity";
+    auto       &factory     = micromorphic_material_library::MaterialFactory::Instance();
+    auto        material    = factory.GetSharedMaterial(_model_name);
+
+    // Set up the inputs
+    const std::vector<double> time = {10, 2.7};
+
+    const std::vector<double> fparams = {2,  1.7, 1.8, 5,  2.8, .76, .15, 9.8, 5.4, 11, 1.,  2.,
+                                         3., 4.,  5.,  6., 7.,  8.,  9.,  10., 11., 2,  .76, 5.4};
+
+    const double current_grad_u[3][3] = {
+        {-1.07901185, -1.09656192, -0.04629144},
+        {-0.77749189, -1.27877771, -0.82648234},
+        {0.66484637,  -0.05552567, -1.65125738}
+    };
+
+    const double current_phi[9] = {-1.40391532, -0.42715691, 0.75393369, 0.2849511,  -2.06484257,
+                                   -0.52190902, 1.07238446,  0.19155907, -0.39704566};
+
+    const double current_grad_phi[9][3] = {
+        {0.14940184, 0.12460812, 0.31971128},
+        {0.67550862, 0.61095383, 0.87972732},
+        {0.30872424, 0.32158187, 0.25480281},
+        {0.45570006, 0.69090695, 0.72388584},
+        {0.14880964, 0.67520596, 0.15106516},
+        {0.77810545, 0.07641724, 0.09367471},
+        {0.15905979, 0.0651695,  0.52150417},
+        {0.91873444, 0.5622355,  0.50199447},
+        {0.26729942, 0.89858519, 0.09043229}
+    };
+
+    const double previous_grad_u[3][3] = {
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0}
+    };
+
+    const double previous_phi[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    const double previous_grad_phi[9][3] = {
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0},
+        {0, 0, 0}
+    };
+
+    std::vector<double>                     SDVS;
+
+    std::vector<double> PK2_answer = {-26.78976487, 91.99831835,  135.04096376, -63.68792655, 149.68226149,
+                                      186.67587146, -42.54105342, 125.2317492,  150.55767059};
+
+    std::vector<double> SIGMA_answer = {-47.59920949, 20.84881327, 93.02392773, 20.84881327, 302.43209139,
+                                        311.0104045,  93.02392773, 311.0104045, 312.60512922};
+
+    std::vector<double> M_answer = {-50.37283054, -23.25778149, -37.92963077, -19.16962188, -32.97279228, -14.89104497,
+                                    -33.4026237,  -15.47947779, -40.31460994, -16.29637436, -36.63942799, -18.22777296,
+                                    -39.33546661, -86.69472439, -59.29150146, -15.76480164, -55.42039768, -35.09720118,
+                                    -28.94394503, -17.96726082, -45.09734176, -16.46568416, -50.79898863, -39.19129183,
+                                    -47.46372724, -42.98201472, -45.57864883};
+
+    // Form the structure of arrays inputs with different values at each point. The first point is the point with
+    // the stored answers and the batch covers more than one block of the linear elastic override.
+    const unsigned int npoints = 11;
+
+    std::vector<double> current_grad_u_batch(9 * npoints), current_phi_batch(9 * npoints),
+        current_grad_phi_batch(27 * npoints);
+    std::vector<double> previous_grad_u_batch(9 * npoints), previous_phi_batch(9 * npoints),
+        previous_grad_phi_batch(27 * npoints);
+
+    for (unsigned int p = 0; p < npoints; p++) {
+        const double scale = 1 - 0.03 * p;
+
+        for (unsigned int i = 0; i < 9; i++) {
+            current_grad_u_batch[i * npoints + p]  = scale * current_grad_u[i / 3][i % 3] + 0.001 * p * i;
+            current_phi_batch[i * npoints + p]     = scale * current_phi[i] - 0.002 * p;
+            previous_grad_u_batch[i * npoints + p] = previous_grad_u[i / 3][i % 3];
+            previous_phi_batch[i * npoints + p]    = previous_phi[i];
+        }
+
+        for (unsigned int i = 0; i < 27; i++) {
+            current_grad_phi_batch[i * npoints + p]  = scale * current_grad_phi[i / 3][i % 3] + 0.001 * p;
+            previous_grad_phi_batch[i * npoints + p] = previous_grad_phi[i / 3][i % 3];
+        }
+    }
+
+    std::vector<double> PK2_batch(9 * npoints), SIGMA_batch(9 * npoints), M_batch(27 * npoints);
+    std::string         output_message;
+
+    int errorCode = material->evaluate_model_batch(
+        npoints, time, fparams, current_grad_u_batch.data(), current_phi_batch.data(), current_grad_phi_batch.data(),
+        previous_grad_u_batch.data(), previous_phi_batch.data(), previous_grad_phi_batch.data(), SDVS,
+        PK2_batch.data(), SIGMA_batch.data(), M_batch.data(), output_message);
+
+    BOOST_CHECK(errorCode <= 0);
+
+    for (unsigned int p = 0; p < npoints; p++) {
+        std::vector<double> PK2_result(9), SIGMA_result(9), M_result(27);
+
+        double current_grad_u_p[3][3], current_phi_p[9], current_grad_phi_p[9][3];
+
+        for (unsigned int i = 0; i < 9; i++) {
+            PK2_result[i]   = PK2_batch[i * npoints + p];
+            SIGMA_result[i] = SIGMA_batch[i * npoints + p];
+
+            current_grad_u_p[i / 3][i % 3] = current_grad_u_batch[i * npoints + p];
+            current_phi_p[i]               = current_phi_batch[i * npoints + p];
+        }
+
+        for (unsigned int i = 0; i < 27; i++) {
+            M_result[i] = M_batch[i * npoints + p];
+
+            current_grad_phi_p[i / 3][i % 3] = current_grad_phi_batch[i * npoints + p];
+        }
+
+        // Every point must match the point-wise evaluation
+        std::vector<double>                     SDVS_p, PK2_p, SIGMA_p, M_p;
+        const std::vector<double>               ADD_DOF;
+        const std::vector<std::vector<double> > ADD_grad_DOF;
+        std::vector<std::vector<double> >       ADD_TERMS;
+
+        errorCode = material->evaluate_model(time, fparams, current_grad_u_p, current_phi_p, current_grad_phi_p,
+                                             previous_grad_u, previous_phi, previous_grad_phi, SDVS_p, ADD_DOF,
+                                             ADD_grad_DOF, ADD_DOF, ADD_grad_DOF, PK2_p, SIGMA_p, M_p, ADD_TERMS,
+                                             output_message);
+
+        BOOST_CHECK(errorCode <= 0);
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(PK2_result, PK2_p));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(SIGMA_result, SIGMA_p));
+
+        BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(M_result, M_p));
+
+        if (p == 0) {
+            BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(PK2_result, PK2_answer));
+
+            BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(SIGMA_result, SIGMA_answer));
+
+            BOOST_CHECK(tardigradeVectorTools::fuzzyEquals(M_result, M_answer));
+        }
+    }
+}
+
+namespace {
+
+    class FailingMaterial : public micromorphic_material_library::IMaterial {
+        /*!
+         * A material with linear stresses which requests a cutback once phi_22 reaches 0.5
+         */
+
+       public:
+        using micromorphic_material_library::IMaterial::evaluate_model;
+
+        int evaluate_model(const std::vector<double> &time, const std::vector<double>(&fparams),
+                           const double (&current_grad_u)[3][3], const double (&current_phi)[9],
+                           const double (&current_grad_phi)[9][3], const double (&previous_grad_u)[3][3],
+                           const double (&previous_phi)[9], const double (&previous_grad_phi)[9][3],
+                           std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+                           const std::vector<std::vector<double> > &current_ADD_grad_DOF,
+                           const std::vector<double>               &previous_ADD_DOF,
+                           const std::vector<std::vector<double> > &previous_ADD_grad_DOF, std::vector<double> &PK2,
+                           std::vector<double> &SIGMA, std::vector<double> &M,
+                           std::vector<std::vector<double> > &ADD_TERMS, std::string &output_message
+#ifdef DEBUG_MODE
+                           ,
+                           std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > >
+                               &debug
+#endif
+                           ) override {
+            if (current_phi[4] >= 0.5) {
+                output_message = "phi_22 is too large";
+                return 1;
+            }
+
+            PK2.assign(9, 0);
+            SIGMA.assign(9, 0);
+            M.assign(27, 0);
+
+            for (unsigned int i = 0; i < 9; i++) {
+                PK2[i]   = 2 * current_grad_u[i / 3][i % 3];
+                SIGMA[i] = current_phi[i];
+            }
+
+            return 0;
+        }
+    };
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(testMaterialDiagnostic) {
+    /*!
+     * Test that failures of the numeric gradients and the batched evaluation are reported through the diagnostic
+     * record and that the messages are only built on failure
+     */
+
+    FailingMaterial material;
+
+    std::vector<double> time = {0., 1.};
+    std::vector<double> fparams;
+
+    double current_grad_u[3][3] = {{0.1, 0.2, 0.3}, {0.4, 0.5, 0.6}, {0.7, 0.8, 0.9}};
+    double current_phi[9]       = {0.1, 0.2, 0.3, 0.4, 0.3, 0.1, 0.2, 0.3, 0.4};
+    double current_grad_phi[9][3] = {};
+
+    std::vector<double>                             SDVS, ADD_DOF, PK2, SIGMA, M;
+    std::vector<std::vector<double> >               ADD_grad_DOF, ADD_TERMS;
+    std::vector<std::vector<std::vector<double> > > ADD_JACOBIANS;
+
+    std::vector<std::vector<double> > DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi,
+        DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi;
+
+    micromorphic_material_library::MaterialDiagnostic diagnostic;
+
+    int errorCode = material.evaluate_model_numeric_gradients(
+        time, fparams, current_grad_u, current_phi, current_grad_phi, current_grad_u, current_phi, current_grad_phi,
+        SDVS, ADD_DOF, ADD_grad_DOF, ADD_DOF, ADD_grad_DOF, PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi,
+        DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS,
+        diagnostic);
+
+    BOOST_CHECK(errorCode == 0);
+
+    BOOST_CHECK(diagnostic.code == 0);
+
+    BOOST_CHECK(diagnostic.message().empty());
+
+    BOOST_CHECK(std::fabs(DPK2Dgrad_u[0][0] - 2) < 1e-6);
+
+    BOOST_CHECK(std::fabs(DSIGMADphi[4][4] - 1) < 1e-6);
+
+    // The positive perturbation of phi_22 ( degree of freedom 13 ) fails for every number of threads
+    current_phi[4] = 0.5 - 1e-8;
+
+    for (unsigned int num_threads = 1; num_threads <= 4; num_threads += 3) {
+        errorCode = material.evaluate_model_numeric_gradients(
+            time, fparams, current_grad_u, current_phi, current_grad_phi, current_grad_u, current_phi,
+            current_grad_phi, SDVS, ADD_DOF, ADD_grad_DOF, ADD_DOF, ADD_grad_DOF, PK2, SIGMA, M, DPK2Dgrad_u,
+            DPK2Dphi, DPK2Dgrad_phi, DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi,
+            ADD_TERMS, ADD_JACOBIANS, diagnostic, 1e-6, micromorphic_material_library::CENTRAL_DIFFERENCE,
+            num_threads);
+
+        BOOST_CHECK(errorCode == 1);
+
+        BOOST_CHECK(diagnostic.code == 1);
+
+        BOOST_CHECK(diagnostic.column == 13);
+
+        BOOST_CHECK(diagnostic.detail == "phi_22 is too large");
+    }
+
+    std::string output_message;
+
+    errorCode = material.evaluate_model_numeric_gradients(
+        time, fparams, current_grad_u, current_phi, current_grad_phi, current_grad_u, current_phi, current_grad_phi,
+        SDVS, ADD_DOF, ADD_grad_DOF, ADD_DOF, ADD_grad_DOF, PK2, SIGMA, M, DPK2Dgrad_u, DPK2Dphi, DPK2Dgrad_phi,
+        DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi, DMDgrad_u, DMDphi, DMDgrad_phi, ADD_TERMS, ADD_JACOBIANS,
+        output_message);
+
+    BOOST_CHECK(errorCode == 1);
+
+    BOOST_CHECK(output_message ==
+                "Error in evaluate_model_numeric_gradients perturbing degree of freedom 13\nphi_22 is too large");
+
+    // A failure of the batch is reported at the first point which failed
+    const unsigned int  npoints = 2;
+    std::vector<double> grad_u_batch(9 * npoints, 0), phi_batch(9 * npoints, 0), grad_phi_batch(27 * npoints, 0);
+    std::vector<double> PK2_batch(9 * npoints), SIGMA_batch(9 * npoints), M_batch(27 * npoints);
+    phi_batch[4 * npoints + 1] = 0.9;
+
+    output_message = "";
+    errorCode      = material.evaluate_model_batch(npoints, time, fparams, grad_u_batch.data(), phi_batch.data(),
+                                                   grad_phi_batch.data(), grad_u_batch.data(), phi_batch.data(),
+                                                   grad_phi_batch.data(), SDVS, PK2_batch.data(), SIGMA_batch.data(),
+                                                   M_batch.data(), output_message);
+
+    BOOST_CHECK(errorCode == 1);
+
+    BOOST_CHECK(output_message == "Error in evaluate_model_batch at point 1\nphi_22 is too large");
+}
+
+BOOST_AUTO_TEST_CASE(testStateVariableStore) {
+    /*!
+     * Test the layout and the committed / trial swapping of the state variable store
+     */
+
+    micromorphic_material_library::StateVariableStore store(5, 8, 3, 16);
+
+    BOOST_CHECK(store.num_points() == 40);
+
+    BOOST_CHECK(store.num_blocks() == 3);
+
+    BOOST_CHECK(store.block_points(0) == 16);
+
+    BOOST_CHECK(store.block_points(2) == 8);
+
+    for (unsigned int b = 0; b < store.num_blocks(); b++) {
+        BOOST_CHECK(reinterpret_cast<std::uintptr_t>(store.trial_block(b)) % 64 == 0);
+
+        BOOST_CHECK(reinterpret_cast<std::uintptr_t>(store.committed_block(b)) % 64 == 0);
+    }
+
+    for (unsigned int e = 0; e < 5; e++) {
+        for (unsigned int g = 0; g < 8; g++) {
+            store.set_committed(e, g, {1. * e, 1. * g, 1. * (e + g)});
+        }
+    }
+
+    // The blocks are in structure of arrays form
+    const double *block = store.committed_block(2);
+
+    for (unsigned int p = 0; p < store.block_points(2); p++) {
+        BOOST_CHECK(block[0 * 8 + p] == 4.);
+
+        BOOST_CHECK(block[1 * 8 + p] == 1. * p);
+
+        BOOST_CHECK(block[2 * 8 + p] == 4. + p);
+    }
+
+    // Update the trial values of every point from the committed values
+    for (unsigned int e = 0; e < 5; e++) {
+        for (unsigned int g = 0; g < 8; g++) {
+            std::vector<double> SDVS;
+            store.get_committed(e, g, SDVS);
+            for (unsigned int i = 0; i < SDVS.size(); i++) {
+                SDVS[i] += 0.5;
+            }
+            store.set_trial(e, g, SDVS);
+        }
+    }
+
+    // The committed values are unchanged until the increment is committed
+    BOOST_CHECK(store.committed(3, 2, 1) == 2.);
+
+    BOOST_CHECK(store.trial(3, 2, 1) == 2.5);
+
+    store.commit();
+
+    BOOST_CHECK(store.committed(3, 2, 1) == 2.5);
+
+    BOOST_CHECK(store.committed(4, 7, 2) == 11.5);
+}
+
+namespace {
+
+    class CountingMaterial : public micromorphic_material_library::IMaterial {
+        /*!
+         * A material with linear stresses which adds grad_u_11 to each of its state variables
+         */
+
+       public:
+        using micromorphic_material_library::IMaterial::evaluate_model;
+
+        int evaluate_model(const std::vector<double> &time, const std::vector<double>(&fparams),
+                           const double (&current_grad_u)[3][3], const double (&current_phi)[9],
+                           const double (&current_grad_phi)[9][3], const double (&previous_grad_u)[3][3],
+                           const double (&previous_phi)[9], const double (&previous_grad_phi)[9][3],
+                           std::vector<double> &SDVS, const std::vector<double> &current_ADD_DOF,
+                           const std::vector<std::vector<double> > &current_ADD_grad_DOF,
+                           const std::vector<double>               &previous_ADD_DOF,
+                           const std::vector<std::vector<double> > &previous_ADD_grad_DOF, std::vector<double> &PK2,
+                           std::vector<double> &SIGMA, std::vector<double> &M,
+                           std::vector<std::vector<double> > &ADD_TERMS, std::string &output_message
+#ifdef DEBUG_MODE
+                           ,
+                           std::map<std::string, std::map<std::string, std::map<std::string, std::vector<double> > > >
+                               &debug
+#endif
+                           ) override {
+            PK2.assign(9, 0);
+            SIGMA.assign(9, 0);
+            M.assign(27, 0);
+
+            for (unsigned int i = 0; i < 9; i++) {
+                PK2[i]   = 2 * current_grad_u[i / 3][i % 3];
+                SIGMA[i] = current_phi[i];
+            }
+
+            for (unsigned int i = 0; i < SDVS.size(); i++) {
+                SDVS[i] += current_grad_u[0][0];
+            }
+
+            return 0;
+        }
+    };
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(testEvaluate_material_store) {
+    /*!
+     * Test the evaluation of a material at every point of a state variable store and that the points which are
+     * not written keep their committed values when the store is committed
+     */
+
+    CountingMaterial material;
+
+    const std::vector<double> time = {0., 1.};
+    const std::vector<double> fparams;
+
+    // 3 elements with 2 Gauss points in blocks of 4 points
+    micromorphic_material_library::StateVariableStore store(3, 2, 2, 4);
+
+    const unsigned int npoints = store.num_points();
+
+    for (unsigned int e = 0; e < 3; e++) {
+        for (unsigned int g = 0; g < 2; g++) {
+            store.set_committed(e, g, {1. * e, 1. * g});
+        }
+    }
+
+    std::vector<double> grad_u(9 * npoints, 0), phi(9 * npoints, 0), grad_phi(27 * npoints, 0);
+    std::vector<double> PK2(9 * npoints), SIGMA(9 * npoints), M(27 * npoints);
+    std::string         output_message;
+
+    for (unsigned int p = 0; p < npoints; p++) {
+        grad_u[p]            = 0.1 * (p + 1);
+        phi[4 * npoints + p] = -1. * p;
+    }
+
+    int errorCode = micromorphic_material_library::evaluate_material_store(
+        material, time, fparams, grad_u.data(), phi.data(), grad_phi.data(), grad_u.data(), phi.data(),
+        grad_phi.data(), store, PK2.data(), SIGMA.data(), M.data(), output_message);
+
+    BOOST_CHECK(errorCode == 0);
+
+    for (unsigned int p = 0; p < npoints; p++) {
+        BOOST_CHECK(std::fabs(PK2[p] - 0.2 * (p + 1)) < 1e-12);
+
+        BOOST_CHECK(SIGMA[4 * npoints + p] == -1. * p);
+
+        BOOST_CHECK(std::fabs(store.trial(p / 2, p % 2, 0) - (p / 2 + 0.1 * (p + 1))) < 1e-12);
+
+        BOOST_CHECK(store.committed(p / 2, p % 2, 1) == 1. * (p % 2));
+    }
+
+    store.commit();
+
+    BOOST_CHECK(std::fabs(store.committed(1, 0, 0) - 1.3) < 1e-12);
+
+    // Only element 0 is updated in the next increment
+    store.set_trial(0, 0, {10., 10.});
+    store.set_trial(0, 1, {10., 10.});
+
+    // A single state variable of a point may be updated
+    store.trial(1, 1, 1) = 5.;
+
+    store.commit();
+
+    BOOST_CHECK(store.committed(0, 1, 0) == 10.);
+
+    BOOST_CHECK(std::fabs(store.committed(1, 0, 0) - 1.3) < 1e-12);
+
+    BOOST_CHECK(std::fabs(store.committed(1, 1, 0) - 1.4) < 1e-12);
+
+    BOOST_CHECK(store.committed(1, 1, 1) == 5.);
+
+    BOOST_CHECK(std::fabs(store.committed(2, 1, 1) - 1.6) < 1e-12);
+
+    // The trial values of a rejected increment are dropped
+    store.set_trial(2, 1, {99., 99.});
+
+    store.discard();
+
+    store.commit();
+
+    BOOST_CHECK(std::fabs(store.committed(2, 1, 1) - 1.6) < 1e-12);
+
+    BOOST_CHECK(store.committed(0, 0, 1) == 10.);
 }
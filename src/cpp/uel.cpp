@@ -1,11 +1,15 @@
 #include<iostream>
 #include<fstream>
 #include<vector>
+#include<cstdlib>
+#include<algorithm>
+#include<mutex>
 #include<Eigen/Dense>
 #include <tensor.h>
 #include <micro_element.h>
 #include <tardigrade_micromorphic_linear_elasticity.h>
 #include <uel.h>
+#include <instrumentation.h>
 #include <aba_for_c.h>
 
 extern "C" void uel_(double *RHS,   double *AMATRX, double *SVARS,  double *ENERGY,
@@ -207,8 +211,6 @@ extern "C" void uel_(double *RHS,   double *AMATRX, double *SVARS,  double *ENER
                         //myfile << "NSVARS: " << NSVARS << "\n";
                         //myfile.close();
 
-                        Vector SVARS_vec            = Vector_Xd_Map(SVARS,NSVARS,1);
-                        //myfile << "SVARS_vec:\n" << SVARS_vec << "\n";
                         energy_vector ENERGY_vec    = Vector_8d_Map(ENERGY,8,1);
                         //myfile << "ENERGY_vec:\n" << ENERGY_vec << "\n";                        
 
@@ -246,13 +248,13 @@ extern "C" void uel_(double *RHS,   double *AMATRX, double *SVARS,  double *ENER
 
                         //!Parse the incoming element to the correct user subroutine
                         if(JTYPE==1){
-                            compute_hex8(RHS,        AMATRX,     SVARS_vec, ENERGY_vec,
+                            compute_hex8(RHS,        AMATRX,     SVARS,     ENERGY_vec,
                                          PROPS_vec,  COORDS_mat, U_vec,     DU_vec,
                                          V_vec,      A_vec,      TIME,      DTIME,
                                          KSTEP,      KINC,       JELEM,     PARAMS_vec,
                                          JDLTYP_mat, ADLMAG_vec, PREDEF,    NPREDF,
                                          LFLAGS_vec, DDLMAG_mat, PNEWDT,    JPROPS_vec,
-                                         PERIOD,     NDOFEL,     NRHS,      SVARS,
+                                         PERIOD,     NDOFEL,     NRHS,      NSVARS,
                                          output_fn);//,      myfile);
                         }
                         else{
@@ -261,13 +263,180 @@ extern "C" void uel_(double *RHS,   double *AMATRX, double *SVARS,  double *ENER
                         return;
 }
 
-void compute_hex8(double *RHS,          double *AMATRX,     Vector &SVARS,  energy_vector &ENERGY,
+template< typename T > class ElementCache{
+    /*!===
+     |
+     | E l e m e n t C a c h e
+     |
+    ===
+    
+    A bounded cache of values computed for each 
+    element indexed by the element number. The 
+    number of an element selects a single slot 
+    (the number modulo the capacity) so the look 
+    up does not search and the value stored for 
+    another element with the same slot is evicted. 
+    The memory used does not grow with the number 
+    of elements the cache has seen.
+    
+    */
+    
+    public:
+        ElementCache(unsigned int capacity) : elements(std::max(capacity,1u),-1), values(std::max(capacity,1u)){
+            /*!Constructor which sets the number of slots*/}
+        
+        T* find(const int JELEM){
+            /*!Return the value stored for the element or NULL if it is not stored*/
+            unsigned int index = slot(JELEM);
+            return (elements[index]==JELEM) ? &values[index] : NULL;
+        }
+        
+        T& insert(const int JELEM){
+            /*!Return the slot of the element for a new value evicting the value of 
+            any other element. The storage of the evicted value is reused.*/
+            unsigned int index = slot(JELEM);
+            elements[index] = JELEM;
+            return values[index];
+        }
+        
+    private:
+        std::vector< int > elements; //!The number of the element stored in each slot (-1 if empty)
+        std::vector< T >   values;   //!The value stored in each slot
+        
+        unsigned int slot(const int JELEM) const{
+            /*!The slot of the element*/
+            return static_cast< unsigned int >(JELEM)%elements.size();
+        }
+};
+
+static unsigned int read_uel_cache_size(){
+    /*!=============================
+    |    read_uel_cache_size    |
+    =============================
+    
+    Read the number of elements for which values 
+    are cached between calls from the environment 
+    variable MICROMORPHIC_UEL_CACHE_SIZE. The shape 
+    functions are cached by each thread and the 
+    element jacobians by the process. The default 
+    is 1024 elements.
+    
+    */
+    
+    const char *value = std::getenv("MICROMORPHIC_UEL_CACHE_SIZE");
+    if(value==NULL){return 1024;}
+    
+    int size = std::atoi(value);
+    if(size<1){return 1;}
+    
+    return size;
+}
+
+struct TangentCache{
+    /*!The element jacobian (stored as AMATRX) and the 
+    degrees of freedom at which it was computed*/
+    
+    Matrix_RM AMATRX; //!The cached AMATRX
+    Vector    U;      //!The degrees of freedom at which AMATRX was computed
+};
+
+class SharedTangentCache{
+    /*!===
+     |
+     | S h a r e d T a n g e n t C a c h e
+     |
+    ===
+    
+    A bounded cache of the element jacobians shared 
+    by all of the threads of the process so that 
+    whether the jacobian of an element is reused 
+    does not depend on which thread Abaqus calls 
+    the UEL on. As for ElementCache the number of 
+    an element selects a single slot. A slot keeps 
+    the lowest numbered element which has been 
+    stored in it and the jacobians of the other 
+    elements with the same slot are not cached. 
+    Once every element has been called (e.g. after 
+    the first iteration) the cached elements do 
+    not depend on the order of the calls. The slots 
+    are locked in shards and the values are copied 
+    while the shard is locked.
+    
+    */
+    
+    public:
+        SharedTangentCache(unsigned int capacity) : elements(std::max(capacity,1u),-1), values(std::max(capacity,1u)){
+            /*!Constructor which sets the number of slots*/}
+        
+        bool reuse(const int JELEM, const Vector &U, const double max_change, Matrix_Xd_Map AMATRX){
+            /*!Copy the jacobian stored for the element into AMATRX if U has changed 
+            by at most max_change since it was computed. Return whether it was copied.*/
+            unsigned int index = slot(JELEM);
+            std::lock_guard< std::mutex > lock(shards[index%num_shards]);
+            
+            TangentCache &value = values[index];
+            if((elements[index]!=JELEM) || (value.U.size()!=U.size()) || ((U-value.U).norm()>max_change)){
+                return false;
+            }
+            
+            AMATRX = value.AMATRX;
+            return true;
+        }
+        
+        void store(const int JELEM, const Vector &U, const Matrix_Xd_Map AMATRX){
+            /*!Store the jacobian of the element unless its slot holds a lower numbered 
+            element. The storage of the previous value of the slot is reused.*/
+            unsigned int index = slot(JELEM);
+            std::lock_guard< std::mutex > lock(shards[index%num_shards]);
+            
+            if((elements[index]>=0) && (elements[index]<JELEM)){return;}
+            
+            elements[index]      = JELEM;
+            values[index].AMATRX = AMATRX;
+            values[index].U      = U;
+        }
+        
+    private:
+        static const unsigned int num_shards = 64; //!The number of locks of the slots
+        
+        std::vector< int >          elements;           //!The number of the element stored in each slot (-1 if empty)
+        std::vector< TangentCache > values;             //!The jacobian stored in each slot
+        std::mutex                  shards[num_shards]; //!The lock of each slot (the slot modulo num_shards)
+        
+        unsigned int slot(const int JELEM) const{
+            /*!The slot of the element*/
+            return static_cast< unsigned int >(JELEM)%elements.size();
+        }
+};
+
+static double read_tangent_reuse_tolerance(){
+    /*!======================================
+    |    read_tangent_reuse_tolerance    |
+    ======================================
+    
+    Read the change in the element degrees of 
+    freedom since the element jacobian was computed, 
+    relative to their change over the increment (DU), 
+    below which the element jacobian of an earlier 
+    call is reused from the environment variable 
+    MICROMORPHIC_TANGENT_REUSE_TOLERANCE. The 
+    jacobian is always computed if it is not defined.
+    
+    */
+    
+    const char *value = std::getenv("MICROMORPHIC_TANGENT_REUSE_TOLERANCE");
+    if(value==NULL){return -1;}
+    
+    return std::atof(value);
+}
+
+void compute_hex8(double *RHS,          double *AMATRX,     double *SVARS,  energy_vector &ENERGY,
                  Vector &PROPS,         Matrix_RM &COORDS,  Vector &U,      Vector &DU,
                  Vector &V,             Vector &A,          double TIME[2], double DTIME, 
                  int KSTEP,             int KINC,           int JELEM,      params_vector &PARAMS,
                  Matrixi_RM &JDLTYP,    Vector &ADLMAG,     double *PREDEF, int NPREDF,
                  lflags_vector &LFLAGS, Matrix_RM &DDLMAG,  double PNEWDT,  Vectori &JPROPS,
-                 double PERIOD,         int NDOFEL,         int NRHS,       double *SVARS_ptr,
+                 double PERIOD,         int NDOFEL,         int NRHS,       int NSVARS,
                  std::string output_fn){//,       std::ofstream &myfile){
     /*!====================
     |   compute_hex8   |
@@ -276,16 +445,69 @@ void compute_hex8(double *RHS,          double *AMATRX,     Vector &SVARS,  ener
     Compute the response for a hex8 
     micromorphic element.
     
+    The calls are timed if the UEL is compiled 
+    with MICROMORPHIC_INSTRUMENTATION. Abaqus does 
+    not notify the UEL at the end of the analysis 
+    so the summary is written at exit to the file 
+    named by MICROMORPHIC_INSTRUMENTATION_OUTPUT.
+    
+    The reference shape functions are cached for 
+    at most MICROMORPHIC_UEL_CACHE_SIZE elements per 
+    thread.
+    
+    If MICROMORPHIC_TANGENT_REUSE_TOLERANCE is set 
+    the element jacobian of an earlier call is 
+    returned (modified Newton) while the change of 
+    the element degrees of freedom from those at 
+    which it was computed is below the tolerance 
+    times their change over the increment. The UEL 
+    does not see the global convergence so the 
+    change of U is the criterion. The correction of 
+    a converging iteration is small compared to DU 
+    while the first iteration of an increment moves 
+    U by about DU so the jacobian is formed again at 
+    least once in each increment. The jacobians are 
+    cached for at most MICROMORPHIC_UEL_CACHE_SIZE 
+    elements per process (about 74 kB each) and are 
+    shared between the threads so the reuse does 
+    not depend on the thread an element is computed 
+    on. If more elements than the cache size are 
+    called some of them are never reused (see 
+    SharedTangentCache).
+    
     */
     
+    MICROMORPHIC_TIME_SCOPE("uel hex8");
+    
     //!Create the element
 
     //myfile << "in compute_hex8\n";
 
-    micro_element::Hex8 element(RHS,    AMATRX,   SVARS,  ENERGY, PROPS,  COORDS, U,      DU,
-                                V,      A,        TIME,   DTIME,  KSTEP,  KINC,   JELEM,  PARAMS,
-                                JDLTYP, ADLMAG,   PREDEF, NPREDF, LFLAGS, DDLMAG, PNEWDT, JPROPS,
-                                PERIOD, output_fn);
+    //!The element is kept as a per-thread workspace and reset for each call 
+    //!so that its storage is not reallocated every time the UEL is called.
+    static thread_local micro_element::Hex8 element;
+    
+    //!The element updates SVARS in place (state variable i of gauss point g 
+    //!is SVARS[i*number_gauss_points+g]) so they are not copied.
+    element.reset(RHS,    AMATRX, SVARS, NSVARS, PROPS,  COORDS, U,  DU,
+                  KSTEP,  KINC,   JELEM, JPROPS, output_fn);
+    
+    //!The reference shape function values are cached for the elements 
+    //!the thread processes since COORDS are the original coordinates. 
+    //!The number of elements cached by each thread is bounded by 
+    //!MICROMORPHIC_UEL_CACHE_SIZE.
+    static thread_local ElementCache< micro_element::ShapeFunctionCache > shape_function_caches(read_uel_cache_size());
+    
+    micro_element::ShapeFunctionCache *shape_function_cache = shape_function_caches.find(JELEM);
+    if(shape_function_cache==NULL){
+        shape_function_cache = &shape_function_caches.insert(JELEM);
+        element.build_shape_function_cache(*shape_function_cache);
+    }
+    element.set_shape_function_cache(shape_function_cache);
+    
+    //!The gauss points are evaluated on the per-process pool if 
+    //!MICROMORPHIC_GAUSS_POINT_THREADS requests more than one thread.
+    micro_element::GaussPointPool &pool = micro_element::get_gauss_point_pool();
     
     //myfile << "Element initialized\n";
 
@@ -303,16 +525,31 @@ void compute_hex8(double *RHS,          double *AMATRX,     Vector &SVARS,  ener
 
     //myfile << "LFLAGS(2): " << LFLAGS(2) << "\n";
     
-    if(     LFLAGS(2)==1){ //!Update the RHS and the tangent
-        element.integrate_element(true, false, false, true);
+    //!The element jacobians are cached for the process if they may be reused.
+    static const double tangent_reuse_tolerance = read_tangent_reuse_tolerance();
+    static SharedTangentCache tangent_cache(read_uel_cache_size());
+    
+    if(     (LFLAGS(2)==1) && (tangent_reuse_tolerance>0)){ //!Update the RHS and the tangent if U has changed enough
+        if(tangent_cache.reuse(JELEM, U, tangent_reuse_tolerance*DU.norm(), Matrix_Xd_Map(AMATRX,NDOFEL,NDOFEL))){
+            MICROMORPHIC_COUNT("uel tangents reused",1);
+            element.integrate_element(pool, false, false, false, true);
+            Matrix_Xd_Map(RHS,NDOFEL,NRHS)          = element.RHS;
+        }
+        else{
+            element.integrate_element(pool, true, false, false, true);
+            Matrix_Xd_Map(RHS,NDOFEL,NRHS)          =  element.RHS;
+            Matrix_Xd_Map(AMATRX,NDOFEL,NDOFEL)     = -element.AMATRX;
+            tangent_cache.store(JELEM, U, Matrix_Xd_Map(AMATRX,NDOFEL,NDOFEL));
+        }
+    }
+    else if(LFLAGS(2)==1){ //!Update the RHS and the tangent
+        element.integrate_element(pool, true, false, false, true);
         Matrix_Xd_Map(RHS,NDOFEL,NRHS)          =  element.RHS;
         Matrix_Xd_Map(AMATRX,NDOFEL,NDOFEL)     = -element.AMATRX;
-        Vector_Xd_Map(SVARS_ptr,SVARS.rows(),1) =  element.SVARS;
     }
     else if(LFLAGS(2)==2){ //!Update the tangent only
-        element.integrate_element(true, true, false, true);
+        element.integrate_element(pool, true, true, false, true);
         Matrix_Xd_Map(AMATRX,NDOFEL,NDOFEL)     = -element.AMATRX;
-        Vector_Xd_Map(SVARS_ptr,SVARS.rows(),1) =  element.SVARS;
     }
     else if(LFLAGS(2)==3){ //!Update the damping matrix only (not implemented)
         std::cout << "\n# Damping matrix not implemented\n";
@@ -322,15 +559,13 @@ void compute_hex8(double *RHS,          double *AMATRX,     Vector &SVARS,  ener
         Matrix_Xd_Map(AMATRX,NDOFEL,NDOFEL) = -element.AMATRX;
     }
     else if(LFLAGS(2)==5){ //!Update the residual only
-        element.integrate_element(false, false);
+        element.integrate_element(pool, false, false);
         Matrix_Xd_Map(RHS,NDOFEL,NRHS)          = element.RHS;
-        Vector_Xd_Map(SVARS_ptr,SVARS.rows(),1) = element.SVARS;
     }
     else if(LFLAGS(2)==6){ //!Update the mass matrix and the residual vector only
         element.integrate_element(false, false, true);
         Matrix_Xd_Map(RHS,NDOFEL,NRHS)          =  element.RHS;
         Matrix_Xd_Map(AMATRX,NDOFEL,NDOFEL)     = -element.AMATRX;
-        Vector_Xd_Map(SVARS_ptr,SVARS.rows(),1) =  element.SVARS;
     }
 
     //myfile.close();
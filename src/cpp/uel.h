@@ -18,11 +18,11 @@ extern "C" void UEL(double *RHS,double *AMATRX,double *SVARS,double *ENERGY,
                     int *LFLAGS,int MLVARX,double *DDLMAG,int MDLOAD,
                     double PNEWDT,int *JPROPS,int NJPROP,double PERIOD);
                     
-void compute_hex8(double *RHS,          double *AMATRX,     Vector &SVARS,  energy_vector &ENERGY,
+void compute_hex8(double *RHS,          double *AMATRX,     double *SVARS,  energy_vector &ENERGY,
                  Vector &PROPS,         Matrix_RM &COORDS,  Vector &U,      Vector &DU,
                  Vector &V,             Vector &A,          double TIME[2], double DTIME, 
                  int KSTEP,             int KINC,           int JELEM,      params_vector &PARAMS,
                  Matrixi_RM &JDLTYP,    Vector &ADLMAG,     double *PREDEF, int NPREDF,
                  lflags_vector &LFLAGS, Matrix_RM &DDLMAG,  double PNEWDT,  Vectori &JPROPS,
-                 double PERIOD,         int NDOFEL,         int NRHS,       double *SVARS_ptr,
+                 double PERIOD,         int NDOFEL,         int NRHS,       int NSVARS,
                  std::string output_fn);//,       std::ofstream&);
@@ -24,3 +24,14 @@ cdef extern from "material_python_interface.h" namespace "materialPythonInterfac
                        vector[vector[double]] &DMDgrad_u,     vector[vector[double]] &DMDphi,     vector[vector[double]] &DMDgrad_phi,
                        vector[vector[double]] &ADD_TERMS,     vector[vector[vector[double]]] &ADD_JACOBIANS,
                        string &output_message);
+
+    int evaluate_model_batch(const string &model_name, const unsigned int npoints,
+                             const vector[double] &time, const vector[double] &fparams,
+                             const double *current_grad_u, const double *current_phi, const double *current_grad_phi,
+                             const double *previous_grad_u, const double *previous_phi, const double *previous_grad_phi,
+                             const unsigned int nsdvs, double *SDVS,
+                             double *PK2, double *SIGMA, double *M,
+                             double *DPK2Dgrad_u,   double *DPK2Dphi,   double *DPK2Dgrad_phi,
+                             double *DSIGMADgrad_u, double *DSIGMADphi, double *DSIGMADgrad_phi,
+                             double *DMDgrad_u,     double *DMDphi,     double *DMDgrad_phi,
+                             int *errorCodes, string &output_message) nogil
@@ -197,3 +197,140 @@ def evaluate_model(object model_name,
            DSIGMADgrad_u, DSIGMADphi, DSIGMADgrad_phi,\
            DMDgrad_u, DMDphi, DMDgrad_phi,\
            ADD_TERMS, ADD_JACOBIANS, output_message
+
+cdef check_shape(str name, tuple shape, tuple expected):
+    """
+    Check that the shape of a batched array is the expected one
+
+    :param str name: The name of the array
+    :param tuple shape: The shape of the array
+    :param tuple expected: The expected shape of the array
+    """
+
+    if shape != expected:
+        raise ValueError(f"{name} has shape {shape} but {expected} is required")
+
+cdef double* jacobian_pointer(str name, double[:, :, ::1] J, Py_ssize_t npoints, Py_ssize_t rows, Py_ssize_t cols) except? NULL:
+    """
+    Get the pointer to the data of an optional jacobian output
+
+    :param str name: The name of the jacobian
+    :param double[:, :, ::1] J: The jacobian array or None
+    :param Py_ssize_t npoints: The number of points
+    :param Py_ssize_t rows: The number of rows of the jacobian of each point
+    :param Py_ssize_t cols: The number of columns of the jacobian of each point
+    """
+
+    if J is None:
+        return NULL
+
+    check_shape(name, (J.shape[0], J.shape[1], J.shape[2]), (npoints, rows, cols))
+
+    return &J[0, 0, 0]
+
+def evaluate_model_batch(object model_name,
+                         np.ndarray time, np.ndarray fparams,
+                         const double[:, :, ::1] current_grad_u,  const double[:, ::1] current_phi,  const double[:, :, ::1] current_grad_phi,
+                         const double[:, :, ::1] previous_grad_u, const double[:, ::1] previous_phi, const double[:, :, ::1] previous_grad_phi,
+                         double[:, ::1] SDVS,
+                         double[:, ::1] PK2, double[:, ::1] SIGMA, double[:, ::1] M,
+                         double[:, :, ::1] DPK2Dgrad_u=None,   double[:, :, ::1] DPK2Dphi=None,   double[:, :, ::1] DPK2Dgrad_phi=None,
+                         double[:, :, ::1] DSIGMADgrad_u=None, double[:, :, ::1] DSIGMADphi=None, double[:, :, ::1] DSIGMADgrad_phi=None,
+                         double[:, :, ::1] DMDgrad_u=None,     double[:, :, ::1] DMDphi=None,     double[:, :, ::1] DMDgrad_phi=None,
+                         int[::1] errorCodes=None):
+    """
+    Evaluate the material model at N points which share the same time and parameters
+
+    The point-wise arrays must be C-contiguous float64 arrays with the point as the first index. They are
+    passed to the material library without being copied and the results are written in place into the
+    preallocated output arrays. The GIL is released while the points are evaluated.
+
+    :param str model_name: The name of the model to be evaluated
+    :param np.ndarray time: The current time and the timestep
+    :param np.ndarray fparams: The parameters for the constitutive model
+    :param current_grad_u: The current displacement gradients ( N, 3, 3 )
+    :param current_phi: The current micro displacements ( N, 9 )
+    :param current_grad_phi: The current micro displacement gradients ( N, 9, 3 )
+    :param previous_grad_u: The previous displacement gradients ( N, 3, 3 )
+    :param previous_phi: The previous micro displacements ( N, 9 )
+    :param previous_grad_phi: The previous micro displacement gradients ( N, 9, 3 )
+    :param SDVS: The previously converged state variables ( N, nsdvs ). Overwritten with the updated values.
+    :param PK2: The output second Piola Kirchhoff stresses ( N, 9 )
+    :param SIGMA: The output reference symmetric micro stresses ( N, 9 )
+    :param M: The output reference higher order stresses ( N, 27 )
+    :param DPK2Dgrad_u: The optional output jacobians of PK2 w.r.t. grad u ( N, 9, 9 )
+    :param DPK2Dphi: The optional output jacobians of PK2 w.r.t. phi ( N, 9, 9 )
+    :param DPK2Dgrad_phi: The optional output jacobians of PK2 w.r.t. grad phi ( N, 9, 27 )
+    :param DSIGMADgrad_u: The optional output jacobians of SIGMA w.r.t. grad u ( N, 9, 9 )
+    :param DSIGMADphi: The optional output jacobians of SIGMA w.r.t. phi ( N, 9, 9 )
+    :param DSIGMADgrad_phi: The optional output jacobians of SIGMA w.r.t. grad phi ( N, 9, 27 )
+    :param DMDgrad_u: The optional output jacobians of M w.r.t. grad u ( N, 27, 9 )
+    :param DMDphi: The optional output jacobians of M w.r.t. phi ( N, 27, 9 )
+    :param DMDgrad_phi: The optional output jacobians of M w.r.t. grad phi ( N, 27, 27 )
+    :param errorCodes: The optional output error code of each point ( N, ) of dtype np.intc
+
+    :returns: The largest error code of the points and the output message of the first point which failed
+        0: No errors. Solution converged.
+        1: Convergence Error. Request timestep cutback.
+        2: Fatal Errors encountered. Terminate the simulation.
+    """
+
+    cdef string c_model_name = model_name.encode('UTF-8')
+
+    cdef vector[double] c_time    = map_array_to_vector(time, 1)
+    cdef vector[double] c_fparams = map_array_to_vector(fparams, 1)
+    cdef string c_output_message
+    cdef int errorCode
+
+    cdef Py_ssize_t npoints = current_grad_u.shape[0]
+    cdef Py_ssize_t nsdvs   = SDVS.shape[1]
+
+    check_shape("current_grad_u",    (current_grad_u.shape[0], current_grad_u.shape[1], current_grad_u.shape[2]),          (npoints, 3, 3))
+    check_shape("current_phi",       (current_phi.shape[0], current_phi.shape[1]),                                         (npoints, 9))
+    check_shape("current_grad_phi",  (current_grad_phi.shape[0], current_grad_phi.shape[1], current_grad_phi.shape[2]),    (npoints, 9, 3))
+    check_shape("previous_grad_u",   (previous_grad_u.shape[0], previous_grad_u.shape[1], previous_grad_u.shape[2]),       (npoints, 3, 3))
+    check_shape("previous_phi",      (previous_phi.shape[0], previous_phi.shape[1]),                                       (npoints, 9))
+    check_shape("previous_grad_phi", (previous_grad_phi.shape[0], previous_grad_phi.shape[1], previous_grad_phi.shape[2]), (npoints, 9, 3))
+    check_shape("SDVS",              (SDVS.shape[0], SDVS.shape[1]),                                                       (npoints, nsdvs))
+    check_shape("PK2",               (PK2.shape[0], PK2.shape[1]),                                                         (npoints, 9))
+    check_shape("SIGMA",             (SIGMA.shape[0], SIGMA.shape[1]),                                                     (npoints, 9))
+    check_shape("M",                 (M.shape[0], M.shape[1]),                                                             (npoints, 27))
+
+    if errorCodes is not None:
+        check_shape("errorCodes", (errorCodes.shape[0],), (npoints,))
+
+    if npoints == 0:
+        return 0, ""
+
+    cdef double *c_DPK2Dgrad_u     = jacobian_pointer("DPK2Dgrad_u",     DPK2Dgrad_u,     npoints,  9,  9)
+    cdef double *c_DPK2Dphi        = jacobian_pointer("DPK2Dphi",        DPK2Dphi,        npoints,  9,  9)
+    cdef double *c_DPK2Dgrad_phi   = jacobian_pointer("DPK2Dgrad_phi",   DPK2Dgrad_phi,   npoints,  9, 27)
+    cdef double *c_DSIGMADgrad_u   = jacobian_pointer("DSIGMADgrad_u",   DSIGMADgrad_u,   npoints,  9,  9)
+    cdef double *c_DSIGMADphi      = jacobian_pointer("DSIGMADphi",      DSIGMADphi,      npoints,  9,  9)
+    cdef double *c_DSIGMADgrad_phi = jacobian_pointer("DSIGMADgrad_phi", DSIGMADgrad_phi, npoints,  9, 27)
+    cdef double *c_DMDgrad_u       = jacobian_pointer("DMDgrad_u",       DMDgrad_u,       npoints, 27,  9)
+    cdef double *c_DMDphi          = jacobian_pointer("DMDphi",          DMDphi,          npoints, 27,  9)
+    cdef double *c_DMDgrad_phi     = jacobian_pointer("DMDgrad_phi",     DMDgrad_phi,     npoints, 27, 27)
+
+    cdef double *c_SDVS      = NULL
+    cdef int    *c_errorCodes = NULL
+
+    if nsdvs > 0:
+        c_SDVS = &SDVS[0, 0]
+
+    if errorCodes is not None:
+        c_errorCodes = &errorCodes[0]
+
+    with nogil:
+        errorCode = materials.evaluate_model_batch(c_model_name, <unsigned int>npoints,\
+                                                   c_time, c_fparams,\
+                                                   &current_grad_u[0, 0, 0],  &current_phi[0, 0],  &current_grad_phi[0, 0, 0],\
+                                                   &previous_grad_u[0, 0, 0], &previous_phi[0, 0], &previous_grad_phi[0, 0, 0],\
+                                                   <unsigned int>nsdvs, c_SDVS,\
+                                                   &PK2[0, 0], &SIGMA[0, 0], &M[0, 0],\
+                                                   c_DPK2Dgrad_u,   c_DPK2Dphi,   c_DPK2Dgrad_phi,\
+                                                   c_DSIGMADgrad_u, c_DSIGMADphi, c_DSIGMADgrad_phi,\
+                                                   c_DMDgrad_u,     c_DMDphi,     c_DMDgrad_phi,\
+                                                   c_errorCodes, c_output_message)
+
+    return errorCode, c_output_message.decode('UTF-8')
@@ -27,6 +27,34 @@ class Element(object):
     def __repr__(self):
         return "Element(steps = {0}, increments = {1})".format(self.steps.keys(),self.steps.values())
 
+#The layout of the records in the binary stress output (see StressWriter in micro_element.h)
+stress_record_dtype = np.dtype([('element',     '<i4'),
+                                ('step',        '<i4'),
+                                ('increment',   '<i4'),
+                                ('gauss_point', '<i4'),
+                                ('PK2',         '<f8', (9,)),
+                                ('SIGMA',       '<f8', (6,)),
+                                ('M',           '<f8', (27,))])
+
+def read_stress_records(fn):
+    """Read the records of a binary stress output file"""
+    with open(fn,'rb') as f:
+        header = f.read(16)
+        if(header[:8] != b"MICROSTR"):
+            raise IOError("{0} is not a binary stress output file".format(fn))
+        version,record_size = np.frombuffer(header[8:],dtype='<u4')
+        if(record_size != stress_record_dtype.itemsize):
+            raise IOError("Unexpected record size {0} in {1}".format(record_size,fn))
+        chunks = []
+        while True:
+            count = np.fromfile(f,dtype='<u8',count=1)
+            if(len(count)==0):
+                break
+            chunks.append(np.fromfile(f,dtype=stress_record_dtype,count=int(count[0])))
+    if(len(chunks)==0):
+        return np.zeros(0,dtype=stress_record_dtype)
+    return np.concatenate(chunks)
+
 class ProcessMicroMorphic(object):
     """ Process the results generated by an abaqus simulation of a micromorphic finite element"""
 
@@ -48,22 +76,52 @@ class ProcessMicroMorphic(object):
         """Process the files to collect the required information"""
 
         for fn in self.files:
+            if(fn.endswith(".stress")):
+                self.process_stress_file(fn)
+                continue
+
             #Get element, step, and increment information
             el,stp,inc = [int(v) for v in fn.split("_")[-3:]]
             data       = self.get_data(fn)
-            
-            if(el not in self.elements.keys()):
-                self.elements[el] = copy.deepcopy(Element(stp,inc,data))
-
-            elif(stp not in self.elements[el].steps.keys()):
-                self.elements[el].steps[inc] = copy.deepcopy(Step(inc,data))
-            
-            elif(inc not in self.elements[el].steps[stp].increments.keys()):
-                self.elements[el].steps[stp].increments[inc] = copy.deepcopy(data)
-
-            else:
-                print "Error: Multiple definitions for\nElement: {0}\nStep: {1}\nIncrement: {2}\n".format(el,stp,inc)
-                raise IOError
+            self.add_data(el,stp,inc,data)
+
+    def process_stress_file(self,fn):
+        """Process a binary stress output file
+
+        The values of the last gauss point are stored under
+        the PK2, SIGMA, and M keys as they were in the text
+        output. The values at every gauss point are stored
+        under the gauss_points key."""
+
+        records = read_stress_records(fn)
+        output  = {}
+
+        for record in records:
+            key = (int(record['element']),int(record['step']),int(record['increment']))
+            if(key not in output.keys()):
+                output[key] = {'gauss_points':{}}
+            values = {'PK2':list(record['PK2']),'SIGMA':list(record['SIGMA']),'M':list(record['M'])}
+            output[key]['gauss_points'][int(record['gauss_point'])] = values
+            if(int(record['gauss_point']) == max(output[key]['gauss_points'].keys())):
+                output[key].update(values)
+
+        for (el,stp,inc),data in output.items():
+            self.add_data(el,stp,inc,data)
+
+    def add_data(self,el,stp,inc,data):
+        """Add the data of an element at a step and increment"""
+        if(el not in self.elements.keys()):
+            self.elements[el] = copy.deepcopy(Element(stp,inc,data))
+
+        elif(stp not in self.elements[el].steps.keys()):
+            self.elements[el].steps[inc] = copy.deepcopy(Step(inc,data))
+        
+        elif(inc not in self.elements[el].steps[stp].increments.keys()):
+            self.elements[el].steps[stp].increments[inc] = copy.deepcopy(data)
+
+        else:
+            print "Error: Multiple definitions for\nElement: {0}\nStep: {1}\nIncrement: {2}\n".format(el,stp,inc)
+            raise IOError
 
     def get_data(self,fn):
         """Get the data from a given file"""
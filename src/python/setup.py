@@ -20,11 +20,17 @@ library_dirs = [os.path.abspath('../../build/src/cpp')]
 
 shared_libraries = ['micromat']
 
+# Compile in the hot path counters and timers if requested
+define_macros = []
+if os.environ.get('MICROMORPHIC_INSTRUMENTATION'):
+    define_macros.append(('MICROMORPHIC_INSTRUMENTATION', None))
+
 ext_modules = [Extension(project_name,
                sources=source_files,
                language='c++',
                libraries=shared_libraries,
                include_dirs=include_dirs,
+               define_macros=define_macros,
                extra_compile_args=[f"-std=c++{cxx_standard}"],
                extra_link_args=[f"-L{d}" for d in library_dirs])]
 
@@ -213,3 +213,101 @@ def test_evaluate_model(model_name, time, fparams, current_grad_u, current_phi,
     for key in answers:
 
         assert np.allclose(answers[key], results[key])
+
+@pytest.mark.parametrize("model_name, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi, previous_grad_phi, SDVS, current_ADD_DOF, previous_ADD_DOF, current_ADD_grad_DOF, previous_ADD_grad_DOF, answers", data)
+def test_evaluate_model_batch(model_name, time, fparams, current_grad_u, current_phi, current_grad_phi, previous_grad_u, previous_phi, previous_grad_phi, SDVS, current_ADD_DOF, previous_ADD_DOF, current_ADD_grad_DOF, previous_ADD_grad_DOF, answers):
+    """
+    Test the evaluation of the model at a batch of points
+
+    Every point of the batch has the same inputs so each row of the outputs must match the single point answers
+    and the jacobians returned by evaluate_model.
+
+    :param str model_name: The name of the model to evaluate
+    :param np.ndarray time: The time
+    :param np.ndarray fparams: The model parameters
+    :param np.ndarray current_grad_u: The current gradient of the macro displacement
+    :param np.ndarray current_phi: The current micro displacement
+    :param np.ndarray current_grad_phi: The current gradient of the micro displacement
+    :param np.ndarray previous_grad_u: The previous gradient of the macro displacement
+    :param np.ndarray previous_phi: The previous micro displacement
+    :param np.ndarray previous_grad_phi: The previous gradient of the micro displacement
+    :param np.ndarray SDVS: The solution dependent state variables
+    :param np.ndarray current_ADD_DOF: The current values additional degrees of freedom required for the model
+    :param np.ndarray previous_ADD_DOF: The previous values of the additional degrees of freedom required for the model
+    :param np.ndarray current_ADD_grad_DOF: The current values of the gradients of the additional degrees of freedom required for the model
+    :param np.ndarray previous_ADD_grad_DOF: The previous values of the gradients of the additional degrees of freedom required for the model
+    :param dict answers: The answer dictionary
+    """
+
+    npoints = 4
+
+    def tile(A):
+        return np.ascontiguousarray(np.tile(np.asarray(A, dtype=float), (npoints,) + (1,) * np.ndim(A)))
+
+    values = micromorphic.evaluate_model(model_name,\
+                                         time, fparams,\
+                                         current_grad_u, current_phi, current_grad_phi,\
+                                         previous_grad_u, previous_phi, previous_grad_phi,\
+                                         SDVS,\
+                                         current_ADD_DOF, current_ADD_grad_DOF,\
+                                         previous_ADD_DOF, previous_ADD_grad_DOF)
+
+    jacobian_keys = ['DPK2Dgrad_u', 'DPK2Dphi', 'DPK2Dgrad_phi',\
+                     'DSIGMADgrad_u', 'DSIGMADphi', 'DSIGMADgrad_phi',\
+                     'DMDgrad_u', 'DMDphi', 'DMDgrad_phi']
+
+    jacobian_answers = dict(zip(jacobian_keys, values[5:14]))
+
+    for compute_jacobians in [False, True]:
+
+        batch_SDVS = tile(SDVS)
+
+        results = {'PK2':np.zeros((npoints, 9)), 'SIGMA':np.zeros((npoints, 9)), 'M':np.zeros((npoints, 27))}
+
+        jacobians = {}
+        if compute_jacobians:
+            jacobians = dict([(key, np.zeros((npoints,) + jacobian_answers[key].shape)) for key in jacobian_keys])
+
+        errorCodes = np.zeros(npoints, dtype=np.intc)
+
+        errorCode, output_message = micromorphic.evaluate_model_batch(model_name,\
+                                                                      time, fparams,\
+                                                                      tile(current_grad_u), tile(current_phi), tile(current_grad_phi),\
+                                                                      tile(previous_grad_u), tile(previous_phi), tile(previous_grad_phi),\
+                                                                      batch_SDVS,\
+                                                                      results['PK2'], results['SIGMA'], results['M'],\
+                                                                      errorCodes=errorCodes, **jacobians)
+
+        if (errorCode != 0):
+            print(output_message)
+            assert errorCode == 0
+
+        assert np.all(errorCodes == 0)
+
+        results['SDVS'] = batch_SDVS
+
+        for p in range(npoints):
+
+            for key in answers:
+
+                assert np.allclose(answers[key], results[key][p])
+
+            for key in jacobians:
+
+                assert np.allclose(jacobian_answers[key], jacobians[key][p])
+
+def test_evaluate_model_batch_shape_check():
+    """
+    Test that evaluate_model_batch rejects arrays of the wrong shape
+    """
+
+    model_name, time, fparams = data[0][:3]
+
+    npoints = 2
+
+    with pytest.raises(ValueError):
+        micromorphic.evaluate_model_batch(model_name, time, fparams,\
+                                          np.zeros((npoints, 3, 3)), np.zeros((npoints, 9)), np.zeros((npoints, 9, 3)),\
+                                          np.zeros((npoints, 3, 3)), np.zeros((npoints, 9)), np.zeros((npoints, 9, 3)),\
+                                          np.zeros((npoints, 3)),\
+                                          np.zeros((npoints, 9)), np.zeros((npoints, 9)), np.zeros((npoints + 1, 27)))